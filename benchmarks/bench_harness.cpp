@@ -0,0 +1,252 @@
+#include "bench_harness.h"
+#include "simd_lib.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+#ifdef PLATFORM_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace simd_bench {
+
+static inline uint64_t read_tsc() {
+#ifdef PLATFORM_X86
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+std::vector<SizeLevel> default_levels() {
+    return {{"L1", 16 << 10}, {"L2", 192 << 10}, {"L3", 3 << 20}, {"DRAM", 96 << 20}};
+}
+
+bool pin_thread(int cpu) {
+    if (cpu < 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// Nearest-rank percentile of sorted values
+static double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = (size_t)std::ceil(p * (double)sorted.size());
+    rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+    return sorted[rank - 1];
+}
+
+static bool matches(const Kernel& kernel, const std::string& filter) {
+    return filter.empty() || (kernel.group + "/" + kernel.name).find(filter) != std::string::npos;
+}
+
+#ifdef SIMD_LIB_PERF_COUNTERS
+static const simd_lib::PerfCounters& bench_counters() {
+    static simd_lib::PerfCounters counters;
+    return counters;
+}
+#endif
+
+// Calls run in batches long enough for the clock, and returns the per-call
+// time and TSC ticks of each batch
+static void sample_variant(const Variant& variant, double budget_ns,
+                           std::vector<double>* call_ns, std::vector<double>* call_ticks, Result* result) {
+    typedef std::chrono::steady_clock clock;
+    const double min_batch_ns = 20000.0;
+
+    // Warm-up call also sizes the batches
+    variant.run();
+    auto start = clock::now();
+    variant.run();
+    double single_ns = std::max(1.0, (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         clock::now() - start).count());
+
+    size_t reps = std::max<size_t>(1, (size_t)(min_batch_ns / single_ns));
+    size_t samples = (size_t)(budget_ns / (single_ns * (double)reps));
+    samples = std::min<size_t>(std::max<size_t>(samples, 5), 2000);
+
+    call_ns->clear();
+    call_ticks->clear();
+#ifdef SIMD_LIB_PERF_COUNTERS
+    simd_lib::PerfSample counters_begin = bench_counters().read();
+#else
+    (void)result;
+#endif
+    for (size_t s = 0; s < samples; ++s) {
+        uint64_t tsc_start = read_tsc();
+        auto t0 = clock::now();
+        for (size_t r = 0; r < reps; ++r) {
+            variant.run();
+        }
+        auto t1 = clock::now();
+        uint64_t tsc_end = read_tsc();
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        call_ns->push_back(ns / (double)reps);
+        call_ticks->push_back((double)(tsc_end - tsc_start) / (double)reps);
+    }
+#ifdef SIMD_LIB_PERF_COUNTERS
+    simd_lib::PerfSample counters = simd_lib::perf_delta(counters_begin, bench_counters().read());
+    result->ipc = counters.ipc();
+    result->l1d_mpki = counters.l1d_mpki();
+    result->llc_mpki = counters.llc_mpki();
+    result->branch_mpki = counters.branch_mpki();
+#endif
+}
+
+static void print_header() {
+    std::cout << std::left << std::setw(30) << "Kernel" << std::setw(9) << "ISA" << std::setw(6) << "Size"
+              << std::right << std::setw(10) << "Elements" << std::setw(12) << "Median us"
+              << std::setw(12) << "p99 us" << std::setw(9) << "GB/s" << std::setw(9) << "GFLOP/s"
+              << std::setw(10) << "Cyc/elem" << std::setw(9) << "Speedup";
+#ifdef SIMD_LIB_PERF_COUNTERS
+    std::cout << std::setw(7) << "IPC" << std::setw(9) << "L1D MPKI" << std::setw(9) << "LLC MPKI"
+              << std::setw(8) << "Br MPKI";
+#endif
+    std::cout << "\n" << std::string(116, '-') << "\n";
+}
+
+static void print_result(const Result& r) {
+    std::cout << std::left << std::setw(30) << (r.group + "/" + r.kernel) << std::setw(9) << r.isa
+              << std::setw(6) << r.level << std::right << std::setw(10) << r.elements << std::fixed
+              << std::setprecision(2) << std::setw(12) << r.median_ns / 1000.0 << std::setw(12)
+              << r.p99_ns / 1000.0 << std::setw(9) << r.gb_per_s << std::setw(9) << r.gflop_per_s
+              << std::setprecision(3) << std::setw(10) << r.cycles_per_element << std::setprecision(2)
+              << std::setw(8) << r.speedup << (r.speedup > 0.0 ? "x" : " ");
+#ifdef SIMD_LIB_PERF_COUNTERS
+    std::cout << std::setw(7) << r.ipc << std::setw(9) << r.l1d_mpki << std::setw(9) << r.llc_mpki
+              << std::setw(8) << r.branch_mpki;
+#endif
+    std::cout << "\n";
+}
+
+std::vector<Result> run_benchmarks(const std::vector<Kernel>& kernels, const Options& options) {
+    std::vector<Result> results;
+    std::vector<double> call_ns, call_ticks;
+
+    print_header();
+    for (const Kernel& kernel : kernels) {
+        if (!matches(kernel, options.filter)) {
+            continue;
+        }
+        for (const SizeLevel& level : options.levels) {
+            Case c = kernel.make(level.bytes);
+            size_t first = results.size();
+            double scalar_ns = 0.0;
+
+            for (const Variant& variant : c.variants) {
+                Result r;
+                sample_variant(variant, options.budget_ms * 1e6, &call_ns, &call_ticks, &r);
+                std::sort(call_ns.begin(), call_ns.end());
+                std::sort(call_ticks.begin(), call_ticks.end());
+
+                r.kernel = kernel.name;
+                r.group = kernel.group;
+                r.isa = variant.isa;
+                r.level = level.name;
+                r.working_set = level.bytes;
+                r.elements = c.elements;
+                r.samples = call_ns.size();
+                r.median_ns = percentile(call_ns, 0.5);
+                r.p99_ns = percentile(call_ns, 0.99);
+                r.gb_per_s = c.bytes / r.median_ns;
+                r.gflop_per_s = c.flops / r.median_ns;
+                r.cycles_per_element = c.elements > 0 ? percentile(call_ticks, 0.5) / (double)c.elements : 0.0;
+                if (variant.isa == "scalar") {
+                    scalar_ns = r.median_ns;
+                }
+                results.push_back(r);
+            }
+
+            for (size_t i = first; i < results.size(); ++i) {
+                results[i].speedup = scalar_ns > 0.0 ? scalar_ns / results[i].median_ns : 0.0;
+                print_result(results[i]);
+            }
+        }
+    }
+    return results;
+}
+
+bool write_csv(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "group,kernel,isa,level,working_set_bytes,elements,samples,median_ns,p99_ns,"
+           "gb_per_s,gflop_per_s,cycles_per_element,speedup_vs_scalar";
+#ifdef SIMD_LIB_PERF_COUNTERS
+    out << ",ipc,l1d_mpki,llc_mpki,branch_mpki";
+#endif
+    out << "\n" << std::setprecision(6);
+    for (const Result& r : results) {
+        out << r.group << "," << r.kernel << "," << r.isa << "," << r.level << "," << r.working_set << ","
+            << r.elements << "," << r.samples << "," << r.median_ns << "," << r.p99_ns << "," << r.gb_per_s
+            << "," << r.gflop_per_s << "," << r.cycles_per_element << "," << r.speedup;
+#ifdef SIMD_LIB_PERF_COUNTERS
+        out << "," << r.ipc << "," << r.l1d_mpki << "," << r.llc_mpki << "," << r.branch_mpki;
+#endif
+        out << "\n";
+    }
+    return (bool)out;
+}
+
+bool write_json(const std::string& path, const std::vector<Result>& results, const Options& options) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    const auto& features = simd_lib::get_cpu_features();
+    auto flag = [](bool value) { return value ? "true" : "false"; };
+
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"version\": \"" << simd_lib::get_simd_version() << "\",\n";
+    out << "  \"timestamp\": " << (long long)std::time(nullptr) << ",\n";
+    out << "  \"pinned_cpu\": " << options.cpu << ",\n";
+    out << "  \"features\": {\"sse4_1\": " << flag(features.has_sse4_1) << ", \"sse4_2\": "
+        << flag(features.has_sse4_2) << ", \"avx\": " << flag(features.has_avx) << ", \"avx2\": "
+        << flag(features.has_avx2) << ", \"fma\": " << flag(features.has_fma) << ", \"avx_vnni\": "
+        << flag(features.has_avx_vnni) << "},\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"group\": \"" << r.group << "\", \"kernel\": \"" << r.kernel << "\", \"isa\": \"" << r.isa
+            << "\", \"level\": \"" << r.level << "\", \"working_set_bytes\": " << r.working_set
+            << ", \"elements\": " << r.elements << ", \"samples\": " << r.samples
+            << ", \"median_ns\": " << r.median_ns << ", \"p99_ns\": " << r.p99_ns
+            << ", \"gb_per_s\": " << r.gb_per_s << ", \"gflop_per_s\": " << r.gflop_per_s
+            << ", \"cycles_per_element\": " << r.cycles_per_element
+            << ", \"speedup_vs_scalar\": " << r.speedup;
+#ifdef SIMD_LIB_PERF_COUNTERS
+        out << ", \"ipc\": " << r.ipc << ", \"l1d_mpki\": " << r.l1d_mpki << ", \"llc_mpki\": " << r.llc_mpki
+            << ", \"branch_mpki\": " << r.branch_mpki;
+#endif
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return (bool)out;
+}
+
+} // namespace simd_bench
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace simd_bench {
+
+// One implementation of a kernel at one problem size. run() performs a single
+// call; it must not allocate so that the timing covers only the kernel.
+struct Variant {
+    std::string isa;            // "scalar", "sse4", "avx2", "avxvnni" or "auto" (dispatcher only)
+    std::function<void()> run;
+};
+
+// A kernel prepared for one size: its variants plus the work done per call
+struct Case {
+    size_t elements = 0;        // elements processed per call, for cycles/element
+    double bytes = 0.0;         // bytes read + written per call, for GB/s
+    double flops = 0.0;         // floating-point (or integer multiply-add) ops per call
+    std::vector<Variant> variants;
+};
+
+// A registered kernel. make() receives a target working-set size in bytes
+// and allocates its own buffers, sized so one call touches about that much
+struct Kernel {
+    std::string name;
+    std::string group;
+    std::function<Case(size_t working_set_bytes)> make;
+};
+
+// Timing of one variant at one size
+struct Result {
+    std::string kernel;
+    std::string group;
+    std::string isa;
+    std::string level;          // "L1", "L2", "L3" or "DRAM"
+    size_t working_set = 0;
+    size_t elements = 0;
+    size_t samples = 0;
+    double median_ns = 0.0;     // per call
+    double p99_ns = 0.0;
+    double gb_per_s = 0.0;
+    double gflop_per_s = 0.0;
+    double cycles_per_element = 0.0;   // TSC reference cycles; 0 when unavailable
+    double speedup = 0.0;       // scalar median / this median; 0 without a scalar variant
+#ifdef SIMD_LIB_PERF_COUNTERS
+    // Core-cycle counters over all timed calls (zero when the PMU is unavailable)
+    double ipc = 0.0;
+    double l1d_mpki = 0.0;
+    double llc_mpki = 0.0;
+    double branch_mpki = 0.0;
+#endif
+};
+
+struct SizeLevel {
+    const char* name;
+    size_t bytes;
+};
+
+struct Options {
+    std::string filter;                 // substring match on "group/name"
+    std::vector<SizeLevel> levels;
+    double budget_ms = 40.0;            // time spent per variant and size
+    int cpu = 0;                        // core to pin to; -1 disables pinning
+    std::string csv_path;
+    std::string json_path;
+};
+
+// The default sweep: working sets that fit L1, L2 and L3, and one that does not
+std::vector<SizeLevel> default_levels();
+
+// Pins the calling thread to one core; returns false if the OS refused
+bool pin_thread(int cpu);
+
+// Times every variant of every matching kernel at every level. Progress is
+// printed as a table on stdout.
+std::vector<Result> run_benchmarks(const std::vector<Kernel>& kernels, const Options& options);
+
+bool write_csv(const std::string& path, const std::vector<Result>& results);
+bool write_json(const std::string& path, const std::vector<Result>& results, const Options& options);
+
+} // namespace simd_bench
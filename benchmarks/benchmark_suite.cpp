@@ -0,0 +1,1298 @@
+#include "simd_lib.h"
+#include "bench_harness.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using simd_bench::Case;
+using simd_bench::Kernel;
+using simd_bench::Variant;
+
+// Results of reductions land here so the calls cannot be optimized away
+static volatile float g_sink;
+static volatile int32_t g_int_sink;
+
+typedef std::shared_ptr<std::vector<float>> FloatBuffer;
+typedef std::shared_ptr<std::vector<int8_t>> Int8Buffer;
+typedef std::shared_ptr<std::vector<uint8_t>> Uint8Buffer;
+
+static FloatBuffer random_floats(size_t count, float lo, float hi, unsigned seed) {
+    auto buffer = std::make_shared<std::vector<float>>(count);
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dis(lo, hi);
+    for (auto& v : *buffer) v = dis(gen);
+    return buffer;
+}
+
+template <typename T>
+static std::shared_ptr<std::vector<T>> random_ints(size_t count, int lo, int hi, unsigned seed) {
+    auto buffer = std::make_shared<std::vector<T>>(count);
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dis(lo, hi);
+    for (auto& v : *buffer) v = (T)dis(gen);
+    return buffer;
+}
+
+// Elements that fit the working set, rounded to a multiple of 64
+static size_t elements_for(size_t working_set, double bytes_per_element) {
+    size_t n = (size_t)((double)working_set / bytes_per_element);
+    return std::max<size_t>(64, n & ~(size_t)63);
+}
+
+static bool has_sse4() { return simd_lib::get_cpu_features().has_sse4_1; }
+static bool has_avx2() { return simd_lib::get_cpu_features().has_avx2; }
+static bool has_avx2_fma() { return has_avx2() && simd_lib::get_cpu_features().has_fma; }
+static bool has_avx_vnni() { return simd_lib::get_cpu_features().has_avx_vnni; }
+
+typedef void (*UnaryFn)(const float*, float*, size_t);
+typedef void (*BinaryFn)(const float*, const float*, float*, size_t);
+typedef float (*ReduceFn)(const float*, size_t);
+
+// result = f(input)
+static Kernel unary_kernel(const char* group, const char* name, UnaryFn scalar, UnaryFn avx2,
+                           bool avx2_available, double flops_per_element, float lo, float hi) {
+    return {name, group, [=](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 8.0);
+        c.bytes = 8.0 * c.elements;
+        c.flops = flops_per_element * c.elements;
+        FloatBuffer in = random_floats(c.elements, lo, hi, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { scalar(in->data(), out->data(), n); }});
+        if (avx2_available) {
+            c.variants.push_back({"avx2", [=] { avx2(in->data(), out->data(), n); }});
+        }
+        return c;
+    }};
+}
+
+// result = f(a, b)
+static Kernel binary_kernel(const char* group, const char* name, BinaryFn scalar, BinaryFn sse4, BinaryFn avx2) {
+    return {name, group, [=](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 12.0);
+        c.bytes = 12.0 * c.elements;
+        c.flops = (double)c.elements;
+        FloatBuffer a = random_floats(c.elements, -100.0f, 100.0f, 1);
+        FloatBuffer b = random_floats(c.elements, -100.0f, 100.0f, 2);
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { scalar(a->data(), b->data(), out->data(), n); }});
+        if (sse4 && has_sse4()) {
+            c.variants.push_back({"sse4", [=] { sse4(a->data(), b->data(), out->data(), n); }});
+        }
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] { avx2(a->data(), b->data(), out->data(), n); }});
+        }
+        return c;
+    }};
+}
+
+// Returns f(a)
+static Kernel reduce_kernel(const char* group, const char* name, ReduceFn scalar, ReduceFn avx2,
+                            bool avx2_available, double flops_per_element) {
+    return {name, group, [=](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 4.0);
+        c.bytes = 4.0 * c.elements;
+        c.flops = flops_per_element * c.elements;
+        FloatBuffer a = random_floats(c.elements, -1.0f, 1.0f, 1);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { g_sink = scalar(a->data(), n); }});
+        if (avx2_available) {
+            c.variants.push_back({"avx2", [=] { g_sink = avx2(a->data(), n); }});
+        }
+        return c;
+    }};
+}
+
+static float argmax_as_float_scalar(const float* a, size_t n) { return (float)simd_lib::argmax_scalar(a, n); }
+static float argmax_as_float_avx2(const float* a, size_t n) { return (float)simd_lib::argmax_avx2(a, n); }
+static float minmax_scalar(const float* a, size_t n) {
+    float lo, hi;
+    simd_lib::vector_minmax_scalar(a, n, &lo, &hi);
+    return lo + hi;
+}
+static float minmax_avx2(const float* a, size_t n) {
+    float lo, hi;
+    simd_lib::vector_minmax_avx2(a, n, &lo, &hi);
+    return lo + hi;
+}
+static float variance_scalar(const float* a, size_t n) {
+    float mean, variance;
+    simd_lib::mean_variance_scalar(a, n, &mean, &variance);
+    return variance;
+}
+static float variance_avx2(const float* a, size_t n) {
+    float mean, variance;
+    simd_lib::mean_variance_avx2(a, n, &mean, &variance);
+    return variance;
+}
+static void scan_scalar(const float* a, float* out, size_t n) { simd_lib::inclusive_scan_scalar(a, out, n, 0.0f); }
+static void scan_avx2(const float* a, float* out, size_t n) { simd_lib::inclusive_scan_avx2(a, out, n, 0.0f); }
+static void scale_scalar(const float* a, float* out, size_t n) { simd_lib::vector_scale_scalar(a, 1.0001f, out, n); }
+static void scale_avx2(const float* a, float* out, size_t n) { simd_lib::vector_scale_avx2(a, 1.0001f, out, n); }
+
+static void add_vector_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back(binary_kernel("vector", "add", simd_lib::vector_add_scalar, simd_lib::vector_add_sse4,
+                                    simd_lib::vector_add_avx2));
+    kernels.push_back(binary_kernel("vector", "subtract", simd_lib::vector_subtract_scalar, nullptr,
+                                    simd_lib::vector_subtract_avx2));
+    kernels.push_back(binary_kernel("vector", "multiply", simd_lib::vector_multiply_scalar, nullptr,
+                                    simd_lib::vector_multiply_avx2));
+    kernels.push_back(unary_kernel("vector", "scale", scale_scalar, scale_avx2, has_avx2(), 1.0, -1.0f, 1.0f));
+    kernels.push_back(unary_kernel("vector", "normalize", simd_lib::vector_normalize_scalar,
+                                   simd_lib::vector_normalize_avx2, has_avx2_fma(), 3.0, -1.0f, 1.0f));
+    kernels.push_back(reduce_kernel("vector", "norm", simd_lib::vector_norm_scalar, simd_lib::vector_norm_avx2,
+                                    has_avx2_fma(), 2.0));
+
+    kernels.push_back({"dot", "vector", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 8.0);
+        c.bytes = 8.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer a = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer b = random_floats(c.elements, -1.0f, 1.0f, 2);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { g_sink = simd_lib::dot_product_scalar(a->data(), b->data(), n); }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] { g_sink = simd_lib::dot_product_avx2(a->data(), b->data(), n); }});
+        }
+        return c;
+    }});
+}
+
+static void add_reduction_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back(reduce_kernel("reduce", "sum", simd_lib::vector_sum_scalar, simd_lib::vector_sum_avx2,
+                                    has_avx2(), 1.0));
+    kernels.push_back(reduce_kernel("reduce", "minmax", minmax_scalar, minmax_avx2, has_avx2(), 2.0));
+    kernels.push_back(reduce_kernel("reduce", "argmax", argmax_as_float_scalar, argmax_as_float_avx2,
+                                    has_avx2(), 1.0));
+    kernels.push_back(reduce_kernel("reduce", "mean_variance", variance_scalar, variance_avx2,
+                                    has_avx2_fma(), 4.0));
+
+    kernels.push_back(unary_kernel("scan", "inclusive_scan", scan_scalar, scan_avx2,
+                                   has_avx2(), 1.0, -1.0f, 1.0f));
+    kernels.push_back({"summed_area_table", "scan", [](size_t working_set) {
+        Case c;
+        size_t side = std::max<size_t>(8, (size_t)std::sqrt((double)working_set / 8.0));
+        c.elements = side * side;
+        c.bytes = 8.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer in = random_floats(c.elements, 0.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        c.variants.push_back({"scalar", [=] { simd_lib::summed_area_table_scalar(in->data(), out->data(), side, side); }});
+        c.variants.push_back({"auto", [=] { simd_lib::summed_area_table(in->data(), out->data(), side, side); }});
+        return c;
+    }});
+}
+
+static void add_math_kernels(std::vector<Kernel>& kernels) {
+    // Transcendentals are counted as one operation per element
+    bool available = has_avx2_fma();
+    kernels.push_back(unary_kernel("math", "exp", simd_lib::vector_exp_scalar, simd_lib::vector_exp_avx2,
+                                   available, 1.0, -10.0f, 10.0f));
+    kernels.push_back(unary_kernel("math", "log", simd_lib::vector_log_scalar, simd_lib::vector_log_avx2,
+                                   available, 1.0, 0.01f, 100.0f));
+    kernels.push_back(unary_kernel("math", "sin", simd_lib::vector_sin_scalar, simd_lib::vector_sin_avx2,
+                                   available, 1.0, -10.0f, 10.0f));
+    kernels.push_back(unary_kernel("math", "tanh", simd_lib::vector_tanh_scalar, simd_lib::vector_tanh_avx2,
+                                   available, 1.0, -5.0f, 5.0f));
+    kernels.push_back(unary_kernel("math", "sigmoid", simd_lib::vector_sigmoid_scalar,
+                                   simd_lib::vector_sigmoid_avx2, available, 1.0, -5.0f, 5.0f));
+    kernels.push_back(unary_kernel("math", "rsqrt", simd_lib::vector_rsqrt_scalar, simd_lib::vector_rsqrt_avx2,
+                                   available, 1.0, 0.01f, 100.0f));
+}
+
+static void add_quantized_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back({"dot_s8", "quantized", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 2.0);
+        c.bytes = 2.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        Int8Buffer a = random_ints<int8_t>(c.elements, -127, 127, 1);
+        Int8Buffer b = random_ints<int8_t>(c.elements, -127, 127, 2);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { g_int_sink = simd_lib::dot_product_s8_scalar(a->data(), b->data(), n); }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] { g_int_sink = simd_lib::dot_product_s8_avx2(a->data(), b->data(), n); }});
+        }
+        if (has_avx_vnni()) {
+            c.variants.push_back({"avxvnni", [=] { g_int_sink = simd_lib::dot_product_s8_avxvnni(a->data(), b->data(), n); }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"dot_u8s8", "quantized", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 2.0);
+        c.bytes = 2.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        Uint8Buffer a = random_ints<uint8_t>(c.elements, 0, 255, 1);
+        Int8Buffer b = random_ints<int8_t>(c.elements, -127, 127, 2);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { g_int_sink = simd_lib::dot_product_u8s8_scalar(a->data(), b->data(), n); }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] { g_int_sink = simd_lib::dot_product_u8s8_avx2(a->data(), b->data(), n); }});
+        }
+        if (has_avx_vnni()) {
+            c.variants.push_back({"avxvnni", [=] { g_int_sink = simd_lib::dot_product_u8s8_avxvnni(a->data(), b->data(), n); }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"l2_squared_s8", "quantized", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 2.0);
+        c.bytes = 2.0 * c.elements;
+        c.flops = 3.0 * c.elements;
+        Int8Buffer a = random_ints<int8_t>(c.elements, -127, 127, 1);
+        Int8Buffer b = random_ints<int8_t>(c.elements, -127, 127, 2);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { g_int_sink = simd_lib::l2_distance_squared_s8_scalar(a->data(), b->data(), n); }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] { g_int_sink = simd_lib::l2_distance_squared_s8_avx2(a->data(), b->data(), n); }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"quantize_s8", "quantized", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 5.0);
+        c.bytes = 5.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        Int8Buffer out = std::make_shared<std::vector<int8_t>>(c.elements);
+        simd_lib::QuantizationParams params;
+        params.scale = 1.0f / 127.0f;
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { simd_lib::quantize_s8_scalar(in->data(), out->data(), n, params); }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] { simd_lib::quantize_s8_avx2(in->data(), out->data(), n, params); }});
+        }
+        return c;
+    }});
+}
+
+// Query-vs-matrix kernels use 128-dimensional rows
+static const size_t kSearchDim = 128;
+
+typedef void (*BatchFn)(const float*, const float*, size_t, size_t, float*);
+
+static Kernel batch_kernel(const char* name, BatchFn scalar, BatchFn avx2, double flops_per_element) {
+    return {name, "search", [=](size_t working_set) {
+        Case c;
+        size_t rows = std::max<size_t>(4, working_set / (4 * kSearchDim));
+        c.elements = rows * kSearchDim;
+        c.bytes = 4.0 * c.elements;
+        c.flops = flops_per_element * c.elements;
+        FloatBuffer query = random_floats(kSearchDim, -1.0f, 1.0f, 1);
+        FloatBuffer matrix = random_floats(c.elements, -1.0f, 1.0f, 2);
+        FloatBuffer out = std::make_shared<std::vector<float>>(rows);
+        c.variants.push_back({"scalar", [=] { scalar(query->data(), matrix->data(), rows, kSearchDim, out->data()); }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] { avx2(query->data(), matrix->data(), rows, kSearchDim, out->data()); }});
+        }
+        return c;
+    }};
+}
+
+static void add_search_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back(batch_kernel("batch_dot", simd_lib::batch_dot_scalar, simd_lib::batch_dot_avx2, 2.0));
+    kernels.push_back(batch_kernel("batch_l2_squared", simd_lib::batch_l2_squared_scalar,
+                                   simd_lib::batch_l2_squared_avx2, 3.0));
+    kernels.push_back(batch_kernel("batch_cosine", simd_lib::batch_cosine_scalar, simd_lib::batch_cosine_avx2, 4.0));
+
+    kernels.push_back({"select_greater", "search", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 4.0);
+        c.bytes = 4.0 * c.elements;
+        c.flops = (double)c.elements;
+        FloatBuffer values = random_floats(c.elements, 0.0f, 1.0f, 1);
+        auto positions = std::make_shared<std::vector<uint32_t>>(c.elements);
+        size_t n = c.elements;
+        // A 1% pass rate, as in a top-k threshold filter
+        c.variants.push_back({"scalar", [=] {
+            g_int_sink = (int32_t)simd_lib::select_greater_scalar(values->data(), n, 0.99f, positions->data());
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                g_int_sink = (int32_t)simd_lib::select_greater_avx2(values->data(), n, 0.99f, positions->data());
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"top_k_10", "search", [](size_t working_set) {
+        Case c;
+        size_t rows = std::max<size_t>(16, working_set / (4 * kSearchDim));
+        c.elements = rows * kSearchDim;
+        c.bytes = 4.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer query = random_floats(kSearchDim, -1.0f, 1.0f, 1);
+        FloatBuffer matrix = random_floats(c.elements, -1.0f, 1.0f, 2);
+        auto indices = std::make_shared<std::vector<size_t>>(10);
+        FloatBuffer scores = std::make_shared<std::vector<float>>(10);
+        c.variants.push_back({"auto", [=] {
+            simd_lib::top_k_search(query->data(), matrix->data(), rows, kSearchDim, 10,
+                                   simd_lib::SimilarityMetric::DotProduct, indices->data(), scores->data());
+        }});
+        return c;
+    }});
+}
+
+// Sparse operands keep 5% of their entries, as in hashed feature vectors
+static const double kSparseDensity = 0.05;
+
+typedef std::shared_ptr<std::vector<uint32_t>> IndexBuffer;
+
+static IndexBuffer random_sparse_indices(size_t dim, unsigned seed) {
+    auto buffer = std::make_shared<std::vector<uint32_t>>();
+    std::mt19937 gen(seed);
+    std::bernoulli_distribution keep(kSparseDensity);
+    for (size_t i = 0; i < dim; ++i) {
+        if (keep(gen)) buffer->push_back((uint32_t)i);
+    }
+    return buffer;
+}
+
+static void add_sparse_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back({"sparse_dot_dense", "sparse", [](size_t working_set) {
+        Case c;
+        // The dense operand fills the working set; the sparse one reads 8 bytes per nonzero
+        size_t dim = elements_for(working_set, 4.0);
+        IndexBuffer indices = random_sparse_indices(dim, 1);
+        size_t nnz = indices->size();
+        c.elements = nnz;
+        c.bytes = 12.0 * nnz;
+        c.flops = 2.0 * nnz;
+        FloatBuffer values = random_floats(nnz, -1.0f, 1.0f, 2);
+        FloatBuffer dense = random_floats(dim, -1.0f, 1.0f, 3);
+        auto compact = std::make_shared<simd_lib::SparseVector16>(
+            simd_lib::compress_sparse_indices(indices->data(), values->data(), nnz));
+        FloatBuffer scratch = std::make_shared<std::vector<float>>(dim);
+        c.variants.push_back({"scalar", [=] {
+            g_sink = simd_lib::sparse_dot_dense_scalar(indices->data(), values->data(), nnz, dense->data());
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                g_sink = simd_lib::sparse_dot_dense_avx2(indices->data(), values->data(), nnz, dense->data());
+            }});
+            c.variants.push_back({"avx2_d16", [=] {
+                g_sink = simd_lib::sparse_dot_dense_delta16_avx2(compact->deltas.data(), compact->values.data(),
+                                                                 compact->deltas.size(), dense->data());
+            }});
+            // What sparse inputs cost when densified for dot_product_avx2
+            c.variants.push_back({"densify", [=] {
+                std::fill(scratch->begin(), scratch->end(), 0.0f);
+                for (size_t i = 0; i < nnz; ++i) (*scratch)[(*indices)[i]] = (*values)[i];
+                g_sink = simd_lib::dot_product_avx2(scratch->data(), dense->data(), dim);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"sparse_dot_sparse", "sparse", [](size_t working_set) {
+        Case c;
+        size_t dim = elements_for(working_set / 2, 8.0 * kSparseDensity);
+        IndexBuffer a = random_sparse_indices(dim, 1);
+        IndexBuffer b = random_sparse_indices(dim, 2);
+        c.elements = a->size() + b->size();
+        c.bytes = 8.0 * c.elements;
+        c.flops = 2.0 * kSparseDensity * c.elements;
+        FloatBuffer a_values = random_floats(a->size(), -1.0f, 1.0f, 3);
+        FloatBuffer b_values = random_floats(b->size(), -1.0f, 1.0f, 4);
+        c.variants.push_back({"scalar", [=] {
+            g_sink = simd_lib::sparse_dot_sparse_scalar(a->data(), a_values->data(), a->size(),
+                                                        b->data(), b_values->data(), b->size());
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                g_sink = simd_lib::sparse_dot_sparse_avx2(a->data(), a_values->data(), a->size(),
+                                                          b->data(), b_values->data(), b->size());
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"spmv", "sparse", [](size_t working_set) {
+        Case c;
+        // 1024 columns; rows are added until the nonzeros fill the working set
+        const size_t cols = 1024;
+        size_t rows = std::max<size_t>(1, working_set / (size_t)(8.0 * kSparseDensity * cols));
+        auto matrix = std::make_shared<simd_lib::CsrMatrix>();
+        matrix->rows = rows;
+        matrix->cols = cols;
+        matrix->row_offsets.push_back(0);
+        for (size_t r = 0; r < rows; ++r) {
+            IndexBuffer row = random_sparse_indices(cols, (unsigned)r + 1);
+            matrix->col_indices.insert(matrix->col_indices.end(), row->begin(), row->end());
+            matrix->row_offsets.push_back(matrix->col_indices.size());
+        }
+        matrix->values = *random_floats(matrix->col_indices.size(), -1.0f, 1.0f, 1);
+        auto compact = std::make_shared<simd_lib::CsrMatrix16>(simd_lib::compress_csr_indices(*matrix));
+        FloatBuffer x = random_floats(cols, -1.0f, 1.0f, 2);
+        FloatBuffer y = std::make_shared<std::vector<float>>(rows);
+        c.elements = matrix->values.size();
+        c.bytes = 8.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        c.variants.push_back({"scalar", [=] {
+            for (size_t r = 0; r < rows; ++r) {
+                size_t offset = matrix->row_offsets[r];
+                (*y)[r] = simd_lib::sparse_dot_dense_scalar(&matrix->col_indices[offset], &matrix->values[offset],
+                                                            matrix->row_offsets[r + 1] - offset, x->data());
+            }
+        }});
+        c.variants.push_back({"auto", [=] { simd_lib::spmv(*matrix, x->data(), y->data()); }});
+        c.variants.push_back({"auto_d16", [=] { simd_lib::spmv(*compact, x->data(), y->data()); }});
+        return c;
+    }});
+}
+
+// Planar views of buffers holding n quaternions (w, x, y, z planes) or n points
+static simd_lib::ConstQuaternionArrays quaternions_in(const FloatBuffer& b, size_t n) {
+    return {b->data(), b->data() + n, b->data() + 2 * n, b->data() + 3 * n};
+}
+
+static simd_lib::QuaternionArrays quaternions_out(const FloatBuffer& b, size_t n) {
+    return {b->data(), b->data() + n, b->data() + 2 * n, b->data() + 3 * n};
+}
+
+static simd_lib::ConstVec3Arrays points_in(const FloatBuffer& b, size_t n) {
+    return {b->data(), b->data() + n, b->data() + 2 * n};
+}
+
+static simd_lib::Vec3Arrays points_out(const FloatBuffer& b, size_t n) {
+    return {b->data(), b->data() + n, b->data() + 2 * n};
+}
+
+static FloatBuffer random_rotations(size_t n, unsigned seed) {
+    FloatBuffer q = random_floats(4 * n, -1.0f, 1.0f, seed);
+    simd_lib::quaternion_normalize(quaternions_in(q, n), quaternions_out(q, n), n);
+    return q;
+}
+
+static void add_transform_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back({"fft_roundtrip", "fft", [](size_t working_set) {
+        Case c;
+        // Largest power of two whose real + imaginary arrays fit the working set
+        size_t n = 64;
+        while (n * 2 * 8 <= working_set) n *= 2;
+        c.elements = n;
+        c.bytes = 2.0 * 4.0 * 8.0 * n;   // two transforms, each reading and writing both arrays
+        c.flops = 2.0 * 5.0 * n * std::log2((double)n);
+        FloatBuffer real = random_floats(n, -1.0f, 1.0f, 1);
+        FloatBuffer imag = random_floats(n, -1.0f, 1.0f, 2);
+        c.variants.push_back({"auto", [=] {
+            simd_lib::fft_forward(real->data(), imag->data(), n);
+            simd_lib::fft_inverse(real->data(), imag->data(), n);
+        }});
+        return c;
+    }});
+
+    kernels.push_back({"matrix_vector_4x4", "matrix", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 32.0);
+        c.bytes = 32.0 * c.elements;
+        c.flops = 28.0 * c.elements;
+        FloatBuffer matrix = random_floats(16, -1.0f, 1.0f, 1);
+        FloatBuffer in = random_floats(4 * c.elements, -1.0f, 1.0f, 2);
+        FloatBuffer out = std::make_shared<std::vector<float>>(4 * c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            for (size_t i = 0; i < n; ++i) {
+                simd_lib::matrix_vector_multiply_4x4_scalar(matrix->data(), &(*in)[4 * i], &(*out)[4 * i]);
+            }
+        }});
+        c.variants.push_back({"auto", [=] {
+            for (size_t i = 0; i < n; ++i) {
+                simd_lib::matrix_vector_multiply_4x4(matrix->data(), &(*in)[4 * i], &(*out)[4 * i]);
+            }
+        }});
+        return c;
+    }});
+
+    kernels.push_back({"quaternion_rotate", "quaternion", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 40.0);
+        c.bytes = 40.0 * c.elements;
+        c.flops = 27.0 * c.elements;
+        size_t n = c.elements;
+        FloatBuffer q = random_rotations(n, 1);
+        FloatBuffer v = random_floats(3 * n, -1.0f, 1.0f, 2);
+        FloatBuffer out = std::make_shared<std::vector<float>>(3 * n);
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::quaternion_rotate_scalar(quaternions_in(q, n), points_in(v, n), points_out(out, n), n);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::quaternion_rotate_avx2(quaternions_in(q, n), points_in(v, n), points_out(out, n), n);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"quaternion_slerp", "quaternion", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 48.0);
+        c.bytes = 48.0 * c.elements;
+        c.flops = 40.0 * c.elements;
+        size_t n = c.elements;
+        FloatBuffer a = random_rotations(n, 1);
+        FloatBuffer b = random_rotations(n, 2);
+        FloatBuffer out = std::make_shared<std::vector<float>>(4 * n);
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::quaternion_slerp_scalar(quaternions_in(a, n), quaternions_in(b, n), 0.3f,
+                                              quaternions_out(out, n), n);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::quaternion_slerp_avx2(quaternions_in(a, n), quaternions_in(b, n), 0.3f,
+                                                quaternions_out(out, n), n);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"rigid_transform", "quaternion", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 24.0);
+        c.bytes = 24.0 * c.elements;
+        c.flops = 18.0 * c.elements;
+        size_t n = c.elements;
+        FloatBuffer p = random_floats(3 * n, -10.0f, 10.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(3 * n);
+        // Quarter turn about y, then a shift
+        FloatBuffer pose = std::make_shared<std::vector<float>>(
+            std::vector<float>{std::sqrt(0.5f), 0.0f, std::sqrt(0.5f), 0.0f, 1.0f, 2.0f, 3.0f});
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::rigid_transform_points_scalar(pose->data(), pose->data() + 4, points_in(p, n),
+                                                    points_out(out, n), n);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::rigid_transform_points_avx2(pose->data(), pose->data() + 4, points_in(p, n),
+                                                      points_out(out, n), n);
+            }});
+        }
+        return c;
+    }});
+}
+
+static void add_spectral_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back({"fft2d_roundtrip", "fft", [](size_t working_set) {
+        Case c;
+        // Largest square power-of-two image whose real + imaginary planes fit the working set
+        size_t side = 16;
+        while (4 * side * side * 8 <= working_set) side *= 2;
+        c.elements = side * side;
+        c.bytes = 2.0 * 4.0 * 8.0 * c.elements;
+        c.flops = 2.0 * 5.0 * c.elements * std::log2((double)c.elements);
+        FloatBuffer real = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer imag = random_floats(c.elements, -1.0f, 1.0f, 2);
+        c.variants.push_back({"auto", [=] {
+            simd_lib::fft2d_forward(real->data(), imag->data(), side, side);
+            simd_lib::fft2d_inverse(real->data(), imag->data(), side, side);
+        }});
+        return c;
+    }});
+
+    kernels.push_back({"fft2d_real_forward", "fft", [](size_t working_set) {
+        Case c;
+        size_t side = 16;
+        while (4 * side * side * 12 <= working_set) side *= 2;
+        size_t half = side / 2 + 1;
+        c.elements = side * side;
+        c.bytes = 4.0 * c.elements + 8.0 * side * half;
+        c.flops = 2.5 * c.elements * std::log2((double)c.elements);
+        FloatBuffer input = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer real = std::make_shared<std::vector<float>>(side * half);
+        FloatBuffer imag = std::make_shared<std::vector<float>>(side * half);
+        c.variants.push_back({"auto", [=] {
+            simd_lib::fft2d_real_forward(input->data(), side, side, real->data(), imag->data());
+        }});
+        return c;
+    }});
+
+    // 1024-sample Hann frames every 256 samples; elements are signal samples
+    kernels.push_back({"stft_power", "spectral", [](size_t working_set) {
+        Case c;
+        simd_lib::STFTConfig config;
+        auto stft = std::make_shared<simd_lib::STFT>(config);
+        // Each hop of input adds a row of bins to the output
+        double bytes_per_sample = 4.0 + 4.0 * stft->bins() / config.hop_size;
+        c.elements = std::max<size_t>(config.frame_size, elements_for(working_set, bytes_per_sample));
+        size_t frames = stft->frame_count(c.elements);
+        c.bytes = 4.0 * (c.elements + frames * stft->bins());
+        c.flops = frames * (5.0 * config.frame_size * std::log2((double)config.frame_size) + 4.0 * config.frame_size);
+        FloatBuffer signal = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(frames * stft->bins());
+        size_t n = c.elements;
+        c.variants.push_back({"auto", [=] { stft->process(signal->data(), n, out->data()); }});
+        return c;
+    }});
+
+    // Hann segments of 1024 samples at 50% overlap
+    kernels.push_back({"welch_psd", "spectral", [](size_t working_set) {
+        Case c;
+        const size_t segment = 1024;
+        c.elements = std::max<size_t>(segment, elements_for(working_set, 4.0));
+        size_t segments = (c.elements - segment) / (segment / 2) + 1;
+        c.bytes = 4.0 * c.elements;
+        c.flops = segments * (5.0 * segment * std::log2((double)segment) + 4.0 * segment);
+        FloatBuffer signal = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer psd = std::make_shared<std::vector<float>>(simd_lib::welch_psd_bins(segment));
+        size_t n = c.elements;
+        c.variants.push_back({"auto", [=] {
+            simd_lib::welch_psd(signal->data(), n, psd->data(), segment, segment / 2);
+        }});
+        return c;
+    }});
+
+    kernels.push_back({"apply_window", "spectral", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 8.0);
+        c.bytes = 12.0 * c.elements;
+        c.flops = (double)c.elements;
+        auto window = simd_lib::get_window(simd_lib::WindowType::Hann, c.elements);
+        FloatBuffer data = random_floats(c.elements, -1.0f, 1.0f, 1);
+        size_t n = c.elements;
+        c.variants.push_back({"auto", [=] { simd_lib::apply_window(data->data(), window->data(), n); }});
+        return c;
+    }});
+}
+
+typedef void (*SplitComplexFn)(const float*, const float*, const float*, const float*, float*, float*, size_t);
+typedef void (*ComplexReduceFn)(const float*, const float*, float*, size_t);
+
+// out = f(a, b) on split complex arrays
+static Kernel complex_binary_kernel(const char* name, SplitComplexFn scalar, SplitComplexFn avx2) {
+    return {name, "complex", [=](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 24.0);
+        c.bytes = 24.0 * c.elements;
+        c.flops = 6.0 * c.elements;
+        FloatBuffer a = random_floats(2 * c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer b = random_floats(2 * c.elements, -1.0f, 1.0f, 2);
+        FloatBuffer out = std::make_shared<std::vector<float>>(2 * c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            scalar(a->data(), a->data() + n, b->data(), b->data() + n, out->data(), out->data() + n, n);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                avx2(a->data(), a->data() + n, b->data(), b->data() + n, out->data(), out->data() + n, n);
+            }});
+        }
+        return c;
+    }};
+}
+
+// out = f(z) from split complex arrays to one real array
+static Kernel complex_unary_kernel(const char* name, ComplexReduceFn scalar, ComplexReduceFn avx2,
+                                   double flops_per_element) {
+    return {name, "complex", [=](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 12.0);
+        c.bytes = 12.0 * c.elements;
+        c.flops = flops_per_element * c.elements;
+        FloatBuffer z = random_floats(2 * c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] { scalar(z->data(), z->data() + n, out->data(), n); }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] { avx2(z->data(), z->data() + n, out->data(), n); }});
+        }
+        return c;
+    }};
+}
+
+static void add_complex_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back(complex_binary_kernel("complex_multiply", simd_lib::complex_multiply_scalar,
+                                            simd_lib::complex_multiply_avx2));
+    kernels.push_back(complex_binary_kernel("complex_multiply_conj", simd_lib::complex_multiply_conj_scalar,
+                                            simd_lib::complex_multiply_conj_avx2));
+    kernels.push_back(complex_unary_kernel("complex_magnitude", simd_lib::complex_magnitude_scalar,
+                                           simd_lib::complex_magnitude_avx2, 4.0));
+    kernels.push_back(complex_unary_kernel("complex_magnitude_sq", simd_lib::complex_magnitude_squared_scalar,
+                                           simd_lib::complex_magnitude_squared_avx2, 3.0));
+    // atan2 counts as one operation, like the other transcendentals
+    kernels.push_back(complex_unary_kernel("complex_phase", simd_lib::complex_phase_scalar,
+                                           simd_lib::complex_phase_avx2, 1.0));
+
+    kernels.push_back({"complex_multiply_il", "complex", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 24.0);
+        c.bytes = 24.0 * c.elements;
+        c.flops = 6.0 * c.elements;
+        FloatBuffer a = random_floats(2 * c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer b = random_floats(2 * c.elements, -1.0f, 1.0f, 2);
+        FloatBuffer out = std::make_shared<std::vector<float>>(2 * c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::complex_multiply_interleaved_scalar(a->data(), b->data(), out->data(), n);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::complex_multiply_interleaved_avx2(a->data(), b->data(), out->data(), n);
+            }});
+        }
+        return c;
+    }});
+}
+
+static void add_layout_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back({"transpose", "layout", [](size_t working_set) {
+        Case c;
+        size_t side = std::max<size_t>(8, (size_t)std::sqrt((double)working_set / 8.0));
+        c.elements = side * side;
+        c.bytes = 8.0 * c.elements;
+        c.flops = 0.0;
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::transpose_scalar(in->data(), side, side, side, out->data(), side);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::transpose_avx2(in->data(), side, side, side, out->data(), side);
+            }});
+        }
+        return c;
+    }});
+
+    // Elements are records: xyz points for the 3-wide kernels, xyzw for the 4-wide ones
+    kernels.push_back({"deinterleave3", "layout", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 24.0);
+        c.bytes = 24.0 * c.elements;
+        c.flops = 0.0;
+        FloatBuffer in = random_floats(3 * c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(3 * c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::deinterleave3_scalar(in->data(), out->data(), out->data() + n, out->data() + 2 * n, n);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::deinterleave3_avx2(in->data(), out->data(), out->data() + n, out->data() + 2 * n, n);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"interleave3", "layout", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 24.0);
+        c.bytes = 24.0 * c.elements;
+        c.flops = 0.0;
+        FloatBuffer in = random_floats(3 * c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(3 * c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::interleave3_scalar(in->data(), in->data() + n, in->data() + 2 * n, out->data(), n);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::interleave3_avx2(in->data(), in->data() + n, in->data() + 2 * n, out->data(), n);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"deinterleave4", "layout", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 32.0);
+        c.bytes = 32.0 * c.elements;
+        c.flops = 0.0;
+        FloatBuffer in = random_floats(4 * c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(4 * c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::deinterleave4_scalar(in->data(), out->data(), out->data() + n, out->data() + 2 * n,
+                                           out->data() + 3 * n, n);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::deinterleave4_avx2(in->data(), out->data(), out->data() + n, out->data() + 2 * n,
+                                             out->data() + 3 * n, n);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"interleave4", "layout", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 32.0);
+        c.bytes = 32.0 * c.elements;
+        c.flops = 0.0;
+        FloatBuffer in = random_floats(4 * c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(4 * c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::interleave4_scalar(in->data(), in->data() + n, in->data() + 2 * n, in->data() + 3 * n,
+                                         out->data(), n);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::interleave4_avx2(in->data(), in->data() + n, in->data() + 2 * n, in->data() + 3 * n,
+                                           out->data(), n);
+            }});
+        }
+        return c;
+    }});
+}
+
+typedef std::shared_ptr<std::vector<int16_t>> Int16Buffer;
+
+static void add_audio_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back({"s16_to_f32", "pcm", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 6.0);
+        c.bytes = 6.0 * c.elements;
+        c.flops = (double)c.elements;
+        Int16Buffer in = random_ints<int16_t>(c.elements, -32768, 32767, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::convert_s16_to_f32_scalar(in->data(), out->data(), n, 0.5f);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::convert_s16_to_f32_avx2(in->data(), out->data(), n, 0.5f);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"s24_to_f32", "pcm", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 7.0);
+        c.bytes = 7.0 * c.elements;
+        c.flops = (double)c.elements;
+        Uint8Buffer in = random_ints<uint8_t>(3 * c.elements, 0, 255, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::convert_s24_to_f32_scalar(in->data(), out->data(), n, 0.5f);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::convert_s24_to_f32_avx2(in->data(), out->data(), n, 0.5f);
+            }});
+        }
+        return c;
+    }});
+
+    // Float to integer with and without TPDF dither
+    kernels.push_back({"f32_to_s16", "pcm", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 6.0);
+        c.bytes = 6.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        Int16Buffer out = std::make_shared<std::vector<int16_t>>(c.elements);
+        auto dither = std::make_shared<simd_lib::PcmDither>();
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::convert_f32_to_s16_scalar(in->data(), out->data(), n, 0.5f, nullptr);
+        }});
+        c.variants.push_back({"scalar_d", [=] {
+            simd_lib::convert_f32_to_s16_scalar(in->data(), out->data(), n, 0.5f, dither.get());
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::convert_f32_to_s16_avx2(in->data(), out->data(), n, 0.5f, nullptr);
+            }});
+            c.variants.push_back({"avx2_d", [=] {
+                simd_lib::convert_f32_to_s16_avx2(in->data(), out->data(), n, 0.5f, dither.get());
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"f32_to_s24", "pcm", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 7.0);
+        c.bytes = 7.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        Uint8Buffer out = std::make_shared<std::vector<uint8_t>>(3 * c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::convert_f32_to_s24_scalar(in->data(), out->data(), n, 0.5f, nullptr);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::convert_f32_to_s24_avx2(in->data(), out->data(), n, 0.5f, nullptr);
+            }});
+        }
+        return c;
+    }});
+
+    // 4 all-pass sections, so repeated in-place runs keep the signal level;
+    // elements are samples over all channels
+    kernels.push_back({"biquad_8ch", "biquad", [](size_t working_set) {
+        Case c;
+        const size_t groups = 1, sections = 4;
+        size_t frames = elements_for(working_set, 32.0);
+        c.elements = 8 * frames;
+        c.bytes = 8.0 * c.elements;
+        c.flops = 9.0 * sections * c.elements;
+        FloatBuffer data = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer coefficients = std::make_shared<std::vector<float>>(sections * groups * 40);
+        const float allpass[5] = {0.3f, -0.5f, 1.0f, -0.5f, 0.3f};
+        for (size_t i = 0; i < coefficients->size(); ++i) (*coefficients)[i] = allpass[(i / 8) % 5];
+        FloatBuffer state = std::make_shared<std::vector<float>>(sections * groups * 16);
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::biquad_channels_scalar(data->data(), frames, 8, groups, sections, coefficients->data(),
+                                             state->data());
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::biquad_channels_avx2(data->data(), frames, 8, groups, sections, coefficients->data(),
+                                               state->data());
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"biquad_1ch", "biquad", [](size_t working_set) {
+        Case c;
+        const size_t sections = 4;
+        c.elements = elements_for(working_set, 8.0);
+        c.bytes = 8.0 * c.elements;
+        c.flops = 9.0 * sections * c.elements;
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        auto across_time = std::make_shared<simd_lib::BiquadCascade>(1, sections, simd_lib::BiquadMode::AcrossTime);
+        auto across_channels = std::make_shared<simd_lib::BiquadCascade>(1, sections,
+                                                                          simd_lib::BiquadMode::AcrossChannels);
+        for (size_t s = 0; s < sections; ++s) {
+            across_time->set_section(s, simd_lib::biquad_lowpass(4000.0, 48000.0));
+            across_channels->set_section(s, simd_lib::biquad_lowpass(4000.0, 48000.0));
+        }
+        size_t n = c.elements;
+        c.variants.push_back({"channel", [=] { across_channels->process(in->data(), out->data(), n); }});
+        c.variants.push_back({"time", [=] { across_time->process(in->data(), out->data(), n); }});
+        return c;
+    }});
+}
+
+static void add_selection_kernels(std::vector<Kernel>& kernels) {
+    // Each run sorts a fresh copy of the unsorted input; the copy is included
+    kernels.push_back({"sort_floats", "sort", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 8.0);
+        c.bytes = 8.0 * c.elements;
+        c.flops = c.elements * std::log2((double)c.elements);
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer work = std::make_shared<std::vector<float>>(c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            std::copy(in->begin(), in->end(), work->begin());
+            simd_lib::sort_floats_scalar(work->data(), n);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                std::copy(in->begin(), in->end(), work->begin());
+                simd_lib::sort_floats_avx2(work->data(), n);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"sort_key_value", "sort", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 16.0);
+        c.bytes = 16.0 * c.elements;
+        c.flops = c.elements * std::log2((double)c.elements);
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer keys = std::make_shared<std::vector<float>>(c.elements);
+        auto values = std::make_shared<std::vector<uint32_t>>(c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            std::copy(in->begin(), in->end(), keys->begin());
+            for (size_t i = 0; i < n; ++i) (*values)[i] = (uint32_t)i;
+            simd_lib::sort_key_value_scalar(keys->data(), values->data(), n);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                std::copy(in->begin(), in->end(), keys->begin());
+                for (size_t i = 0; i < n; ++i) (*values)[i] = (uint32_t)i;
+                simd_lib::sort_key_value_avx2(keys->data(), values->data(), n);
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"select_median", "sort", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 8.0);
+        c.bytes = 8.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer work = std::make_shared<std::vector<float>>(c.elements);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            std::copy(in->begin(), in->end(), work->begin());
+            g_sink = simd_lib::select_nth_scalar(work->data(), n, n / 2);
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                std::copy(in->begin(), in->end(), work->begin());
+                g_sink = simd_lib::select_nth_avx2(work->data(), n, n / 2);
+            }});
+        }
+        return c;
+    }});
+
+    // Quartiles and the 99th percentile from one copy
+    kernels.push_back({"quantiles", "sort", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 8.0);
+        c.bytes = 8.0 * c.elements;
+        c.flops = 4.0 * c.elements;
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(4);
+        size_t n = c.elements;
+        c.variants.push_back({"auto", [=] {
+            const double qs[4] = {0.25, 0.5, 0.75, 0.99};
+            simd_lib::quantiles(in->data(), n, qs, 4, out->data());
+        }});
+        return c;
+    }});
+
+    kernels.push_back({"histogram_256", "histogram", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 4.0);
+        c.bytes = 4.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer in = random_floats(c.elements, -1.0f, 1.0f, 1);
+        auto counts = std::make_shared<std::vector<uint64_t>>(256);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::histogram_scalar(in->data(), n, -1.0f, 1.0f, 256, counts->data());
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::histogram_avx2(in->data(), n, -1.0f, 1.0f, 256, counts->data());
+            }});
+        }
+        return c;
+    }});
+
+    kernels.push_back({"histogram2d_64", "histogram", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 8.0);
+        c.bytes = 8.0 * c.elements;
+        c.flops = 4.0 * c.elements;
+        FloatBuffer x = random_floats(c.elements, -1.0f, 1.0f, 1);
+        FloatBuffer y = random_floats(c.elements, -1.0f, 1.0f, 2);
+        auto counts = std::make_shared<std::vector<uint64_t>>(64 * 64);
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::histogram2d_scalar(x->data(), y->data(), n, -1.0f, 1.0f, 64, -1.0f, 1.0f, 64,
+                                         counts->data());
+        }});
+        if (has_avx2()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::histogram2d_avx2(x->data(), y->data(), n, -1.0f, 1.0f, 64, -1.0f, 1.0f, 64,
+                                           counts->data());
+            }});
+        }
+        return c;
+    }});
+}
+
+static void add_random_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back({"fill_uniform", "random", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 4.0);
+        c.bytes = 4.0 * c.elements;
+        c.flops = 2.0 * c.elements;
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        auto state = std::make_shared<simd_lib::RandomState>(simd_lib::random_state(1));
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::fill_uniform_scalar(state.get(), out->data(), n, -1.0f, 1.0f);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::fill_uniform_avx2(state.get(), out->data(), n, -1.0f, 1.0f);
+            }});
+        }
+        return c;
+    }});
+
+    // Box-Muller: a log, a square root and a sincos per pair, counted as 4 operations per output
+    kernels.push_back({"fill_normal", "random", [](size_t working_set) {
+        Case c;
+        c.elements = elements_for(working_set, 4.0);
+        c.bytes = 4.0 * c.elements;
+        c.flops = 4.0 * c.elements;
+        FloatBuffer out = std::make_shared<std::vector<float>>(c.elements);
+        auto state = std::make_shared<simd_lib::RandomState>(simd_lib::random_state(1));
+        size_t n = c.elements;
+        c.variants.push_back({"scalar", [=] {
+            simd_lib::fill_normal_scalar(state.get(), out->data(), n, 0.0f, 1.0f);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                simd_lib::fill_normal_avx2(state.get(), out->data(), n, 0.0f, 1.0f);
+            }});
+        }
+        return c;
+    }});
+}
+
+// Polyphase resampling by interpolation / decimation with 64 taps per branch;
+// elements are input samples
+static Kernel resample_kernel(const char* name, size_t interpolation, size_t decimation) {
+    return {name, "resample", [=](size_t working_set) {
+        Case c;
+        auto bank = simd_lib::get_polyphase_bank(interpolation, decimation, 64);
+        double ratio = (double)bank->interpolation / (double)bank->decimation;
+        c.elements = elements_for(working_set, 4.0 * (1.0 + ratio));
+        size_t length = c.elements + bank->taps;
+        size_t outputs = (size_t)(c.elements * ratio) + 1;
+        c.bytes = 4.0 * (c.elements + outputs);
+        c.flops = 2.0 * bank->taps * outputs;
+        FloatBuffer in = random_floats(length, -1.0f, 1.0f, 1);
+        FloatBuffer out = std::make_shared<std::vector<float>>(outputs + 1);
+        c.variants.push_back({"scalar", [=] {
+            size_t position = 0;
+            simd_lib::resample_polyphase_scalar(in->data(), length, bank->coefficients.data(), bank->taps,
+                                                bank->interpolation, bank->decimation, &position, out->data(), 1);
+        }});
+        if (has_avx2_fma()) {
+            c.variants.push_back({"avx2", [=] {
+                size_t position = 0;
+                simd_lib::resample_polyphase_avx2(in->data(), length, bank->coefficients.data(), bank->taps,
+                                                  bank->interpolation, bank->decimation, &position, out->data(), 1);
+            }});
+        }
+        return c;
+    }};
+}
+
+static void add_signal_kernels(std::vector<Kernel>& kernels) {
+    kernels.push_back(resample_kernel("resample_44k1_48k", 160, 147));
+    kernels.push_back(resample_kernel("decimate_2", 1, 2));
+}
+
+static std::vector<Kernel> all_kernels() {
+    std::vector<Kernel> kernels;
+    add_vector_kernels(kernels);
+    add_reduction_kernels(kernels);
+    add_math_kernels(kernels);
+    add_quantized_kernels(kernels);
+    add_search_kernels(kernels);
+    add_sparse_kernels(kernels);
+    add_transform_kernels(kernels);
+    add_spectral_kernels(kernels);
+    add_complex_kernels(kernels);
+    add_layout_kernels(kernels);
+    add_audio_kernels(kernels);
+    add_selection_kernels(kernels);
+    add_random_kernels(kernels);
+    add_signal_kernels(kernels);
+    return kernels;
+}
+
+static void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --filter <text>     only kernels whose group/name contains text\n"
+              << "  --levels <list>     comma-separated subset of L1,L2,L3,DRAM (default: all)\n"
+              << "  --budget-ms <ms>    time per kernel variant and size (default: 40)\n"
+              << "  --cpu <n>           core to pin to, -1 to leave unpinned (default: 0)\n"
+              << "  --csv <path>        write results as CSV\n"
+              << "  --json <path>       write results as JSON\n"
+              << "  --list              list kernels and exit\n";
+}
+
+int main(int argc, char** argv) {
+    simd_bench::Options options;
+    options.levels = simd_bench::default_levels();
+    bool list_only = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--levels" && has_value) {
+            std::vector<simd_bench::SizeLevel> selected;
+            std::stringstream list(argv[++i]);
+            std::string name;
+            while (std::getline(list, name, ',')) {
+                for (const auto& level : simd_bench::default_levels()) {
+                    if (name == level.name) selected.push_back(level);
+                }
+            }
+            options.levels = selected;
+        } else if (arg == "--budget-ms" && has_value) {
+            options.budget_ms = std::atof(argv[++i]);
+        } else if (arg == "--cpu" && has_value) {
+            options.cpu = std::atoi(argv[++i]);
+        } else if (arg == "--csv" && has_value) {
+            options.csv_path = argv[++i];
+        } else if (arg == "--json" && has_value) {
+            options.json_path = argv[++i];
+        } else if (arg == "--list") {
+            list_only = true;
+        } else {
+            print_usage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::cout << simd_lib::get_simd_version() << " - Benchmark Suite\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    std::vector<Kernel> kernels = all_kernels();
+    if (list_only) {
+        for (const auto& kernel : kernels) {
+            std::cout << kernel.group << "/" << kernel.name << "\n";
+        }
+        return 0;
+    }
+
+    if (simd_bench::pin_thread(options.cpu)) {
+        std::cout << "Pinned to CPU " << options.cpu << "\n";
+    } else {
+        std::cout << "Running unpinned\n";
+        options.cpu = -1;
+    }
+    std::cout << "Cycles are TSC reference cycles\n";
+#ifdef SIMD_LIB_PERF_COUNTERS
+    {
+        simd_lib::PerfCounters probe;
+        bool hardware = (probe.available() & simd_lib::kPerfInstructions) != 0;
+        std::cout << "Hardware counters: " << (hardware ? "IPC and MPKI from perf_event_open"
+                                                        : "unavailable, counter columns read zero") << "\n";
+    }
+#endif
+    std::cout << "\n";
+
+    auto results = simd_bench::run_benchmarks(kernels, options);
+
+    if (!options.csv_path.empty() && !simd_bench::write_csv(options.csv_path, results)) {
+        std::cerr << "Could not write " << options.csv_path << "\n";
+        return 1;
+    }
+    if (!options.json_path.empty() && !simd_bench::write_json(options.json_path, results, options)) {
+        std::cerr << "Could not write " << options.json_path << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -5,16 +5,85 @@ REM Create build directory
 if not exist build mkdir build
 cd build
 
-REM Compile with GCC
-g++ -std=c++17 -O3 -mavx2 -mfma -DPLATFORM_X86 -I../include ^
+REM Compile each instruction set separately: portable code stays baseline
+REM x86-64 and only the kernels behind runtime dispatch get -mavx2
+set CXXFLAGS=-std=c++17 -O3 -pthread -DPLATFORM_X86 -I../include
+
+g++ %CXXFLAGS% ^
     ../src/common/detection.cpp ^
     ../src/common/dispatch.cpp ^
-    ../src/x86/avx2.cpp ^
-    ../src/x86/sse4.cpp ^
+    ../src/common/quantized.cpp ^
+    ../src/common/parallel.cpp ^
+    ../src/common/search.cpp ^
+    ../src/common/fft.cpp ^
+    ../src/common/reduce.cpp ^
+    ../src/common/scan.cpp ^
+    ../src/common/perf_counters.cpp ^
+    ../src/common/telemetry.cpp ^
+    ../src/common/tuning.cpp ^
+    ../src/common/stream.cpp ^
+    ../src/common/stft.cpp ^
+    ../src/common/window.cpp ^
+    ../src/common/fft2d.cpp ^
+    ../src/common/transpose.cpp ^
+    ../src/common/biquad.cpp ^
+    ../src/common/resample.cpp ^
+    ../src/common/quantile.cpp ^
+    ../src/common/sparse.cpp ^
+    ../src/common/histogram.cpp ^
+    ../src/common/random.cpp ^
     ../src/scalar/scalar.cpp ^
+    ../src/scalar/quantized_scalar.cpp ^
+    ../src/scalar/search_scalar.cpp ^
+    ../src/scalar/math_scalar.cpp ^
+    ../src/scalar/reduce_scalar.cpp ^
+    ../src/scalar/scan_scalar.cpp ^
+    ../src/scalar/matrix_scalar.cpp ^
+    ../src/scalar/fft_scalar.cpp ^
+    ../src/scalar/transpose_scalar.cpp ^
+    ../src/scalar/layout_scalar.cpp ^
+    ../src/scalar/complex_scalar.cpp ^
+    ../src/scalar/biquad_scalar.cpp ^
+    ../src/scalar/resample_scalar.cpp ^
+    ../src/scalar/pcm_scalar.cpp ^
+    ../src/scalar/sort_scalar.cpp ^
+    ../src/scalar/sparse_scalar.cpp ^
+    ../src/scalar/histogram_scalar.cpp ^
+    ../src/scalar/random_scalar.cpp ^
+    ../src/scalar/quaternion_scalar.cpp ^
+    -c || goto failed
+
+g++ %CXXFLAGS% -msse4.1 -msse4.2 ^
+    ../src/x86/sse4.cpp ^
+    -c || goto failed
+
+g++ %CXXFLAGS% -mavx2 -mfma ^
+    ../src/x86/avx2.cpp ^
+    ../src/x86/quantized_avx2.cpp ^
+    ../src/x86/search_avx2.cpp ^
+    ../src/x86/math_avx2.cpp ^
+    ../src/x86/reduce_avx2.cpp ^
+    ../src/x86/scan_avx2.cpp ^
+    ../src/x86/matrix_avx2.cpp ^
+    ../src/x86/fft_avx2.cpp ^
+    ../src/x86/transpose_avx2.cpp ^
+    ../src/x86/layout_avx2.cpp ^
+    ../src/x86/complex_avx2.cpp ^
+    ../src/x86/biquad_avx2.cpp ^
+    ../src/x86/resample_avx2.cpp ^
+    ../src/x86/pcm_avx2.cpp ^
+    ../src/x86/sort_avx2.cpp ^
+    ../src/x86/sparse_avx2.cpp ^
+    ../src/x86/histogram_avx2.cpp ^
+    ../src/x86/random_avx2.cpp ^
+    ../src/x86/quaternion_avx2.cpp ^
+    -c || goto failed
+
+g++ %CXXFLAGS% *.o ^
     ../tests/test_vector_add.cpp ^
     -o simd_test.exe
 
+:failed
 if %ERRORLEVEL% EQU 0 (
     echo Build successful! Running tests...
     echo.
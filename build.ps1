@@ -6,20 +6,91 @@ if (!(Test-Path "build")) {
 }
 Set-Location "build"
 
-# Compile with GCC
-$compileArgs = @(
-    "-std=c++17", "-O3", "-mavx2", "-mfma", "-I../include",
+# Compile each instruction set separately: portable code stays baseline
+# x86-64 and only the kernels behind runtime dispatch get -mavx2
+$baseArgs = @("-std=c++17", "-O3", "-pthread", "-DPLATFORM_X86", "-I../include")
+
+$commonSources = @(
     "../src/common/detection.cpp",
-    "../src/common/dispatch.cpp", 
-    "../src/x86/avx2.cpp",
-    "../src/x86/sse4.cpp",
+    "../src/common/dispatch.cpp",
+    "../src/common/quantized.cpp",
+    "../src/common/parallel.cpp",
+    "../src/common/search.cpp",
+    "../src/common/fft.cpp",
+    "../src/common/reduce.cpp",
+    "../src/common/scan.cpp",
+    "../src/common/perf_counters.cpp",
+    "../src/common/telemetry.cpp",
+    "../src/common/tuning.cpp",
+    "../src/common/stream.cpp",
+    "../src/common/stft.cpp",
+    "../src/common/window.cpp",
+    "../src/common/fft2d.cpp",
+    "../src/common/transpose.cpp",
+    "../src/common/biquad.cpp",
+    "../src/common/resample.cpp",
+    "../src/common/quantile.cpp",
+    "../src/common/sparse.cpp",
+    "../src/common/histogram.cpp",
+    "../src/common/random.cpp",
     "../src/scalar/scalar.cpp",
-    "../tests/test_vector_add.cpp",
-    "-o", "simd_test.exe"
+    "../src/scalar/quantized_scalar.cpp",
+    "../src/scalar/search_scalar.cpp",
+    "../src/scalar/math_scalar.cpp",
+    "../src/scalar/reduce_scalar.cpp",
+    "../src/scalar/scan_scalar.cpp",
+    "../src/scalar/matrix_scalar.cpp",
+    "../src/scalar/fft_scalar.cpp",
+    "../src/scalar/transpose_scalar.cpp",
+    "../src/scalar/layout_scalar.cpp",
+    "../src/scalar/complex_scalar.cpp",
+    "../src/scalar/biquad_scalar.cpp",
+    "../src/scalar/resample_scalar.cpp",
+    "../src/scalar/pcm_scalar.cpp",
+    "../src/scalar/sort_scalar.cpp",
+    "../src/scalar/sparse_scalar.cpp",
+    "../src/scalar/histogram_scalar.cpp",
+    "../src/scalar/random_scalar.cpp",
+    "../src/scalar/quaternion_scalar.cpp",
+    "-c"
+)
+
+$sse4Sources = @(
+    "../src/x86/sse4.cpp",
+    "-c"
+)
+
+$avx2Sources = @(
+    "../src/x86/avx2.cpp",
+    "../src/x86/quantized_avx2.cpp",
+    "../src/x86/search_avx2.cpp",
+    "../src/x86/math_avx2.cpp",
+    "../src/x86/reduce_avx2.cpp",
+    "../src/x86/scan_avx2.cpp",
+    "../src/x86/matrix_avx2.cpp",
+    "../src/x86/fft_avx2.cpp",
+    "../src/x86/transpose_avx2.cpp",
+    "../src/x86/layout_avx2.cpp",
+    "../src/x86/complex_avx2.cpp",
+    "../src/x86/biquad_avx2.cpp",
+    "../src/x86/resample_avx2.cpp",
+    "../src/x86/pcm_avx2.cpp",
+    "../src/x86/sort_avx2.cpp",
+    "../src/x86/sparse_avx2.cpp",
+    "../src/x86/histogram_avx2.cpp",
+    "../src/x86/random_avx2.cpp",
+    "../src/x86/quaternion_avx2.cpp",
+    "-c"
 )
 
 Write-Host "Compiling..." -ForegroundColor Yellow
-& g++ @compileArgs
+& g++ @baseArgs @commonSources
+if ($LASTEXITCODE -eq 0) { & g++ @baseArgs "-msse4.1" "-msse4.2" @sse4Sources }
+if ($LASTEXITCODE -eq 0) { & g++ @baseArgs "-mavx2" "-mfma" @avx2Sources }
+if ($LASTEXITCODE -eq 0) {
+    $objects = Get-ChildItem -Filter *.o | ForEach-Object { $_.Name }
+    & g++ @baseArgs @objects "../tests/test_vector_add.cpp" "-o" "simd_test.exe"
+}
 
 if ($LASTEXITCODE -eq 0) {
     Write-Host "Build successful! Running tests..." -ForegroundColor Green
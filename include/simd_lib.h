@@ -2,6 +2,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace simd_lib {
 
@@ -12,22 +16,27 @@ struct CPUFeatures {
     bool has_avx = false;
     bool has_avx2 = false;
     bool has_fma = false;
+    bool has_avx_vnni = false;
 };
 
 // Initialize CPU feature detection
 void init_cpu_features();
 const CPUFeatures& get_cpu_features();
+// CPUID brand string, e.g. "Intel(R) Core(TM) i7-9700K CPU @ 3.60GHz"
+std::string get_cpu_model();
 
 // Vector addition functions
 void vector_add(const float* a, const float* b, float* result, size_t count);
 void vector_add_scalar(const float* a, const float* b, float* result, size_t count);
 void vector_add_sse4(const float* a, const float* b, float* result, size_t count);
 void vector_add_avx2(const float* a, const float* b, float* result, size_t count);
+void vector_add_avx2_stream(const float* a, const float* b, float* result, size_t count);
 
 // Vector multiplication functions
 void vector_multiply(const float* a, const float* b, float* result, size_t count);
 void vector_multiply_scalar(const float* a, const float* b, float* result, size_t count);
 void vector_multiply_avx2(const float* a, const float* b, float* result, size_t count);
+void vector_multiply_avx2_stream(const float* a, const float* b, float* result, size_t count);
 
 // Dot product functions
 float dot_product(const float* a, const float* b, size_t count);
@@ -38,10 +47,12 @@ float dot_product_avx2(const float* a, const float* b, size_t count);
 void vector_subtract(const float* a, const float* b, float* result, size_t count);
 void vector_subtract_scalar(const float* a, const float* b, float* result, size_t count);
 void vector_subtract_avx2(const float* a, const float* b, float* result, size_t count);
+void vector_subtract_avx2_stream(const float* a, const float* b, float* result, size_t count);
 
 void vector_scale(const float* a, float scale, float* result, size_t count);
 void vector_scale_scalar(const float* a, float scale, float* result, size_t count);
 void vector_scale_avx2(const float* a, float scale, float* result, size_t count);
+void vector_scale_avx2_stream(const float* a, float scale, float* result, size_t count);
 
 float vector_norm(const float* a, size_t count);
 float vector_norm_scalar(const float* a, size_t count);
@@ -55,23 +66,1140 @@ void vector_normalize(const float* a, float* result, size_t count);
 void vector_normalize_scalar(const float* a, float* result, size_t count);
 void vector_normalize_avx2(const float* a, float* result, size_t count);
 
+// Reductions
+// The dispatching versions split inputs of at least 64K elements across
+// num_threads threads (0 = all cores). Empty inputs give sum 0, min +inf,
+// max -inf, argmin/argmax 0 and mean/variance 0. NaN inputs give unspecified
+// results. argmin/argmax return the first index of the extreme value.
+float vector_sum(const float* a, size_t count, size_t num_threads = 1);
+float vector_sum_scalar(const float* a, size_t count);
+float vector_sum_avx2(const float* a, size_t count);
+
+float vector_min(const float* a, size_t count, size_t num_threads = 1);
+float vector_min_scalar(const float* a, size_t count);
+float vector_min_avx2(const float* a, size_t count);
+
+float vector_max(const float* a, size_t count, size_t num_threads = 1);
+float vector_max_scalar(const float* a, size_t count);
+float vector_max_avx2(const float* a, size_t count);
+
+void vector_minmax(const float* a, size_t count, float* min_value, float* max_value, size_t num_threads = 1);
+void vector_minmax_scalar(const float* a, size_t count, float* min_value, float* max_value);
+void vector_minmax_avx2(const float* a, size_t count, float* min_value, float* max_value);
+
+size_t argmin(const float* a, size_t count, size_t num_threads = 1);
+size_t argmin_scalar(const float* a, size_t count);
+size_t argmin_avx2(const float* a, size_t count);
+
+size_t argmax(const float* a, size_t count, size_t num_threads = 1);
+size_t argmax_scalar(const float* a, size_t count);
+size_t argmax_avx2(const float* a, size_t count);
+
+// Population variance in a single pass: per-block sums around a block shift,
+// merged with Chan's parallel update in double precision
+void mean_variance(const float* a, size_t count, float* mean, float* variance, size_t num_threads = 1);
+void mean_variance_scalar(const float* a, size_t count, float* mean, float* variance);
+void mean_variance_avx2(const float* a, size_t count, float* mean, float* variance);
+// The same statistics left in double, as the mean and the sum of squared
+// deviations (M2), for callers that merge further partials
+void mean_m2_scalar(const float* a, size_t count, double* mean, double* m2);
+void mean_m2_avx2(const float* a, size_t count, double* mean, double* m2);
+
+// Histograms
+// bins equal-width bins over [lo, hi]: x lands in bin floor((x - lo) * bins / (hi - lo)),
+// with x == hi in the last bin. Values outside the range and NaN are not
+// counted. counts (bins entries) is overwritten. The AVX2 kernels compute 8
+// bin indices at once and spread increments over 4 sub-histograms, so runs of
+// equal bins do not stall on store-to-load forwarding. Inputs are split across
+// num_threads threads (0 = all cores) in blocks of at least 64K elements, each
+// filling its own histogram before the merge. bins must be below 2^31.
+void histogram(const float* data, size_t count, float lo, float hi, size_t bins, uint64_t* counts,
+               size_t num_threads = 1);
+// The kernels add to counts instead of overwriting them
+void histogram_scalar(const float* data, size_t count, float lo, float hi, size_t bins, uint64_t* counts);
+void histogram_avx2(const float* data, size_t count, float lo, float hi, size_t bins, uint64_t* counts);
+
+// Joint histogram of (x[i], y[i]) pairs; counts is row-major [x_bins][y_bins]
+// and x_bins * y_bins must be below 2^31. A pair is counted only if both
+// coordinates are in range.
+void histogram2d(const float* x, const float* y, size_t count, float x_lo, float x_hi, size_t x_bins,
+                 float y_lo, float y_hi, size_t y_bins, uint64_t* counts, size_t num_threads = 1);
+void histogram2d_scalar(const float* x, const float* y, size_t count, float x_lo, float x_hi, size_t x_bins,
+                        float y_lo, float y_hi, size_t y_bins, uint64_t* counts);
+void histogram2d_avx2(const float* x, const float* y, size_t count, float x_lo, float x_hi, size_t x_bins,
+                      float y_lo, float y_hi, size_t y_bins, uint64_t* counts);
+
+// Prefix sums
+// inclusive: result[i] = input[0] + ... + input[i]
+// exclusive: result[0] = 0, result[i] = input[0] + ... + input[i - 1]
+// input and result may be the same array. The AVX2 kernels add within each
+// vector in log steps, so results can differ from a serial sum by rounding.
+// Inputs of at least 512K elements are split across num_threads threads with
+// a two-pass block scan (block sums, then a scan of each block from its offset).
+void inclusive_scan(const float* input, float* result, size_t count, size_t num_threads = 1);
+void exclusive_scan(const float* input, float* result, size_t count, size_t num_threads = 1);
+
+// Scan kernels start from carry and return the running total after the last
+// element, so a long array can be scanned in pieces
+float inclusive_scan_scalar(const float* input, float* result, size_t count, float carry);
+float inclusive_scan_avx2(const float* input, float* result, size_t count, float carry);
+float exclusive_scan_scalar(const float* input, float* result, size_t count, float carry);
+float exclusive_scan_avx2(const float* input, float* result, size_t count, float carry);
+
+// Summed-area table of a row-major rows x cols image:
+// result[r * cols + c] = sum of input[i * cols + j] for i <= r, j <= c.
+// input and result may be the same array. Single precision limits the exact
+// range: sums above 2^24 lose integer precision.
+void summed_area_table(const float* input, float* result, size_t rows, size_t cols, size_t num_threads = 1);
+void summed_area_table_scalar(const float* input, float* result, size_t rows, size_t cols);
+
+// Streaming reductions
+// Accumulators for data that arrives in chunks, e.g. read from a file larger
+// than memory. add() reduces each chunk with the SIMD kernels in blocks of 4K
+// elements and folds the block results into double-precision totals, so the
+// error does not grow with the length of the stream and the result barely
+// depends on how it was chunked. merge() combines accumulators filled by
+// different threads. Empty accumulators give sum 0, min +inf, max -inf and
+// mean/variance 0.
+class SumAccumulator {
+public:
+    void add(const float* data, size_t count);
+    void merge(const SumAccumulator& other);
+    void reset() { *this = SumAccumulator(); }
+    double sum() const { return sum_; }
+    uint64_t count() const { return count_; }
+
+private:
+    double sum_ = 0.0;
+    uint64_t count_ = 0;
+};
+
+class DotAccumulator {
+public:
+    void add(const float* a, const float* b, size_t count);
+    void merge(const DotAccumulator& other);
+    void reset() { *this = DotAccumulator(); }
+    double dot() const { return dot_; }
+    uint64_t count() const { return count_; }
+
+private:
+    double dot_ = 0.0;
+    uint64_t count_ = 0;
+};
+
+class NormAccumulator {
+public:
+    void add(const float* data, size_t count);
+    void merge(const NormAccumulator& other);
+    void reset() { *this = NormAccumulator(); }
+    double norm_squared() const { return sum_squares_; }
+    double norm() const;
+    uint64_t count() const { return count_; }
+
+private:
+    double sum_squares_ = 0.0;
+    uint64_t count_ = 0;
+};
+
+class MinMaxAccumulator {
+public:
+    MinMaxAccumulator();
+    void add(const float* data, size_t count);
+    void merge(const MinMaxAccumulator& other);
+    void reset() { *this = MinMaxAccumulator(); }
+    float min() const { return min_; }
+    float max() const { return max_; }
+    uint64_t count() const { return count_; }
+
+private:
+    float min_;
+    float max_;
+    uint64_t count_ = 0;
+};
+
+// Population mean and variance, merged across blocks with Chan's update
+class MeanVarianceAccumulator {
+public:
+    void add(const float* data, size_t count);
+    void merge(const MeanVarianceAccumulator& other);
+    void reset() { *this = MeanVarianceAccumulator(); }
+    double mean() const { return mean_; }
+    double variance() const { return count_ > 0 ? m2_ / (double)count_ : 0.0; }
+    uint64_t count() const { return count_; }
+
+private:
+    void combine(double n, double mean, double m2);
+
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    uint64_t count_ = 0;
+};
+
+// Chunked file processing
+// Files hold raw native-endian floats. for_each_chunk calls fn on consecutive
+// chunks of up to chunk_floats elements. Buffered reads the next chunk on a
+// background thread while fn runs on the current one; Mapped memory-maps the
+// file and passes views into the mapping (POSIX only; other platforms fall
+// back to Buffered). Both return false, before calling fn, if the file cannot
+// be opened or its size is not a multiple of sizeof(float), and false if a
+// later read fails.
+enum class ChunkSource { Buffered, Mapped };
+
+bool for_each_chunk(const std::string& path, const std::function<void(const float*, size_t)>& fn,
+                    size_t chunk_floats = 1 << 20, ChunkSource source = ChunkSource::Buffered);
+
+// Runs an elementwise kernel such as vector_exp over a file, writing the
+// results to output_path. The next chunk is read and the previous one
+// written on background threads while the kernel runs.
+bool transform_file(const std::string& input_path, const std::string& output_path,
+                    const std::function<void(const float*, float*, size_t)>& kernel,
+                    size_t chunk_floats = 1 << 20);
+
 // Matrix operations
 void matrix_multiply_4x4(const float* a, const float* b, float* result);
 void matrix_multiply_4x4_scalar(const float* a, const float* b, float* result);
+void matrix_multiply_4x4_avx2(const float* a, const float* b, float* result);
 void matrix_multiply_3x3(const float* a, const float* b, float* result);
 void matrix_multiply_3x3_scalar(const float* a, const float* b, float* result);
 void matrix_vector_multiply_4x4(const float* matrix, const float* vector, float* result);
 void matrix_vector_multiply_4x4_scalar(const float* matrix, const float* vector, float* result);
+void matrix_vector_multiply_4x4_avx2(const float* matrix, const float* vector, float* result);
 void matrix_vector_multiply_3x3(const float* matrix, const float* vector, float* result);
 void matrix_vector_multiply_3x3_scalar(const float* matrix, const float* vector, float* result);
 
+// Quaternions and rigid transforms
+// Batches are SoA: quaternion i is w[i] + x[i] i + y[i] j + z[i] k and point i
+// is (x[i], y[i], z[i]); deinterleave4/deinterleave3 convert from AoS. Rotations
+// assume unit quaternions. Outputs may alias inputs of the same shape.
+struct QuaternionArrays {
+    float* w;
+    float* x;
+    float* y;
+    float* z;
+};
+
+struct ConstQuaternionArrays {
+    const float* w;
+    const float* x;
+    const float* y;
+    const float* z;
+};
+
+struct Vec3Arrays {
+    float* x;
+    float* y;
+    float* z;
+};
+
+struct ConstVec3Arrays {
+    const float* x;
+    const float* y;
+    const float* z;
+};
+
+// result = a * b (Hamilton product: rotating by result applies b, then a)
+void quaternion_multiply(ConstQuaternionArrays a, ConstQuaternionArrays b, QuaternionArrays result, size_t count);
+void quaternion_multiply_scalar(ConstQuaternionArrays a, ConstQuaternionArrays b, QuaternionArrays result,
+                                size_t count);
+void quaternion_multiply_avx2(ConstQuaternionArrays a, ConstQuaternionArrays b, QuaternionArrays result,
+                              size_t count);
+
+// result = q v q*, as v + w t + u x t with u = (x, y, z) and t = 2 u x v
+void quaternion_rotate(ConstQuaternionArrays q, ConstVec3Arrays v, Vec3Arrays result, size_t count);
+void quaternion_rotate_scalar(ConstQuaternionArrays q, ConstVec3Arrays v, Vec3Arrays result, size_t count);
+void quaternion_rotate_avx2(ConstQuaternionArrays q, ConstVec3Arrays v, Vec3Arrays result, size_t count);
+
+// Rotation matrices as 9 planes of count floats: element (r, c) of matrix i
+// is matrices[(3 * r + c) * count + i], so each plane is one SoA array
+void quaternion_to_matrix3(ConstQuaternionArrays q, float* matrices, size_t count);
+void quaternion_to_matrix3_scalar(ConstQuaternionArrays q, float* matrices, size_t count);
+void quaternion_to_matrix3_avx2(ConstQuaternionArrays q, float* matrices, size_t count);
+
+// Shepperd's method: the largest of w, x, y, z is recovered from the diagonal
+// and made positive, the others from off-diagonal sums, so no case divides by
+// a small value. The AVX2 version computes all four cases and blends per lane.
+void quaternion_from_matrix3(const float* matrices, QuaternionArrays q, size_t count);
+void quaternion_from_matrix3_scalar(const float* matrices, QuaternionArrays q, size_t count);
+void quaternion_from_matrix3_avx2(const float* matrices, QuaternionArrays q, size_t count);
+
+// Scales each quaternion to unit length; the AVX2 version uses rsqrt plus one
+// Newton step (about 1 ulp). Zero quaternions become the identity.
+void quaternion_normalize(ConstQuaternionArrays q, QuaternionArrays result, size_t count);
+void quaternion_normalize_scalar(ConstQuaternionArrays q, QuaternionArrays result, size_t count);
+void quaternion_normalize_avx2(ConstQuaternionArrays q, QuaternionArrays result, size_t count);
+
+// Spherical interpolation from a (t = 0) to b (t = 1) along the shorter arc.
+// Nearly parallel pairs (cos > 0.9995) fall back to normalized lerp.
+void quaternion_slerp(ConstQuaternionArrays a, ConstQuaternionArrays b, float t, QuaternionArrays result,
+                      size_t count);
+void quaternion_slerp_scalar(ConstQuaternionArrays a, ConstQuaternionArrays b, float t, QuaternionArrays result,
+                             size_t count);
+void quaternion_slerp_avx2(ConstQuaternionArrays a, ConstQuaternionArrays b, float t, QuaternionArrays result,
+                           size_t count);
+
+// Rigid transform of a point cloud: result = R(rotation) p + translation, with
+// rotation = {w, x, y, z} and translation = {x, y, z}. The quaternion becomes a
+// matrix once, then each coordinate takes three FMAs in one pass over the points.
+void rigid_transform_points(const float* rotation, const float* translation, ConstVec3Arrays points,
+                            Vec3Arrays result, size_t count);
+void rigid_transform_points_scalar(const float* rotation, const float* translation, ConstVec3Arrays points,
+                                   Vec3Arrays result, size_t count);
+void rigid_transform_points_avx2(const float* rotation, const float* translation, ConstVec3Arrays points,
+                                 Vec3Arrays result, size_t count);
+
+// Matrix transpose
+// dst[c * ldd + r] = src[r * lds + c] for a row-major rows x cols src with
+// row stride lds, so sub-matrices can be transposed in place in a larger
+// array. src and dst must not overlap. The matrix is walked in 64x64 tiles,
+// split across num_threads threads by tile rows; the AVX2 kernel transposes
+// 8x8 blocks in registers.
+void transpose(const float* src, size_t rows, size_t cols, size_t lds, float* dst, size_t ldd,
+               size_t num_threads = 1);
+void transpose_scalar(const float* src, size_t rows, size_t cols, size_t lds, float* dst, size_t ldd);
+void transpose_avx2(const float* src, size_t rows, size_t cols, size_t lds, float* dst, size_t ldd);
+
+// In-place transpose of an n x n matrix with row stride ld
+void transpose_inplace(float* data, size_t n, size_t ld, size_t num_threads = 1);
+// Exchanges the rows x cols block a with the transpose of the cols x rows
+// block b, both with row stride ld. a == b (rows == cols) transposes a
+// square block in place.
+void transpose_swap_scalar(float* a, float* b, size_t rows, size_t cols, size_t ld);
+void transpose_swap_avx2(float* a, float* b, size_t rows, size_t cols, size_t ld);
+
+// Layout conversion
+// Interleaved (AoS) records of 2, 3 or 4 floats, e.g. complex (re, im),
+// xyz or xyzw points, to and from planar (SoA) arrays of count elements:
+// deinterleave3: a[i] = src[3i], b[i] = src[3i + 1], c[i] = src[3i + 2].
+void deinterleave2(const float* src, float* a, float* b, size_t count);
+void deinterleave2_scalar(const float* src, float* a, float* b, size_t count);
+void deinterleave2_avx2(const float* src, float* a, float* b, size_t count);
+
+void deinterleave3(const float* src, float* a, float* b, float* c, size_t count);
+void deinterleave3_scalar(const float* src, float* a, float* b, float* c, size_t count);
+void deinterleave3_avx2(const float* src, float* a, float* b, float* c, size_t count);
+
+void deinterleave4(const float* src, float* a, float* b, float* c, float* d, size_t count);
+void deinterleave4_scalar(const float* src, float* a, float* b, float* c, float* d, size_t count);
+void deinterleave4_avx2(const float* src, float* a, float* b, float* c, float* d, size_t count);
+
+void interleave2(const float* a, const float* b, float* dst, size_t count);
+void interleave2_scalar(const float* a, const float* b, float* dst, size_t count);
+void interleave2_avx2(const float* a, const float* b, float* dst, size_t count);
+
+void interleave3(const float* a, const float* b, const float* c, float* dst, size_t count);
+void interleave3_scalar(const float* a, const float* b, const float* c, float* dst, size_t count);
+void interleave3_avx2(const float* a, const float* b, const float* c, float* dst, size_t count);
+
+void interleave4(const float* a, const float* b, const float* c, const float* d, float* dst, size_t count);
+void interleave4_scalar(const float* a, const float* b, const float* c, const float* d, float* dst, size_t count);
+void interleave4_avx2(const float* a, const float* b, const float* c, const float* d, float* dst, size_t count);
+
+// Elementwise transcendental functions
+// The _scalar versions call libm and serve as the reference. The _avx2
+// versions (AVX2 + FMA) are Cephes-style polynomials; max error against a
+// double-precision reference, measured by tests/test_math.cpp:
+//   exp      1.5 ulp  (+inf above 88.72, 0 below -87.33)
+//   log      1 ulp    (denormals included; 0 -> -inf, x < 0 -> NaN)
+//   sin/cos  1.5 ulp where |result| > 0.5, 2^-23 absolute elsewhere,
+//            for |x| <= 8192 (larger |x| falls back to libm)
+//   tanh     1.5 ulp
+//   sigmoid  3.5 ulp
+//   rsqrt    3.5 ulp  (rsqrtps + one Newton-Raphson step)
+void vector_exp(const float* input, float* result, size_t count);
+void vector_exp_scalar(const float* input, float* result, size_t count);
+void vector_exp_avx2(const float* input, float* result, size_t count);
+
+void vector_log(const float* input, float* result, size_t count);
+void vector_log_scalar(const float* input, float* result, size_t count);
+void vector_log_avx2(const float* input, float* result, size_t count);
+
+void vector_sin(const float* input, float* result, size_t count);
+void vector_sin_scalar(const float* input, float* result, size_t count);
+void vector_sin_avx2(const float* input, float* result, size_t count);
+
+void vector_cos(const float* input, float* result, size_t count);
+void vector_cos_scalar(const float* input, float* result, size_t count);
+void vector_cos_avx2(const float* input, float* result, size_t count);
+
+void vector_sincos(const float* input, float* sin_result, float* cos_result, size_t count);
+void vector_sincos_scalar(const float* input, float* sin_result, float* cos_result, size_t count);
+void vector_sincos_avx2(const float* input, float* sin_result, float* cos_result, size_t count);
+
+void vector_tanh(const float* input, float* result, size_t count);
+void vector_tanh_scalar(const float* input, float* result, size_t count);
+void vector_tanh_avx2(const float* input, float* result, size_t count);
+
+void vector_sigmoid(const float* input, float* result, size_t count);
+void vector_sigmoid_scalar(const float* input, float* result, size_t count);
+void vector_sigmoid_avx2(const float* input, float* result, size_t count);
+
+void vector_rsqrt(const float* input, float* result, size_t count);
+void vector_rsqrt_scalar(const float* input, float* result, size_t count);
+void vector_rsqrt_avx2(const float* input, float* result, size_t count);
+
+// Quantized (8-bit) operations
+// Real value = scale * (q - zero_point). Signed kernels expect symmetric
+// quantization in [-127, 127] (what quantize_s8 produces); int32 accumulation
+// is exact for count up to 2^31 / (127 * 255) ~ 66k elements.
+struct QuantizationParams {
+    float scale = 1.0f;
+    int32_t zero_point = 0;
+};
+
+void quantize_s8(const float* input, int8_t* output, size_t count, const QuantizationParams& params);
+void quantize_s8_scalar(const float* input, int8_t* output, size_t count, const QuantizationParams& params);
+void quantize_s8_avx2(const float* input, int8_t* output, size_t count, const QuantizationParams& params);
+
+void quantize_u8(const float* input, uint8_t* output, size_t count, const QuantizationParams& params);
+void quantize_u8_scalar(const float* input, uint8_t* output, size_t count, const QuantizationParams& params);
+void quantize_u8_avx2(const float* input, uint8_t* output, size_t count, const QuantizationParams& params);
+
+int32_t sum_s8(const int8_t* a, size_t count);
+int32_t sum_s8_scalar(const int8_t* a, size_t count);
+int32_t sum_s8_avx2(const int8_t* a, size_t count);
+
+int32_t sum_u8(const uint8_t* a, size_t count);
+int32_t sum_u8_scalar(const uint8_t* a, size_t count);
+int32_t sum_u8_avx2(const uint8_t* a, size_t count);
+
+int32_t dot_product_s8(const int8_t* a, const int8_t* b, size_t count);
+int32_t dot_product_s8_scalar(const int8_t* a, const int8_t* b, size_t count);
+int32_t dot_product_s8_avx2(const int8_t* a, const int8_t* b, size_t count);
+int32_t dot_product_s8_avxvnni(const int8_t* a, const int8_t* b, size_t count);
+
+int32_t dot_product_u8s8(const uint8_t* a, const int8_t* b, size_t count);
+int32_t dot_product_u8s8_scalar(const uint8_t* a, const int8_t* b, size_t count);
+int32_t dot_product_u8s8_avx2(const uint8_t* a, const int8_t* b, size_t count);
+int32_t dot_product_u8s8_avxvnni(const uint8_t* a, const int8_t* b, size_t count);
+
+int32_t l2_distance_squared_s8(const int8_t* a, const int8_t* b, size_t count);
+int32_t l2_distance_squared_s8_scalar(const int8_t* a, const int8_t* b, size_t count);
+int32_t l2_distance_squared_s8_avx2(const int8_t* a, const int8_t* b, size_t count);
+
+// Dequantized results: zero points are corrected from the integer sums
+float dot_product_quantized(const int8_t* a, const QuantizationParams& qa,
+                            const int8_t* b, const QuantizationParams& qb, size_t count);
+float dot_product_quantized(const uint8_t* a, const QuantizationParams& qa,
+                            const int8_t* b, const QuantizationParams& qb, size_t count);
+// Both vectors must share the same params (the zero point cancels)
+float l2_distance_squared_quantized(const int8_t* a, const int8_t* b, size_t count,
+                                    const QuantizationParams& params);
+
+// Batched query-vs-many: database is row-major [rows x dim], out has one entry per row
+void batch_dot_product_s8(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+void batch_dot_product_s8_scalar(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+void batch_dot_product_s8_avx2(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+void batch_dot_product_s8_avxvnni(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+
+void batch_dot_product_u8s8(const uint8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+void batch_dot_product_u8s8_scalar(const uint8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+void batch_dot_product_u8s8_avx2(const uint8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+void batch_dot_product_u8s8_avxvnni(const uint8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+
+void batch_l2_distance_squared_s8(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+void batch_l2_distance_squared_s8_scalar(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+void batch_l2_distance_squared_s8_avx2(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out);
+
+// PCM conversion
+// Full scale maps to [-1, 1): s16 / 2^15, s24 / 2^23, s32 / 2^31. Every
+// conversion also multiplies by scale in the same pass, so a gain (what
+// vector_scale would apply) costs no extra trip through memory. s24 is packed
+// little-endian, 3 bytes per sample. Float to integer rounds to nearest and
+// saturates at the integer range; NaN gives an unspecified value.
+void convert_s16_to_f32(const int16_t* input, float* output, size_t count, float scale = 1.0f);
+void convert_s16_to_f32_scalar(const int16_t* input, float* output, size_t count, float scale);
+void convert_s16_to_f32_avx2(const int16_t* input, float* output, size_t count, float scale);
+
+void convert_s24_to_f32(const uint8_t* input, float* output, size_t count, float scale = 1.0f);
+void convert_s24_to_f32_scalar(const uint8_t* input, float* output, size_t count, float scale);
+void convert_s24_to_f32_avx2(const uint8_t* input, float* output, size_t count, float scale);
+
+void convert_s32_to_f32(const int32_t* input, float* output, size_t count, float scale = 1.0f);
+void convert_s32_to_f32_scalar(const int32_t* input, float* output, size_t count, float scale);
+void convert_s32_to_f32_avx2(const int32_t* input, float* output, size_t count, float scale);
+
+// Triangular (TPDF) dither of +-1 LSB added before rounding. The noise is a
+// hash of (seed, index), so it does not depend on the ISA or on how a stream
+// is split into calls; each call advances index by count.
+struct PcmDither {
+    uint32_t seed = 0x2545f491u;
+    uint64_t index = 0;
+};
+
+// dither may be null for plain rounding
+void convert_f32_to_s16(const float* input, int16_t* output, size_t count, float scale = 1.0f,
+                        PcmDither* dither = nullptr);
+void convert_f32_to_s16_scalar(const float* input, int16_t* output, size_t count, float scale,
+                               const PcmDither* dither);
+void convert_f32_to_s16_avx2(const float* input, int16_t* output, size_t count, float scale,
+                             const PcmDither* dither);
+
+void convert_f32_to_s24(const float* input, uint8_t* output, size_t count, float scale = 1.0f,
+                        PcmDither* dither = nullptr);
+void convert_f32_to_s24_scalar(const float* input, uint8_t* output, size_t count, float scale,
+                               const PcmDither* dither);
+void convert_f32_to_s24_avx2(const float* input, uint8_t* output, size_t count, float scale,
+                             const PcmDither* dither);
+
+void convert_f32_to_s32(const float* input, int32_t* output, size_t count, float scale = 1.0f);
+void convert_f32_to_s32_scalar(const float* input, int32_t* output, size_t count, float scale);
+void convert_f32_to_s32_avx2(const float* input, int32_t* output, size_t count, float scale);
+
+// Random number generation
+// Eight xoshiro128+ streams, one per AVX2 lane; s[k][lane] is state word k.
+// The scalar kernels step the same eight lanes in turn, so both produce the
+// same integers. Lanes start 2^64 steps apart and streams 2^96 steps apart,
+// so neither overlaps in practice. Give each thread its own stream for
+// reproducible parallel generation.
+struct RandomState {
+    uint32_t s[4][8];
+};
+
+// State for stream number stream of seed; stream k is the seed's stream 0
+// advanced by k long jumps, so any stream can be reached without the others
+RandomState random_state(uint64_t seed, uint64_t stream = 0);
+// Advances every lane by 2^96 steps, to the start of the next stream
+void random_long_jump(RandomState* state);
+
+// Each call consumes whole generator steps: output i comes from lane i % 8 and
+// lanes left over by a count that is not a multiple of 8 (16 for normals) are
+// discarded. Uniforms take the top 24 bits of each output, in [lo, hi).
+void fill_uniform(RandomState* state, float* output, size_t count, float lo = 0.0f, float hi = 1.0f);
+void fill_uniform_scalar(RandomState* state, float* output, size_t count, float lo, float hi);
+void fill_uniform_avx2(RandomState* state, float* output, size_t count, float lo, float hi);
+
+// Box-Muller: each step of two uniform vectors gives 8 cosine then 8 sine
+// normals. The AVX2 version uses the polynomial log and sincos, so it agrees
+// with the scalar one to a few ulps rather than exactly.
+void fill_normal(RandomState* state, float* output, size_t count, float mean = 0.0f, float stddev = 1.0f);
+void fill_normal_scalar(RandomState* state, float* output, size_t count, float mean, float stddev);
+void fill_normal_avx2(RandomState* state, float* output, size_t count, float mean, float stddev);
+
+// Batched similarity search
+// matrix is row-major [rows x dim]; out receives one score per row. The
+// dispatching versions split rows across num_threads threads (0 = all cores).
+enum class SimilarityMetric {
+    DotProduct,   // larger is better
+    L2Squared,    // smaller is better
+    Cosine        // larger is better; zero-norm rows score 0
+};
+
+void batch_dot(const float* query, const float* matrix, size_t rows, size_t dim, float* out, size_t num_threads = 1);
+void batch_dot_scalar(const float* query, const float* matrix, size_t rows, size_t dim, float* out);
+void batch_dot_avx2(const float* query, const float* matrix, size_t rows, size_t dim, float* out);
+
+void batch_l2_squared(const float* query, const float* matrix, size_t rows, size_t dim, float* out, size_t num_threads = 1);
+void batch_l2_squared_scalar(const float* query, const float* matrix, size_t rows, size_t dim, float* out);
+void batch_l2_squared_avx2(const float* query, const float* matrix, size_t rows, size_t dim, float* out);
+
+void batch_cosine(const float* query, const float* matrix, size_t rows, size_t dim, float* out, size_t num_threads = 1);
+void batch_cosine_scalar(const float* query, const float* matrix, size_t rows, size_t dim, float* out);
+void batch_cosine_avx2(const float* query, const float* matrix, size_t rows, size_t dim, float* out);
+
+// Writes the positions i with values[i] > threshold to positions, returns how many
+size_t select_greater(const float* values, size_t count, float threshold, uint32_t* positions);
+size_t select_greater_scalar(const float* values, size_t count, float threshold, uint32_t* positions);
+size_t select_greater_avx2(const float* values, size_t count, float threshold, uint32_t* positions);
+
+// Finds the k best rows for metric without materializing all scores. Results
+// are ordered best first; returns min(k, rows).
+size_t top_k_search(const float* query, const float* matrix, size_t rows, size_t dim, size_t k,
+                    SimilarityMetric metric, size_t* indices, float* scores, size_t num_threads = 1);
+
+// Sparse vectors and matrices
+// A sparse vector is nnz (index, value) pairs with strictly increasing indices.
+// The AVX2 sparse-dense dot gathers 8 dense elements per step (indices must be
+// below 2^31); the sparse-sparse dot compares 8 indices from each side against
+// all 8 of the other and advances whichever block ends lower.
+float sparse_dot_dense(const uint32_t* indices, const float* values, size_t nnz, const float* dense);
+float sparse_dot_dense_scalar(const uint32_t* indices, const float* values, size_t nnz, const float* dense);
+float sparse_dot_dense_avx2(const uint32_t* indices, const float* values, size_t nnz, const float* dense);
+
+float sparse_dot_sparse(const uint32_t* a_indices, const float* a_values, size_t a_nnz,
+                        const uint32_t* b_indices, const float* b_values, size_t b_nnz);
+float sparse_dot_sparse_scalar(const uint32_t* a_indices, const float* a_values, size_t a_nnz,
+                               const uint32_t* b_indices, const float* b_values, size_t b_nnz);
+float sparse_dot_sparse_avx2(const uint32_t* a_indices, const float* a_values, size_t a_nnz,
+                             const uint32_t* b_indices, const float* b_values, size_t b_nnz);
+
+// Compact index format: each index is stored as the uint16 gap from the one
+// before it (the first from 0), halving index traffic. Gaps above 65535 are
+// bridged by zero-valued filler entries, so deltas may be longer than the
+// original nonzero list.
+struct SparseVector16 {
+    std::vector<uint16_t> deltas;
+    std::vector<float> values;
+};
+
+SparseVector16 compress_sparse_indices(const uint32_t* indices, const float* values, size_t nnz);
+
+float sparse_dot_dense_delta16(const uint16_t* deltas, const float* values, size_t nnz, const float* dense);
+float sparse_dot_dense_delta16_scalar(const uint16_t* deltas, const float* values, size_t nnz, const float* dense);
+float sparse_dot_dense_delta16_avx2(const uint16_t* deltas, const float* values, size_t nnz, const float* dense);
+
+// Compressed sparse row matrix: row r owns entries [row_offsets[r], row_offsets[r + 1])
+struct CsrMatrix {
+    size_t rows = 0;
+    size_t cols = 0;
+    std::vector<size_t> row_offsets;    // rows + 1 entries
+    std::vector<uint32_t> col_indices;
+    std::vector<float> values;
+};
+
+// The same matrix with delta16 column indices; each row starts again from column 0
+struct CsrMatrix16 {
+    size_t rows = 0;
+    size_t cols = 0;
+    std::vector<size_t> row_offsets;
+    std::vector<uint16_t> col_deltas;
+    std::vector<float> values;
+};
+
+// Keeps the nonzero entries of a row-major matrix
+CsrMatrix csr_from_dense(const float* dense, size_t rows, size_t cols);
+CsrMatrix16 compress_csr_indices(const CsrMatrix& matrix);
+
+// y = A x. Rows are split into contiguous blocks of roughly equal nonzero
+// count, one per thread (0 = all cores), so skewed rows do not unbalance them.
+void spmv(const CsrMatrix& matrix, const float* x, float* y, size_t num_threads = 1);
+void spmv(const CsrMatrix16& matrix, const float* x, float* y, size_t num_threads = 1);
+
+// Sorting and selection
+// Ascending order; inputs must not contain NaN. The AVX2 versions partition
+// 8 keys per step around a median-of-three pivot and finish ranges of up to
+// 64 keys with a bitonic sorting network held in registers. Neither sort is stable.
+void sort_floats(float* data, size_t count);
+void sort_floats_scalar(float* data, size_t count);
+void sort_floats_avx2(float* data, size_t count);
+
+// Sorts keys and applies the same permutation to values, e.g. indices
+// 0 .. count - 1 to obtain the sorted order
+void sort_key_value(float* keys, uint32_t* values, size_t count);
+void sort_key_value_scalar(float* keys, uint32_t* values, size_t count);
+void sort_key_value_avx2(float* keys, uint32_t* values, size_t count);
+
+// Reorders data like std::nth_element: data[n] becomes the value a full sort
+// would put there, with no larger value before it and no smaller one after.
+// Returns data[n]; n >= count leaves data unchanged and returns NaN.
+float select_nth(float* data, size_t count, size_t n);
+float select_nth_scalar(float* data, size_t count, size_t n);
+float select_nth_avx2(float* data, size_t count, size_t n);
+
+// Quantiles with linear interpolation between order statistics (q in [0, 1],
+// the default method of numpy.quantile). The input is copied, not reordered.
+// quantiles() selects all of qs from one copy, each within the range left by
+// the previous one. Empty inputs give NaN.
+float quantile(const float* data, size_t count, double q);
+void quantiles(const float* data, size_t count, const double* qs, size_t num_quantiles, float* out);
+
 // FFT operations (basic implementation)
+// Power-of-2 sizes only; other sizes leave the data unchanged. The inverse
+// is scaled by 1/n. These use the cached plan for n.
 void fft_radix2(float* real, float* imag, size_t n, bool inverse = false);
 void fft_forward(float* real, float* imag, size_t n);
 void fft_inverse(float* real, float* imag, size_t n);
 
+// Complex-interleaved input: data holds n (re, im) pairs. The first
+// butterfly stage gathers straight from the pairs and the last one writes
+// them back, so there is no separate conversion pass.
+void fft_interleaved(float* data, size_t n, bool inverse = false);
+void fft_forward_interleaved(float* data, size_t n);
+void fft_inverse_interleaved(float* data, size_t n);
+
+// Bit-reversal pairs and per-stage twiddles (computed in double) for one
+// power-of-2 size. execute() is const, so one plan can serve many threads.
+class FFTPlan {
+public:
+    explicit FFTPlan(size_t n);
+    size_t size() const { return n_; }
+    bool valid() const { return n_ != 0; }
+    void execute(float* real, float* imag, bool inverse = false) const;
+    // In place on n interleaved (re, im) pairs, via a per-thread planar scratch
+    void execute_interleaved(float* data, bool inverse = false) const;
+
+private:
+    size_t n_;
+    std::vector<uint32_t> swaps_;          // (i, j) pairs with i < j
+    std::vector<uint32_t> first_index_;    // bit reverse of 2k, k < n / 2
+    // Stage with half-length h uses entries [h - 1, 2h - 1): exp(-i*pi*k/h)
+    std::vector<float> twiddle_real_;
+    std::vector<float> twiddle_imag_;
+    std::vector<float> twiddle_imag_inverse_;
+};
+
+// Shared plan for size n, built on first request
+std::shared_ptr<const FFTPlan> get_fft_plan(size_t n);
+// Smallest power of 2 >= n, e.g. the FFT size to zero-pad n samples to
+size_t next_power_of_2(size_t n);
+
+// One radix-2 pass: butterflies of span 2 * half over all n points, with
+// twiddles w[0..half)
+void fft_stage_scalar(float* real, float* imag, size_t n, size_t half, const float* w_real, const float* w_imag);
+void fft_stage_avx2(float* real, float* imag, size_t n, size_t half, const float* w_real, const float* w_imag);
+
+// First stage fused with the bit-reversed gather from interleaved pairs
+// (index = the plan's first_index_), and last stage (half = n / 2) fused with
+// the 1/n scale and the store back to interleaved pairs
+void fft_first_stage_interleaved_scalar(const float* data, const uint32_t* index, float* real, float* imag, size_t n);
+void fft_first_stage_interleaved_avx2(const float* data, const uint32_t* index, float* real, float* imag, size_t n);
+void fft_last_stage_interleaved_scalar(const float* real, const float* imag, size_t n, const float* w_real,
+                                       const float* w_imag, float scale, float* data);
+void fft_last_stage_interleaved_avx2(const float* real, const float* imag, size_t n, const float* w_real,
+                                     const float* w_imag, float scale, float* data);
+
+// 2D FFT
+// Row-major rows x cols data, both powers of 2; other sizes leave the data
+// unchanged. Rows are transformed in place; columns are transposed in
+// 16-wide strips into contiguous rows, transformed, and transposed back.
+// Rows and strips are split across num_threads threads. The inverse is
+// scaled by 1/(rows * cols).
+void fft2d_forward(float* real, float* imag, size_t rows, size_t cols, size_t num_threads = 1);
+void fft2d_inverse(float* real, float* imag, size_t rows, size_t cols, size_t num_threads = 1);
+// Real input: the rows x (cols / 2 + 1) half spectrum, the remaining
+// columns being conjugate mirrors. Two real rows share one complex row FFT
+// and the column pass only covers the half spectrum, so this is about twice
+// as fast as the complex transform.
+void fft2d_real_forward(const float* input, size_t rows, size_t cols, float* out_real, float* out_imag,
+                        size_t num_threads = 1);
+void fft2d_real_inverse(const float* in_real, const float* in_imag, size_t rows, size_t cols, float* output,
+                        size_t num_threads = 1);
+
+// Complex arithmetic
+// Elementwise on count complex values, either split into real and imaginary
+// arrays (as fft_forward uses) or interleaved (re, im) pairs. Outputs may be
+// the same arrays as inputs. The AVX2 kernels use FMA, so results can differ
+// from the scalar ones in the last bit.
+// multiply:          out = a * b
+// multiply_conj:     out = a * conj(b), the cross-spectrum for correlation
+// magnitude:         |z| = sqrt(re^2 + im^2) (overflows above ~1.8e19)
+// phase:             atan2(im, re) in [-pi, pi]; the AVX2 polynomial is
+//                    within 2 ulp + 2^-24 absolute of the libm scalar version
+// scale_accumulate:  acc += s * z for a complex scalar s
+// power_db:          10 * log10(max(re^2 + im^2, floor)) in one pass; kernels
+//                    only, behind SpectrumType::LogPower
+void complex_multiply(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                      float* out_real, float* out_imag, size_t count);
+void complex_multiply_scalar(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                             float* out_real, float* out_imag, size_t count);
+void complex_multiply_avx2(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                           float* out_real, float* out_imag, size_t count);
+
+void complex_multiply_conj(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                           float* out_real, float* out_imag, size_t count);
+void complex_multiply_conj_scalar(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                                  float* out_real, float* out_imag, size_t count);
+void complex_multiply_conj_avx2(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                                float* out_real, float* out_imag, size_t count);
+
+void complex_magnitude(const float* real, const float* imag, float* out, size_t count);
+void complex_magnitude_scalar(const float* real, const float* imag, float* out, size_t count);
+void complex_magnitude_avx2(const float* real, const float* imag, float* out, size_t count);
+
+void complex_magnitude_squared(const float* real, const float* imag, float* out, size_t count);
+void complex_magnitude_squared_scalar(const float* real, const float* imag, float* out, size_t count);
+void complex_magnitude_squared_avx2(const float* real, const float* imag, float* out, size_t count);
+
+void complex_phase(const float* real, const float* imag, float* out, size_t count);
+void complex_phase_scalar(const float* real, const float* imag, float* out, size_t count);
+void complex_phase_avx2(const float* real, const float* imag, float* out, size_t count);
+
+void complex_scale_accumulate(const float* real, const float* imag, float scale_real, float scale_imag,
+                              float* acc_real, float* acc_imag, size_t count);
+void complex_scale_accumulate_scalar(const float* real, const float* imag, float scale_real, float scale_imag,
+                                     float* acc_real, float* acc_imag, size_t count);
+void complex_scale_accumulate_avx2(const float* real, const float* imag, float scale_real, float scale_imag,
+                                   float* acc_real, float* acc_imag, size_t count);
+
+void complex_power_db_scalar(const float* real, const float* imag, float floor, float* out, size_t count);
+void complex_power_db_avx2(const float* real, const float* imag, float floor, float* out, size_t count);
+
+// Interleaved layout: a, b, out, data and acc hold 2 * count floats; the
+// magnitude and phase outputs hold count floats
+void complex_multiply_interleaved(const float* a, const float* b, float* out, size_t count);
+void complex_multiply_interleaved_scalar(const float* a, const float* b, float* out, size_t count);
+void complex_multiply_interleaved_avx2(const float* a, const float* b, float* out, size_t count);
+
+void complex_multiply_conj_interleaved(const float* a, const float* b, float* out, size_t count);
+void complex_multiply_conj_interleaved_scalar(const float* a, const float* b, float* out, size_t count);
+void complex_multiply_conj_interleaved_avx2(const float* a, const float* b, float* out, size_t count);
+
+void complex_magnitude_interleaved(const float* data, float* out, size_t count);
+void complex_magnitude_interleaved_scalar(const float* data, float* out, size_t count);
+void complex_magnitude_interleaved_avx2(const float* data, float* out, size_t count);
+
+void complex_magnitude_squared_interleaved(const float* data, float* out, size_t count);
+void complex_magnitude_squared_interleaved_scalar(const float* data, float* out, size_t count);
+void complex_magnitude_squared_interleaved_avx2(const float* data, float* out, size_t count);
+
+void complex_phase_interleaved(const float* data, float* out, size_t count);
+void complex_phase_interleaved_scalar(const float* data, float* out, size_t count);
+void complex_phase_interleaved_avx2(const float* data, float* out, size_t count);
+
+void complex_scale_accumulate_interleaved(const float* data, float scale_real, float scale_imag, float* acc,
+                                          size_t count);
+void complex_scale_accumulate_interleaved_scalar(const float* data, float scale_real, float scale_imag, float* acc,
+                                                 size_t count);
+void complex_scale_accumulate_interleaved_avx2(const float* data, float scale_real, float scale_imag, float* acc,
+                                               size_t count);
+
+// Window functions
+// Periodic (DFT-even) windows, w[i] for phase 2*pi*i/n, so frames overlapped
+// at the usual hops sum to a constant. generate_window evaluates the cosines
+// with vector_cos; get_window caches one copy per type and length.
+enum class WindowType { Rectangular, Hann, Hamming, Blackman };
+
+void generate_window(WindowType type, float* window, size_t n);
+std::shared_ptr<const std::vector<float>> get_window(WindowType type, size_t n);
+// data[i] *= window[i]
+void apply_window(float* data, const float* window, size_t n);
+void apply_window(float* data, WindowType type, size_t n);
+
+// Welch power spectral density: segments of segment_size samples (rounded up
+// to a power of 2) starting every hop samples are windowed and transformed,
+// and their power spectra averaged. psd receives welch_psd_bins(segment_size)
+// = next_power_of_2(segment_size) / 2 + 1 one-sided bins in units^2/Hz, so a
+// white signal of variance v reads 2 * v / sample_rate. Segments are split
+// across num_threads threads.
+// Returns the number of segments averaged (0 leaves psd zeroed).
+size_t welch_psd_bins(size_t segment_size);
+size_t welch_psd(const float* signal, size_t count, float* psd, size_t segment_size, size_t hop,
+                 WindowType window = WindowType::Hann, float sample_rate = 1.0f, size_t num_threads = 1);
+
+// Short-time Fourier transform
+// Frames of frame_size samples start every hop_size samples; each is
+// windowed, transformed with a cached plan and reduced to frame_size / 2 + 1
+// bins of magnitude, power, or power in dB (floored at -200 dB).
+enum class SpectrumType { Magnitude, Power, LogPower };
+
+struct STFTConfig {
+    size_t frame_size = 1024;           // rounded up to a power of 2
+    size_t hop_size = 256;
+    WindowType window = WindowType::Hann;
+    SpectrumType output = SpectrumType::Power;
+    size_t num_threads = 1;             // for process(); 0 = all cores
+};
+
+class STFT {
+public:
+    explicit STFT(const STFTConfig& config);
+
+    const STFTConfig& config() const { return config_; }
+    size_t bins() const { return config_.frame_size / 2 + 1; }
+    // Frames in a whole signal of count samples (no padding: 0 if count < frame_size)
+    size_t frame_count(size_t count) const;
+
+    // Spectrogram of a whole signal into out[frame_count(count) x bins()];
+    // frames are split across config().num_threads threads. Returns the frame count.
+    size_t process(const float* signal, size_t count, float* out) const;
+
+    // Streaming: appends samples and writes each frame completed so far, up to
+    // max_frames rows, to out. Samples not yet consumed by a frame are carried
+    // to the next call. Returns the frames written.
+    size_t push(const float* samples, size_t count, float* out, size_t max_frames);
+    // Frames the next push() of count samples would complete
+    size_t pending_frames(size_t count) const;
+    void reset();
+
+private:
+    void transform_frame(const float* samples, float* out, float* real, float* imag) const;
+
+    STFTConfig config_;
+    std::shared_ptr<const FFTPlan> plan_;
+    std::shared_ptr<const std::vector<float>> window_;
+    std::vector<float> carry_;          // samples not yet consumed by a frame
+    size_t skip_ = 0;                   // incoming samples to drop when hop_size > frame_size
+    std::vector<float> scratch_real_;
+    std::vector<float> scratch_imag_;
+};
+
+// Biquad IIR filters
+// One second-order section, normalized so a0 = 1, in transposed direct form II:
+// y = b0 x + s1;  s1 = b1 x - a1 y + s2;  s2 = b2 x - a2 y
+struct BiquadCoefficients {
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+    float a1 = 0.0f, a2 = 0.0f;
+};
+
+// Audio EQ cookbook designs; frequencies in Hz, q = 0.7071 is Butterworth
+BiquadCoefficients biquad_lowpass(double cutoff, double sample_rate, double q = 0.70710678);
+BiquadCoefficients biquad_highpass(double cutoff, double sample_rate, double q = 0.70710678);
+BiquadCoefficients biquad_peaking(double center, double sample_rate, double q, double gain_db);
+
+// State-space form of one section over 8 samples: H columns (8 x 8), the
+// responses to unit s1 and s2 (O), the state contributions of each input
+// (C, two rows) and the two columns of A^8, each padded to 4 floats
+static const size_t kBiquadBlockFloats = 13 * 8;
+
+// AcrossChannels runs 8 channels per AVX2 register with their states in
+// SoA order, so each recursion step filters 8 channels at once. AcrossTime
+// filters one channel 8 samples at a time through a precomputed state-space
+// form of each section (y = H x + O s, s' = C x + A^8 s); it suits one or
+// two channels, where channel lanes would sit idle. Auto picks AcrossTime
+// below 4 channels.
+enum class BiquadMode { Auto, AcrossChannels, AcrossTime };
+
+// A cascade of sections applied in order to each of num_channels channels.
+// Sections start as pass-through; set_section() assigns coefficients to all
+// channels or to one. State persists across process() calls until reset().
+// All buffers are allocated by the constructor, so processing never allocates.
+class BiquadCascade {
+public:
+    BiquadCascade(size_t num_channels, size_t num_sections, BiquadMode mode = BiquadMode::Auto);
+
+    size_t channels() const { return channels_; }
+    size_t sections() const { return sections_; }
+    BiquadMode mode() const { return mode_; }
+
+    void set_section(size_t section, const BiquadCoefficients& coefficients);
+    void set_section(size_t channel, size_t section, const BiquadCoefficients& coefficients);
+    BiquadCoefficients section(size_t channel, size_t section) const;
+
+    // Interleaved frames: sample t of channel c at [t * channels() + c].
+    // input may equal output.
+    void process(const float* input, float* output, size_t frames);
+    // Planar: one array of frames samples per channel; input[c] may equal output[c]
+    void process_planar(const float* const* input, float* const* output, size_t frames);
+    void reset();
+
+private:
+    void update_blocks(size_t channel, size_t section);
+    void run_channels(float* data, size_t frames, size_t stride);
+    void run_time(float* data, size_t frames, size_t channel);
+
+    size_t channels_;
+    size_t sections_;
+    size_t groups_;                     // AcrossChannels: channel groups of 8
+    BiquadMode mode_;
+    std::vector<float> coefficients_;   // AcrossChannels [section][group][b0 b1 b2 a1 a2][8]; else [channel][section][5]
+    std::vector<float> blocks_;         // AcrossTime [channel][section][kBiquadBlockFloats]
+    std::vector<float> state_;          // AcrossChannels [section][group][s1 s2][8]; else [channel][section][2]
+    std::vector<float> scratch_;
+};
+
+// Kernels behind BiquadCascade. Channel kernels filter frame-major data of
+// stride floats per frame in place, groups * 8 channels wide. Time kernels
+// filter count contiguous samples of one channel in place.
+void biquad_channels_scalar(float* data, size_t frames, size_t stride, size_t groups, size_t sections,
+                            const float* coefficients, float* state);
+void biquad_channels_avx2(float* data, size_t frames, size_t stride, size_t groups, size_t sections,
+                          const float* coefficients, float* state);
+void biquad_time_scalar(float* data, size_t count, size_t sections, const float* coefficients,
+                        const float* blocks, float* state);
+void biquad_time_avx2(float* data, size_t count, size_t sections, const float* coefficients,
+                      const float* blocks, float* state);
+
+// Sample-rate conversion
+// Polyphase bank of a Kaiser-windowed sinc for conversion by interpolation / decimation
+// (the rate ratio reduced by its gcd). Branch p holds taps coefficients in
+// reverse order, so output sample n is a dot product with taps consecutive inputs.
+// The cutoff sits below the lower of the two Nyquist rates with about 90 dB of
+// stopband rejection. Banks are cached and shared by resamplers of equal ratio.
+struct PolyphaseBank {
+    size_t interpolation = 1;
+    size_t decimation = 1;
+    size_t taps = 0;                    // per branch, a multiple of 8
+    std::vector<float> coefficients;    // [interpolation][taps]
+};
+
+std::shared_ptr<const PolyphaseBank> get_polyphase_bank(size_t interpolation, size_t decimation,
+                                                         size_t taps_per_phase);
+
+// Streaming rational resampler, e.g. 44100 -> 48000 (160 / 147) or integer
+// decimation and interpolation (48000 -> 16000 is 1 / 3). taps_per_phase sets
+// quality: it is the filter length in samples of the lower rate. Each call
+// consumes all input frames and writes output_frames(frames) output frames;
+// the filter history carries over to the next call.
+// Output frame n corresponds to input time n * decimation / interpolation - delay().
+class Resampler {
+public:
+    Resampler(size_t num_channels, size_t input_rate, size_t output_rate, size_t taps_per_phase = 64);
+
+    size_t channels() const { return channels_; }
+    size_t interpolation() const { return bank_->interpolation; }
+    size_t decimation() const { return bank_->decimation; }
+    // Group delay of the filter, in input samples
+    double delay() const;
+    // Number of frames the next process() call writes for input_frames input frames
+    size_t output_frames(size_t input_frames) const;
+
+    // Interleaved frames in and out
+    size_t process(const float* input, size_t frames, float* output);
+    // One array per channel
+    size_t process_planar(const float* const* input, size_t frames, float* const* output);
+    void reset();
+
+private:
+    size_t run(const float* const* input, size_t input_stride, size_t frames, float* const* output,
+               size_t output_stride);
+
+    size_t channels_;
+    std::shared_ptr<const PolyphaseBank> bank_;
+    size_t position_ = 0;               // next output, in 1 / interpolation input samples from buffer start
+    std::vector<float> buffers_;        // [channel][taps - 1 history + chunk]
+    std::vector<const float*> inputs_;
+    std::vector<float*> outputs_;
+};
+
+// Resampling kernels over a bank of phases branches of taps coefficients:
+// write output samples while the branch window fits in input[0, length),
+// starting at *position and advancing it by step per output (both in units of
+// 1 / phases input samples); return the number written, output_stride floats apart.
+size_t resample_polyphase_scalar(const float* input, size_t length, const float* bank, size_t taps, size_t phases,
+                                 size_t step, size_t* position, float* output, size_t output_stride);
+size_t resample_polyphase_avx2(const float* input, size_t length, const float* bank, size_t taps, size_t phases,
+                               size_t step, size_t* position, float* output, size_t output_stride);
+
 // Utility functions
 void print_cpu_features();
 const char* get_simd_version();
 
+// Auto-tuning
+// Machine-dependent thresholds used by the dispatchers. Defaults suit a
+// typical desktop core; autotune() micro-benchmarks the candidates on this
+// machine (a few hundred ms), applies the winners and caches them on disk
+// keyed by CPU model. The cache is loaded on first use. Set
+// SIMD_LIB_AUTOTUNE=1 to autotune on first use when there is no cache, and
+// SIMD_LIB_TUNING_CACHE to override the cache file path.
+struct TuningConfig {
+    // vector_add/multiply/subtract/scale outputs of at least this many bytes
+    // use non-temporal stores (SIZE_MAX: never)
+    size_t streaming_store_bytes;
+    // Minimum elements per thread for threaded reductions and prefix sums
+    size_t reduce_min_block;
+    size_t scan_min_block;
+    // Minimum matrix floats per thread for batched similarity and top-k, and
+    // minimum nonzeros per thread for spmv
+    size_t batch_min_floats;
+    // Rows scored per block by top_k_search
+    size_t top_k_block_rows;
+};
+
+TuningConfig default_tuning();
+TuningConfig get_tuning();
+void set_tuning(const TuningConfig& config);
+TuningConfig autotune(bool save_cache = true);
+// Loads the cache for this CPU model; false if missing, stale or malformed
+bool load_tuning_cache();
+bool save_tuning_cache();
+std::string tuning_cache_path();
+
+// Runtime telemetry
+// Opt-in statistics for the dispatching entry points: call count, total wall
+// time, which ISA path ran, and a log2 histogram of the problem size
+// (elements; rows * dim for batched kernels). Disabled by default, when a
+// call costs one relaxed atomic load. When enabled, calls are counted in
+// per-thread blocks without locks and summed when queried. Only the
+// outermost entry point is recorded, so library functions calling each
+// other are not double counted.
+enum class DispatchIsa : uint8_t { Scalar, SSE4, AVX2, AVXVNNI, Count };
+
+// Bucket 0 holds size 0, bucket b holds [2^(b-1), 2^b); the last bucket also
+// holds everything larger
+static const size_t kTelemetrySizeBuckets = 32;
+
+struct KernelStats {
+    const char* function;
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t isa_calls[(size_t)DispatchIsa::Count];
+    uint64_t size_histogram[kTelemetrySizeBuckets];
+};
+
+void set_telemetry_enabled(bool enabled);
+bool telemetry_enabled();
+// Copies stats for functions called since the last reset; returns how many there are
+size_t telemetry_snapshot(KernelStats* stats, size_t max_stats);
+// Stats for one function by name, e.g. "dot_product"; false if unknown
+bool telemetry_function_stats(const char* function, KernelStats* stats);
+void telemetry_reset();
+const char* dispatch_isa_name(DispatchIsa isa);
+std::string telemetry_json();
+
+// Hardware performance counters
+// Built only with -DSIMD_LIB_PERF_COUNTERS=ON (Linux, perf_event_open).
+// Otherwise SIMD_PERF_SCOPE expands to nothing and none of this is declared.
+#ifdef SIMD_LIB_PERF_COUNTERS
+
+enum PerfEvent : uint32_t {
+    kPerfCycles = 1u << 0,
+    kPerfInstructions = 1u << 1,
+    kPerfL1dMisses = 1u << 2,     // L1 data cache read misses
+    kPerfLlcMisses = 1u << 3,     // last-level cache misses
+    kPerfBranchMisses = 1u << 4
+};
+
+struct PerfSample {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t l1d_misses = 0;
+    uint64_t llc_misses = 0;
+    uint64_t branch_misses = 0;
+    uint32_t available = 0;       // PerfEvent bits that were counted
+
+    double ipc() const { return cycles ? (double)instructions / (double)cycles : 0.0; }
+    // Misses per thousand instructions
+    double l1d_mpki() const { return instructions ? 1000.0 * (double)l1d_misses / (double)instructions : 0.0; }
+    double llc_mpki() const { return instructions ? 1000.0 * (double)llc_misses / (double)instructions : 0.0; }
+    double branch_mpki() const { return instructions ? 1000.0 * (double)branch_misses / (double)instructions : 0.0; }
+};
+
+// Counts since construction for the calling thread, user space only. Events
+// the kernel or PMU refuses (VMs, perf_event_paranoid) are left out of
+// available(); values are scaled when the kernel multiplexes counters.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    uint32_t available() const { return available_; }
+    PerfSample read() const;
+
+private:
+    int fds_[5];
+    uint32_t available_ = 0;
+};
+
+// Counter difference end - begin
+PerfSample perf_delta(const PerfSample& begin, const PerfSample& end);
+
+// Per-region totals, accumulated by SIMD_PERF_SCOPE or perf_record
+struct PerfRegion {
+    const char* name;
+    uint64_t calls;
+    PerfSample total;
+};
+
+void perf_record(const char* name, const PerfSample& sample, uint64_t calls = 1);
+// Copies up to max_regions regions in first-recorded order; returns how many exist
+size_t perf_regions(PerfRegion* regions, size_t max_regions);
+void perf_reset();
+// Prints calls, cycles per call, IPC and L1/LLC/branch MPKI per region
+void perf_report();
+
+// Records the counters between construction and destruction under name,
+// which must be a string literal or otherwise outlive the report
+class PerfScope {
+public:
+    explicit PerfScope(const char* name);
+    ~PerfScope();
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    const char* name_;
+    PerfSample begin_;
+};
+
+#define SIMD_PERF_CONCAT_INNER(a, b) a##b
+#define SIMD_PERF_CONCAT(a, b) SIMD_PERF_CONCAT_INNER(a, b)
+#define SIMD_PERF_SCOPE(name) ::simd_lib::PerfScope SIMD_PERF_CONCAT(simd_perf_scope_, __LINE__)(name)
+
+#else
+
+#define SIMD_PERF_SCOPE(name)
+
+#endif // SIMD_LIB_PERF_COUNTERS
+
 } // namespace simd_lib
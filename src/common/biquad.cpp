@@ -0,0 +1,271 @@
+#include "simd_lib.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace simd_lib {
+
+// Frames per pass through all sections: the block stays in L1 while every
+// section runs over it, up to 64 channels
+static const size_t kBiquadBlockFrames = 128;
+
+// Below this many channels most of the 8 lanes would be padding
+static const size_t kMinChannelsAcross = 4;
+
+static BiquadCoefficients normalized(double b0, double b1, double b2, double a0, double a1, double a2) {
+    BiquadCoefficients c;
+    c.b0 = (float)(b0 / a0);
+    c.b1 = (float)(b1 / a0);
+    c.b2 = (float)(b2 / a0);
+    c.a1 = (float)(a1 / a0);
+    c.a2 = (float)(a2 / a0);
+    return c;
+}
+
+BiquadCoefficients biquad_lowpass(double cutoff, double sample_rate, double q) {
+    double w = 2.0 * M_PI * cutoff / sample_rate;
+    double alpha = std::sin(w) / (2.0 * q);
+    double cw = std::cos(w);
+    return normalized((1.0 - cw) / 2.0, 1.0 - cw, (1.0 - cw) / 2.0, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+}
+
+BiquadCoefficients biquad_highpass(double cutoff, double sample_rate, double q) {
+    double w = 2.0 * M_PI * cutoff / sample_rate;
+    double alpha = std::sin(w) / (2.0 * q);
+    double cw = std::cos(w);
+    return normalized((1.0 + cw) / 2.0, -(1.0 + cw), (1.0 + cw) / 2.0, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+}
+
+BiquadCoefficients biquad_peaking(double center, double sample_rate, double q, double gain_db) {
+    double a = std::pow(10.0, gain_db / 40.0);
+    double w = 2.0 * M_PI * center / sample_rate;
+    double alpha = std::sin(w) / (2.0 * q);
+    double cw = std::cos(w);
+    return normalized(1.0 + alpha * a, -2.0 * cw, 1.0 - alpha * a, 1.0 + alpha / a, -2.0 * cw, 1.0 - alpha / a);
+}
+
+BiquadCascade::BiquadCascade(size_t num_channels, size_t num_sections, BiquadMode mode)
+    : channels_(num_channels), sections_(num_sections), groups_((num_channels + 7) / 8), mode_(mode) {
+    if (mode_ == BiquadMode::Auto) {
+        mode_ = channels_ < kMinChannelsAcross ? BiquadMode::AcrossTime : BiquadMode::AcrossChannels;
+    }
+
+    if (mode_ == BiquadMode::AcrossChannels) {
+        coefficients_.assign(sections_ * groups_ * 40, 0.0f);
+        state_.assign(sections_ * groups_ * 16, 0.0f);
+        scratch_.assign(kBiquadBlockFrames * groups_ * 8, 0.0f);
+    } else {
+        coefficients_.assign(channels_ * sections_ * 5, 0.0f);
+        blocks_.assign(channels_ * sections_ * kBiquadBlockFloats, 0.0f);
+        state_.assign(channels_ * sections_ * 2, 0.0f);
+        scratch_.assign(kBiquadBlockFrames, 0.0f);
+    }
+
+    // Pass-through, including the padding lanes of the last channel group
+    size_t slots = mode_ == BiquadMode::AcrossChannels ? groups_ * 8 : channels_;
+    for (size_t c = 0; c < slots; ++c) {
+        for (size_t s = 0; s < sections_; ++s) {
+            set_section(c, s, BiquadCoefficients());
+        }
+    }
+}
+
+void BiquadCascade::set_section(size_t section, const BiquadCoefficients& coefficients) {
+    for (size_t c = 0; c < channels_; ++c) {
+        set_section(c, section, coefficients);
+    }
+}
+
+void BiquadCascade::set_section(size_t channel, size_t section, const BiquadCoefficients& coefficients) {
+    if (section >= sections_) {
+        return;
+    }
+    const float values[5] = {coefficients.b0, coefficients.b1, coefficients.b2, coefficients.a1, coefficients.a2};
+    if (mode_ == BiquadMode::AcrossChannels) {
+        if (channel >= groups_ * 8) {
+            return;
+        }
+        float* c = &coefficients_[(section * groups_ + channel / 8) * 40 + channel % 8];
+        for (size_t k = 0; k < 5; ++k) {
+            c[k * 8] = values[k];
+        }
+    } else {
+        if (channel >= channels_) {
+            return;
+        }
+        std::copy(values, values + 5, &coefficients_[(channel * sections_ + section) * 5]);
+        update_blocks(channel, section);
+    }
+}
+
+BiquadCoefficients BiquadCascade::section(size_t channel, size_t section) const {
+    BiquadCoefficients result;
+    if (channel >= channels_ || section >= sections_) {
+        return result;
+    }
+    float values[5];
+    for (size_t k = 0; k < 5; ++k) {
+        values[k] = mode_ == BiquadMode::AcrossChannels
+                        ? coefficients_[(section * groups_ + channel / 8) * 40 + k * 8 + channel % 8]
+                        : coefficients_[(channel * sections_ + section) * 5 + k];
+    }
+    result.b0 = values[0];
+    result.b1 = values[1];
+    result.b2 = values[2];
+    result.a1 = values[3];
+    result.a2 = values[4];
+    return result;
+}
+
+// Builds the 8-sample state-space matrices of one section by running the
+// recursion in double on unit inputs and unit states
+void BiquadCascade::update_blocks(size_t channel, size_t section) {
+    const float* c = &coefficients_[(channel * sections_ + section) * 5];
+    const double b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+    float* m = &blocks_[(channel * sections_ + section) * kBiquadBlockFloats];
+
+    // Runs 8 samples from state (s1, s2); writes y and the final state
+    auto run = [&](const double* x, double s1, double s2, double* y, double* final_state) {
+        for (size_t n = 0; n < 8; ++n) {
+            y[n] = b0 * x[n] + s1;
+            s1 = b1 * x[n] - a1 * y[n] + s2;
+            s2 = b2 * x[n] - a2 * y[n];
+        }
+        final_state[0] = s1;
+        final_state[1] = s2;
+    };
+
+    double y[8], final_state[2];
+    for (size_t k = 0; k < 8; ++k) {
+        double x[8] = {};
+        x[k] = 1.0;
+        run(x, 0.0, 0.0, y, final_state);
+        for (size_t n = 0; n < 8; ++n) {
+            m[k * 8 + n] = (float)y[n];     // H column k
+        }
+        m[80 + k] = (float)final_state[0];  // C row 0
+        m[88 + k] = (float)final_state[1];  // C row 1
+    }
+
+    const double zeros[8] = {};
+    for (size_t j = 0; j < 2; ++j) {
+        run(zeros, j == 0 ? 1.0 : 0.0, j == 1 ? 1.0 : 0.0, y, final_state);
+        for (size_t n = 0; n < 8; ++n) {
+            m[64 + j * 8 + n] = (float)y[n];  // O column j
+        }
+        m[96 + j * 4] = (float)final_state[0];  // A^8 column j
+        m[96 + j * 4 + 1] = (float)final_state[1];
+        m[96 + j * 4 + 2] = 0.0f;
+        m[96 + j * 4 + 3] = 0.0f;
+    }
+}
+
+void BiquadCascade::run_channels(float* data, size_t frames, size_t stride) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 && features.has_fma ? biquad_channels_avx2 : biquad_channels_scalar;
+    kernel(data, frames, stride, groups_, sections_, coefficients_.data(), state_.data());
+}
+
+void BiquadCascade::run_time(float* data, size_t frames, size_t channel) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 && features.has_fma ? biquad_time_avx2 : biquad_time_scalar;
+    kernel(data, frames, sections_, &coefficients_[channel * sections_ * 5],
+           &blocks_[channel * sections_ * kBiquadBlockFloats], &state_[channel * sections_ * 2]);
+}
+
+void BiquadCascade::process(const float* input, float* output, size_t frames) {
+    if (frames == 0 || channels_ == 0) {
+        return;
+    }
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::biquad_cascade, frames * channels_);
+    telemetry.isa(features.has_avx2 && features.has_fma ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    // Whole channel groups, or a single channel, are filtered in the output itself
+    bool direct = mode_ == BiquadMode::AcrossChannels ? channels_ % 8 == 0 : channels_ == 1;
+    if (direct && input != output) {
+        std::copy(input, input + frames * channels_, output);
+    }
+
+    for (size_t t = 0; t < frames; t += kBiquadBlockFrames) {
+        size_t n = std::min(kBiquadBlockFrames, frames - t);
+        const float* in = &input[t * channels_];
+        float* out = &output[t * channels_];
+
+        if (mode_ == BiquadMode::AcrossChannels) {
+            if (direct) {
+                run_channels(out, n, channels_);
+                continue;
+            }
+            // Padding lanes stay zero: pass-through sections on zero input
+            const size_t stride = groups_ * 8;
+            for (size_t f = 0; f < n; ++f) {
+                std::copy(&in[f * channels_], &in[(f + 1) * channels_], &scratch_[f * stride]);
+            }
+            run_channels(scratch_.data(), n, stride);
+            for (size_t f = 0; f < n; ++f) {
+                std::copy(&scratch_[f * stride], &scratch_[f * stride + channels_], &out[f * channels_]);
+            }
+        } else if (direct) {
+            run_time(out, n, 0);
+        } else {
+            for (size_t c = 0; c < channels_; ++c) {
+                for (size_t f = 0; f < n; ++f) {
+                    scratch_[f] = in[f * channels_ + c];
+                }
+                run_time(scratch_.data(), n, c);
+                for (size_t f = 0; f < n; ++f) {
+                    out[f * channels_ + c] = scratch_[f];
+                }
+            }
+        }
+    }
+}
+
+void BiquadCascade::process_planar(const float* const* input, float* const* output, size_t frames) {
+    if (frames == 0 || channels_ == 0) {
+        return;
+    }
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::biquad_cascade, frames * channels_);
+    telemetry.isa(features.has_avx2 && features.has_fma ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    if (mode_ == BiquadMode::AcrossTime) {
+        // Each channel is already contiguous
+        for (size_t c = 0; c < channels_; ++c) {
+            if (input[c] != output[c]) {
+                std::copy(input[c], input[c] + frames, output[c]);
+            }
+            for (size_t t = 0; t < frames; t += kBiquadBlockFrames) {
+                run_time(&output[c][t], std::min(kBiquadBlockFrames, frames - t), c);
+            }
+        }
+        return;
+    }
+
+    const size_t stride = groups_ * 8;
+    for (size_t t = 0; t < frames; t += kBiquadBlockFrames) {
+        size_t n = std::min(kBiquadBlockFrames, frames - t);
+        for (size_t c = 0; c < channels_; ++c) {
+            for (size_t f = 0; f < n; ++f) {
+                scratch_[f * stride + c] = input[c][t + f];
+            }
+        }
+        run_channels(scratch_.data(), n, stride);
+        for (size_t c = 0; c < channels_; ++c) {
+            for (size_t f = 0; f < n; ++f) {
+                output[c][t + f] = scratch_[f * stride + c];
+            }
+        }
+    }
+}
+
+void BiquadCascade::reset() {
+    std::fill(state_.begin(), state_.end(), 0.0f);
+}
+
+} // namespace simd_lib
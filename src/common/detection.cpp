@@ -1,4 +1,5 @@
 #include "simd_lib.h"
+#include <cstring>
 #include <iostream>
 
 #ifdef _MSC_VER
@@ -12,25 +13,65 @@ namespace simd_lib {
 static CPUFeatures g_cpu_features;
 static bool g_features_initialized = false;
 
+#ifdef PLATFORM_X86
+// Runs CPUID for leaf/subleaf; regs receives eax, ebx, ecx, edx
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = (uint32_t)info[i];
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// XCR0 lists the register states the OS saves on a context switch. Executed
+// only after CPUID reports OSXSAVE, and kept as inline asm so this file needs
+// no -mxsave and stays baseline x86-64.
+static uint64_t read_xcr0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+#endif
+
 void init_cpu_features() {
     if (g_features_initialized) {
         return;
     }
 
 #ifdef PLATFORM_X86
-    // Get CPUID information
-    uint32_t eax, ebx, ecx, edx;
-    
-    // Check for SSE4.1 and SSE4.2
-    __cpuid(1, eax, ebx, ecx, edx);
+    uint32_t regs[4];
+    cpuid(0, 0, regs);
+    uint32_t max_leaf = regs[0];
+
+    // Check for SSE4.1, SSE4.2, AVX and FMA (leaf 1, ECX)
+    cpuid(1, 0, regs);
+    uint32_t ecx = regs[2];
     g_cpu_features.has_sse4_1 = (ecx & (1 << 19)) != 0;
     g_cpu_features.has_sse4_2 = (ecx & (1 << 20)) != 0;
-    g_cpu_features.has_avx = (ecx & (1 << 28)) != 0;
-    
-    // Check for AVX2 and FMA
-    __cpuid_count(7, 0, eax, ebx, ecx, edx);
-    g_cpu_features.has_avx2 = (ebx & (1 << 5)) != 0;
-    g_cpu_features.has_fma = (ecx & (1 << 12)) != 0;
+
+    // AVX is only usable when the OS saves the YMM state (XCR0 bits 1 and 2);
+    // everything VEX-encoded below depends on it
+    bool os_saves_ymm = (ecx & (1 << 27)) != 0 && (read_xcr0() & 0x6) == 0x6;
+    g_cpu_features.has_avx = os_saves_ymm && (ecx & (1 << 28)) != 0;
+    g_cpu_features.has_fma = g_cpu_features.has_avx && (ecx & (1 << 12)) != 0;
+
+    if (max_leaf >= 7) {
+        // Check for AVX2 (leaf 7, sub-leaf 0, EBX)
+        cpuid(7, 0, regs);
+        g_cpu_features.has_avx2 = g_cpu_features.has_avx && (regs[1] & (1 << 5)) != 0;
+
+        // Check for AVX-VNNI (leaf 7, sub-leaf 1, EAX)
+        cpuid(7, 1, regs);
+        g_cpu_features.has_avx_vnni = g_cpu_features.has_avx2 && (regs[0] & (1 << 4)) != 0;
+    }
 #else
     // For non-x86 platforms, set all to false for now
     g_cpu_features.has_sse4_1 = false;
@@ -38,6 +79,7 @@ void init_cpu_features() {
     g_cpu_features.has_avx = false;
     g_cpu_features.has_avx2 = false;
     g_cpu_features.has_fma = false;
+    g_cpu_features.has_avx_vnni = false;
 #endif
 
     g_features_initialized = true;
@@ -50,6 +92,28 @@ const CPUFeatures& get_cpu_features() {
     return g_cpu_features;
 }
 
+std::string get_cpu_model() {
+#ifdef PLATFORM_X86
+    uint32_t regs[4];
+    cpuid(0x80000000, 0, regs);
+    if (regs[0] >= 0x80000004) {
+        // Leaves 0x80000002-4 each return 16 bytes of the brand string
+        char brand[49] = {};
+        for (uint32_t leaf = 0; leaf < 3; ++leaf) {
+            cpuid(0x80000002 + leaf, 0, regs);
+            std::memcpy(&brand[leaf * 16], regs, sizeof(regs));
+        }
+        std::string model(brand);
+        size_t first = model.find_first_not_of(' ');
+        size_t last = model.find_last_not_of(' ');
+        if (first != std::string::npos) {
+            return model.substr(first, last - first + 1);
+        }
+    }
+#endif
+    return "unknown";
+}
+
 void print_cpu_features() {
     const auto& features = get_cpu_features();
     
@@ -59,6 +123,7 @@ void print_cpu_features() {
     std::cout << "  AVX:    " << (features.has_avx ? "Yes" : "No") << "\n";
     std::cout << "  AVX2:   " << (features.has_avx2 ? "Yes" : "No") << "\n";
     std::cout << "  FMA:    " << (features.has_fma ? "Yes" : "No") << "\n";
+    std::cout << "  AVX-VNNI: " << (features.has_avx_vnni ? "Yes" : "No") << "\n";
 }
 
 const char* get_simd_version() {
@@ -1,87 +1,874 @@
 #include "simd_lib.h"
+#include "telemetry.h"
+#include "tuning.h"
+#include <limits>
 
 namespace simd_lib {
 
 void vector_add(const float* a, const float* b, float* result, size_t count) {
     const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_add, count);
     
     if (features.has_avx2) {
-        vector_add_avx2(a, b, result, count);
+        telemetry.isa(DispatchIsa::AVX2);
+        if (count * sizeof(float) >= tuned(TuningParam::StreamingStoreBytes)) {
+            vector_add_avx2_stream(a, b, result, count);
+        } else {
+            vector_add_avx2(a, b, result, count);
+        }
     } else if (features.has_sse4_1) {
+        telemetry.isa(DispatchIsa::SSE4);
         vector_add_sse4(a, b, result, count);
     } else {
+        telemetry.isa(DispatchIsa::Scalar);
         vector_add_scalar(a, b, result, count);
     }
 }
 
 void vector_multiply(const float* a, const float* b, float* result, size_t count) {
     const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_multiply, count);
     
     if (features.has_avx2) {
-        vector_multiply_avx2(a, b, result, count);
+        telemetry.isa(DispatchIsa::AVX2);
+        if (count * sizeof(float) >= tuned(TuningParam::StreamingStoreBytes)) {
+            vector_multiply_avx2_stream(a, b, result, count);
+        } else {
+            vector_multiply_avx2(a, b, result, count);
+        }
     } else {
+        telemetry.isa(DispatchIsa::Scalar);
         vector_multiply_scalar(a, b, result, count);
     }
 }
 
 float dot_product(const float* a, const float* b, size_t count) {
     const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::dot_product, count);
     
-    if (features.has_avx2) {
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
         return dot_product_avx2(a, b, count);
     } else {
+        telemetry.isa(DispatchIsa::Scalar);
         return dot_product_scalar(a, b, count);
     }
 }
 
 void vector_subtract(const float* a, const float* b, float* result, size_t count) {
     const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_subtract, count);
     
     if (features.has_avx2) {
-        vector_subtract_avx2(a, b, result, count);
+        telemetry.isa(DispatchIsa::AVX2);
+        if (count * sizeof(float) >= tuned(TuningParam::StreamingStoreBytes)) {
+            vector_subtract_avx2_stream(a, b, result, count);
+        } else {
+            vector_subtract_avx2(a, b, result, count);
+        }
     } else {
+        telemetry.isa(DispatchIsa::Scalar);
         vector_subtract_scalar(a, b, result, count);
     }
 }
 
 void vector_scale(const float* a, float scale, float* result, size_t count) {
     const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_scale, count);
     
     if (features.has_avx2) {
-        vector_scale_avx2(a, scale, result, count);
+        telemetry.isa(DispatchIsa::AVX2);
+        if (count * sizeof(float) >= tuned(TuningParam::StreamingStoreBytes)) {
+            vector_scale_avx2_stream(a, scale, result, count);
+        } else {
+            vector_scale_avx2(a, scale, result, count);
+        }
     } else {
+        telemetry.isa(DispatchIsa::Scalar);
         vector_scale_scalar(a, scale, result, count);
     }
 }
 
 float vector_norm(const float* a, size_t count) {
     const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_norm, count);
     
-    if (features.has_avx2) {
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
         return vector_norm_avx2(a, count);
     } else {
+        telemetry.isa(DispatchIsa::Scalar);
         return vector_norm_scalar(a, count);
     }
 }
 
 float vector_norm_squared(const float* a, size_t count) {
     const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_norm_squared, count);
     
-    if (features.has_avx2) {
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
         return vector_norm_squared_avx2(a, count);
     } else {
+        telemetry.isa(DispatchIsa::Scalar);
         return vector_norm_squared_scalar(a, count);
     }
 }
 
 void vector_normalize(const float* a, float* result, size_t count) {
     const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_normalize, count);
     
-    if (features.has_avx2) {
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
         vector_normalize_avx2(a, result, count);
     } else {
+        telemetry.isa(DispatchIsa::Scalar);
         vector_normalize_scalar(a, result, count);
     }
 }
 
+void vector_exp(const float* input, float* result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_exp, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        vector_exp_avx2(input, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        vector_exp_scalar(input, result, count);
+    }
+}
+
+void vector_log(const float* input, float* result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_log, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        vector_log_avx2(input, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        vector_log_scalar(input, result, count);
+    }
+}
+
+void vector_sin(const float* input, float* result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_sin, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        vector_sin_avx2(input, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        vector_sin_scalar(input, result, count);
+    }
+}
+
+void vector_cos(const float* input, float* result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_cos, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        vector_cos_avx2(input, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        vector_cos_scalar(input, result, count);
+    }
+}
+
+void vector_sincos(const float* input, float* sin_result, float* cos_result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_sincos, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        vector_sincos_avx2(input, sin_result, cos_result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        vector_sincos_scalar(input, sin_result, cos_result, count);
+    }
+}
+
+void vector_tanh(const float* input, float* result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_tanh, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        vector_tanh_avx2(input, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        vector_tanh_scalar(input, result, count);
+    }
+}
+
+void vector_sigmoid(const float* input, float* result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_sigmoid, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        vector_sigmoid_avx2(input, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        vector_sigmoid_scalar(input, result, count);
+    }
+}
+
+void vector_rsqrt(const float* input, float* result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::vector_rsqrt, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        vector_rsqrt_avx2(input, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        vector_rsqrt_scalar(input, result, count);
+    }
+}
+
+void quantize_s8(const float* input, int8_t* output, size_t count, const QuantizationParams& params) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quantize_s8, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        quantize_s8_avx2(input, output, count, params);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        quantize_s8_scalar(input, output, count, params);
+    }
+}
+
+void quantize_u8(const float* input, uint8_t* output, size_t count, const QuantizationParams& params) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quantize_u8, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        quantize_u8_avx2(input, output, count, params);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        quantize_u8_scalar(input, output, count, params);
+    }
+}
+
+int32_t sum_s8(const int8_t* a, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::sum_s8, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return sum_s8_avx2(a, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return sum_s8_scalar(a, count);
+    }
+}
+
+int32_t sum_u8(const uint8_t* a, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::sum_u8, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return sum_u8_avx2(a, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return sum_u8_scalar(a, count);
+    }
+}
+
+int32_t dot_product_s8(const int8_t* a, const int8_t* b, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::dot_product_s8, count);
+    
+    if (features.has_avx_vnni) {
+        telemetry.isa(DispatchIsa::AVXVNNI);
+        return dot_product_s8_avxvnni(a, b, count);
+    } else if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return dot_product_s8_avx2(a, b, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return dot_product_s8_scalar(a, b, count);
+    }
+}
+
+int32_t dot_product_u8s8(const uint8_t* a, const int8_t* b, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::dot_product_u8s8, count);
+    
+    if (features.has_avx_vnni) {
+        telemetry.isa(DispatchIsa::AVXVNNI);
+        return dot_product_u8s8_avxvnni(a, b, count);
+    } else if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return dot_product_u8s8_avx2(a, b, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return dot_product_u8s8_scalar(a, b, count);
+    }
+}
+
+int32_t l2_distance_squared_s8(const int8_t* a, const int8_t* b, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::l2_distance_squared_s8, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return l2_distance_squared_s8_avx2(a, b, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return l2_distance_squared_s8_scalar(a, b, count);
+    }
+}
+
+void batch_dot_product_s8(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::batch_dot_product_s8, rows * dim);
+    
+    if (features.has_avx_vnni) {
+        telemetry.isa(DispatchIsa::AVXVNNI);
+        batch_dot_product_s8_avxvnni(query, database, rows, dim, out);
+    } else if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        batch_dot_product_s8_avx2(query, database, rows, dim, out);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        batch_dot_product_s8_scalar(query, database, rows, dim, out);
+    }
+}
+
+void batch_dot_product_u8s8(const uint8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::batch_dot_product_u8s8, rows * dim);
+    
+    if (features.has_avx_vnni) {
+        telemetry.isa(DispatchIsa::AVXVNNI);
+        batch_dot_product_u8s8_avxvnni(query, database, rows, dim, out);
+    } else if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        batch_dot_product_u8s8_avx2(query, database, rows, dim, out);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        batch_dot_product_u8s8_scalar(query, database, rows, dim, out);
+    }
+}
+
+void batch_l2_distance_squared_s8(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::batch_l2_distance_squared_s8, rows * dim);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        batch_l2_distance_squared_s8_avx2(query, database, rows, dim, out);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        batch_l2_distance_squared_s8_scalar(query, database, rows, dim, out);
+    }
+}
+
+void deinterleave2(const float* src, float* a, float* b, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::deinterleave2, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        deinterleave2_avx2(src, a, b, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        deinterleave2_scalar(src, a, b, count);
+    }
+}
+
+void deinterleave3(const float* src, float* a, float* b, float* c, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::deinterleave3, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        deinterleave3_avx2(src, a, b, c, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        deinterleave3_scalar(src, a, b, c, count);
+    }
+}
+
+void deinterleave4(const float* src, float* a, float* b, float* c, float* d, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::deinterleave4, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        deinterleave4_avx2(src, a, b, c, d, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        deinterleave4_scalar(src, a, b, c, d, count);
+    }
+}
+
+void interleave2(const float* a, const float* b, float* dst, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::interleave2, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        interleave2_avx2(a, b, dst, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        interleave2_scalar(a, b, dst, count);
+    }
+}
+
+void interleave3(const float* a, const float* b, const float* c, float* dst, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::interleave3, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        interleave3_avx2(a, b, c, dst, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        interleave3_scalar(a, b, c, dst, count);
+    }
+}
+
+void interleave4(const float* a, const float* b, const float* c, const float* d, float* dst, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::interleave4, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        interleave4_avx2(a, b, c, d, dst, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        interleave4_scalar(a, b, c, d, dst, count);
+    }
+}
+
+void matrix_multiply_4x4(const float* a, const float* b, float* result) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::matrix_multiply_4x4, 16);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        matrix_multiply_4x4_avx2(a, b, result);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        matrix_multiply_4x4_scalar(a, b, result);
+    }
+}
+
+void matrix_multiply_3x3(const float* a, const float* b, float* result) {
+    // Three-element rows do not fill a vector register; the scalar kernel wins
+    TelemetryScope telemetry(TelemetryFunction::matrix_multiply_3x3, 9);
+    telemetry.isa(DispatchIsa::Scalar);
+    matrix_multiply_3x3_scalar(a, b, result);
+}
+
+void matrix_vector_multiply_4x4(const float* matrix, const float* vector, float* result) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::matrix_vector_multiply_4x4, 16);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        matrix_vector_multiply_4x4_avx2(matrix, vector, result);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        matrix_vector_multiply_4x4_scalar(matrix, vector, result);
+    }
+}
+
+void matrix_vector_multiply_3x3(const float* matrix, const float* vector, float* result) {
+    TelemetryScope telemetry(TelemetryFunction::matrix_vector_multiply_3x3, 9);
+    telemetry.isa(DispatchIsa::Scalar);
+    matrix_vector_multiply_3x3_scalar(matrix, vector, result);
+}
+
+void quaternion_multiply(ConstQuaternionArrays a, ConstQuaternionArrays b, QuaternionArrays result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quaternion_multiply, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        quaternion_multiply_avx2(a, b, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        quaternion_multiply_scalar(a, b, result, count);
+    }
+}
+
+void quaternion_rotate(ConstQuaternionArrays q, ConstVec3Arrays v, Vec3Arrays result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quaternion_rotate, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        quaternion_rotate_avx2(q, v, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        quaternion_rotate_scalar(q, v, result, count);
+    }
+}
+
+void quaternion_to_matrix3(ConstQuaternionArrays q, float* matrices, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quaternion_to_matrix3, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        quaternion_to_matrix3_avx2(q, matrices, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        quaternion_to_matrix3_scalar(q, matrices, count);
+    }
+}
+
+void quaternion_from_matrix3(const float* matrices, QuaternionArrays q, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quaternion_from_matrix3, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        quaternion_from_matrix3_avx2(matrices, q, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        quaternion_from_matrix3_scalar(matrices, q, count);
+    }
+}
+
+void quaternion_normalize(ConstQuaternionArrays q, QuaternionArrays result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quaternion_normalize, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        quaternion_normalize_avx2(q, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        quaternion_normalize_scalar(q, result, count);
+    }
+}
+
+void quaternion_slerp(ConstQuaternionArrays a, ConstQuaternionArrays b, float t, QuaternionArrays result,
+                      size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quaternion_slerp, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        quaternion_slerp_avx2(a, b, t, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        quaternion_slerp_scalar(a, b, t, result, count);
+    }
+}
+
+void rigid_transform_points(const float* rotation, const float* translation, ConstVec3Arrays points,
+                            Vec3Arrays result, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::rigid_transform_points, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        rigid_transform_points_avx2(rotation, translation, points, result, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        rigid_transform_points_scalar(rotation, translation, points, result, count);
+    }
+}
+
+
+void complex_multiply(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                      float* out_real, float* out_imag, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_multiply, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_multiply_avx2(a_real, a_imag, b_real, b_imag, out_real, out_imag, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_multiply_scalar(a_real, a_imag, b_real, b_imag, out_real, out_imag, count);
+    }
+}
+
+void complex_multiply_conj(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                           float* out_real, float* out_imag, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_multiply_conj, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_multiply_conj_avx2(a_real, a_imag, b_real, b_imag, out_real, out_imag, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_multiply_conj_scalar(a_real, a_imag, b_real, b_imag, out_real, out_imag, count);
+    }
+}
+
+void complex_magnitude(const float* real, const float* imag, float* out, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_magnitude, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_magnitude_avx2(real, imag, out, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_magnitude_scalar(real, imag, out, count);
+    }
+}
+
+void complex_magnitude_squared(const float* real, const float* imag, float* out, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_magnitude_squared, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_magnitude_squared_avx2(real, imag, out, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_magnitude_squared_scalar(real, imag, out, count);
+    }
+}
+
+void complex_phase(const float* real, const float* imag, float* out, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_phase, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_phase_avx2(real, imag, out, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_phase_scalar(real, imag, out, count);
+    }
+}
+
+void complex_scale_accumulate(const float* real, const float* imag, float scale_real, float scale_imag,
+                              float* acc_real, float* acc_imag, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_scale_accumulate, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_scale_accumulate_avx2(real, imag, scale_real, scale_imag, acc_real, acc_imag, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_scale_accumulate_scalar(real, imag, scale_real, scale_imag, acc_real, acc_imag, count);
+    }
+}
+
+void complex_multiply_interleaved(const float* a, const float* b, float* out, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_multiply_interleaved, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_multiply_interleaved_avx2(a, b, out, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_multiply_interleaved_scalar(a, b, out, count);
+    }
+}
+
+void complex_multiply_conj_interleaved(const float* a, const float* b, float* out, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_multiply_conj_interleaved, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_multiply_conj_interleaved_avx2(a, b, out, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_multiply_conj_interleaved_scalar(a, b, out, count);
+    }
+}
+
+void complex_magnitude_interleaved(const float* data, float* out, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_magnitude_interleaved, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_magnitude_interleaved_avx2(data, out, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_magnitude_interleaved_scalar(data, out, count);
+    }
+}
+
+void complex_magnitude_squared_interleaved(const float* data, float* out, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_magnitude_squared_interleaved, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_magnitude_squared_interleaved_avx2(data, out, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_magnitude_squared_interleaved_scalar(data, out, count);
+    }
+}
+
+void complex_phase_interleaved(const float* data, float* out, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_phase_interleaved, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_phase_interleaved_avx2(data, out, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_phase_interleaved_scalar(data, out, count);
+    }
+}
+
+void complex_scale_accumulate_interleaved(const float* data, float scale_real, float scale_imag, float* acc,
+                                          size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::complex_scale_accumulate_interleaved, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        complex_scale_accumulate_interleaved_avx2(data, scale_real, scale_imag, acc, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        complex_scale_accumulate_interleaved_scalar(data, scale_real, scale_imag, acc, count);
+    }
+}
+
+void convert_s16_to_f32(const int16_t* input, float* output, size_t count, float scale) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::convert_s16_to_f32, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        convert_s16_to_f32_avx2(input, output, count, scale);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        convert_s16_to_f32_scalar(input, output, count, scale);
+    }
+}
+
+void convert_s24_to_f32(const uint8_t* input, float* output, size_t count, float scale) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::convert_s24_to_f32, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        convert_s24_to_f32_avx2(input, output, count, scale);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        convert_s24_to_f32_scalar(input, output, count, scale);
+    }
+}
+
+void convert_s32_to_f32(const int32_t* input, float* output, size_t count, float scale) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::convert_s32_to_f32, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        convert_s32_to_f32_avx2(input, output, count, scale);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        convert_s32_to_f32_scalar(input, output, count, scale);
+    }
+}
+
+void convert_f32_to_s16(const float* input, int16_t* output, size_t count, float scale, PcmDither* dither) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::convert_f32_to_s16, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        convert_f32_to_s16_avx2(input, output, count, scale, dither);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        convert_f32_to_s16_scalar(input, output, count, scale, dither);
+    }
+    if (dither) {
+        dither->index += count;
+    }
+}
+
+void convert_f32_to_s24(const float* input, uint8_t* output, size_t count, float scale, PcmDither* dither) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::convert_f32_to_s24, count);
+    
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        convert_f32_to_s24_avx2(input, output, count, scale, dither);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        convert_f32_to_s24_scalar(input, output, count, scale, dither);
+    }
+    if (dither) {
+        dither->index += count;
+    }
+}
+
+void convert_f32_to_s32(const float* input, int32_t* output, size_t count, float scale) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::convert_f32_to_s32, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        convert_f32_to_s32_avx2(input, output, count, scale);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        convert_f32_to_s32_scalar(input, output, count, scale);
+    }
+}
+
+void sort_floats(float* data, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::sort_floats, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        sort_floats_avx2(data, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        sort_floats_scalar(data, count);
+    }
+}
+
+void sort_key_value(float* keys, uint32_t* values, size_t count) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::sort_key_value, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        sort_key_value_avx2(keys, values, count);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        sort_key_value_scalar(keys, values, count);
+    }
+}
+
+float select_nth(float* data, size_t count, size_t n) {
+    if (n >= count) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::select_nth, count);
+    
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return select_nth_avx2(data, count, n);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return select_nth_scalar(data, count, n);
+    }
+}
+
 } // namespace simd_lib
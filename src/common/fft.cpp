@@ -1,6 +1,10 @@
 #include "simd_lib.h"
+#include "telemetry.h"
 #include <cmath>
 #include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -13,6 +17,14 @@ bool is_power_of_2(size_t n) {
     return n > 0 && (n & (n - 1)) == 0;
 }
 
+size_t next_power_of_2(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
 // Helper function to reverse bits for FFT
 size_t reverse_bits(size_t x, size_t bits) {
     size_t result = 0;
@@ -23,64 +35,145 @@ size_t reverse_bits(size_t x, size_t bits) {
     return result;
 }
 
-void fft_radix2(float* real, float* imag, size_t n, bool inverse) {
-    if (!is_power_of_2(n)) {
-        // For simplicity, we only support power-of-2 sizes
+FFTPlan::FFTPlan(size_t n) : n_(is_power_of_2(n) && n <= (size_t(1) << 31) ? n : 0) {
+    if (n_ == 0) {
         return;
     }
-    
+
     size_t bits = 0;
-    size_t temp = n;
-    while (temp >>= 1) ++bits;
-    
-    // Bit-reverse the arrays
-    for (size_t i = 0; i < n; ++i) {
+    while ((size_t(1) << bits) < n_) ++bits;
+    for (size_t i = 0; i < n_; ++i) {
         size_t j = reverse_bits(i, bits);
         if (i < j) {
-            std::swap(real[i], real[j]);
-            std::swap(imag[i], imag[j]);
+            swaps_.push_back((uint32_t)i);
+            swaps_.push_back((uint32_t)j);
         }
     }
-    
-    // FFT computation
-    for (size_t len = 2; len <= n; len <<= 1) {
-        float angle = (inverse ? 2.0f : -2.0f) * M_PI / len;
-        float w_real = std::cos(angle);
-        float w_imag = std::sin(angle);
-        
-        for (size_t i = 0; i < n; i += len) {
-            float w_r = 1.0f;
-            float w_i = 0.0f;
-            
-            for (size_t j = 0; j < len / 2; ++j) {
-                size_t u = i + j;
-                size_t v = i + j + len / 2;
-                
-                float t_real = w_r * real[v] - w_i * imag[v];
-                float t_imag = w_r * imag[v] + w_i * real[v];
-                
-                real[v] = real[u] - t_real;
-                imag[v] = imag[u] - t_imag;
-                real[u] += t_real;
-                imag[u] += t_imag;
-                
-                float next_w_r = w_r * w_real - w_i * w_imag;
-                float next_w_i = w_r * w_imag + w_i * w_real;
-                w_r = next_w_r;
-                w_i = next_w_i;
-            }
+
+    // Even outputs of the first stage, for gathering from interleaved input
+    first_index_.resize(n_ / 2);
+    for (size_t k = 0; k < n_ / 2; ++k) {
+        first_index_[k] = (uint32_t)reverse_bits(2 * k, bits);
+    }
+
+    // Each stage gets its own contiguous table so the butterflies load
+    // twiddles with unit stride
+    twiddle_real_.resize(n_ > 1 ? n_ - 1 : 0);
+    twiddle_imag_.resize(twiddle_real_.size());
+    twiddle_imag_inverse_.resize(twiddle_real_.size());
+    for (size_t half = 1; half < n_; half <<= 1) {
+        for (size_t k = 0; k < half; ++k) {
+            double angle = -M_PI * (double)k / (double)half;
+            twiddle_real_[half - 1 + k] = (float)std::cos(angle);
+            twiddle_imag_[half - 1 + k] = (float)std::sin(angle);
+            twiddle_imag_inverse_[half - 1 + k] = -twiddle_imag_[half - 1 + k];
         }
     }
-    
-    // Normalize for inverse FFT
+}
+
+void FFTPlan::execute(float* real, float* imag, bool inverse) const {
+    if (n_ == 0) {
+        return;
+    }
+
+    for (size_t s = 0; s < swaps_.size(); s += 2) {
+        std::swap(real[swaps_[s]], real[swaps_[s + 1]]);
+        std::swap(imag[swaps_[s]], imag[swaps_[s + 1]]);
+    }
+
+    const auto& features = get_cpu_features();
+    auto stage = (features.has_avx2 && features.has_fma) ? fft_stage_avx2 : fft_stage_scalar;
+    const float* w_imag = inverse ? twiddle_imag_inverse_.data() : twiddle_imag_.data();
+    for (size_t half = 1; half < n_; half <<= 1) {
+        stage(real, imag, n_, half, &twiddle_real_[half - 1], &w_imag[half - 1]);
+    }
+
     if (inverse) {
-        for (size_t i = 0; i < n; ++i) {
-            real[i] /= n;
-            imag[i] /= n;
-        }
+        float scale = 1.0f / (float)n_;
+        vector_scale(real, scale, real, n_);
+        vector_scale(imag, scale, imag, n_);
     }
 }
 
+void FFTPlan::execute_interleaved(float* data, bool inverse) const {
+    if (n_ == 0) {
+        return;
+    }
+    if (n_ < 4) {
+        // The first stage is also the last one
+        float real[2], imag[2];
+        deinterleave2_scalar(data, real, imag, n_);
+        execute(real, imag, inverse);
+        interleave2_scalar(real, imag, data, n_);
+        return;
+    }
+
+    // Planar working copy, kept per thread so repeated calls do not allocate
+    thread_local std::vector<float> scratch;
+    if (scratch.size() < 2 * n_) {
+        scratch.resize(2 * n_);
+    }
+    float* real = scratch.data();
+    float* imag = real + n_;
+
+    const auto& features = get_cpu_features();
+    const bool avx2 = features.has_avx2 && features.has_fma;
+    auto stage = avx2 ? fft_stage_avx2 : fft_stage_scalar;
+    auto first = avx2 ? fft_first_stage_interleaved_avx2 : fft_first_stage_interleaved_scalar;
+    auto last = avx2 ? fft_last_stage_interleaved_avx2 : fft_last_stage_interleaved_scalar;
+    const float* w_imag = inverse ? twiddle_imag_inverse_.data() : twiddle_imag_.data();
+
+    first(data, first_index_.data(), real, imag, n_);
+    for (size_t half = 2; half < n_ / 2; half <<= 1) {
+        stage(real, imag, n_, half, &twiddle_real_[half - 1], &w_imag[half - 1]);
+    }
+    const size_t half = n_ / 2;
+    last(real, imag, n_, &twiddle_real_[half - 1], &w_imag[half - 1], inverse ? 1.0f / (float)n_ : 1.0f, data);
+}
+
+std::shared_ptr<const FFTPlan> get_fft_plan(size_t n) {
+    static std::mutex cache_mutex;
+    static std::map<size_t, std::shared_ptr<const FFTPlan>> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto& plan = cache[n];
+    if (!plan) {
+        plan = std::make_shared<const FFTPlan>(n);
+    }
+    return plan;
+}
+
+void fft_radix2(float* real, float* imag, size_t n, bool inverse) {
+    TelemetryScope telemetry(TelemetryFunction::fft_radix2, n);
+    const auto& features = get_cpu_features();
+    telemetry.isa((features.has_avx2 && features.has_fma) ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    if (!is_power_of_2(n)) {
+        // For simplicity, we only support power-of-2 sizes
+        return;
+    }
+    get_fft_plan(n)->execute(real, imag, inverse);
+}
+
+void fft_interleaved(float* data, size_t n, bool inverse) {
+    TelemetryScope telemetry(TelemetryFunction::fft_interleaved, n);
+    const auto& features = get_cpu_features();
+    telemetry.isa((features.has_avx2 && features.has_fma) ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    if (!is_power_of_2(n)) {
+        return;
+    }
+    get_fft_plan(n)->execute_interleaved(data, inverse);
+}
+
+void fft_forward_interleaved(float* data, size_t n) {
+    fft_interleaved(data, n, false);
+}
+
+void fft_inverse_interleaved(float* data, size_t n) {
+    fft_interleaved(data, n, true);
+}
+
 void fft_forward(float* real, float* imag, size_t n) {
     fft_radix2(real, imag, n, false);
 }
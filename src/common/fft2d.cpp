@@ -0,0 +1,181 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <vector>
+
+namespace simd_lib {
+
+// Rows per thread: enough FFT work that spawning pays for itself
+static const size_t kMinSamplesPerThread = 1 << 15;
+
+// Columns moved per transposed strip: one 64-byte line of each row, so
+// every source line fetched is used in full and a strip of 2048-point
+// columns (256 KB for both planes) stays in L2 while it is transformed
+static const size_t kColumnStrip = 16;
+
+typedef void (*TransposeKernel)(const float*, size_t, size_t, size_t, float*, size_t);
+
+static bool is_pow2(size_t n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+static size_t min_rows_for(size_t length) {
+    return std::max<size_t>(1, kMinSamplesPerThread / std::max<size_t>(length, 1));
+}
+
+// The row and column FFTs run the radix-2 stages of fft.cpp
+static DispatchIsa fft2d_isa() {
+    const auto& features = get_cpu_features();
+    return features.has_avx2 && features.has_fma ? DispatchIsa::AVX2 : DispatchIsa::Scalar;
+}
+
+static void fft_rows(float* real, float* imag, size_t rows, size_t cols, bool inverse, size_t num_threads) {
+    auto plan = get_fft_plan(cols);
+    parallel_for(rows, num_threads, min_rows_for(cols), [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            plan->execute(&real[r * cols], &imag[r * cols], inverse);
+        }
+    });
+}
+
+// Transforms each column of the rows x cols planes: a strip of columns is
+// transposed into contiguous rows, transformed, and transposed back, with
+// strips split across threads. A strip is already cache-sized, so it goes
+// straight to the transpose kernel rather than through the tiled transpose().
+static void fft_columns(float* real, float* imag, size_t rows, size_t cols, bool inverse, size_t num_threads) {
+    if (rows <= 1) {
+        return;
+    }
+    auto plan = get_fft_plan(rows);
+    TransposeKernel transpose_strip = get_cpu_features().has_avx2 ? transpose_avx2 : transpose_scalar;
+    size_t strips = (cols + kColumnStrip - 1) / kColumnStrip;
+    parallel_for(strips, num_threads, std::max<size_t>(1, min_rows_for(rows) / kColumnStrip),
+        [&](size_t begin, size_t end) {
+            std::vector<float> s_real(kColumnStrip * rows), s_imag(kColumnStrip * rows);
+            for (size_t s = begin; s < end; ++s) {
+                size_t c0 = s * kColumnStrip;
+                size_t width = std::min(kColumnStrip, cols - c0);
+                transpose_strip(&real[c0], rows, width, cols, s_real.data(), rows);
+                transpose_strip(&imag[c0], rows, width, cols, s_imag.data(), rows);
+                for (size_t j = 0; j < width; ++j) {
+                    plan->execute(&s_real[j * rows], &s_imag[j * rows], inverse);
+                }
+                transpose_strip(s_real.data(), width, rows, rows, &real[c0], cols);
+                transpose_strip(s_imag.data(), width, rows, rows, &imag[c0], cols);
+            }
+        });
+}
+
+static void fft2d(float* real, float* imag, size_t rows, size_t cols, bool inverse, size_t num_threads) {
+    TelemetryScope telemetry(TelemetryFunction::fft2d, rows * cols);
+    telemetry.isa(fft2d_isa());
+
+    if (!is_pow2(rows) || !is_pow2(cols)) {
+        return;
+    }
+    fft_rows(real, imag, rows, cols, inverse, num_threads);
+    fft_columns(real, imag, rows, cols, inverse, num_threads);
+}
+
+void fft2d_forward(float* real, float* imag, size_t rows, size_t cols, size_t num_threads) {
+    fft2d(real, imag, rows, cols, false, num_threads);
+}
+
+void fft2d_inverse(float* real, float* imag, size_t rows, size_t cols, size_t num_threads) {
+    fft2d(real, imag, rows, cols, true, num_threads);
+}
+
+void fft2d_real_forward(const float* input, size_t rows, size_t cols, float* out_real, float* out_imag,
+                        size_t num_threads) {
+    TelemetryScope telemetry(TelemetryFunction::fft2d_real, rows * cols);
+    telemetry.isa(fft2d_isa());
+
+    if (!is_pow2(rows) || !is_pow2(cols) || cols < 2) {
+        return;
+    }
+    const size_t width = cols / 2 + 1;
+    auto plan = get_fft_plan(cols);
+
+    // Two real rows a and b go through one complex FFT as z = a + ib; with
+    // m = (n - k) mod n, A[k] = (Z[k] + conj(Z[m])) / 2 and
+    // B[k] = (Z[k] - conj(Z[m])) / 2i
+    size_t pairs = (rows + 1) / 2;
+    parallel_for(pairs, num_threads, std::max<size_t>(1, min_rows_for(cols) / 2), [&](size_t begin, size_t end) {
+        std::vector<float> z_real(cols), z_imag(cols);
+        for (size_t p = begin; p < end; ++p) {
+            size_t a = 2 * p;
+            size_t b = a + 1;
+            std::copy(&input[a * cols], &input[a * cols] + cols, z_real.begin());
+            if (b < rows) {
+                std::copy(&input[b * cols], &input[b * cols] + cols, z_imag.begin());
+            } else {
+                std::fill(z_imag.begin(), z_imag.end(), 0.0f);
+            }
+            plan->execute(z_real.data(), z_imag.data(), false);
+
+            for (size_t k = 0; k < width; ++k) {
+                size_t m = (cols - k) & (cols - 1);
+                float zr = z_real[k], zi = z_imag[k];
+                float mr = z_real[m], mi = z_imag[m];
+                out_real[a * width + k] = 0.5f * (zr + mr);
+                out_imag[a * width + k] = 0.5f * (zi - mi);
+                if (b < rows) {
+                    out_real[b * width + k] = 0.5f * (zi + mi);
+                    out_imag[b * width + k] = 0.5f * (mr - zr);
+                }
+            }
+        }
+    });
+
+    fft_columns(out_real, out_imag, rows, width, false, num_threads);
+}
+
+void fft2d_real_inverse(const float* in_real, const float* in_imag, size_t rows, size_t cols, float* output,
+                        size_t num_threads) {
+    TelemetryScope telemetry(TelemetryFunction::fft2d_real, rows * cols);
+    telemetry.isa(fft2d_isa());
+
+    if (!is_pow2(rows) || !is_pow2(cols) || cols < 2) {
+        return;
+    }
+    const size_t width = cols / 2 + 1;
+    const size_t half = cols / 2;
+    auto plan = get_fft_plan(cols);
+
+    std::vector<float> h_real(in_real, in_real + rows * width), h_imag(in_imag, in_imag + rows * width);
+    fft_columns(h_real.data(), h_imag.data(), rows, width, true, num_threads);
+
+    // Rebuild each row's full spectrum from Hermitian symmetry and pack two
+    // rows as Z = A + iB, so one inverse FFT yields row a in the real part and
+    // row b in the imaginary part. The imaginary parts of the DC and Nyquist
+    // bins of a real signal are zero and are ignored.
+    size_t pairs = (rows + 1) / 2;
+    parallel_for(pairs, num_threads, std::max<size_t>(1, min_rows_for(cols) / 2), [&](size_t begin, size_t end) {
+        std::vector<float> z_real(cols), z_imag(cols);
+        for (size_t p = begin; p < end; ++p) {
+            size_t a = 2 * p;
+            size_t b = a + 1;
+            for (size_t k = 0; k < cols; ++k) {
+                // Bins above the half spectrum are conjugates of the mirrored bin
+                size_t src = k <= half ? k : cols - k;
+                float sign = k <= half ? 1.0f : -1.0f;
+                bool edge = k == 0 || k == half;
+                float ar = h_real[a * width + src];
+                float ai = edge ? 0.0f : sign * h_imag[a * width + src];
+                float br = b < rows ? h_real[b * width + src] : 0.0f;
+                float bi = b < rows && !edge ? sign * h_imag[b * width + src] : 0.0f;
+                z_real[k] = ar - bi;
+                z_imag[k] = ai + br;
+            }
+            plan->execute(z_real.data(), z_imag.data(), true);
+
+            std::copy(z_real.begin(), z_real.end(), &output[a * cols]);
+            if (b < rows) {
+                std::copy(z_imag.begin(), z_imag.end(), &output[b * cols]);
+            }
+        }
+    });
+}
+
+} // namespace simd_lib
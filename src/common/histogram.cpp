@@ -0,0 +1,74 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include "tuning.h"
+#include <algorithm>
+#include <vector>
+
+namespace simd_lib {
+
+// Runs fill(begin, end, counts) over blocks of the input. With one block it
+// writes straight into counts; otherwise every block fills its own histogram
+// and the partials are summed in block order.
+template <typename Fill>
+static void fill_histogram(size_t count, size_t bins, uint64_t* counts, size_t num_threads, Fill fill) {
+    std::fill(counts, counts + bins, (uint64_t)0);
+    size_t min_block = tuned(TuningParam::ReduceMinBlock);
+    if (resolve_thread_count(num_threads) <= 1 || count < 2 * min_block) {
+        fill(0, count, counts);
+        return;
+    }
+
+    auto partials = parallel_map_blocks<std::vector<uint64_t>>(count, num_threads, min_block,
+        [&](size_t begin, size_t end) {
+            std::vector<uint64_t> local(bins, 0);
+            fill(begin, end, local.data());
+            return local;
+        });
+    for (const auto& partial : partials) {
+        for (size_t b = 0; b < bins; ++b) {
+            counts[b] += partial[b];
+        }
+    }
+}
+
+void histogram(const float* data, size_t count, float lo, float hi, size_t bins, uint64_t* counts,
+               size_t num_threads) {
+    if (bins == 0) {
+        return;
+    }
+    if (!(hi > lo)) {
+        std::fill(counts, counts + bins, (uint64_t)0);
+        return;
+    }
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 ? histogram_avx2 : histogram_scalar;
+    TelemetryScope telemetry(TelemetryFunction::histogram, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    fill_histogram(count, bins, counts, num_threads, [&](size_t begin, size_t end, uint64_t* out) {
+        kernel(&data[begin], end - begin, lo, hi, bins, out);
+    });
+}
+
+void histogram2d(const float* x, const float* y, size_t count, float x_lo, float x_hi, size_t x_bins,
+                 float y_lo, float y_hi, size_t y_bins, uint64_t* counts, size_t num_threads) {
+    size_t bins = x_bins * y_bins;
+    if (bins == 0) {
+        return;
+    }
+    if (!(x_hi > x_lo) || !(y_hi > y_lo)) {
+        std::fill(counts, counts + bins, (uint64_t)0);
+        return;
+    }
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 ? histogram2d_avx2 : histogram2d_scalar;
+    TelemetryScope telemetry(TelemetryFunction::histogram2d, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    fill_histogram(count, bins, counts, num_threads, [&](size_t begin, size_t end, uint64_t* out) {
+        kernel(&x[begin], &y[begin], end - begin, x_lo, x_hi, x_bins, y_lo, y_hi, y_bins, out);
+    });
+}
+
+} // namespace simd_lib
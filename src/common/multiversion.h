@@ -0,0 +1,14 @@
+#pragma once
+
+// Marks a portable kernel for function multi-versioning. With the
+// SIMD_LIB_FAT_BINARY build option the compiler emits one clone per x86-64
+// microarchitecture level and an ifunc resolver picks the best at load time,
+// so the scalar fallbacks are auto-vectorized for whatever CPU runs them while
+// the library itself still only assumes baseline x86-64. Without the option
+// the macro expands to nothing.
+#if defined(SIMD_LIB_FAT_BINARY) && defined(__GNUC__)
+#define SIMD_LIB_MULTIVERSION \
+    __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "arch=x86-64-v2", "default")))
+#else
+#define SIMD_LIB_MULTIVERSION
+#endif
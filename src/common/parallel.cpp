@@ -0,0 +1,54 @@
+#include "parallel.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace simd_lib {
+
+size_t resolve_thread_count(size_t requested) {
+    if (requested != 0) {
+        return requested;
+    }
+    size_t hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+void parallel_for(size_t count, size_t num_threads, size_t min_block,
+                  const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    size_t block_min = std::max<size_t>(min_block, 1);
+    size_t threads = std::min(resolve_thread_count(num_threads), (count + block_min - 1) / block_min);
+
+    if (threads <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    size_t block = (count + threads - 1) / threads;
+    bool nested = telemetry_nested();
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        size_t begin = t * block;
+        size_t end = std::min(count, begin + block);
+        if (begin >= end) {
+            break;
+        }
+        workers.emplace_back([&fn, nested, begin, end] {
+            telemetry_set_nested(nested);
+            fn(begin, end);
+        });
+    }
+
+    fn(0, std::min(count, block));
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace simd_lib {
+
+// Resolves a thread count request: 0 means one thread per hardware thread
+size_t resolve_thread_count(size_t requested);
+
+// Splits [0, count) into contiguous blocks of at least min_block items and runs
+// fn(begin, end) for each block on up to num_threads threads. The calling
+// thread takes the first block, so num_threads == 1 never spawns a thread.
+void parallel_for(size_t count, size_t num_threads, size_t min_block,
+                  const std::function<void(size_t, size_t)>& fn);
+
+// Runs fn(begin, end) -> T for each parallel_for block and returns the partial
+// results in block order, so merging them is deterministic
+template <typename T, typename Fn>
+std::vector<T> parallel_map_blocks(size_t count, size_t num_threads, size_t min_block, Fn fn) {
+    std::vector<std::pair<size_t, T>> partials;
+    std::mutex partials_mutex;
+
+    parallel_for(count, num_threads, min_block, [&](size_t begin, size_t end) {
+        T value = fn(begin, end);
+        std::lock_guard<std::mutex> lock(partials_mutex);
+        partials.emplace_back(begin, value);
+    });
+
+    std::sort(partials.begin(), partials.end(),
+              [](const std::pair<size_t, T>& a, const std::pair<size_t, T>& b) { return a.first < b.first; });
+    std::vector<T> results;
+    results.reserve(partials.size());
+    for (auto& partial : partials) {
+        results.push_back(partial.second);
+    }
+    return results;
+}
+
+} // namespace simd_lib
@@ -0,0 +1,201 @@
+#include "simd_lib.h"
+
+#ifdef SIMD_LIB_PERF_COUNTERS
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace simd_lib {
+
+static const int kPerfEventCount = 5;
+
+#ifdef __linux__
+static int open_event(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        fds_[i] = -1;
+    }
+
+#ifdef __linux__
+    const uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const struct {
+        uint32_t type;
+        uint64_t config;
+    } events[kPerfEventCount] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, l1d_read_miss},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        fds_[i] = open_event(events[i].type, events[i].config);
+        if (fds_[i] >= 0) {
+            available_ |= 1u << i;
+        }
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        if (fds_[i] >= 0) {
+            close(fds_[i]);
+        }
+    }
+#endif
+}
+
+PerfSample PerfCounters::read() const {
+    uint64_t values[kPerfEventCount] = {0, 0, 0, 0, 0};
+
+#ifdef __linux__
+    for (int i = 0; i < kPerfEventCount; ++i) {
+        if (fds_[i] < 0) {
+            continue;
+        }
+        // value, time enabled, time running
+        uint64_t data[3];
+        if (::read(fds_[i], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            continue;
+        }
+        // Extrapolate if the PMU was shared with other events part of the time
+        if (data[2] > 0 && data[2] < data[1]) {
+            values[i] = (uint64_t)((double)data[0] * (double)data[1] / (double)data[2]);
+        } else {
+            values[i] = data[0];
+        }
+    }
+#endif
+
+    PerfSample sample;
+    sample.cycles = values[0];
+    sample.instructions = values[1];
+    sample.l1d_misses = values[2];
+    sample.llc_misses = values[3];
+    sample.branch_misses = values[4];
+    sample.available = available_;
+    return sample;
+}
+
+PerfSample perf_delta(const PerfSample& begin, const PerfSample& end) {
+    PerfSample delta;
+    delta.cycles = end.cycles - begin.cycles;
+    delta.instructions = end.instructions - begin.instructions;
+    delta.l1d_misses = end.l1d_misses - begin.l1d_misses;
+    delta.llc_misses = end.llc_misses - begin.llc_misses;
+    delta.branch_misses = end.branch_misses - begin.branch_misses;
+    delta.available = begin.available & end.available;
+    return delta;
+}
+
+static std::mutex g_regions_mutex;
+static std::vector<PerfRegion> g_regions;
+
+void perf_record(const char* name, const PerfSample& sample, uint64_t calls) {
+    std::lock_guard<std::mutex> lock(g_regions_mutex);
+
+    PerfRegion* region = nullptr;
+    for (auto& existing : g_regions) {
+        if (std::strcmp(existing.name, name) == 0) {
+            region = &existing;
+            break;
+        }
+    }
+    if (!region) {
+        g_regions.push_back(PerfRegion{name, 0, PerfSample()});
+        region = &g_regions.back();
+        region->total.available = sample.available;
+    }
+
+    region->calls += calls;
+    region->total.cycles += sample.cycles;
+    region->total.instructions += sample.instructions;
+    region->total.l1d_misses += sample.l1d_misses;
+    region->total.llc_misses += sample.llc_misses;
+    region->total.branch_misses += sample.branch_misses;
+    region->total.available &= sample.available;
+}
+
+size_t perf_regions(PerfRegion* regions, size_t max_regions) {
+    std::lock_guard<std::mutex> lock(g_regions_mutex);
+    size_t count = g_regions.size() < max_regions ? g_regions.size() : max_regions;
+    for (size_t i = 0; i < count; ++i) {
+        regions[i] = g_regions[i];
+    }
+    return g_regions.size();
+}
+
+void perf_reset() {
+    std::lock_guard<std::mutex> lock(g_regions_mutex);
+    g_regions.clear();
+}
+
+void perf_report() {
+    std::lock_guard<std::mutex> lock(g_regions_mutex);
+
+    std::cout << "Performance Counters:\n";
+    if (g_regions.empty()) {
+        std::cout << "  (no regions recorded)\n";
+        return;
+    }
+
+    std::cout << "  " << std::left << std::setw(28) << "Region" << std::right << std::setw(10) << "Calls"
+              << std::setw(14) << "Cycles/call" << std::setw(8) << "IPC" << std::setw(10) << "L1D MPKI"
+              << std::setw(10) << "LLC MPKI" << std::setw(10) << "Br MPKI" << "\n";
+    for (const auto& region : g_regions) {
+        const PerfSample& total = region.total;
+        std::cout << "  " << std::left << std::setw(28) << region.name << std::right << std::setw(10)
+                  << region.calls << std::fixed << std::setprecision(1) << std::setw(14)
+                  << (region.calls ? (double)total.cycles / (double)region.calls : 0.0) << std::setprecision(2)
+                  << std::setw(8) << total.ipc() << std::setw(10) << total.l1d_mpki() << std::setw(10)
+                  << total.llc_mpki() << std::setw(10) << total.branch_mpki() << "\n";
+    }
+    if ((g_regions.front().total.available & (kPerfCycles | kPerfInstructions)) !=
+        (kPerfCycles | kPerfInstructions)) {
+        std::cout << "  Hardware counters unavailable (no PMU access); values are zero\n";
+    }
+}
+
+// One counter set per thread, opened on first use
+static const PerfCounters& thread_counters() {
+    thread_local PerfCounters counters;
+    return counters;
+}
+
+PerfScope::PerfScope(const char* name) : name_(name) {
+    begin_ = thread_counters().read();
+}
+
+PerfScope::~PerfScope() {
+    perf_record(name_, perf_delta(begin_, thread_counters().read()));
+}
+
+} // namespace simd_lib
+
+#endif // SIMD_LIB_PERF_COUNTERS
@@ -0,0 +1,74 @@
+#include "simd_lib.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace simd_lib {
+
+using SelectKernel = float (*)(float*, size_t, size_t);
+using MinKernel = float (*)(const float*, size_t);
+
+// Selects the order statistic at h = q * (count - 1) in data[begin, count)
+// and interpolates towards the next one, the smallest key after it. Keys
+// before begin must be no larger than any key from begin on.
+static float interpolate(float* data, size_t count, size_t begin, double q, SelectKernel select, MinKernel min,
+                         size_t* rank) {
+    double h = std::min(std::max(q, 0.0), 1.0) * (double)(count - 1);
+    size_t lo = std::max((size_t)std::floor(h), begin);
+    *rank = lo;
+    float x_lo = select(&data[begin], count - begin, lo - begin);
+    double fraction = h - (double)lo;
+    if (fraction <= 0.0 || lo + 1 >= count) {
+        return x_lo;
+    }
+    float x_hi = min(&data[lo + 1], count - lo - 1);
+    if (x_hi == x_lo) {
+        return x_lo;  // Repeated infinities would otherwise give inf - inf
+    }
+    return (float)(x_lo + fraction * ((double)x_hi - x_lo));
+}
+
+void quantiles(const float* data, size_t count, const double* qs, size_t num_quantiles, float* out) {
+    if (count == 0) {
+        std::fill(out, out + num_quantiles, std::numeric_limits<float>::quiet_NaN());
+        return;
+    }
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::quantile, count);
+    SelectKernel select = select_nth_scalar;
+    MinKernel min = vector_min_scalar;
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        select = select_nth_avx2;
+        min = vector_min_avx2;
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+    }
+
+    std::vector<float> copy(data, data + count);
+    // Ascending q lets each selection skip the keys already below the last one
+    std::vector<size_t> order;
+    order.reserve(num_quantiles);
+    for (size_t i = 0; i < num_quantiles; ++i) {
+        if (std::isnan(qs[i])) {
+            out[i] = std::numeric_limits<float>::quiet_NaN();
+        } else {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [qs](size_t a, size_t b) { return qs[a] < qs[b]; });
+    size_t begin = 0;
+    for (size_t i : order) {
+        out[i] = interpolate(copy.data(), count, begin, qs[i], select, min, &begin);
+    }
+}
+
+float quantile(const float* data, size_t count, double q) {
+    float result;
+    quantiles(data, count, &q, 1, &result);
+    return result;
+}
+
+} // namespace simd_lib
@@ -0,0 +1,39 @@
+#include "simd_lib.h"
+
+namespace simd_lib {
+
+// sum((a - za) * (b - zb)) = sum(a*b) - zb*sum(a) - za*sum(b) + n*za*zb
+// The correction terms are skipped for symmetric (zero point 0) inputs.
+
+float dot_product_quantized(const int8_t* a, const QuantizationParams& qa,
+                            const int8_t* b, const QuantizationParams& qb, size_t count) {
+    int64_t acc = dot_product_s8(a, b, count);
+    if (qb.zero_point != 0) {
+        acc -= (int64_t)qb.zero_point * sum_s8(a, count);
+    }
+    if (qa.zero_point != 0) {
+        acc -= (int64_t)qa.zero_point * sum_s8(b, count);
+    }
+    acc += (int64_t)count * qa.zero_point * qb.zero_point;
+    return qa.scale * qb.scale * (float)acc;
+}
+
+float dot_product_quantized(const uint8_t* a, const QuantizationParams& qa,
+                            const int8_t* b, const QuantizationParams& qb, size_t count) {
+    int64_t acc = dot_product_u8s8(a, b, count);
+    if (qb.zero_point != 0) {
+        acc -= (int64_t)qb.zero_point * sum_u8(a, count);
+    }
+    if (qa.zero_point != 0) {
+        acc -= (int64_t)qa.zero_point * sum_s8(b, count);
+    }
+    acc += (int64_t)count * qa.zero_point * qb.zero_point;
+    return qa.scale * qb.scale * (float)acc;
+}
+
+float l2_distance_squared_quantized(const int8_t* a, const int8_t* b, size_t count,
+                                    const QuantizationParams& params) {
+    return params.scale * params.scale * (float)l2_distance_squared_s8(a, b, count);
+}
+
+} // namespace simd_lib
@@ -0,0 +1,115 @@
+#include "simd_lib.h"
+#include "telemetry.h"
+
+namespace simd_lib {
+
+static uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+static void step(uint32_t s[4]) {
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+}
+
+// Advances one lane by the jump polynomial: 2^64 steps for kJump, 2^96 for kLongJump
+static const uint32_t kJump[4] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+static const uint32_t kLongJump[4] = {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+
+static void jump(uint32_t s[4], const uint32_t polynomial[4]) {
+    uint32_t result[4] = {0, 0, 0, 0};
+    for (int word = 0; word < 4; ++word) {
+        for (int bit = 0; bit < 32; ++bit) {
+            if (polynomial[word] & (1u << bit)) {
+                for (int k = 0; k < 4; ++k) {
+                    result[k] ^= s[k];
+                }
+            }
+            step(s);
+        }
+    }
+    for (int k = 0; k < 4; ++k) {
+        s[k] = result[k];
+    }
+}
+
+static void get_lane(const RandomState* state, int lane, uint32_t s[4]) {
+    for (int k = 0; k < 4; ++k) {
+        s[k] = state->s[k][lane];
+    }
+}
+
+static void set_lane(RandomState* state, int lane, const uint32_t s[4]) {
+    for (int k = 0; k < 4; ++k) {
+        state->s[k][lane] = s[k];
+    }
+}
+
+RandomState random_state(uint64_t seed, uint64_t stream) {
+    uint32_t s[4];
+    uint64_t x = seed;
+    uint64_t a = splitmix64(x);
+    uint64_t b = splitmix64(x);
+    s[0] = (uint32_t)a;
+    s[1] = (uint32_t)(a >> 32);
+    s[2] = (uint32_t)b;
+    s[3] = (uint32_t)(b >> 32);
+    if ((s[0] | s[1] | s[2] | s[3]) == 0) {
+        s[0] = 1;  // the all-zero state is a fixed point
+    }
+
+    RandomState state;
+    for (int lane = 0; lane < 8; ++lane) {
+        set_lane(&state, lane, s);
+        jump(s, kJump);
+    }
+    for (uint64_t k = 0; k < stream; ++k) {
+        random_long_jump(&state);
+    }
+    return state;
+}
+
+void random_long_jump(RandomState* state) {
+    for (int lane = 0; lane < 8; ++lane) {
+        uint32_t s[4];
+        get_lane(state, lane, s);
+        jump(s, kLongJump);
+        set_lane(state, lane, s);
+    }
+}
+
+void fill_uniform(RandomState* state, float* output, size_t count, float lo, float hi) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::fill_uniform, count);
+
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        fill_uniform_avx2(state, output, count, lo, hi);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        fill_uniform_scalar(state, output, count, lo, hi);
+    }
+}
+
+void fill_normal(RandomState* state, float* output, size_t count, float mean, float stddev) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::fill_normal, count);
+
+    if (features.has_avx2 && features.has_fma) {
+        telemetry.isa(DispatchIsa::AVX2);
+        fill_normal_avx2(state, output, count, mean, stddev);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        fill_normal_scalar(state, output, count, mean, stddev);
+    }
+}
+
+} // namespace simd_lib
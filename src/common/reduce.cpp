@@ -0,0 +1,154 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include "tuning.h"
+#include <limits>
+
+namespace simd_lib {
+
+// Minimum elements per thread (64K unless tuned): below that a reduction is
+// memory-latency bound and spawning costs more than it saves
+static size_t reduce_min_block() {
+    return tuned(TuningParam::ReduceMinBlock);
+}
+
+float vector_sum(const float* a, size_t count, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 ? vector_sum_avx2 : vector_sum_scalar;
+    TelemetryScope telemetry(TelemetryFunction::vector_sum, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    auto partials = parallel_map_blocks<float>(count, num_threads, reduce_min_block(),
+        [&](size_t begin, size_t end) { return kernel(&a[begin], end - begin); });
+
+    float result = 0.0f;
+    for (float partial : partials) {
+        result += partial;
+    }
+    return result;
+}
+
+float vector_min(const float* a, size_t count, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 ? vector_min_avx2 : vector_min_scalar;
+    TelemetryScope telemetry(TelemetryFunction::vector_min, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    auto partials = parallel_map_blocks<float>(count, num_threads, reduce_min_block(),
+        [&](size_t begin, size_t end) { return kernel(&a[begin], end - begin); });
+
+    float result = std::numeric_limits<float>::infinity();
+    for (float partial : partials) {
+        result = partial < result ? partial : result;
+    }
+    return result;
+}
+
+float vector_max(const float* a, size_t count, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 ? vector_max_avx2 : vector_max_scalar;
+    TelemetryScope telemetry(TelemetryFunction::vector_max, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    auto partials = parallel_map_blocks<float>(count, num_threads, reduce_min_block(),
+        [&](size_t begin, size_t end) { return kernel(&a[begin], end - begin); });
+
+    float result = -std::numeric_limits<float>::infinity();
+    for (float partial : partials) {
+        result = partial > result ? partial : result;
+    }
+    return result;
+}
+
+void vector_minmax(const float* a, size_t count, float* min_value, float* max_value, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 ? vector_minmax_avx2 : vector_minmax_scalar;
+    TelemetryScope telemetry(TelemetryFunction::vector_minmax, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    struct Range {
+        float lo, hi;
+    };
+    auto partials = parallel_map_blocks<Range>(count, num_threads, reduce_min_block(),
+        [&](size_t begin, size_t end) {
+            Range range;
+            kernel(&a[begin], end - begin, &range.lo, &range.hi);
+            return range;
+        });
+
+    *min_value = std::numeric_limits<float>::infinity();
+    *max_value = -std::numeric_limits<float>::infinity();
+    for (const Range& range : partials) {
+        *min_value = range.lo < *min_value ? range.lo : *min_value;
+        *max_value = range.hi > *max_value ? range.hi : *max_value;
+    }
+}
+
+size_t argmin(const float* a, size_t count, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 ? argmin_avx2 : argmin_scalar;
+    TelemetryScope telemetry(TelemetryFunction::argmin, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    auto partials = parallel_map_blocks<size_t>(count, num_threads, reduce_min_block(),
+        [&](size_t begin, size_t end) { return begin + kernel(&a[begin], end - begin); });
+
+    // Blocks arrive in order, so a strict comparison keeps the first index
+    size_t result = 0;
+    for (size_t index : partials) {
+        if (a[index] < a[result]) {
+            result = index;
+        }
+    }
+    return result;
+}
+
+size_t argmax(const float* a, size_t count, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 ? argmax_avx2 : argmax_scalar;
+    TelemetryScope telemetry(TelemetryFunction::argmax, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    auto partials = parallel_map_blocks<size_t>(count, num_threads, reduce_min_block(),
+        [&](size_t begin, size_t end) { return begin + kernel(&a[begin], end - begin); });
+
+    size_t result = 0;
+    for (size_t index : partials) {
+        if (a[index] > a[result]) {
+            result = index;
+        }
+    }
+    return result;
+}
+
+void mean_variance(const float* a, size_t count, float* mean, float* variance, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    auto kernel = (features.has_avx2 && features.has_fma) ? mean_m2_avx2 : mean_m2_scalar;
+    TelemetryScope telemetry(TelemetryFunction::mean_variance, count);
+    telemetry.isa((features.has_avx2 && features.has_fma) ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    struct Moments {
+        double n, mean, m2;
+    };
+    auto partials = parallel_map_blocks<Moments>(count, num_threads, reduce_min_block(),
+        [&](size_t begin, size_t end) {
+            Moments part{(double)(end - begin), 0.0, 0.0};
+            kernel(&a[begin], end - begin, &part.mean, &part.m2);
+            return part;
+        });
+
+    // Chan et al. pairwise combination of the per-thread moments
+    Moments total{0.0, 0.0, 0.0};
+    for (const Moments& part : partials) {
+        double n = total.n + part.n;
+        double delta = part.mean - total.mean;
+        total.mean += delta * part.n / n;
+        total.m2 += part.m2 + delta * delta * total.n * part.n / n;
+        total.n = n;
+    }
+
+    *mean = (float)total.mean;
+    *variance = count > 0 ? (float)(total.m2 / total.n) : 0.0f;
+}
+
+} // namespace simd_lib
@@ -0,0 +1,185 @@
+#include "simd_lib.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace simd_lib {
+
+// Input frames gathered per kernel pass; with 64 taps of history the
+// per-channel buffer stays within 5 KB
+static const size_t kResampleChunk = 1024;
+
+// Kaiser design for ~90 dB of stopband attenuation
+static const double kStopbandDb = 90.0;
+
+static size_t gcd(size_t a, size_t b) {
+    while (b != 0) {
+        size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Zeroth-order modified Bessel function of the first kind, by its power series
+static double bessel_i0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 64 && term > 1e-17 * sum; ++k) {
+        double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+    }
+    return sum;
+}
+
+static void design_bank(PolyphaseBank& bank, size_t taps_per_phase) {
+    const size_t L = bank.interpolation;
+    const size_t M = bank.decimation;
+    const size_t wider = std::max(L, M);
+
+    // Length in samples of the lower rate stays taps_per_phase, so decimating
+    // by M needs about M / L times as many taps per branch
+    size_t taps = (taps_per_phase * wider + L - 1) / L;
+    bank.taps = std::max<size_t>((taps + 7) / 8 * 8, 8);
+    const size_t length = bank.taps * L;
+
+    // Transition band of a Kaiser window (Harris), in cycles per lower-rate
+    // sample, ending at the lower Nyquist rate
+    const double span = (double)length / (double)wider;
+    const double transition = (kStopbandDb - 7.95) / (14.36 * span);
+    const double cutoff = std::max(0.5 - transition / 2.0, 0.05) / (double)wider;
+    const double beta = 0.1102 * (kStopbandDb - 8.7);
+
+    std::vector<double> h(length);
+    const double center = (double)(length - 1) / 2.0;
+    const double norm = bessel_i0(beta);
+    double sum = 0.0;
+    for (size_t n = 0; n < length; ++n) {
+        double t = (double)n - center;
+        double x = 2.0 * cutoff * t;
+        double sinc = t == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+        double r = t / (center + 0.5);
+        double window = bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / norm;
+        h[n] = sinc * window;
+        sum += h[n];
+    }
+
+    // Unit gain at DC for every branch on average: the zero-stuffed input
+    // carries 1 / L of the energy
+    bank.coefficients.assign(L * bank.taps, 0.0f);
+    for (size_t p = 0; p < L; ++p) {
+        for (size_t k = 0; k < bank.taps; ++k) {
+            bank.coefficients[p * bank.taps + (bank.taps - 1 - k)] = (float)(h[k * L + p] * (double)L / sum);
+        }
+    }
+}
+
+std::shared_ptr<const PolyphaseBank> get_polyphase_bank(size_t interpolation, size_t decimation,
+                                                         size_t taps_per_phase) {
+    static std::mutex cache_mutex;
+    static std::map<std::tuple<size_t, size_t, size_t>, std::shared_ptr<const PolyphaseBank>> cache;
+
+    if (interpolation == 0 || decimation == 0) {
+        interpolation = decimation = 1;
+    }
+    size_t divisor = gcd(interpolation, decimation);
+    interpolation /= divisor;
+    decimation /= divisor;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto& bank = cache[std::make_tuple(interpolation, decimation, taps_per_phase)];
+    if (!bank) {
+        auto values = std::make_shared<PolyphaseBank>();
+        values->interpolation = interpolation;
+        values->decimation = decimation;
+        design_bank(*values, taps_per_phase);
+        bank = values;
+    }
+    return bank;
+}
+
+Resampler::Resampler(size_t num_channels, size_t input_rate, size_t output_rate, size_t taps_per_phase)
+    : channels_(num_channels),
+      bank_(get_polyphase_bank(output_rate, input_rate, taps_per_phase)),
+      buffers_(num_channels * (bank_->taps - 1 + kResampleChunk), 0.0f),
+      inputs_(num_channels),
+      outputs_(num_channels) {}
+
+double Resampler::delay() const {
+    return (double)(bank_->taps * bank_->interpolation - 1) / (2.0 * (double)bank_->interpolation);
+}
+
+size_t Resampler::output_frames(size_t input_frames) const {
+    // Outputs at positions below input_frames * L, counting from position_
+    size_t end = input_frames * bank_->interpolation;
+    return end > position_ ? (end - position_ + bank_->decimation - 1) / bank_->decimation : 0;
+}
+
+size_t Resampler::run(const float* const* input, size_t input_stride, size_t frames, float* const* output,
+                      size_t output_stride) {
+    const auto& features = get_cpu_features();
+    auto kernel = features.has_avx2 && features.has_fma ? resample_polyphase_avx2 : resample_polyphase_scalar;
+    const PolyphaseBank& bank = *bank_;
+    const size_t history = bank.taps - 1;
+    const size_t width = history + kResampleChunk;
+
+    size_t written = 0;
+    for (size_t t = 0; t < frames; t += kResampleChunk) {
+        size_t n = std::min(kResampleChunk, frames - t);
+        size_t produced = 0, position = position_;
+        for (size_t c = 0; c < channels_; ++c) {
+            float* buffer = &buffers_[c * width];
+            for (size_t f = 0; f < n; ++f) {
+                buffer[history + f] = input[c][(t + f) * input_stride];
+            }
+            // Every channel advances identically; each starts from the same position
+            position = position_;
+            produced = kernel(buffer, history + n, bank.coefficients.data(), bank.taps, bank.interpolation,
+                              bank.decimation, &position, &output[c][written * output_stride], output_stride);
+            std::copy(&buffer[n], &buffer[n + history], buffer);
+        }
+        position_ = position - n * bank.interpolation;
+        written += produced;
+    }
+    return written;
+}
+
+size_t Resampler::process(const float* input, size_t frames, float* output) {
+    if (frames == 0 || channels_ == 0) {
+        return 0;
+    }
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::resample, frames * channels_);
+    telemetry.isa(features.has_avx2 && features.has_fma ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    for (size_t c = 0; c < channels_; ++c) {
+        inputs_[c] = &input[c];
+        outputs_[c] = &output[c];
+    }
+    return run(inputs_.data(), channels_, frames, outputs_.data(), channels_);
+}
+
+size_t Resampler::process_planar(const float* const* input, size_t frames, float* const* output) {
+    if (frames == 0 || channels_ == 0) {
+        return 0;
+    }
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::resample, frames * channels_);
+    telemetry.isa(features.has_avx2 && features.has_fma ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    return run(input, 1, frames, output, 1);
+}
+
+void Resampler::reset() {
+    position_ = 0;
+    std::fill(buffers_.begin(), buffers_.end(), 0.0f);
+}
+
+} // namespace simd_lib
@@ -0,0 +1,121 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include "tuning.h"
+#include <algorithm>
+#include <vector>
+
+namespace simd_lib {
+
+// Rows or columns per thread for the summed-area table passes
+static const size_t kTableMinElements = 1 << 16;
+
+typedef float (*ScanKernel)(const float*, float*, size_t, float);
+
+static void blocked_scan(const float* input, float* result, size_t count, size_t num_threads,
+                         ScanKernel kernel) {
+    const auto& features = get_cpu_features();
+    auto sum_kernel = features.has_avx2 ? vector_sum_avx2 : vector_sum_scalar;
+    // A threaded scan streams the array twice, so it only pays off once the
+    // blocks no longer fit in a core's L2 (256K floats unless tuned). Both
+    // passes must see the same partition, so read the threshold once.
+    size_t min_block = tuned(TuningParam::ScanMinBlock);
+
+    // Pass 1: the total of every block
+    struct BlockSum {
+        size_t begin;
+        float sum;
+    };
+    auto sums = parallel_map_blocks<BlockSum>(count, num_threads, min_block,
+        [&](size_t begin, size_t end) { return BlockSum{begin, sum_kernel(&input[begin], end - begin)}; });
+
+    if (sums.size() <= 1) {
+        kernel(input, result, count, 0.0f);
+        return;
+    }
+
+    // Exclusive scan of the block totals gives each block's starting offset
+    std::vector<size_t> begins(sums.size());
+    std::vector<float> offsets(sums.size());
+    float running = 0.0f;
+    for (size_t b = 0; b < sums.size(); ++b) {
+        begins[b] = sums[b].begin;
+        offsets[b] = running;
+        running += sums[b].sum;
+    }
+
+    // Pass 2: scan each block from its offset; parallel_for reproduces the
+    // same partition for the same arguments
+    parallel_for(count, num_threads, min_block, [&](size_t begin, size_t end) {
+        size_t b = std::lower_bound(begins.begin(), begins.end(), begin) - begins.begin();
+        kernel(&input[begin], &result[begin], end - begin, offsets[b]);
+    });
+}
+
+void inclusive_scan(const float* input, float* result, size_t count, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    ScanKernel kernel = features.has_avx2 ? inclusive_scan_avx2 : inclusive_scan_scalar;
+    TelemetryScope telemetry(TelemetryFunction::inclusive_scan, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    if (count < 2 * tuned(TuningParam::ScanMinBlock) || resolve_thread_count(num_threads) <= 1) {
+        kernel(input, result, count, 0.0f);
+        return;
+    }
+    blocked_scan(input, result, count, num_threads, kernel);
+}
+
+void exclusive_scan(const float* input, float* result, size_t count, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    ScanKernel kernel = features.has_avx2 ? exclusive_scan_avx2 : exclusive_scan_scalar;
+    TelemetryScope telemetry(TelemetryFunction::exclusive_scan, count);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    if (count < 2 * tuned(TuningParam::ScanMinBlock) || resolve_thread_count(num_threads) <= 1) {
+        kernel(input, result, count, 0.0f);
+        return;
+    }
+    blocked_scan(input, result, count, num_threads, kernel);
+}
+
+void summed_area_table(const float* input, float* result, size_t rows, size_t cols, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    ScanKernel kernel = features.has_avx2 ? inclusive_scan_avx2 : inclusive_scan_scalar;
+    TelemetryScope telemetry(TelemetryFunction::summed_area_table, rows * cols);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    if (rows == 0 || cols == 0) {
+        return;
+    }
+
+    if (rows * cols < 2 * kTableMinElements || resolve_thread_count(num_threads) <= 1) {
+        // Scan each row and add the finished row above while it is still in cache
+        for (size_t r = 0; r < rows; ++r) {
+            float* out_row = &result[r * cols];
+            kernel(&input[r * cols], out_row, cols, 0.0f);
+            if (r > 0) {
+                vector_add(out_row, &result[(r - 1) * cols], out_row, cols);
+            }
+        }
+        return;
+    }
+
+    // Pass 1: independent row scans. Pass 2: accumulate down each column strip.
+    // Both passes perform the same additions as the fused loop above.
+    size_t min_rows = std::max<size_t>(1, kTableMinElements / cols);
+    parallel_for(rows, num_threads, min_rows, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            kernel(&input[r * cols], &result[r * cols], cols, 0.0f);
+        }
+    });
+
+    size_t min_cols = std::max<size_t>(64, kTableMinElements / rows);
+    parallel_for(cols, num_threads, min_cols, [&](size_t begin, size_t end) {
+        for (size_t r = 1; r < rows; ++r) {
+            float* out = &result[r * cols + begin];
+            vector_add(out, out - cols, out, end - begin);
+        }
+    });
+}
+
+} // namespace simd_lib
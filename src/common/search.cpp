@@ -0,0 +1,159 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include "tuning.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace simd_lib {
+
+using BatchKernel = void (*)(const float*, const float*, size_t, size_t, float*);
+
+static bool use_avx2_batch() {
+    const auto& features = get_cpu_features();
+    return features.has_avx2 && features.has_fma;
+}
+
+static BatchKernel select_batch_kernel(SimilarityMetric metric) {
+    bool use_avx2 = use_avx2_batch();
+
+    switch (metric) {
+    case SimilarityMetric::L2Squared:
+        return use_avx2 ? batch_l2_squared_avx2 : batch_l2_squared_scalar;
+    case SimilarityMetric::Cosine:
+        return use_avx2 ? batch_cosine_avx2 : batch_cosine_scalar;
+    case SimilarityMetric::DotProduct:
+    default:
+        return use_avx2 ? batch_dot_avx2 : batch_dot_scalar;
+    }
+}
+
+// Give each thread at least tuned(BatchMinFloats) floats of rows (64K by
+// default) so spawning pays for itself
+static size_t min_rows_per_thread(size_t dim) {
+    return std::max<size_t>(1, tuned(TuningParam::BatchMinFloats) / std::max<size_t>(dim, 1));
+}
+
+static void run_batch(TelemetryFunction function, SimilarityMetric metric, const float* query,
+                      const float* matrix, size_t rows, size_t dim, float* out, size_t num_threads) {
+    BatchKernel kernel = select_batch_kernel(metric);
+    TelemetryScope telemetry(function, rows * dim);
+    telemetry.isa(use_avx2_batch() ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+    parallel_for(rows, num_threads, min_rows_per_thread(dim), [&](size_t begin, size_t end) {
+        kernel(query, &matrix[begin * dim], end - begin, dim, &out[begin]);
+    });
+}
+
+void batch_dot(const float* query, const float* matrix, size_t rows, size_t dim, float* out, size_t num_threads) {
+    run_batch(TelemetryFunction::batch_dot, SimilarityMetric::DotProduct, query, matrix, rows, dim, out, num_threads);
+}
+
+void batch_l2_squared(const float* query, const float* matrix, size_t rows, size_t dim, float* out, size_t num_threads) {
+    run_batch(TelemetryFunction::batch_l2_squared, SimilarityMetric::L2Squared, query, matrix, rows, dim, out, num_threads);
+}
+
+void batch_cosine(const float* query, const float* matrix, size_t rows, size_t dim, float* out, size_t num_threads) {
+    run_batch(TelemetryFunction::batch_cosine, SimilarityMetric::Cosine, query, matrix, rows, dim, out, num_threads);
+}
+
+size_t select_greater(const float* values, size_t count, float threshold, uint32_t* positions) {
+    const auto& features = get_cpu_features();
+    TelemetryScope telemetry(TelemetryFunction::select_greater, count);
+
+    if (features.has_avx2) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return select_greater_avx2(values, count, threshold, positions);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return select_greater_scalar(values, count, threshold, positions);
+    }
+}
+
+namespace {
+
+struct Candidate {
+    float score;
+    size_t index;
+};
+
+// Best first: higher score, then lower row index for deterministic ties
+bool better(const Candidate& a, const Candidate& b) {
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+}
+
+// Scores rows in blocks small enough to stay in L1 and keeps a k-element
+// min-heap (worst candidate at the front). Once the heap is full its worst
+// score becomes the select_greater threshold, so rejected rows cost one SIMD
+// compare instead of a heap operation.
+void top_k_range(const float* query, const float* matrix, size_t begin, size_t end, size_t dim,
+                 size_t k, SimilarityMetric metric, BatchKernel kernel, std::vector<Candidate>& heap) {
+    const size_t block_rows = std::max<size_t>(1, tuned(TuningParam::TopKBlockRows));
+    std::vector<float> scores(block_rows);
+    std::vector<uint32_t> positions(block_rows);
+
+    heap.clear();
+    heap.reserve(k);
+
+    for (size_t block = begin; block < end; block += block_rows) {
+        size_t n = std::min(block_rows, end - block);
+        kernel(query, &matrix[block * dim], n, dim, scores.data());
+
+        // Smaller distances are better: negate so one ordering serves all metrics
+        if (metric == SimilarityMetric::L2Squared) {
+            vector_scale(scores.data(), -1.0f, scores.data(), n);
+        }
+
+        float threshold = heap.size() < k ? -std::numeric_limits<float>::infinity() : heap.front().score;
+        size_t found = select_greater(scores.data(), n, threshold, positions.data());
+
+        for (size_t j = 0; j < found; ++j) {
+            Candidate candidate{scores[positions[j]], block + positions[j]};
+            if (heap.size() < k) {
+                heap.push_back(candidate);
+                std::push_heap(heap.begin(), heap.end(), better);
+            } else if (candidate.score > heap.front().score) {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = candidate;
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+    }
+}
+
+} // namespace
+
+size_t top_k_search(const float* query, const float* matrix, size_t rows, size_t dim, size_t k,
+                    SimilarityMetric metric, size_t* indices, float* scores, size_t num_threads) {
+    k = std::min(k, rows);
+    if (k == 0) {
+        return 0;
+    }
+
+    BatchKernel kernel = select_batch_kernel(metric);
+    TelemetryScope telemetry(TelemetryFunction::top_k_search, rows * dim);
+    telemetry.isa(use_avx2_batch() ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+    std::vector<Candidate> merged;
+    std::mutex merge_mutex;
+
+    // Each thread selects its own top k over a row range; the survivors are merged below
+    parallel_for(rows, num_threads, std::max(min_rows_per_thread(dim), k), [&](size_t begin, size_t end) {
+        std::vector<Candidate> heap;
+        top_k_range(query, matrix, begin, end, dim, k, metric, kernel, heap);
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        merged.insert(merged.end(), heap.begin(), heap.end());
+    });
+
+    std::partial_sort(merged.begin(), merged.begin() + std::min(k, merged.size()), merged.end(), better);
+    size_t found = std::min(k, merged.size());
+
+    for (size_t i = 0; i < found; ++i) {
+        indices[i] = merged[i].index;
+        scores[i] = metric == SimilarityMetric::L2Squared ? -merged[i].score : merged[i].score;
+    }
+    return found;
+}
+
+} // namespace simd_lib
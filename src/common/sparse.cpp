@@ -0,0 +1,179 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include "tuning.h"
+#include <algorithm>
+#include <vector>
+
+namespace simd_lib {
+
+static bool use_avx2_sparse() {
+    const auto& features = get_cpu_features();
+    return features.has_avx2 && features.has_fma;
+}
+
+float sparse_dot_dense(const uint32_t* indices, const float* values, size_t nnz, const float* dense) {
+    TelemetryScope telemetry(TelemetryFunction::sparse_dot_dense, nnz);
+
+    if (use_avx2_sparse()) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return sparse_dot_dense_avx2(indices, values, nnz, dense);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return sparse_dot_dense_scalar(indices, values, nnz, dense);
+    }
+}
+
+float sparse_dot_dense_delta16(const uint16_t* deltas, const float* values, size_t nnz, const float* dense) {
+    TelemetryScope telemetry(TelemetryFunction::sparse_dot_dense, nnz);
+
+    if (use_avx2_sparse()) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return sparse_dot_dense_delta16_avx2(deltas, values, nnz, dense);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return sparse_dot_dense_delta16_scalar(deltas, values, nnz, dense);
+    }
+}
+
+float sparse_dot_sparse(const uint32_t* a_indices, const float* a_values, size_t a_nnz,
+                        const uint32_t* b_indices, const float* b_values, size_t b_nnz) {
+    TelemetryScope telemetry(TelemetryFunction::sparse_dot_sparse, a_nnz + b_nnz);
+
+    if (use_avx2_sparse()) {
+        telemetry.isa(DispatchIsa::AVX2);
+        return sparse_dot_sparse_avx2(a_indices, a_values, a_nnz, b_indices, b_values, b_nnz);
+    } else {
+        telemetry.isa(DispatchIsa::Scalar);
+        return sparse_dot_sparse_scalar(a_indices, a_values, a_nnz, b_indices, b_values, b_nnz);
+    }
+}
+
+// Appends one sparse vector in delta16 form, starting from index 0
+static void append_delta16(const uint32_t* indices, const float* values, size_t nnz,
+                           std::vector<uint16_t>& deltas, std::vector<float>& out_values) {
+    uint32_t previous = 0;
+    for (size_t i = 0; i < nnz; ++i) {
+        uint32_t gap = indices[i] - previous;
+        while (gap > 0xFFFF) {
+            deltas.push_back(0xFFFF);
+            out_values.push_back(0.0f);
+            gap -= 0xFFFF;
+        }
+        deltas.push_back((uint16_t)gap);
+        out_values.push_back(values[i]);
+        previous = indices[i];
+    }
+}
+
+SparseVector16 compress_sparse_indices(const uint32_t* indices, const float* values, size_t nnz) {
+    SparseVector16 result;
+    result.deltas.reserve(nnz);
+    result.values.reserve(nnz);
+    append_delta16(indices, values, nnz, result.deltas, result.values);
+    return result;
+}
+
+CsrMatrix csr_from_dense(const float* dense, size_t rows, size_t cols) {
+    CsrMatrix matrix;
+    matrix.rows = rows;
+    matrix.cols = cols;
+    matrix.row_offsets.reserve(rows + 1);
+    matrix.row_offsets.push_back(0);
+    for (size_t r = 0; r < rows; ++r) {
+        const float* row = &dense[r * cols];
+        for (size_t c = 0; c < cols; ++c) {
+            if (row[c] != 0.0f) {
+                matrix.col_indices.push_back((uint32_t)c);
+                matrix.values.push_back(row[c]);
+            }
+        }
+        matrix.row_offsets.push_back(matrix.values.size());
+    }
+    return matrix;
+}
+
+CsrMatrix16 compress_csr_indices(const CsrMatrix& matrix) {
+    CsrMatrix16 result;
+    result.rows = matrix.rows;
+    result.cols = matrix.cols;
+    result.row_offsets.reserve(matrix.rows + 1);
+    result.row_offsets.push_back(0);
+    result.col_deltas.reserve(matrix.values.size());
+    result.values.reserve(matrix.values.size());
+    for (size_t r = 0; r < matrix.rows; ++r) {
+        size_t begin = matrix.row_offsets[r];
+        size_t end = matrix.row_offsets[r + 1];
+        append_delta16(&matrix.col_indices[begin], &matrix.values[begin], end - begin, result.col_deltas,
+                       result.values);
+        result.row_offsets.push_back(result.values.size());
+    }
+    return result;
+}
+
+// Runs row_fn(row_begin, row_end) over blocks that each hold about the same
+// number of nonzeros. Each thread gets at least tuned(BatchMinFloats) of them.
+template <typename RowFn>
+static void for_balanced_rows(const std::vector<size_t>& row_offsets, size_t rows, size_t num_threads,
+                              RowFn row_fn) {
+    size_t nnz = row_offsets[rows];
+    size_t min_nnz = std::max<size_t>(1, tuned(TuningParam::BatchMinFloats));
+    size_t threads = std::min(resolve_thread_count(num_threads), std::max<size_t>(1, nnz / min_nnz));
+    if (threads <= 1) {
+        row_fn(0, rows);
+        return;
+    }
+
+    std::vector<size_t> bounds(threads + 1, rows);
+    bounds[0] = 0;
+    for (size_t t = 1; t < threads; ++t) {
+        size_t target = nnz / threads * t;
+        bounds[t] = (size_t)(std::lower_bound(row_offsets.begin(), row_offsets.begin() + rows + 1, target) -
+                             row_offsets.begin());
+    }
+    parallel_for(threads, threads, 1, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            if (bounds[t] < bounds[t + 1]) {
+                row_fn(bounds[t], bounds[t + 1]);
+            }
+        }
+    });
+}
+
+void spmv(const CsrMatrix& matrix, const float* x, float* y, size_t num_threads) {
+    if (matrix.rows == 0) {
+        return;
+    }
+    bool use_avx2 = use_avx2_sparse();
+    auto kernel = use_avx2 ? sparse_dot_dense_avx2 : sparse_dot_dense_scalar;
+    TelemetryScope telemetry(TelemetryFunction::spmv, matrix.values.size());
+    telemetry.isa(use_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    for_balanced_rows(matrix.row_offsets, matrix.rows, num_threads, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            size_t offset = matrix.row_offsets[r];
+            size_t nnz = matrix.row_offsets[r + 1] - offset;
+            y[r] = kernel(&matrix.col_indices[offset], &matrix.values[offset], nnz, x);
+        }
+    });
+}
+
+void spmv(const CsrMatrix16& matrix, const float* x, float* y, size_t num_threads) {
+    if (matrix.rows == 0) {
+        return;
+    }
+    bool use_avx2 = use_avx2_sparse();
+    auto kernel = use_avx2 ? sparse_dot_dense_delta16_avx2 : sparse_dot_dense_delta16_scalar;
+    TelemetryScope telemetry(TelemetryFunction::spmv, matrix.values.size());
+    telemetry.isa(use_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    for_balanced_rows(matrix.row_offsets, matrix.rows, num_threads, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            size_t offset = matrix.row_offsets[r];
+            size_t nnz = matrix.row_offsets[r + 1] - offset;
+            y[r] = kernel(&matrix.col_deltas[offset], &matrix.values[offset], nnz, x);
+        }
+    });
+}
+
+} // namespace simd_lib
@@ -0,0 +1,111 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <vector>
+
+namespace simd_lib {
+
+// Power below which LogPower output is clamped: -200 dB
+static const float kPowerFloor = 1e-20f;
+
+// Frames per thread: enough FFT work that spawning pays for itself
+static const size_t kMinFrameSamplesPerThread = 1 << 16;
+
+STFT::STFT(const STFTConfig& config) : config_(config) {
+    config_.frame_size = next_power_of_2(std::max<size_t>(config_.frame_size, 2));
+    config_.hop_size = std::max<size_t>(config_.hop_size, 1);
+    plan_ = get_fft_plan(config_.frame_size);
+    window_ = get_window(config_.window, config_.frame_size);
+    scratch_real_.resize(config_.frame_size);
+    scratch_imag_.resize(config_.frame_size);
+}
+
+size_t STFT::frame_count(size_t count) const {
+    return count >= config_.frame_size ? (count - config_.frame_size) / config_.hop_size + 1 : 0;
+}
+
+static bool use_avx2_kernels() {
+    const auto& features = get_cpu_features();
+    return features.has_avx2 && features.has_fma;
+}
+
+// The kernels are called directly: a frame is a few KB, so the dispatchers'
+// feature checks and telemetry would be a visible share of its cost. The
+// spectrum is reduced to the output type in one pass over the bins.
+void STFT::transform_frame(const float* samples, float* out, float* real, float* imag) const {
+    const size_t n = config_.frame_size;
+    const size_t num_bins = bins();
+    const bool avx2 = use_avx2_kernels();
+
+    (avx2 ? vector_multiply_avx2 : vector_multiply_scalar)(samples, window_->data(), real, n);
+    std::fill(imag, imag + n, 0.0f);
+    plan_->execute(real, imag, false);
+
+    // Bins above n / 2 mirror the ones below for real input
+    switch (config_.output) {
+    case SpectrumType::Magnitude:
+        (avx2 ? complex_magnitude_avx2 : complex_magnitude_scalar)(real, imag, out, num_bins);
+        break;
+    case SpectrumType::LogPower:
+        (avx2 ? complex_power_db_avx2 : complex_power_db_scalar)(real, imag, kPowerFloor, out, num_bins);
+        break;
+    case SpectrumType::Power:
+    default:
+        (avx2 ? complex_magnitude_squared_avx2 : complex_magnitude_squared_scalar)(real, imag, out, num_bins);
+        break;
+    }
+}
+
+size_t STFT::process(const float* signal, size_t count, float* out) const {
+    TelemetryScope telemetry(TelemetryFunction::stft, count);
+    telemetry.isa(use_avx2_kernels() ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    size_t frames = frame_count(count);
+    size_t min_frames = std::max<size_t>(1, kMinFrameSamplesPerThread / config_.frame_size);
+
+    parallel_for(frames, config_.num_threads, min_frames, [&](size_t begin, size_t end) {
+        std::vector<float> real(config_.frame_size), imag(config_.frame_size);
+        for (size_t f = begin; f < end; ++f) {
+            transform_frame(&signal[f * config_.hop_size], &out[f * bins()], real.data(), imag.data());
+        }
+    });
+    return frames;
+}
+
+size_t STFT::pending_frames(size_t count) const {
+    size_t available = carry_.size() + (count > skip_ ? count - skip_ : 0);
+    return frame_count(available);
+}
+
+size_t STFT::push(const float* samples, size_t count, float* out, size_t max_frames) {
+    TelemetryScope telemetry(TelemetryFunction::stft, count);
+    telemetry.isa(use_avx2_kernels() ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    // With hop_size > frame_size the samples between frames are dropped
+    size_t skipped = std::min(skip_, count);
+    skip_ -= skipped;
+    carry_.insert(carry_.end(), samples + skipped, samples + count);
+
+    size_t frames = 0;
+    size_t offset = 0;
+    while (frames < max_frames && carry_.size() >= offset + config_.frame_size) {
+        transform_frame(&carry_[offset], &out[frames * bins()], scratch_real_.data(), scratch_imag_.data());
+        ++frames;
+        offset += config_.hop_size;
+    }
+
+    if (offset > carry_.size()) {
+        skip_ = offset - carry_.size();
+        offset = carry_.size();
+    }
+    carry_.erase(carry_.begin(), carry_.begin() + offset);
+    return frames;
+}
+
+void STFT::reset() {
+    carry_.clear();
+    skip_ = 0;
+}
+
+} // namespace simd_lib
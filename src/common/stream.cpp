@@ -0,0 +1,275 @@
+#include "simd_lib.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SIMD_LIB_HAS_MMAP 1
+#endif
+
+namespace simd_lib {
+
+// Elements reduced in float by one kernel call before the result is folded
+// into a double: 16 KB, so the float error stays small and the call overhead
+// is noise
+static const size_t kAccumulateBlock = 4096;
+
+// Calls fn(offset, length) for each block of a chunk
+template <typename Fn>
+static void for_each_block(size_t count, Fn fn) {
+    for (size_t begin = 0; begin < count; begin += kAccumulateBlock) {
+        fn(begin, std::min(kAccumulateBlock, count - begin));
+    }
+}
+
+// The dot and norm kernels contain FMA instructions
+static bool use_fma_kernels() {
+    const auto& features = get_cpu_features();
+    return features.has_avx2 && features.has_fma;
+}
+
+void SumAccumulator::add(const float* data, size_t count) {
+    auto kernel = get_cpu_features().has_avx2 ? vector_sum_avx2 : vector_sum_scalar;
+    for_each_block(count, [&](size_t begin, size_t n) { sum_ += (double)kernel(&data[begin], n); });
+    count_ += count;
+}
+
+void SumAccumulator::merge(const SumAccumulator& other) {
+    sum_ += other.sum_;
+    count_ += other.count_;
+}
+
+void DotAccumulator::add(const float* a, const float* b, size_t count) {
+    auto kernel = use_fma_kernels() ? dot_product_avx2 : dot_product_scalar;
+    for_each_block(count, [&](size_t begin, size_t n) { dot_ += (double)kernel(&a[begin], &b[begin], n); });
+    count_ += count;
+}
+
+void DotAccumulator::merge(const DotAccumulator& other) {
+    dot_ += other.dot_;
+    count_ += other.count_;
+}
+
+void NormAccumulator::add(const float* data, size_t count) {
+    auto kernel = use_fma_kernels() ? vector_norm_squared_avx2 : vector_norm_squared_scalar;
+    for_each_block(count, [&](size_t begin, size_t n) { sum_squares_ += (double)kernel(&data[begin], n); });
+    count_ += count;
+}
+
+void NormAccumulator::merge(const NormAccumulator& other) {
+    sum_squares_ += other.sum_squares_;
+    count_ += other.count_;
+}
+
+double NormAccumulator::norm() const {
+    return std::sqrt(sum_squares_);
+}
+
+MinMaxAccumulator::MinMaxAccumulator()
+    : min_(std::numeric_limits<float>::infinity()), max_(-std::numeric_limits<float>::infinity()) {}
+
+void MinMaxAccumulator::add(const float* data, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    // No rounding to bound, so the whole chunk goes to the kernel at once
+    float lo, hi;
+    if (get_cpu_features().has_avx2) {
+        vector_minmax_avx2(data, count, &lo, &hi);
+    } else {
+        vector_minmax_scalar(data, count, &lo, &hi);
+    }
+    min_ = lo < min_ ? lo : min_;
+    max_ = hi > max_ ? hi : max_;
+    count_ += count;
+}
+
+void MinMaxAccumulator::merge(const MinMaxAccumulator& other) {
+    min_ = other.min_ < min_ ? other.min_ : min_;
+    max_ = other.max_ > max_ ? other.max_ : max_;
+    count_ += other.count_;
+}
+
+void MeanVarianceAccumulator::combine(double n, double mean, double m2) {
+    // Chan et al. pairwise update, as in mean_variance()
+    double total = (double)count_ + n;
+    double delta = mean - mean_;
+    mean_ += delta * n / total;
+    m2_ += m2 + delta * delta * (double)count_ * n / total;
+    count_ += (uint64_t)n;
+}
+
+void MeanVarianceAccumulator::add(const float* data, size_t count) {
+    const auto& features = get_cpu_features();
+    auto kernel = (features.has_avx2 && features.has_fma) ? mean_m2_avx2 : mean_m2_scalar;
+    for_each_block(count, [&](size_t begin, size_t n) {
+        double block_mean, block_m2;
+        kernel(&data[begin], n, &block_mean, &block_m2);
+        combine((double)n, block_mean, block_m2);
+    });
+}
+
+void MeanVarianceAccumulator::merge(const MeanVarianceAccumulator& other) {
+    if (other.count_ > 0) {
+        combine((double)other.count_, other.mean_, other.m2_);
+    }
+}
+
+namespace {
+
+struct FileCloser {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+// Size in floats; false if the file is missing or holds a partial float
+bool float_count(const std::string& path, size_t* count) {
+    std::error_code error;
+    uintmax_t bytes = std::filesystem::file_size(path, error);
+    if (error || bytes % sizeof(float) != 0) {
+        return false;
+    }
+    *count = (size_t)(bytes / sizeof(float));
+    return true;
+}
+
+bool for_each_chunk_buffered(const std::string& path, size_t total,
+                             const std::function<void(const float*, size_t)>& fn, size_t chunk_floats) {
+    FilePtr file(std::fopen(path.c_str(), "rb"));
+    if (!file) {
+        return false;
+    }
+
+    std::vector<float> buffers[2] = {std::vector<float>(std::min(chunk_floats, total)),
+                                     std::vector<float>(std::min(chunk_floats, total))};
+    auto read = [&](std::vector<float>& buffer) {
+        return std::fread(buffer.data(), sizeof(float), buffer.size(), file.get());
+    };
+
+    size_t remaining = total;
+    size_t cur = 0;
+    size_t got = remaining > 0 ? read(buffers[cur]) : 0;
+    while (got > 0) {
+        remaining -= got;
+        std::future<size_t> next;
+        if (remaining > 0) {
+            next = std::async(std::launch::async, read, std::ref(buffers[cur ^ 1]));
+        }
+        fn(buffers[cur].data(), got);
+        got = next.valid() ? next.get() : 0;
+        cur ^= 1;
+    }
+    // A short read before the end means the file shrank or the read failed
+    return remaining == 0 && !std::ferror(file.get());
+}
+
+#ifdef SIMD_LIB_HAS_MMAP
+bool for_each_chunk_mapped(const std::string& path, size_t total,
+                           const std::function<void(const float*, size_t)>& fn, size_t chunk_floats) {
+    if (total == 0) {
+        return true;
+    }
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    size_t bytes = total * sizeof(float);
+    void* mapping = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    // Let the kernel read ahead aggressively and drop pages behind us
+    madvise(mapping, bytes, MADV_SEQUENTIAL);
+
+    const float* data = static_cast<const float*>(mapping);
+    for (size_t begin = 0; begin < total; begin += chunk_floats) {
+        fn(&data[begin], std::min(chunk_floats, total - begin));
+    }
+    munmap(mapping, bytes);
+    return true;
+}
+#endif
+
+} // namespace
+
+bool for_each_chunk(const std::string& path, const std::function<void(const float*, size_t)>& fn,
+                    size_t chunk_floats, ChunkSource source) {
+    size_t total = 0;
+    if (!float_count(path, &total)) {
+        return false;
+    }
+    chunk_floats = std::max<size_t>(chunk_floats, 1);
+
+#ifdef SIMD_LIB_HAS_MMAP
+    if (source == ChunkSource::Mapped) {
+        return for_each_chunk_mapped(path, total, fn, chunk_floats);
+    }
+#else
+    (void)source;
+#endif
+    return for_each_chunk_buffered(path, total, fn, chunk_floats);
+}
+
+bool transform_file(const std::string& input_path, const std::string& output_path,
+                    const std::function<void(const float*, float*, size_t)>& kernel, size_t chunk_floats) {
+    size_t total = 0;
+    if (!float_count(input_path, &total)) {
+        return false;
+    }
+    FilePtr input(std::fopen(input_path.c_str(), "rb"));
+    FilePtr output(std::fopen(output_path.c_str(), "wb"));
+    if (!input || !output) {
+        return false;
+    }
+
+    size_t chunk = std::max<size_t>(1, std::min(chunk_floats, total));
+    std::vector<float> in[2] = {std::vector<float>(chunk), std::vector<float>(chunk)};
+    std::vector<float> out[2] = {std::vector<float>(chunk), std::vector<float>(chunk)};
+    auto read = [&](std::vector<float>& buffer) {
+        return std::fread(buffer.data(), sizeof(float), buffer.size(), input.get());
+    };
+    auto write = [&](const std::vector<float>& buffer, size_t count) {
+        return std::fwrite(buffer.data(), sizeof(float), count, output.get()) == count;
+    };
+
+    size_t remaining = total;
+    size_t cur = 0;
+    size_t got = remaining > 0 ? read(in[cur]) : 0;
+    bool ok = true;
+    std::future<bool> pending_write;
+    while (got > 0) {
+        remaining -= got;
+        std::future<size_t> next;
+        if (remaining > 0) {
+            next = std::async(std::launch::async, read, std::ref(in[cur ^ 1]));
+        }
+
+        kernel(in[cur].data(), out[cur].data(), got);
+
+        // The previous write used out[cur ^ 1]; it must finish before the
+        // next iteration computes into that buffer
+        if (pending_write.valid()) {
+            ok = pending_write.get() && ok;
+        }
+        pending_write = std::async(std::launch::async, write, std::cref(out[cur]), got);
+
+        got = next.valid() ? next.get() : 0;
+        cur ^= 1;
+    }
+    if (pending_write.valid()) {
+        ok = pending_write.get() && ok;
+    }
+    return ok && remaining == 0 && !std::ferror(input.get()) && std::fflush(output.get()) == 0;
+}
+
+} // namespace simd_lib
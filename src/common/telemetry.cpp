@@ -0,0 +1,254 @@
+#include "telemetry.h"
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace simd_lib {
+
+std::atomic<bool> g_telemetry_enabled(false);
+
+static const size_t kFunctionCount = (size_t)TelemetryFunction::Count;
+static const size_t kIsaCount = (size_t)DispatchIsa::Count;
+
+static const char* const kFunctionNames[] = {
+#define SIMD_TELEMETRY_NAME(name) #name,
+    SIMD_TELEMETRY_FUNCTIONS(SIMD_TELEMETRY_NAME)
+#undef SIMD_TELEMETRY_NAME
+};
+
+namespace {
+
+// Written only by the owning thread (relaxed load + store, no lock prefix);
+// read by any thread while aggregating
+struct FunctionCounters {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> isa_calls[kIsaCount] = {};
+    std::atomic<uint64_t> size_histogram[kTelemetrySizeBuckets] = {};
+};
+
+struct ThreadCounters {
+    FunctionCounters functions[kFunctionCount];
+};
+
+inline void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+// Plain totals, used for the baseline and for threads that have exited
+struct Totals {
+    uint64_t calls[kFunctionCount] = {};
+    uint64_t total_ns[kFunctionCount] = {};
+    uint64_t isa_calls[kFunctionCount][kIsaCount] = {};
+    uint64_t size_histogram[kFunctionCount][kTelemetrySizeBuckets] = {};
+
+    void add(const ThreadCounters& counters) {
+        for (size_t f = 0; f < kFunctionCount; ++f) {
+            const FunctionCounters& c = counters.functions[f];
+            calls[f] += c.calls.load(std::memory_order_relaxed);
+            total_ns[f] += c.total_ns.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < kIsaCount; ++i) {
+                isa_calls[f][i] += c.isa_calls[i].load(std::memory_order_relaxed);
+            }
+            for (size_t b = 0; b < kTelemetrySizeBuckets; ++b) {
+                size_histogram[f][b] += c.size_histogram[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// Live per-thread blocks, counts from exited threads, and the reset baseline.
+// The mutex is taken when a thread first records, when it exits, and when
+// aggregating; never on the recording path itself.
+std::mutex g_registry_mutex;
+std::vector<ThreadCounters*> g_threads;
+Totals g_retired;
+Totals g_baseline;
+
+struct ThreadRegistration {
+    ThreadCounters* counters = nullptr;
+
+    ThreadCounters* get() {
+        if (!counters) {
+            counters = new ThreadCounters();
+            std::lock_guard<std::mutex> lock(g_registry_mutex);
+            g_threads.push_back(counters);
+        }
+        return counters;
+    }
+
+    ~ThreadRegistration() {
+        if (!counters) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        g_retired.add(*counters);
+        for (size_t i = 0; i < g_threads.size(); ++i) {
+            if (g_threads[i] == counters) {
+                g_threads.erase(g_threads.begin() + i);
+                break;
+            }
+        }
+        delete counters;
+    }
+};
+
+thread_local ThreadRegistration t_registration;
+thread_local bool t_in_call = false;
+
+size_t size_bucket(size_t size) {
+    size_t bucket = 0;
+    while (size != 0 && bucket + 1 < kTelemetrySizeBuckets) {
+        size >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+Totals aggregate_locked() {
+    Totals totals = g_retired;
+    for (const ThreadCounters* counters : g_threads) {
+        totals.add(*counters);
+    }
+    return totals;
+}
+
+} // namespace
+
+bool telemetry_begin() {
+    if (t_in_call) {
+        return false;
+    }
+    t_in_call = true;
+    return true;
+}
+
+void telemetry_end(TelemetryFunction function, size_t size, DispatchIsa isa, uint64_t elapsed_ns) {
+    t_in_call = false;
+    FunctionCounters& c = t_registration.get()->functions[(size_t)function];
+    bump(c.calls, 1);
+    bump(c.total_ns, elapsed_ns);
+    bump(c.isa_calls[(size_t)isa], 1);
+    bump(c.size_histogram[size_bucket(size)], 1);
+}
+
+bool telemetry_nested() {
+    return t_in_call;
+}
+
+void telemetry_set_nested(bool nested) {
+    t_in_call = nested;
+}
+
+void set_telemetry_enabled(bool enabled) {
+    g_telemetry_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool telemetry_enabled() {
+    return g_telemetry_enabled.load(std::memory_order_relaxed);
+}
+
+const char* dispatch_isa_name(DispatchIsa isa) {
+    switch (isa) {
+    case DispatchIsa::Scalar: return "scalar";
+    case DispatchIsa::SSE4: return "sse4";
+    case DispatchIsa::AVX2: return "avx2";
+    case DispatchIsa::AVXVNNI: return "avxvnni";
+    default: return "unknown";
+    }
+}
+
+static KernelStats stats_for(const Totals& totals, size_t f) {
+    KernelStats stats;
+    stats.function = kFunctionNames[f];
+    stats.calls = totals.calls[f] - g_baseline.calls[f];
+    stats.total_ns = totals.total_ns[f] - g_baseline.total_ns[f];
+    for (size_t i = 0; i < kIsaCount; ++i) {
+        stats.isa_calls[i] = totals.isa_calls[f][i] - g_baseline.isa_calls[f][i];
+    }
+    for (size_t b = 0; b < kTelemetrySizeBuckets; ++b) {
+        stats.size_histogram[b] = totals.size_histogram[f][b] - g_baseline.size_histogram[f][b];
+    }
+    return stats;
+}
+
+size_t telemetry_snapshot(KernelStats* stats, size_t max_stats) {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    Totals totals = aggregate_locked();
+
+    size_t found = 0;
+    for (size_t f = 0; f < kFunctionCount; ++f) {
+        if (totals.calls[f] == g_baseline.calls[f]) {
+            continue;
+        }
+        if (found < max_stats) {
+            stats[found] = stats_for(totals, f);
+        }
+        ++found;
+    }
+    return found;
+}
+
+bool telemetry_function_stats(const char* function, KernelStats* stats) {
+    for (size_t f = 0; f < kFunctionCount; ++f) {
+        if (std::strcmp(kFunctionNames[f], function) == 0) {
+            std::lock_guard<std::mutex> lock(g_registry_mutex);
+            *stats = stats_for(aggregate_locked(), f);
+            return true;
+        }
+    }
+    return false;
+}
+
+void telemetry_reset() {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    g_baseline = aggregate_locked();
+}
+
+std::string telemetry_json() {
+    std::vector<KernelStats> stats(kFunctionCount);
+    stats.resize(telemetry_snapshot(stats.data(), stats.size()));
+
+    std::string json = "{\n  \"enabled\": ";
+    json += telemetry_enabled() ? "true" : "false";
+    json += ",\n  \"functions\": [";
+    char buffer[128];
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const KernelStats& s = stats[i];
+        std::snprintf(buffer, sizeof(buffer), "%s\n    {\"name\": \"%s\", \"calls\": %llu, \"total_ns\": %llu",
+                      i ? "," : "", s.function, (unsigned long long)s.calls, (unsigned long long)s.total_ns);
+        json += buffer;
+
+        json += ", \"isa\": {";
+        bool first = true;
+        for (size_t k = 0; k < kIsaCount; ++k) {
+            if (s.isa_calls[k] == 0) {
+                continue;
+            }
+            std::snprintf(buffer, sizeof(buffer), "%s\"%s\": %llu", first ? "" : ", ",
+                          dispatch_isa_name((DispatchIsa)k), (unsigned long long)s.isa_calls[k]);
+            json += buffer;
+            first = false;
+        }
+
+        // Buckets keyed by their lower bound: 0, 1, 2, 4, 8, ...
+        json += "}, \"sizes\": {";
+        first = true;
+        for (size_t b = 0; b < kTelemetrySizeBuckets; ++b) {
+            if (s.size_histogram[b] == 0) {
+                continue;
+            }
+            unsigned long long lower = b == 0 ? 0ull : 1ull << (b - 1);
+            std::snprintf(buffer, sizeof(buffer), "%s\"%llu\": %llu", first ? "" : ", ", lower,
+                          (unsigned long long)s.size_histogram[b]);
+            json += buffer;
+            first = false;
+        }
+        json += "}}";
+    }
+    json += stats.empty() ? "]\n}\n" : "\n  ]\n}\n";
+    return json;
+}
+
+} // namespace simd_lib
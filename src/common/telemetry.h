@@ -0,0 +1,86 @@
+#pragma once
+
+#include "simd_lib.h"
+#include <atomic>
+#include <chrono>
+
+namespace simd_lib {
+
+// Every instrumented entry point, in report order
+#define SIMD_TELEMETRY_FUNCTIONS(X) \
+    X(vector_add) X(vector_multiply) X(dot_product) X(vector_subtract) X(vector_scale) \
+    X(vector_norm) X(vector_norm_squared) X(vector_normalize) \
+    X(vector_sum) X(vector_min) X(vector_max) X(vector_minmax) X(argmin) X(argmax) X(mean_variance) \
+    X(inclusive_scan) X(exclusive_scan) X(summed_area_table) \
+    X(vector_exp) X(vector_log) X(vector_sin) X(vector_cos) X(vector_sincos) X(vector_tanh) \
+    X(vector_sigmoid) X(vector_rsqrt) \
+    X(quantize_s8) X(quantize_u8) X(sum_s8) X(sum_u8) X(dot_product_s8) X(dot_product_u8s8) \
+    X(l2_distance_squared_s8) X(batch_dot_product_s8) X(batch_dot_product_u8s8) \
+    X(batch_l2_distance_squared_s8) \
+    X(batch_dot) X(batch_l2_squared) X(batch_cosine) X(select_greater) X(top_k_search) \
+    X(matrix_multiply_4x4) X(matrix_multiply_3x3) X(matrix_vector_multiply_4x4) X(matrix_vector_multiply_3x3) \
+    X(transpose) X(transpose_inplace) \
+    X(deinterleave2) X(deinterleave3) X(deinterleave4) X(interleave2) X(interleave3) X(interleave4) \
+    X(fft_radix2) X(fft_interleaved) X(fft2d) X(fft2d_real) X(stft) X(welch_psd) \
+    X(complex_multiply) X(complex_multiply_conj) X(complex_magnitude) X(complex_magnitude_squared) \
+    X(complex_phase) X(complex_scale_accumulate) \
+    X(complex_multiply_interleaved) X(complex_multiply_conj_interleaved) X(complex_magnitude_interleaved) \
+    X(complex_magnitude_squared_interleaved) X(complex_phase_interleaved) X(complex_scale_accumulate_interleaved) \
+    X(biquad_cascade) X(resample) \
+    X(convert_s16_to_f32) X(convert_s24_to_f32) X(convert_s32_to_f32) X(convert_f32_to_s16) X(convert_f32_to_s24) \
+    X(convert_f32_to_s32) X(sort_floats) X(sort_key_value) X(select_nth) X(quantile) \
+    X(sparse_dot_dense) X(sparse_dot_sparse) X(spmv) X(histogram) X(histogram2d) \
+    X(fill_uniform) X(fill_normal) X(quaternion_multiply) X(quaternion_rotate) X(quaternion_to_matrix3) \
+    X(quaternion_from_matrix3) X(quaternion_normalize) X(quaternion_slerp) X(rigid_transform_points)
+
+enum class TelemetryFunction : uint16_t {
+#define SIMD_TELEMETRY_ENUM(name) name,
+    SIMD_TELEMETRY_FUNCTIONS(SIMD_TELEMETRY_ENUM)
+#undef SIMD_TELEMETRY_ENUM
+    Count
+};
+
+extern std::atomic<bool> g_telemetry_enabled;
+
+// Returns false if this call is nested inside another recorded call
+bool telemetry_begin();
+void telemetry_end(TelemetryFunction function, size_t size, DispatchIsa isa, uint64_t elapsed_ns);
+
+// Nesting state of the calling thread. parallel_for hands it to its workers so
+// public calls made there on behalf of a recorded call are not recorded either.
+bool telemetry_nested();
+void telemetry_set_nested(bool nested);
+
+// Records one call of an entry point: construct it before dispatching and
+// call isa() in the branch taken. Costs one relaxed load when disabled.
+class TelemetryScope {
+public:
+    TelemetryScope(TelemetryFunction function, size_t size) : function_(function), size_(size) {
+        if (g_telemetry_enabled.load(std::memory_order_relaxed) && telemetry_begin()) {
+            active_ = true;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~TelemetryScope() {
+        if (active_) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            telemetry_end(function_, size_, isa_,
+                          (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+
+    TelemetryScope(const TelemetryScope&) = delete;
+    TelemetryScope& operator=(const TelemetryScope&) = delete;
+
+    void isa(DispatchIsa isa) { isa_ = isa; }
+
+private:
+    TelemetryFunction function_;
+    size_t size_;
+    DispatchIsa isa_ = DispatchIsa::Scalar;
+    bool active_ = false;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace simd_lib
@@ -0,0 +1,78 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include <algorithm>
+
+namespace simd_lib {
+
+// Tile edge: a 64x64 source tile and its destination tile (32 KB together)
+// stay cached while the 8x8 kernel walks them, and every destination row
+// segment is a 256-byte run of whole cache lines
+static const size_t kTransposeTile = 64;
+
+// Elements per thread
+static const size_t kTransposeMinElements = 1 << 16;
+
+typedef void (*TransposeKernel)(const float*, size_t, size_t, size_t, float*, size_t);
+typedef void (*TransposeSwapKernel)(float*, float*, size_t, size_t, size_t);
+
+void transpose(const float* src, size_t rows, size_t cols, size_t lds, float* dst, size_t ldd,
+               size_t num_threads) {
+    const auto& features = get_cpu_features();
+    TransposeKernel kernel = features.has_avx2 ? transpose_avx2 : transpose_scalar;
+    TelemetryScope telemetry(TelemetryFunction::transpose, rows * cols);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    if (rows == 0 || cols == 0) {
+        return;
+    }
+
+    size_t tile_rows = (rows + kTransposeTile - 1) / kTransposeTile;
+    size_t min_tile_rows = std::max<size_t>(1, kTransposeMinElements / (kTransposeTile * cols));
+    parallel_for(tile_rows, num_threads, min_tile_rows, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            size_t r0 = t * kTransposeTile;
+            size_t height = std::min(kTransposeTile, rows - r0);
+            for (size_t c0 = 0; c0 < cols; c0 += kTransposeTile) {
+                kernel(&src[r0 * lds + c0], height, std::min(kTransposeTile, cols - c0), lds,
+                       &dst[c0 * ldd + r0], ldd);
+            }
+        }
+    });
+}
+
+void transpose_inplace(float* data, size_t n, size_t ld, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    TransposeSwapKernel kernel = features.has_avx2 ? transpose_swap_avx2 : transpose_swap_scalar;
+    TelemetryScope telemetry(TelemetryFunction::transpose_inplace, n * n);
+    telemetry.isa(features.has_avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    if (n < 2) {
+        return;
+    }
+
+    // Tile row i swaps its tiles right of the diagonal with tile column i.
+    // Row i has tiles - i of them, so rows i and tiles - 1 - i are paired to
+    // give every thread an equal share.
+    size_t tiles = (n + kTransposeTile - 1) / kTransposeTile;
+    auto swap_tile_row = [&](size_t i) {
+        size_t r0 = i * kTransposeTile;
+        size_t height = std::min(kTransposeTile, n - r0);
+        for (size_t j = i; j < tiles; ++j) {
+            size_t c0 = j * kTransposeTile;
+            kernel(&data[r0 * ld + c0], &data[c0 * ld + r0], height, std::min(kTransposeTile, n - c0), ld);
+        }
+    };
+    size_t pairs = (tiles + 1) / 2;
+    size_t min_pairs = std::max<size_t>(1, kTransposeMinElements / (kTransposeTile * n));
+    parallel_for(pairs, num_threads, min_pairs, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            swap_tile_row(p);
+            if (tiles - 1 - p != p) {
+                swap_tile_row(tiles - 1 - p);
+            }
+        }
+    });
+}
+
+} // namespace simd_lib
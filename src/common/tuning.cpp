@@ -0,0 +1,364 @@
+#include "tuning.h"
+#include "parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace simd_lib {
+
+std::atomic<size_t> g_tuning[(size_t)TuningParam::Count];
+std::atomic<bool> g_tuning_loaded(false);
+
+namespace {
+
+// Bump when a parameter's meaning changes so stale caches are ignored
+const int kCacheVersion = 1;
+
+const char* const kParamNames[] = {
+    "streaming_store_bytes",
+    "reduce_min_block",
+    "scan_min_block",
+    "batch_min_floats",
+    "top_k_block_rows",
+};
+
+std::mutex g_tuning_mutex;
+
+void apply(const TuningConfig& config) {
+    const size_t values[] = {config.streaming_store_bytes, config.reduce_min_block, config.scan_min_block,
+                             config.batch_min_floats, config.top_k_block_rows};
+    for (size_t p = 0; p < (size_t)TuningParam::Count; ++p) {
+        // Zero would make every block empty
+        g_tuning[p].store(std::max<size_t>(values[p], 1), std::memory_order_relaxed);
+    }
+}
+
+TuningConfig current() {
+    TuningConfig config;
+    config.streaming_store_bytes = g_tuning[(size_t)TuningParam::StreamingStoreBytes].load(std::memory_order_relaxed);
+    config.reduce_min_block = g_tuning[(size_t)TuningParam::ReduceMinBlock].load(std::memory_order_relaxed);
+    config.scan_min_block = g_tuning[(size_t)TuningParam::ScanMinBlock].load(std::memory_order_relaxed);
+    config.batch_min_floats = g_tuning[(size_t)TuningParam::BatchMinFloats].load(std::memory_order_relaxed);
+    config.top_k_block_rows = g_tuning[(size_t)TuningParam::TopKBlockRows].load(std::memory_order_relaxed);
+    return config;
+}
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool read_cache(TuningConfig& config) {
+    std::ifstream in(tuning_cache_path());
+    if (!in) {
+        return false;
+    }
+
+    size_t values[(size_t)TuningParam::Count] = {};
+    bool found[(size_t)TuningParam::Count] = {};
+    bool version_ok = false;
+    bool cpu_ok = false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        size_t space = line.find(' ');
+        if (space == std::string::npos) {
+            return false;
+        }
+        std::string key = line.substr(0, space);
+        std::string value = line.substr(space + 1);
+
+        if (key == "version") {
+            version_ok = std::atoi(value.c_str()) == kCacheVersion;
+        } else if (key == "cpu") {
+            cpu_ok = value == get_cpu_model();
+        } else {
+            for (size_t p = 0; p < (size_t)TuningParam::Count; ++p) {
+                if (key == kParamNames[p]) {
+                    char* end = nullptr;
+                    unsigned long long parsed = std::strtoull(value.c_str(), &end, 10);
+                    if (end == value.c_str() || *end != '\0' || parsed == 0) {
+                        return false;
+                    }
+                    values[p] = (size_t)parsed;
+                    found[p] = true;
+                }
+            }
+        }
+    }
+
+    if (!version_ok || !cpu_ok || std::find(found, found + (size_t)TuningParam::Count, false) !=
+                                     found + (size_t)TuningParam::Count) {
+        return false;
+    }
+    config.streaming_store_bytes = values[(size_t)TuningParam::StreamingStoreBytes];
+    config.reduce_min_block = values[(size_t)TuningParam::ReduceMinBlock];
+    config.scan_min_block = values[(size_t)TuningParam::ScanMinBlock];
+    config.batch_min_floats = values[(size_t)TuningParam::BatchMinFloats];
+    config.top_k_block_rows = values[(size_t)TuningParam::TopKBlockRows];
+    return true;
+}
+
+// Best of a few runs, in nanoseconds; the first run warms caches and pages
+template <typename Fn>
+double best_time_ns(Fn fn, int runs = 5) {
+    fn();
+    double best = 0.0;
+    for (int r = 0; r < runs; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = r == 0 ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+// Smallest output size from 1 MB to 32 MB at which streaming stores beat
+// regular stores by 5%, at that size and every larger one
+size_t tune_streaming_store_bytes(size_t fallback) {
+    if (!get_cpu_features().has_avx2) {
+        return fallback;
+    }
+
+    const size_t max_count = (32u << 20) / sizeof(float);
+    std::vector<float> a(max_count, 1.0f), b(max_count, 2.0f), out(max_count);
+
+    size_t threshold = SIZE_MAX;
+    for (size_t bytes = 32u << 20; bytes >= (1u << 20); bytes /= 2) {
+        size_t count = bytes / sizeof(float);
+        double regular = best_time_ns([&]() { vector_add_avx2(a.data(), b.data(), out.data(), count); }, 3);
+        double streaming = best_time_ns([&]() { vector_add_avx2_stream(a.data(), b.data(), out.data(), count); }, 3);
+        if (streaming > 0.95 * regular) {
+            break;
+        }
+        threshold = bytes;
+    }
+    return threshold;
+}
+
+// Smallest problem size at which splitting across every hardware thread beats
+// one thread by 10%, expressed as elements per thread. run(count, threads,
+// min_block) performs one call.
+template <typename Run>
+size_t tune_thread_threshold(size_t max_count, Run run, size_t fallback) {
+    size_t threads = resolve_thread_count(0);
+    if (threads <= 1) {
+        return fallback;
+    }
+
+    for (size_t count = 16384; count <= max_count; count *= 2) {
+        size_t per_thread = std::max<size_t>(1, count / threads);
+        double single = best_time_ns([&]() { run(count, 1, per_thread); });
+        double split = best_time_ns([&]() { run(count, threads, per_thread); });
+        if (split < 0.9 * single) {
+            return per_thread;
+        }
+    }
+    // Never paid off in the tested range
+    return max_count;
+}
+
+std::vector<float> test_data(size_t count) {
+    std::vector<float> data(count);
+    uint32_t state = 12345;
+    for (float& x : data) {
+        state = state * 1664525u + 1013904223u;
+        x = (float)(state >> 8) * (1.0f / 16777216.0f) - 0.5f;
+    }
+    return data;
+}
+
+} // namespace
+
+void load_tuning_once() {
+    bool run_autotune = false;
+    {
+        std::lock_guard<std::mutex> lock(g_tuning_mutex);
+        if (g_tuning_loaded.load(std::memory_order_relaxed)) {
+            return;
+        }
+        TuningConfig config = default_tuning();
+        bool cached = read_cache(config);
+        apply(config);
+        g_tuning_loaded.store(true, std::memory_order_release);
+
+        const char* env = std::getenv("SIMD_LIB_AUTOTUNE");
+        run_autotune = !cached && env && std::strcmp(env, "1") == 0;
+    }
+    // Outside the lock: autotune() calls back into tuned kernels
+    if (run_autotune) {
+        autotune(true);
+    }
+}
+
+TuningConfig default_tuning() {
+    TuningConfig config;
+    config.streaming_store_bytes = 8u << 20;
+    config.reduce_min_block = 65536;
+    config.scan_min_block = 1 << 18;
+    config.batch_min_floats = 65536;
+    config.top_k_block_rows = 256;
+    return config;
+}
+
+TuningConfig get_tuning() {
+    tuned(TuningParam::StreamingStoreBytes);
+    return current();
+}
+
+void set_tuning(const TuningConfig& config) {
+    tuned(TuningParam::StreamingStoreBytes);
+    std::lock_guard<std::mutex> lock(g_tuning_mutex);
+    apply(config);
+}
+
+std::string tuning_cache_path() {
+    if (const char* path = std::getenv("SIMD_LIB_TUNING_CACHE")) {
+        return path;
+    }
+
+    std::string dir;
+#ifdef _WIN32
+    if (const char* local = std::getenv("LOCALAPPDATA")) {
+        dir = std::string(local) + "\\simd_lib\\";
+    }
+#else
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        dir = std::string(xdg) + "/simd_lib/";
+    } else if (const char* home = std::getenv("HOME")) {
+        dir = std::string(home) + "/.cache/simd_lib/";
+    }
+#endif
+
+    // One file per CPU model, so a home directory shared between machines
+    // keeps a configuration for each
+    char name[40];
+    std::snprintf(name, sizeof(name), "tuning-%016llx.txt", (unsigned long long)fnv1a(get_cpu_model()));
+    return dir + name;
+}
+
+bool load_tuning_cache() {
+    tuned(TuningParam::StreamingStoreBytes);
+    TuningConfig config;
+    if (!read_cache(config)) {
+        return false;
+    }
+    set_tuning(config);
+    return true;
+}
+
+bool save_tuning_cache() {
+    std::string path = tuning_cache_path();
+    std::error_code error;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+
+    // Write to a temporary file and rename so a concurrent reader never sees
+    // a partial cache
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        TuningConfig config = get_tuning();
+        const size_t values[] = {config.streaming_store_bytes, config.reduce_min_block, config.scan_min_block,
+                                 config.batch_min_floats, config.top_k_block_rows};
+        out << "# simd_lib tuning cache, written by autotune()\n";
+        out << "version " << kCacheVersion << "\n";
+        out << "cpu " << get_cpu_model() << "\n";
+        for (size_t p = 0; p < (size_t)TuningParam::Count; ++p) {
+            out << kParamNames[p] << " " << values[p] << "\n";
+        }
+        if (!out) {
+            return false;
+        }
+    }
+    std::filesystem::rename(temp, path, error);
+    return !error;
+}
+
+TuningConfig autotune(bool save_cache) {
+    const auto& features = get_cpu_features();
+    TuningConfig config = default_tuning();
+
+    config.streaming_store_bytes = tune_streaming_store_bytes(config.streaming_store_bytes);
+
+    // Threading thresholds: time the kernels behind each dispatcher directly so
+    // the measurement does not depend on the thresholds being tuned
+    const size_t max_count = 1 << 22;
+    std::vector<float> data = test_data(max_count), scanned(max_count);
+    auto sum_kernel = features.has_avx2 ? vector_sum_avx2 : vector_sum_scalar;
+    auto scan_kernel = features.has_avx2 ? inclusive_scan_avx2 : inclusive_scan_scalar;
+
+    config.reduce_min_block = tune_thread_threshold(max_count,
+        [&](size_t count, size_t threads, size_t min_block) {
+            auto partials = parallel_map_blocks<float>(count, threads, min_block,
+                [&](size_t begin, size_t end) { return sum_kernel(&data[begin], end - begin); });
+            volatile float sink = partials[0];
+            (void)sink;
+        }, config.reduce_min_block);
+
+    // The threaded scan makes two passes: block totals, then offset scans
+    config.scan_min_block = tune_thread_threshold(max_count,
+        [&](size_t count, size_t threads, size_t min_block) {
+            auto sums = parallel_map_blocks<float>(count, threads, min_block,
+                [&](size_t begin, size_t end) { return sum_kernel(&data[begin], end - begin); });
+            parallel_for(count, threads, min_block, [&](size_t begin, size_t end) {
+                scan_kernel(&data[begin], &scanned[begin], end - begin, sums[0]);
+            });
+        }, config.scan_min_block);
+
+    const size_t dim = 128;
+    std::vector<float> query = test_data(dim), scores(max_count / dim);
+    auto batch_kernel = features.has_avx2 && features.has_fma ? batch_dot_avx2 : batch_dot_scalar;
+    config.batch_min_floats = tune_thread_threshold(max_count,
+        [&](size_t count, size_t threads, size_t min_block) {
+            parallel_for(count / dim, threads, std::max<size_t>(1, min_block / dim), [&](size_t begin, size_t end) {
+                batch_kernel(query.data(), &data[begin * dim], end - begin, dim, &scores[begin]);
+            });
+        }, config.batch_min_floats);
+
+    // top_k block size: the block's scores must stay in L1 next to the rows
+    // being streamed, so the best size depends on L1 and the prefetchers
+    TuningConfig saved = get_tuning();
+    const size_t rows = 16384;
+    const size_t top_dim = 64;
+    size_t indices[10];
+    float top_scores[10];
+    double best = 0.0;
+    for (size_t block_rows = 64; block_rows <= 2048; block_rows *= 2) {
+        g_tuning[(size_t)TuningParam::TopKBlockRows].store(block_rows, std::memory_order_relaxed);
+        double ns = best_time_ns([&]() {
+            top_k_search(query.data(), data.data(), rows, top_dim, 10, SimilarityMetric::DotProduct,
+                         indices, top_scores, 1);
+        });
+        if (block_rows == 64 || ns < best) {
+            best = ns;
+            config.top_k_block_rows = block_rows;
+        }
+    }
+    g_tuning[(size_t)TuningParam::TopKBlockRows].store(saved.top_k_block_rows, std::memory_order_relaxed);
+
+    set_tuning(config);
+    if (save_cache) {
+        save_tuning_cache();
+    }
+    return config;
+}
+
+} // namespace simd_lib
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "simd_lib.h"
+#include <atomic>
+
+namespace simd_lib {
+
+// One slot per TuningConfig field, in declaration order
+enum class TuningParam : uint8_t {
+    StreamingStoreBytes,
+    ReduceMinBlock,
+    ScanMinBlock,
+    BatchMinFloats,
+    TopKBlockRows,
+    Count
+};
+
+extern std::atomic<size_t> g_tuning[(size_t)TuningParam::Count];
+extern std::atomic<bool> g_tuning_loaded;
+
+// Applies the defaults and the on-disk cache; runs once
+void load_tuning_once();
+
+// Current value of one threshold. After the first call this is two relaxed
+// loads, so dispatchers can read it on every call.
+inline size_t tuned(TuningParam param) {
+    if (!g_tuning_loaded.load(std::memory_order_acquire)) {
+        load_tuning_once();
+    }
+    return g_tuning[(size_t)param].load(std::memory_order_relaxed);
+}
+
+} // namespace simd_lib
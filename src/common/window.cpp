@@ -0,0 +1,145 @@
+#include "simd_lib.h"
+#include "parallel.h"
+#include "telemetry.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace simd_lib {
+
+// Segments per thread for welch_psd, as for the STFT
+static const size_t kMinSegmentSamplesPerThread = 1 << 16;
+
+void generate_window(WindowType type, float* window, size_t n) {
+    if (type == WindowType::Rectangular) {
+        std::fill(window, window + n, 1.0f);
+        return;
+    }
+
+    // Rounding the phases to float keeps the window within a few 1e-7 of
+    // the double-precision formula
+    std::vector<float> phase(n), c1(n);
+    for (size_t i = 0; i < n; ++i) {
+        phase[i] = (float)(2.0 * M_PI * (double)i / (double)n);
+    }
+    vector_cos(phase.data(), c1.data(), n);
+
+    switch (type) {
+    case WindowType::Hann:
+        for (size_t i = 0; i < n; ++i) {
+            window[i] = 0.5f - 0.5f * c1[i];
+        }
+        break;
+    case WindowType::Hamming:
+        for (size_t i = 0; i < n; ++i) {
+            window[i] = 0.54f - 0.46f * c1[i];
+        }
+        break;
+    case WindowType::Blackman:
+        // cos(2x) = 2cos^2(x) - 1 saves a second vector_cos pass
+        for (size_t i = 0; i < n; ++i) {
+            float c2 = 2.0f * c1[i] * c1[i] - 1.0f;
+            window[i] = 0.42f - 0.5f * c1[i] + 0.08f * c2;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+std::shared_ptr<const std::vector<float>> get_window(WindowType type, size_t n) {
+    static std::mutex cache_mutex;
+    static std::map<std::pair<WindowType, size_t>, std::shared_ptr<const std::vector<float>>> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto& window = cache[std::make_pair(type, n)];
+    if (!window) {
+        auto values = std::make_shared<std::vector<float>>(n);
+        generate_window(type, values->data(), n);
+        window = values;
+    }
+    return window;
+}
+
+void apply_window(float* data, const float* window, size_t n) {
+    vector_multiply(data, window, data, n);
+}
+
+void apply_window(float* data, WindowType type, size_t n) {
+    if (type == WindowType::Rectangular) {
+        return;
+    }
+    apply_window(data, get_window(type, n)->data(), n);
+}
+
+size_t welch_psd_bins(size_t segment_size) {
+    return next_power_of_2(std::max<size_t>(segment_size, 2)) / 2 + 1;
+}
+
+size_t welch_psd(const float* signal, size_t count, float* psd, size_t segment_size, size_t hop,
+                 WindowType window, float sample_rate, size_t num_threads) {
+    const auto& features = get_cpu_features();
+    const bool avx2 = features.has_avx2 && features.has_fma;
+    TelemetryScope telemetry(TelemetryFunction::welch_psd, count);
+    telemetry.isa(avx2 ? DispatchIsa::AVX2 : DispatchIsa::Scalar);
+
+    const size_t bins = welch_psd_bins(segment_size);
+    const size_t n = (bins - 1) * 2;
+    hop = std::max<size_t>(hop, 1);
+    std::fill(psd, psd + bins, 0.0f);
+
+    size_t segments = count >= n ? (count - n) / hop + 1 : 0;
+    if (segments == 0) {
+        return 0;
+    }
+
+    auto plan = get_fft_plan(n);
+    auto coefficients = get_window(window, n);
+
+    // Each block of segments sums its power spectra; the block sums are then
+    // added in block order, so a given thread count always gives the same result.
+    // Segments are a few KB, so the kernels are called directly rather than
+    // through the dispatchers, and the sums are plain cached loops.
+    auto multiply = avx2 ? vector_multiply_avx2 : vector_multiply_scalar;
+    auto magnitude_squared = avx2 ? complex_magnitude_squared_avx2 : complex_magnitude_squared_scalar;
+    size_t min_segments = std::max<size_t>(1, kMinSegmentSamplesPerThread / n);
+    auto partials = parallel_map_blocks<std::vector<float>>(segments, num_threads, min_segments,
+        [&](size_t begin, size_t end) {
+            std::vector<float> sum(bins, 0.0f), power(bins), real(n), imag(n);
+            for (size_t s = begin; s < end; ++s) {
+                multiply(&signal[s * hop], coefficients->data(), real.data(), n);
+                std::fill(imag.begin(), imag.end(), 0.0f);
+                plan->execute(real.data(), imag.data(), false);
+                magnitude_squared(real.data(), imag.data(), power.data(), bins);
+                for (size_t k = 0; k < bins; ++k) {
+                    sum[k] += power[k];
+                }
+            }
+            return sum;
+        });
+    for (const auto& partial : partials) {
+        for (size_t k = 0; k < bins; ++k) {
+            psd[k] += partial[k];
+        }
+    }
+
+    // Density scaling: divide by sample_rate * sum(w^2) and the segment
+    // count; double every bin but DC and Nyquist for the one-sided spectrum
+    double window_power = 0.0;
+    for (float w : *coefficients) {
+        window_power += (double)w * w;
+    }
+    float scale = (float)(1.0 / ((double)sample_rate * window_power * (double)segments));
+    for (size_t k = 0; k < bins; ++k) {
+        psd[k] *= k == 0 || k == bins - 1 ? scale : 2.0f * scale;
+    }
+    return segments;
+}
+
+} // namespace simd_lib
@@ -0,0 +1,52 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void biquad_channels_scalar(float* data, size_t frames, size_t stride, size_t groups, size_t sections,
+                            const float* coefficients, float* state) {
+    for (size_t s = 0; s < sections; ++s) {
+        for (size_t g = 0; g < groups; ++g) {
+            const float* c = &coefficients[(s * groups + g) * 40];
+            float* st = &state[(s * groups + g) * 16];
+            for (size_t lane = 0; lane < 8; ++lane) {
+                const float b0 = c[lane], b1 = c[8 + lane], b2 = c[16 + lane];
+                const float a1 = c[24 + lane], a2 = c[32 + lane];
+                float s1 = st[lane], s2 = st[8 + lane];
+                float* x = &data[g * 8 + lane];
+                for (size_t t = 0; t < frames; ++t) {
+                    float in = x[t * stride];
+                    float y = b0 * in + s1;
+                    s1 = b1 * in - a1 * y + s2;
+                    s2 = b2 * in - a2 * y;
+                    x[t * stride] = y;
+                }
+                st[lane] = s1;
+                st[8 + lane] = s2;
+            }
+        }
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void biquad_time_scalar(float* data, size_t count, size_t sections, const float* coefficients,
+                        const float* blocks, float* state) {
+    // The sample-by-sample recursion needs no block matrices
+    (void)blocks;
+    for (size_t s = 0; s < sections; ++s) {
+        const float* c = &coefficients[s * 5];
+        float s1 = state[2 * s], s2 = state[2 * s + 1];
+        for (size_t i = 0; i < count; ++i) {
+            float in = data[i];
+            float y = c[0] * in + s1;
+            s1 = c[1] * in - c[3] * y + s2;
+            s2 = c[2] * in - c[4] * y;
+            data[i] = y;
+        }
+        state[2 * s] = s1;
+        state[2 * s + 1] = s2;
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,121 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <algorithm>
+#include <cmath>
+
+namespace simd_lib {
+
+// 10 / ln(10): decibels per natural-log unit of power
+static const float kDecibelsPerLog = 4.34294482f;
+
+SIMD_LIB_MULTIVERSION
+void complex_multiply_scalar(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                             float* out_real, float* out_imag, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float re = a_real[i] * b_real[i] - a_imag[i] * b_imag[i];
+        float im = a_real[i] * b_imag[i] + a_imag[i] * b_real[i];
+        out_real[i] = re;
+        out_imag[i] = im;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_multiply_conj_scalar(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                                  float* out_real, float* out_imag, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float re = a_real[i] * b_real[i] + a_imag[i] * b_imag[i];
+        float im = a_imag[i] * b_real[i] - a_real[i] * b_imag[i];
+        out_real[i] = re;
+        out_imag[i] = im;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_magnitude_scalar(const float* real, const float* imag, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::sqrt(real[i] * real[i] + imag[i] * imag[i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_magnitude_squared_scalar(const float* real, const float* imag, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = real[i] * real[i] + imag[i] * imag[i];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_phase_scalar(const float* real, const float* imag, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::atan2(imag[i], real[i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_scale_accumulate_scalar(const float* real, const float* imag, float scale_real, float scale_imag,
+                                     float* acc_real, float* acc_imag, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        acc_real[i] += scale_real * real[i] - scale_imag * imag[i];
+        acc_imag[i] += scale_real * imag[i] + scale_imag * real[i];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_power_db_scalar(const float* real, const float* imag, float floor, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float power = real[i] * real[i] + imag[i] * imag[i];
+        out[i] = kDecibelsPerLog * std::log(std::max(power, floor));
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_multiply_interleaved_scalar(const float* a, const float* b, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float re = a[2 * i] * b[2 * i] - a[2 * i + 1] * b[2 * i + 1];
+        float im = a[2 * i] * b[2 * i + 1] + a[2 * i + 1] * b[2 * i];
+        out[2 * i] = re;
+        out[2 * i + 1] = im;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_multiply_conj_interleaved_scalar(const float* a, const float* b, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float re = a[2 * i] * b[2 * i] + a[2 * i + 1] * b[2 * i + 1];
+        float im = a[2 * i + 1] * b[2 * i] - a[2 * i] * b[2 * i + 1];
+        out[2 * i] = re;
+        out[2 * i + 1] = im;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_magnitude_interleaved_scalar(const float* data, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::sqrt(data[2 * i] * data[2 * i] + data[2 * i + 1] * data[2 * i + 1]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_magnitude_squared_interleaved_scalar(const float* data, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = data[2 * i] * data[2 * i] + data[2 * i + 1] * data[2 * i + 1];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_phase_interleaved_scalar(const float* data, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::atan2(data[2 * i + 1], data[2 * i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void complex_scale_accumulate_interleaved_scalar(const float* data, float scale_real, float scale_imag, float* acc,
+                                                 size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        acc[2 * i] += scale_real * data[2 * i] - scale_imag * data[2 * i + 1];
+        acc[2 * i + 1] += scale_real * data[2 * i + 1] + scale_imag * data[2 * i];
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,53 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void fft_stage_scalar(float* real, float* imag, size_t n, size_t half, const float* w_real, const float* w_imag) {
+    for (size_t i = 0; i < n; i += 2 * half) {
+        for (size_t j = 0; j < half; ++j) {
+            size_t u = i + j;
+            size_t v = u + half;
+            float t_real = w_real[j] * real[v] - w_imag[j] * imag[v];
+            float t_imag = w_real[j] * imag[v] + w_imag[j] * real[v];
+
+            real[v] = real[u] - t_real;
+            imag[v] = imag[u] - t_imag;
+            real[u] += t_real;
+            imag[u] += t_imag;
+        }
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void fft_first_stage_interleaved_scalar(const float* data, const uint32_t* index, float* real, float* imag, size_t n) {
+    // Output 2k holds input index[k] and output 2k + 1 holds input index[k] + n / 2
+    const size_t half_n = n / 2;
+    for (size_t k = 0; k < half_n; ++k) {
+        const float* u = &data[2 * index[k]];
+        const float* v = &data[2 * (index[k] + half_n)];
+        real[2 * k] = u[0] + v[0];
+        imag[2 * k] = u[1] + v[1];
+        real[2 * k + 1] = u[0] - v[0];
+        imag[2 * k + 1] = u[1] - v[1];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void fft_last_stage_interleaved_scalar(const float* real, const float* imag, size_t n, const float* w_real,
+                                       const float* w_imag, float scale, float* data) {
+    const size_t half = n / 2;
+    for (size_t j = 0; j < half; ++j) {
+        size_t v = j + half;
+        float t_real = w_real[j] * real[v] - w_imag[j] * imag[v];
+        float t_imag = w_real[j] * imag[v] + w_imag[j] * real[v];
+
+        data[2 * j] = (real[j] + t_real) * scale;
+        data[2 * j + 1] = (imag[j] + t_imag) * scale;
+        data[2 * v] = (real[j] - t_real) * scale;
+        data[2 * v + 1] = (imag[j] - t_imag) * scale;
+    }
+}
+
+} // namespace simd_lib
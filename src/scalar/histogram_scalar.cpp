@@ -0,0 +1,41 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+
+namespace simd_lib {
+
+// Bin of x, or bins when x is outside [lo, hi] or NaN. The AVX2 kernels use
+// the same float arithmetic, so both agree on values at bin edges.
+static inline size_t bin_of(float x, float lo, float hi, float scale, size_t bins) {
+    if (!(x >= lo && x <= hi)) {
+        return bins;
+    }
+    size_t bin = (size_t)(int32_t)((x - lo) * scale);
+    return bin < bins ? bin : bins - 1;
+}
+
+SIMD_LIB_MULTIVERSION
+void histogram_scalar(const float* data, size_t count, float lo, float hi, size_t bins, uint64_t* counts) {
+    const float scale = (float)((double)bins / ((double)hi - (double)lo));
+    for (size_t i = 0; i < count; ++i) {
+        size_t bin = bin_of(data[i], lo, hi, scale, bins);
+        if (bin < bins) {
+            ++counts[bin];
+        }
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void histogram2d_scalar(const float* x, const float* y, size_t count, float x_lo, float x_hi, size_t x_bins,
+                        float y_lo, float y_hi, size_t y_bins, uint64_t* counts) {
+    const float x_scale = (float)((double)x_bins / ((double)x_hi - (double)x_lo));
+    const float y_scale = (float)((double)y_bins / ((double)y_hi - (double)y_lo));
+    for (size_t i = 0; i < count; ++i) {
+        size_t bx = bin_of(x[i], x_lo, x_hi, x_scale, x_bins);
+        size_t by = bin_of(y[i], y_lo, y_hi, y_scale, y_bins);
+        if (bx < x_bins && by < y_bins) {
+            ++counts[bx * y_bins + by];
+        }
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,60 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void deinterleave2_scalar(const float* src, float* a, float* b, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = src[2 * i];
+        b[i] = src[2 * i + 1];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void deinterleave3_scalar(const float* src, float* a, float* b, float* c, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = src[3 * i];
+        b[i] = src[3 * i + 1];
+        c[i] = src[3 * i + 2];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void deinterleave4_scalar(const float* src, float* a, float* b, float* c, float* d, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = src[4 * i];
+        b[i] = src[4 * i + 1];
+        c[i] = src[4 * i + 2];
+        d[i] = src[4 * i + 3];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void interleave2_scalar(const float* a, const float* b, float* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[2 * i] = a[i];
+        dst[2 * i + 1] = b[i];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void interleave3_scalar(const float* a, const float* b, const float* c, float* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[3 * i] = a[i];
+        dst[3 * i + 1] = b[i];
+        dst[3 * i + 2] = c[i];
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void interleave4_scalar(const float* a, const float* b, const float* c, const float* d, float* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[4 * i] = a[i];
+        dst[4 * i + 1] = b[i];
+        dst[4 * i + 2] = c[i];
+        dst[4 * i + 3] = d[i];
+    }
+}
+
+} // namespace simd_lib
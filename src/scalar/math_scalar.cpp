@@ -0,0 +1,64 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <cmath>
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void vector_exp_scalar(const float* input, float* result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = std::exp(input[i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void vector_log_scalar(const float* input, float* result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = std::log(input[i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void vector_sin_scalar(const float* input, float* result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = std::sin(input[i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void vector_cos_scalar(const float* input, float* result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = std::cos(input[i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void vector_sincos_scalar(const float* input, float* sin_result, float* cos_result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        sin_result[i] = std::sin(input[i]);
+        cos_result[i] = std::cos(input[i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void vector_tanh_scalar(const float* input, float* result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = std::tanh(input[i]);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void vector_sigmoid_scalar(const float* input, float* result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = 1.0f / (1.0f + std::exp(-input[i]));
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void vector_rsqrt_scalar(const float* input, float* result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = 1.0f / std::sqrt(input[i]);
+    }
+}
+
+} // namespace simd_lib
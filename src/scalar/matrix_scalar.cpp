@@ -1,7 +1,9 @@
 #include "simd_lib.h"
+#include "../common/multiversion.h"
 
 namespace simd_lib {
 
+SIMD_LIB_MULTIVERSION
 void matrix_multiply_4x4_scalar(const float* a, const float* b, float* result) {
     for (int i = 0; i < 4; ++i) {
         for (int j = 0; j < 4; ++j) {
@@ -13,6 +15,7 @@ void matrix_multiply_4x4_scalar(const float* a, const float* b, float* result) {
     }
 }
 
+SIMD_LIB_MULTIVERSION
 void matrix_multiply_3x3_scalar(const float* a, const float* b, float* result) {
     for (int i = 0; i < 3; ++i) {
         for (int j = 0; j < 3; ++j) {
@@ -24,6 +27,7 @@ void matrix_multiply_3x3_scalar(const float* a, const float* b, float* result) {
     }
 }
 
+SIMD_LIB_MULTIVERSION
 void matrix_vector_multiply_4x4_scalar(const float* matrix, const float* vector, float* result) {
     for (int i = 0; i < 4; ++i) {
         result[i] = 0.0f;
@@ -33,6 +37,7 @@ void matrix_vector_multiply_4x4_scalar(const float* matrix, const float* vector,
     }
 }
 
+SIMD_LIB_MULTIVERSION
 void matrix_vector_multiply_3x3_scalar(const float* matrix, const float* vector, float* result) {
     for (int i = 0; i < 3; ++i) {
         result[i] = 0.0f;
@@ -0,0 +1,92 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <cmath>
+#include <algorithm>
+
+namespace simd_lib {
+
+// Triangular noise in (-1, 1): the difference of the two 16-bit halves of a
+// lowbias32 hash of the sample index. pcm_avx2.cpp computes the same values.
+static inline float dither_noise(uint32_t seed, uint64_t index) {
+    uint32_t h = (uint32_t)index * 0x9e3779b9u + seed;
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return (float)((int32_t)(h & 0xffff) - (int32_t)(h >> 16)) * (1.0f / 65536.0f);
+}
+
+SIMD_LIB_MULTIVERSION
+void convert_s16_to_f32_scalar(const int16_t* input, float* output, size_t count, float scale) {
+    const float k = scale * (1.0f / 32768.0f);
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = (float)input[i] * k;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void convert_s24_to_f32_scalar(const uint8_t* input, float* output, size_t count, float scale) {
+    const float k = scale * (1.0f / 8388608.0f);
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* p = &input[3 * i];
+        // Assemble in the top 24 bits, then shift down to sign-extend
+        int32_t v = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+        output[i] = (float)v * k;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void convert_s32_to_f32_scalar(const int32_t* input, float* output, size_t count, float scale) {
+    const float k = scale * (1.0f / 2147483648.0f);
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = (float)input[i] * k;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void convert_f32_to_s16_scalar(const float* input, int16_t* output, size_t count, float scale,
+                               const PcmDither* dither) {
+    const float k = scale * 32768.0f;
+    for (size_t i = 0; i < count; ++i) {
+        float v = input[i] * k;
+        if (dither) {
+            v += dither_noise(dither->seed, dither->index + i);
+        }
+        v = std::min(std::max(v, -32768.0f), 32767.0f);
+        output[i] = (int16_t)std::lrint(v);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void convert_f32_to_s24_scalar(const float* input, uint8_t* output, size_t count, float scale,
+                               const PcmDither* dither) {
+    const float k = scale * 8388608.0f;
+    for (size_t i = 0; i < count; ++i) {
+        float v = input[i] * k;
+        if (dither) {
+            v += dither_noise(dither->seed, dither->index + i);
+        }
+        v = std::min(std::max(v, -8388608.0f), 8388607.0f);
+        uint32_t q = (uint32_t)(int32_t)std::lrint(v);
+        output[3 * i] = (uint8_t)q;
+        output[3 * i + 1] = (uint8_t)(q >> 8);
+        output[3 * i + 2] = (uint8_t)(q >> 16);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void convert_f32_to_s32_scalar(const float* input, int32_t* output, size_t count, float scale) {
+    const float k = scale * 2147483648.0f;
+    for (size_t i = 0; i < count; ++i) {
+        float v = input[i] * k;
+        // 2^31 itself is out of range; every float below it converts exactly
+        if (v >= 2147483648.0f) {
+            output[i] = INT32_MAX;
+        } else {
+            output[i] = (int32_t)std::lrint(std::max(v, -2147483648.0f));
+        }
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,96 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <cmath>
+#include <algorithm>
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void quantize_s8_scalar(const float* input, int8_t* output, size_t count, const QuantizationParams& params) {
+    float inv_scale = 1.0f / params.scale;
+    // Clamped in float first: lrint is undefined beyond the range of long
+    float lower = -127.0f - (float)params.zero_point, upper = 127.0f - (float)params.zero_point;
+    for (size_t i = 0; i < count; ++i) {
+        long q = std::lrint(std::min(upper, std::max(lower, input[i] * inv_scale))) + params.zero_point;
+        output[i] = (int8_t)std::min(127L, std::max(-127L, q));
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void quantize_u8_scalar(const float* input, uint8_t* output, size_t count, const QuantizationParams& params) {
+    float inv_scale = 1.0f / params.scale;
+    float lower = 0.0f - (float)params.zero_point, upper = 255.0f - (float)params.zero_point;
+    for (size_t i = 0; i < count; ++i) {
+        long q = std::lrint(std::min(upper, std::max(lower, input[i] * inv_scale))) + params.zero_point;
+        output[i] = (uint8_t)std::min(255L, std::max(0L, q));
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+int32_t sum_s8_scalar(const int8_t* a, size_t count) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += a[i];
+    }
+    return sum;
+}
+
+SIMD_LIB_MULTIVERSION
+int32_t sum_u8_scalar(const uint8_t* a, size_t count) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += a[i];
+    }
+    return sum;
+}
+
+SIMD_LIB_MULTIVERSION
+int32_t dot_product_s8_scalar(const int8_t* a, const int8_t* b, size_t count) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += (int32_t)a[i] * (int32_t)b[i];
+    }
+    return sum;
+}
+
+SIMD_LIB_MULTIVERSION
+int32_t dot_product_u8s8_scalar(const uint8_t* a, const int8_t* b, size_t count) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += (int32_t)a[i] * (int32_t)b[i];
+    }
+    return sum;
+}
+
+SIMD_LIB_MULTIVERSION
+int32_t l2_distance_squared_s8_scalar(const int8_t* a, const int8_t* b, size_t count) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int32_t diff = (int32_t)a[i] - (int32_t)b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+SIMD_LIB_MULTIVERSION
+void batch_dot_product_s8_scalar(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    for (size_t r = 0; r < rows; ++r) {
+        out[r] = dot_product_s8_scalar(query, &database[r * dim], dim);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void batch_dot_product_u8s8_scalar(const uint8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    for (size_t r = 0; r < rows; ++r) {
+        out[r] = dot_product_u8s8_scalar(query, &database[r * dim], dim);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void batch_l2_distance_squared_s8_scalar(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    for (size_t r = 0; r < rows; ++r) {
+        out[r] = l2_distance_squared_s8_scalar(query, &database[r * dim], dim);
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,144 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <cfloat>
+#include <cmath>
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void quaternion_multiply_scalar(ConstQuaternionArrays a, ConstQuaternionArrays b, QuaternionArrays result,
+                                size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float aw = a.w[i], ax = a.x[i], ay = a.y[i], az = a.z[i];
+        float bw = b.w[i], bx = b.x[i], by = b.y[i], bz = b.z[i];
+        result.w[i] = aw * bw - ax * bx - ay * by - az * bz;
+        result.x[i] = aw * bx + ax * bw + ay * bz - az * by;
+        result.y[i] = aw * by - ax * bz + ay * bw + az * bx;
+        result.z[i] = aw * bz + ax * by - ay * bx + az * bw;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void quaternion_rotate_scalar(ConstQuaternionArrays q, ConstVec3Arrays v, Vec3Arrays result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float w = q.w[i], x = q.x[i], y = q.y[i], z = q.z[i];
+        float vx = v.x[i], vy = v.y[i], vz = v.z[i];
+        float tx = 2.0f * (y * vz - z * vy);
+        float ty = 2.0f * (z * vx - x * vz);
+        float tz = 2.0f * (x * vy - y * vx);
+        result.x[i] = vx + w * tx + (y * tz - z * ty);
+        result.y[i] = vy + w * ty + (z * tx - x * tz);
+        result.z[i] = vz + w * tz + (x * ty - y * tx);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void quaternion_to_matrix3_scalar(ConstQuaternionArrays q, float* matrices, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float w = q.w[i], x = q.x[i], y = q.y[i], z = q.z[i];
+        float m[9] = {1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y),
+                      2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x),
+                      2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y)};
+        for (size_t k = 0; k < 9; ++k) {
+            matrices[k * count + i] = m[k];
+        }
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void quaternion_from_matrix3_scalar(const float* matrices, QuaternionArrays q, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float m[9];
+        for (size_t k = 0; k < 9; ++k) {
+            m[k] = matrices[k * count + i];
+        }
+        float trace = m[0] + m[4] + m[8];
+        float d0 = m[7] - m[5], d1 = m[2] - m[6], d2 = m[3] - m[1];
+        float s0 = m[5] + m[7], s1 = m[2] + m[6], s2 = m[1] + m[3];
+        // 4 c^2 = t for the largest component c; the others are sums over 4 c
+        float w, x, y, z, t;
+        if (m[8] > trace && m[8] > m[0] && m[8] > m[4]) {
+            t = 1.0f + 2.0f * m[8] - trace;
+            w = d2, x = s1, y = s0, z = t;
+        } else if (m[4] > trace && m[4] > m[0]) {
+            t = 1.0f + 2.0f * m[4] - trace;
+            w = d1, x = s2, y = t, z = s0;
+        } else if (m[0] > trace) {
+            t = 1.0f + 2.0f * m[0] - trace;
+            w = d0, x = t, y = s2, z = s1;
+        } else {
+            t = 1.0f + trace;
+            w = t, x = d0, y = d1, z = d2;
+        }
+        float scale = 0.5f / std::sqrt(t);
+        q.w[i] = w * scale;
+        q.x[i] = x * scale;
+        q.y[i] = y * scale;
+        q.z[i] = z * scale;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void quaternion_normalize_scalar(ConstQuaternionArrays q, QuaternionArrays result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float w = q.w[i], x = q.x[i], y = q.y[i], z = q.z[i];
+        float norm_sq = w * w + x * x + y * y + z * z;
+        if (norm_sq < FLT_MIN) {
+            result.w[i] = 1.0f;
+            result.x[i] = result.y[i] = result.z[i] = 0.0f;
+            continue;
+        }
+        float inv = 1.0f / std::sqrt(norm_sq);
+        result.w[i] = w * inv;
+        result.x[i] = x * inv;
+        result.y[i] = y * inv;
+        result.z[i] = z * inv;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void quaternion_slerp_scalar(ConstQuaternionArrays a, ConstQuaternionArrays b, float t, QuaternionArrays result,
+                             size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float aw = a.w[i], ax = a.x[i], ay = a.y[i], az = a.z[i];
+        float bw = b.w[i], bx = b.x[i], by = b.y[i], bz = b.z[i];
+        float d = aw * bw + ax * bx + ay * by + az * bz;
+        // q and -q are the same rotation; take the one on the shorter arc
+        if (d < 0.0f) {
+            d = -d, bw = -bw, bx = -bx, by = -by, bz = -bz;
+        }
+        if (d > 0.9995f) {
+            float w = aw + t * (bw - aw), x = ax + t * (bx - ax), y = ay + t * (by - ay), z = az + t * (bz - az);
+            float inv = 1.0f / std::sqrt(w * w + x * x + y * y + z * z);
+            result.w[i] = w * inv;
+            result.x[i] = x * inv;
+            result.y[i] = y * inv;
+            result.z[i] = z * inv;
+            continue;
+        }
+        float theta = std::acos(d);
+        float sin_theta = std::sin(theta);
+        float wa = std::sin((1.0f - t) * theta) / sin_theta;
+        float wb = std::sin(t * theta) / sin_theta;
+        result.w[i] = wa * aw + wb * bw;
+        result.x[i] = wa * ax + wb * bx;
+        result.y[i] = wa * ay + wb * by;
+        result.z[i] = wa * az + wb * bz;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void rigid_transform_points_scalar(const float* rotation, const float* translation, ConstVec3Arrays points,
+                                   Vec3Arrays result, size_t count) {
+    // A single quaternion in the planar layout is a row-major 3x3 matrix
+    float m[9];
+    quaternion_to_matrix3_scalar({&rotation[0], &rotation[1], &rotation[2], &rotation[3]}, m, 1);
+    for (size_t i = 0; i < count; ++i) {
+        float x = points.x[i], y = points.y[i], z = points.z[i];
+        result.x[i] = m[0] * x + m[1] * y + m[2] * z + translation[0];
+        result.y[i] = m[3] * x + m[4] * y + m[5] * z + translation[1];
+        result.z[i] = m[6] * x + m[7] * y + m[8] * z + translation[2];
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,66 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace simd_lib {
+
+// One xoshiro128+ step of one lane
+static inline uint32_t next(RandomState* state, int lane) {
+    uint32_t (&s)[4][8] = state->s;
+    uint32_t result = s[0][lane] + s[3][lane];
+    uint32_t t = s[1][lane] << 9;
+    s[2][lane] ^= s[0][lane];
+    s[3][lane] ^= s[1][lane];
+    s[1][lane] ^= s[2][lane];
+    s[0][lane] ^= s[3][lane];
+    s[2][lane] ^= t;
+    s[3][lane] = (s[3][lane] << 11) | (s[3][lane] >> 21);
+    return result;
+}
+
+SIMD_LIB_MULTIVERSION
+void fill_uniform_scalar(RandomState* state, float* output, size_t count, float lo, float hi) {
+    const float span = hi - lo;
+    // The top draws round up to hi itself; keep the interval half open
+    const float top = std::nextafter(hi, lo);
+    for (size_t i = 0; i < count; i += 8) {
+        for (int lane = 0; lane < 8; ++lane) {
+            float u = (float)(next(state, lane) >> 8) * (1.0f / 16777216.0f);
+            if (i + lane < count) {
+                float v = lo + u * span;
+                output[i + lane] = v == hi ? top : v;
+            }
+        }
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void fill_normal_scalar(RandomState* state, float* output, size_t count, float mean, float stddev) {
+    const float two_pi = (float)(2.0 * M_PI);
+    for (size_t i = 0; i < count; i += 16) {
+        float u1[8], u2[8];
+        // u1 in (0, 1] keeps the logarithm finite
+        for (int lane = 0; lane < 8; ++lane) {
+            u1[lane] = (float)((next(state, lane) >> 8) + 1) * (1.0f / 16777216.0f);
+        }
+        for (int lane = 0; lane < 8; ++lane) {
+            u2[lane] = (float)(next(state, lane) >> 8) * (1.0f / 16777216.0f);
+        }
+        for (int lane = 0; lane < 8; ++lane) {
+            float r = std::sqrt(-2.0f * std::log(u1[lane]));
+            float theta = two_pi * u2[lane];
+            if (i + lane < count) {
+                output[i + lane] = mean + stddev * (r * std::cos(theta));
+            }
+            if (i + 8 + lane < count) {
+                output[i + 8 + lane] = mean + stddev * (r * std::sin(theta));
+            }
+        }
+    }
+}
+
+} // namespace simd_lib
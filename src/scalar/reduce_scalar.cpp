@@ -0,0 +1,88 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <limits>
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+float vector_sum_scalar(const float* a, size_t count) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        sum += a[i];
+    }
+    return sum;
+}
+
+SIMD_LIB_MULTIVERSION
+float vector_min_scalar(const float* a, size_t count) {
+    float result = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < count; ++i) {
+        if (a[i] < result) {
+            result = a[i];
+        }
+    }
+    return result;
+}
+
+SIMD_LIB_MULTIVERSION
+float vector_max_scalar(const float* a, size_t count) {
+    float result = -std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < count; ++i) {
+        if (a[i] > result) {
+            result = a[i];
+        }
+    }
+    return result;
+}
+
+SIMD_LIB_MULTIVERSION
+void vector_minmax_scalar(const float* a, size_t count, float* min_value, float* max_value) {
+    *min_value = vector_min_scalar(a, count);
+    *max_value = vector_max_scalar(a, count);
+}
+
+SIMD_LIB_MULTIVERSION
+size_t argmin_scalar(const float* a, size_t count) {
+    size_t index = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (a[i] < a[index]) {
+            index = i;
+        }
+    }
+    return index;
+}
+
+SIMD_LIB_MULTIVERSION
+size_t argmax_scalar(const float* a, size_t count) {
+    size_t index = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (a[i] > a[index]) {
+            index = i;
+        }
+    }
+    return index;
+}
+
+SIMD_LIB_MULTIVERSION
+void mean_m2_scalar(const float* a, size_t count, double* mean, double* m2) {
+    // Welford's update
+    double m = 0.0;
+    double s = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double delta = a[i] - m;
+        m += delta / (double)(i + 1);
+        s += delta * (a[i] - m);
+    }
+    *mean = m;
+    *m2 = s;
+}
+
+SIMD_LIB_MULTIVERSION
+void mean_variance_scalar(const float* a, size_t count, float* mean, float* variance) {
+    double m, m2;
+    mean_m2_scalar(a, count, &m, &m2);
+    *mean = (float)m;
+    *variance = count > 0 ? (float)(m2 / (double)count) : 0.0f;
+}
+
+} // namespace simd_lib
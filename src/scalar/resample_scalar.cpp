@@ -0,0 +1,26 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+size_t resample_polyphase_scalar(const float* input, size_t length, const float* bank, size_t taps, size_t phases,
+                                 size_t step, size_t* position, float* output, size_t output_stride) {
+    size_t pos = *position;
+    size_t produced = 0;
+    while (pos / phases + taps <= length) {
+        const float* x = &input[pos / phases];
+        const float* h = &bank[(pos % phases) * taps];
+        float sum = 0.0f;
+        for (size_t k = 0; k < taps; ++k) {
+            sum += h[k] * x[k];
+        }
+        output[produced * output_stride] = sum;
+        ++produced;
+        pos += step;
+    }
+    *position = pos;
+    return produced;
+}
+
+} // namespace simd_lib
@@ -1,20 +1,24 @@
 #include "simd_lib.h"
+#include "../common/multiversion.h"
 #include <cmath>
 
 namespace simd_lib {
 
+SIMD_LIB_MULTIVERSION
 void vector_add_scalar(const float* a, const float* b, float* result, size_t count) {
     for (size_t i = 0; i < count; ++i) {
         result[i] = a[i] + b[i];
     }
 }
 
+SIMD_LIB_MULTIVERSION
 void vector_multiply_scalar(const float* a, const float* b, float* result, size_t count) {
     for (size_t i = 0; i < count; ++i) {
         result[i] = a[i] * b[i];
     }
 }
 
+SIMD_LIB_MULTIVERSION
 float dot_product_scalar(const float* a, const float* b, size_t count) {
     float sum = 0.0f;
     for (size_t i = 0; i < count; ++i) {
@@ -23,18 +27,21 @@ float dot_product_scalar(const float* a, const float* b, size_t count) {
     return sum;
 }
 
+SIMD_LIB_MULTIVERSION
 void vector_subtract_scalar(const float* a, const float* b, float* result, size_t count) {
     for (size_t i = 0; i < count; ++i) {
         result[i] = a[i] - b[i];
     }
 }
 
+SIMD_LIB_MULTIVERSION
 void vector_scale_scalar(const float* a, float scale, float* result, size_t count) {
     for (size_t i = 0; i < count; ++i) {
         result[i] = a[i] * scale;
     }
 }
 
+SIMD_LIB_MULTIVERSION
 float vector_norm_scalar(const float* a, size_t count) {
     float sum = 0.0f;
     for (size_t i = 0; i < count; ++i) {
@@ -43,6 +50,7 @@ float vector_norm_scalar(const float* a, size_t count) {
     return std::sqrt(sum);
 }
 
+SIMD_LIB_MULTIVERSION
 float vector_norm_squared_scalar(const float* a, size_t count) {
     float sum = 0.0f;
     for (size_t i = 0; i < count; ++i) {
@@ -51,6 +59,7 @@ float vector_norm_squared_scalar(const float* a, size_t count) {
     return sum;
 }
 
+SIMD_LIB_MULTIVERSION
 void vector_normalize_scalar(const float* a, float* result, size_t count) {
     float norm = vector_norm_scalar(a, count);
     if (norm > 0.0f) {
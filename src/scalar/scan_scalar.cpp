@@ -0,0 +1,40 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+float inclusive_scan_scalar(const float* input, float* result, size_t count, float carry) {
+    for (size_t i = 0; i < count; ++i) {
+        carry += input[i];
+        result[i] = carry;
+    }
+    return carry;
+}
+
+SIMD_LIB_MULTIVERSION
+float exclusive_scan_scalar(const float* input, float* result, size_t count, float carry) {
+    for (size_t i = 0; i < count; ++i) {
+        float value = input[i];
+        result[i] = carry;
+        carry += value;
+    }
+    return carry;
+}
+
+SIMD_LIB_MULTIVERSION
+void summed_area_table_scalar(const float* input, float* result, size_t rows, size_t cols) {
+    for (size_t r = 0; r < rows; ++r) {
+        const float* in_row = &input[r * cols];
+        float* out_row = &result[r * cols];
+        inclusive_scan_scalar(in_row, out_row, cols, 0.0f);
+        if (r > 0) {
+            const float* above = &result[(r - 1) * cols];
+            for (size_t c = 0; c < cols; ++c) {
+                out_row[c] += above[c];
+            }
+        }
+    }
+}
+
+} // namespace simd_lib
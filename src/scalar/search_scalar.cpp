@@ -0,0 +1,48 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <cmath>
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void batch_dot_scalar(const float* query, const float* matrix, size_t rows, size_t dim, float* out) {
+    for (size_t r = 0; r < rows; ++r) {
+        out[r] = dot_product_scalar(query, &matrix[r * dim], dim);
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void batch_l2_squared_scalar(const float* query, const float* matrix, size_t rows, size_t dim, float* out) {
+    for (size_t r = 0; r < rows; ++r) {
+        const float* row = &matrix[r * dim];
+        float sum = 0.0f;
+        for (size_t i = 0; i < dim; ++i) {
+            float diff = row[i] - query[i];
+            sum += diff * diff;
+        }
+        out[r] = sum;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void batch_cosine_scalar(const float* query, const float* matrix, size_t rows, size_t dim, float* out) {
+    float query_norm = vector_norm_scalar(query, dim);
+    for (size_t r = 0; r < rows; ++r) {
+        const float* row = &matrix[r * dim];
+        float denom = query_norm * vector_norm_scalar(row, dim);
+        out[r] = denom > 0.0f ? dot_product_scalar(query, row, dim) / denom : 0.0f;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+size_t select_greater_scalar(const float* values, size_t count, float threshold, uint32_t* positions) {
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (values[i] > threshold) {
+            positions[found++] = (uint32_t)i;
+        }
+    }
+    return found;
+}
+
+} // namespace simd_lib
@@ -0,0 +1,34 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void sort_floats_scalar(float* data, size_t count) {
+    std::sort(data, data + count);
+}
+
+SIMD_LIB_MULTIVERSION
+void sort_key_value_scalar(float* keys, uint32_t* values, size_t count) {
+    std::vector<std::pair<float, uint32_t>> pairs(count);
+    for (size_t i = 0; i < count; ++i) {
+        pairs[i] = std::make_pair(keys[i], values[i]);
+    }
+    std::sort(pairs.begin(), pairs.end(),
+              [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) { return a.first < b.first; });
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = pairs[i].first;
+        values[i] = pairs[i].second;
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+float select_nth_scalar(float* data, size_t count, size_t n) {
+    std::nth_element(data, data + n, data + count);
+    return data[n];
+}
+
+} // namespace simd_lib
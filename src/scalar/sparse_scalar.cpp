@@ -0,0 +1,43 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+float sparse_dot_dense_scalar(const uint32_t* indices, const float* values, size_t nnz, const float* dense) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < nnz; ++i) {
+        sum += values[i] * dense[indices[i]];
+    }
+    return sum;
+}
+
+SIMD_LIB_MULTIVERSION
+float sparse_dot_sparse_scalar(const uint32_t* a_indices, const float* a_values, size_t a_nnz,
+                               const uint32_t* b_indices, const float* b_values, size_t b_nnz) {
+    float sum = 0.0f;
+    size_t i = 0, j = 0;
+    while (i < a_nnz && j < b_nnz) {
+        if (a_indices[i] < b_indices[j]) {
+            ++i;
+        } else if (a_indices[i] > b_indices[j]) {
+            ++j;
+        } else {
+            sum += a_values[i++] * b_values[j++];
+        }
+    }
+    return sum;
+}
+
+SIMD_LIB_MULTIVERSION
+float sparse_dot_dense_delta16_scalar(const uint16_t* deltas, const float* values, size_t nnz, const float* dense) {
+    float sum = 0.0f;
+    size_t index = 0;
+    for (size_t i = 0; i < nnz; ++i) {
+        index += deltas[i];
+        sum += values[i] * dense[index];
+    }
+    return sum;
+}
+
+} // namespace simd_lib
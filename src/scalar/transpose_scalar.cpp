@@ -0,0 +1,26 @@
+#include "simd_lib.h"
+#include "../common/multiversion.h"
+#include <utility>
+
+namespace simd_lib {
+
+SIMD_LIB_MULTIVERSION
+void transpose_scalar(const float* src, size_t rows, size_t cols, size_t lds, float* dst, size_t ldd) {
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            dst[c * ldd + r] = src[r * lds + c];
+        }
+    }
+}
+
+SIMD_LIB_MULTIVERSION
+void transpose_swap_scalar(float* a, float* b, size_t rows, size_t cols, size_t ld) {
+    const bool diagonal = a == b;
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = diagonal ? r + 1 : 0; c < cols; ++c) {
+            std::swap(a[r * ld + c], b[c * ld + r]);
+        }
+    }
+}
+
+} // namespace simd_lib
@@ -2,6 +2,7 @@
 #include <immintrin.h>
 #include <cstring>
 #include <cmath>
+#include <cstdint>
 
 namespace simd_lib {
 
@@ -106,6 +107,56 @@ void vector_scale_avx2(const float* a, float scale, float* result, size_t count)
     }
 }
 
+// Non-temporal variants for outputs much larger than the cache: the stores
+// bypass it, so they skip the read-for-ownership and do not evict the inputs.
+// op(a_vec, b_vec) / op(a, b) computes one result from the loaded inputs.
+template <typename VecOp, typename ScalarOp>
+static void binary_stream_avx2(const float* a, const float* b, float* result, size_t count,
+                               VecOp vec_op, ScalarOp scalar_op) {
+    size_t i = 0;
+
+    // Streaming stores need 32-byte aligned destinations
+    for (; i < count && (reinterpret_cast<uintptr_t>(&result[i]) & 31) != 0; ++i) {
+        result[i] = scalar_op(a[i], b[i]);
+    }
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 a_vec = _mm256_loadu_ps(&a[i]);
+        __m256 b_vec = _mm256_loadu_ps(&b[i]);
+        _mm256_stream_ps(&result[i], vec_op(a_vec, b_vec));
+    }
+    // Order the weakly-ordered stores before any later store, e.g. a flag
+    // another thread waits on
+    _mm_sfence();
+
+    for (; i < count; ++i) {
+        result[i] = scalar_op(a[i], b[i]);
+    }
+}
+
+void vector_add_avx2_stream(const float* a, const float* b, float* result, size_t count) {
+    binary_stream_avx2(a, b, result, count,
+        [](__m256 x, __m256 y) { return _mm256_add_ps(x, y); }, [](float x, float y) { return x + y; });
+}
+
+void vector_multiply_avx2_stream(const float* a, const float* b, float* result, size_t count) {
+    binary_stream_avx2(a, b, result, count,
+        [](__m256 x, __m256 y) { return _mm256_mul_ps(x, y); }, [](float x, float y) { return x * y; });
+}
+
+void vector_subtract_avx2_stream(const float* a, const float* b, float* result, size_t count) {
+    binary_stream_avx2(a, b, result, count,
+        [](__m256 x, __m256 y) { return _mm256_sub_ps(x, y); }, [](float x, float y) { return x - y; });
+}
+
+void vector_scale_avx2_stream(const float* a, float scale, float* result, size_t count) {
+    // b is unused; passing a keeps the loads in bounds
+    __m256 scale_vec = _mm256_set1_ps(scale);
+    binary_stream_avx2(a, a, result, count,
+        [scale_vec](__m256 x, __m256) { return _mm256_mul_ps(x, scale_vec); },
+        [scale](float x, float) { return x * scale; });
+}
+
 float vector_norm_squared_avx2(const float* a, size_t count) {
     __m256 sum_vec = _mm256_setzero_ps();
     size_t i = 0;
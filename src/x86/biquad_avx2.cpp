@@ -0,0 +1,113 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// One section over G adjacent groups of 8 channels. Each group's recursion
+// is a chain of two dependent FMAs per frame; running up to four groups
+// side by side keeps both FMA ports busy instead of waiting on the chain.
+template <size_t G>
+static inline void section_groups(float* data, size_t frames, size_t stride, const float* c, float* st) {
+    __m256 s1[G], s2[G];
+    for (size_t g = 0; g < G; ++g) {
+        s1[g] = _mm256_loadu_ps(&st[16 * g]);
+        s2[g] = _mm256_loadu_ps(&st[16 * g + 8]);
+    }
+    for (size_t t = 0; t < frames; ++t) {
+        float* x = &data[t * stride];
+        for (size_t g = 0; g < G; ++g) {
+            const float* k = &c[40 * g];  // b0 b1 b2 a1 a2, 8 lanes each
+            __m256 in = _mm256_loadu_ps(&x[8 * g]);
+            __m256 y = _mm256_fmadd_ps(_mm256_loadu_ps(&k[0]), in, s1[g]);
+            s1[g] = _mm256_fnmadd_ps(_mm256_loadu_ps(&k[24]), y, _mm256_fmadd_ps(_mm256_loadu_ps(&k[8]), in, s2[g]));
+            s2[g] = _mm256_fnmadd_ps(_mm256_loadu_ps(&k[32]), y, _mm256_mul_ps(_mm256_loadu_ps(&k[16]), in));
+            _mm256_storeu_ps(&x[8 * g], y);
+        }
+    }
+    for (size_t g = 0; g < G; ++g) {
+        _mm256_storeu_ps(&st[16 * g], s1[g]);
+        _mm256_storeu_ps(&st[16 * g + 8], s2[g]);
+    }
+}
+
+void biquad_channels_avx2(float* data, size_t frames, size_t stride, size_t groups, size_t sections,
+                          const float* coefficients, float* state) {
+    for (size_t s = 0; s < sections; ++s) {
+        const float* c = &coefficients[s * groups * 40];
+        float* st = &state[s * groups * 16];
+        size_t g = 0;
+        for (; g + 4 <= groups; g += 4) {
+            section_groups<4>(&data[8 * g], frames, stride, &c[40 * g], &st[16 * g]);
+        }
+        switch (groups - g) {
+        case 3:
+            section_groups<3>(&data[8 * g], frames, stride, &c[40 * g], &st[16 * g]);
+            break;
+        case 2:
+            section_groups<2>(&data[8 * g], frames, stride, &c[40 * g], &st[16 * g]);
+            break;
+        case 1:
+            section_groups<1>(&data[8 * g], frames, stride, &c[40 * g], &st[16 * g]);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void biquad_time_avx2(float* data, size_t count, size_t sections, const float* coefficients,
+                      const float* blocks, float* state) {
+    for (size_t s = 0; s < sections; ++s) {
+        const float* m = &blocks[s * kBiquadBlockFloats];
+        const __m128 a_col0 = _mm_loadu_ps(&m[96]);
+        const __m128 a_col1 = _mm_loadu_ps(&m[100]);
+        __m128 sv = _mm_setr_ps(state[2 * s], state[2 * s + 1], 0.0f, 0.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            float* x = &data[i];
+            __m256 xv = _mm256_loadu_ps(x);
+
+            // Input part of the next state, C x: both dot products reduced together
+            __m256 c0 = _mm256_mul_ps(xv, _mm256_loadu_ps(&m[80]));
+            __m256 c1 = _mm256_mul_ps(xv, _mm256_loadu_ps(&m[88]));
+            __m256 pairs = _mm256_hadd_ps(c0, c1);  // c0 c0 c1 c1 | c0 c0 c1 c1
+            __m128 quad = _mm_add_ps(_mm256_castps256_ps128(pairs), _mm256_extractf128_ps(pairs, 1));
+            __m128 cx = _mm_hadd_ps(quad, quad);    // C0 x, C1 x, C0 x, C1 x
+
+            // y = H x + O s; the H x part does not depend on the state
+            __m256 acc0 = _mm256_mul_ps(_mm256_broadcast_ss(&x[0]), _mm256_loadu_ps(&m[0]));
+            __m256 acc1 = _mm256_mul_ps(_mm256_broadcast_ss(&x[1]), _mm256_loadu_ps(&m[8]));
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&x[2]), _mm256_loadu_ps(&m[16]), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(&x[3]), _mm256_loadu_ps(&m[24]), acc1);
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&x[4]), _mm256_loadu_ps(&m[32]), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(&x[5]), _mm256_loadu_ps(&m[40]), acc1);
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&x[6]), _mm256_loadu_ps(&m[48]), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(&x[7]), _mm256_loadu_ps(&m[56]), acc1);
+            __m256 s1 = _mm256_broadcastss_ps(sv);
+            __m256 s2 = _mm256_broadcastss_ps(_mm_movehdup_ps(sv));
+            acc0 = _mm256_fmadd_ps(s1, _mm256_loadu_ps(&m[64]), acc0);
+            acc1 = _mm256_fmadd_ps(s2, _mm256_loadu_ps(&m[72]), acc1);
+            _mm256_storeu_ps(x, _mm256_add_ps(acc0, acc1));
+
+            // s' = C x + A^8 s: the only dependency between blocks
+            __m128 next = _mm_fmadd_ps(a_col0, _mm_permute_ps(sv, _MM_SHUFFLE(0, 0, 0, 0)), cx);
+            sv = _mm_fmadd_ps(a_col1, _mm_permute_ps(sv, _MM_SHUFFLE(1, 1, 1, 1)), next);
+        }
+
+        // Remaining samples by the plain recursion, which shares the state form
+        const float* c = &coefficients[s * 5];
+        float s1 = _mm_cvtss_f32(sv), s2 = _mm_cvtss_f32(_mm_movehdup_ps(sv));
+        for (; i < count; ++i) {
+            float in = data[i];
+            float y = c[0] * in + s1;
+            s1 = c[1] * in - c[3] * y + s2;
+            s2 = c[2] * in - c[4] * y;
+            data[i] = y;
+        }
+        state[2 * s] = s1;
+        state[2 * s + 1] = s2;
+    }
+}
+
+} // namespace simd_lib
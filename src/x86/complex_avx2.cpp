@@ -0,0 +1,234 @@
+#include "simd_lib.h"
+#include "math_avx2.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// Four interleaved complex products: (ar br - ai bi, ar bi + ai br). The real
+// parts of b are duplicated across each pair, the imaginary parts likewise,
+// and fmaddsub subtracts in the even (real) slots and adds in the odd ones.
+static inline __m256 multiply_pairs(__m256 a, __m256 b) {
+    __m256 b_real = _mm256_moveldup_ps(b);
+    __m256 b_imag = _mm256_movehdup_ps(b);
+    __m256 a_swapped = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));  // ai ar per pair
+    return _mm256_fmaddsub_ps(a, b_real, _mm256_mul_ps(a_swapped, b_imag));
+}
+
+// a * conj(b): (ar br + ai bi, ai br - ar bi)
+static inline __m256 multiply_conj_pairs(__m256 a, __m256 b) {
+    __m256 b_real = _mm256_moveldup_ps(b);
+    __m256 b_imag = _mm256_movehdup_ps(b);
+    __m256 a_swapped = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm256_fmsubadd_ps(a, b_real, _mm256_mul_ps(a_swapped, b_imag));
+}
+
+// Splits eight interleaved complex values into planar real and imaginary parts
+static inline void split_pairs(const float* data, __m256* real, __m256* imag) {
+    __m256 v0 = _mm256_loadu_ps(data);
+    __m256 v1 = _mm256_loadu_ps(data + 8);
+    // Per lane: r0 r1 r4 r5 | r2 r3 r6 r7, then reorder the 64-bit pairs
+    __m256 even = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 odd = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+    *real = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(even), _MM_SHUFFLE(3, 1, 2, 0)));
+    *imag = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(odd), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+void complex_multiply_avx2(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                           float* out_real, float* out_imag, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 ar = _mm256_loadu_ps(&a_real[i]);
+        __m256 ai = _mm256_loadu_ps(&a_imag[i]);
+        __m256 br = _mm256_loadu_ps(&b_real[i]);
+        __m256 bi = _mm256_loadu_ps(&b_imag[i]);
+        __m256 re = _mm256_fmsub_ps(ar, br, _mm256_mul_ps(ai, bi));
+        __m256 im = _mm256_fmadd_ps(ar, bi, _mm256_mul_ps(ai, br));
+        _mm256_storeu_ps(&out_real[i], re);
+        _mm256_storeu_ps(&out_imag[i], im);
+    }
+    complex_multiply_scalar(&a_real[i], &a_imag[i], &b_real[i], &b_imag[i], &out_real[i], &out_imag[i], count - i);
+}
+
+void complex_multiply_conj_avx2(const float* a_real, const float* a_imag, const float* b_real, const float* b_imag,
+                                float* out_real, float* out_imag, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 ar = _mm256_loadu_ps(&a_real[i]);
+        __m256 ai = _mm256_loadu_ps(&a_imag[i]);
+        __m256 br = _mm256_loadu_ps(&b_real[i]);
+        __m256 bi = _mm256_loadu_ps(&b_imag[i]);
+        __m256 re = _mm256_fmadd_ps(ar, br, _mm256_mul_ps(ai, bi));
+        __m256 im = _mm256_fmsub_ps(ai, br, _mm256_mul_ps(ar, bi));
+        _mm256_storeu_ps(&out_real[i], re);
+        _mm256_storeu_ps(&out_imag[i], im);
+    }
+    complex_multiply_conj_scalar(&a_real[i], &a_imag[i], &b_real[i], &b_imag[i], &out_real[i], &out_imag[i],
+                                 count - i);
+}
+
+void complex_magnitude_avx2(const float* real, const float* imag, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 re = _mm256_loadu_ps(&real[i]);
+        __m256 im = _mm256_loadu_ps(&imag[i]);
+        _mm256_storeu_ps(&out[i], _mm256_sqrt_ps(_mm256_fmadd_ps(re, re, _mm256_mul_ps(im, im))));
+    }
+    complex_magnitude_scalar(&real[i], &imag[i], &out[i], count - i);
+}
+
+void complex_magnitude_squared_avx2(const float* real, const float* imag, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 re = _mm256_loadu_ps(&real[i]);
+        __m256 im = _mm256_loadu_ps(&imag[i]);
+        _mm256_storeu_ps(&out[i], _mm256_fmadd_ps(re, re, _mm256_mul_ps(im, im)));
+    }
+    complex_magnitude_squared_scalar(&real[i], &imag[i], &out[i], count - i);
+}
+
+void complex_phase_avx2(const float* real, const float* imag, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(&out[i], atan2_256_ps(_mm256_loadu_ps(&imag[i]), _mm256_loadu_ps(&real[i])));
+    }
+    // The tail goes through the same polynomial so results never depend on position
+    if (i < count) {
+        float re[8] = {}, im[8] = {}, phase[8];
+        for (size_t k = 0; k < count - i; ++k) {
+            re[k] = real[i + k];
+            im[k] = imag[i + k];
+        }
+        _mm256_storeu_ps(phase, atan2_256_ps(_mm256_loadu_ps(im), _mm256_loadu_ps(re)));
+        for (size_t k = 0; k < count - i; ++k) {
+            out[i + k] = phase[k];
+        }
+    }
+}
+
+void complex_scale_accumulate_avx2(const float* real, const float* imag, float scale_real, float scale_imag,
+                                   float* acc_real, float* acc_imag, size_t count) {
+    const __m256 sr = _mm256_set1_ps(scale_real);
+    const __m256 si = _mm256_set1_ps(scale_imag);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 re = _mm256_loadu_ps(&real[i]);
+        __m256 im = _mm256_loadu_ps(&imag[i]);
+        __m256 acc_re = _mm256_fmadd_ps(sr, re, _mm256_loadu_ps(&acc_real[i]));
+        __m256 acc_im = _mm256_fmadd_ps(sr, im, _mm256_loadu_ps(&acc_imag[i]));
+        _mm256_storeu_ps(&acc_real[i], _mm256_fnmadd_ps(si, im, acc_re));
+        _mm256_storeu_ps(&acc_imag[i], _mm256_fmadd_ps(si, re, acc_im));
+    }
+    complex_scale_accumulate_scalar(&real[i], &imag[i], scale_real, scale_imag, &acc_real[i], &acc_imag[i],
+                                    count - i);
+}
+
+// 10 / ln(10): decibels per natural-log unit of power
+static const float kDecibelsPerLog = 4.34294482f;
+
+static inline __m256 power_db(__m256 re, __m256 im, __m256 floor) {
+    __m256 power = _mm256_fmadd_ps(re, re, _mm256_mul_ps(im, im));
+    return _mm256_mul_ps(_mm256_set1_ps(kDecibelsPerLog), log256_ps(_mm256_max_ps(power, floor)));
+}
+
+void complex_power_db_avx2(const float* real, const float* imag, float floor, float* out, size_t count) {
+    const __m256 lower = _mm256_set1_ps(floor);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(&out[i], power_db(_mm256_loadu_ps(&real[i]), _mm256_loadu_ps(&imag[i]), lower));
+    }
+    // The tail goes through the same polynomial so results never depend on position
+    if (i < count) {
+        float re[8] = {}, im[8] = {}, db[8];
+        for (size_t k = 0; k < count - i; ++k) {
+            re[k] = real[i + k];
+            im[k] = imag[i + k];
+        }
+        _mm256_storeu_ps(db, power_db(_mm256_loadu_ps(re), _mm256_loadu_ps(im), lower));
+        for (size_t k = 0; k < count - i; ++k) {
+            out[i + k] = db[k];
+        }
+    }
+}
+
+void complex_multiply_interleaved_avx2(const float* a, const float* b, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 p0 = multiply_pairs(_mm256_loadu_ps(&a[2 * i]), _mm256_loadu_ps(&b[2 * i]));
+        __m256 p1 = multiply_pairs(_mm256_loadu_ps(&a[2 * i + 8]), _mm256_loadu_ps(&b[2 * i + 8]));
+        _mm256_storeu_ps(&out[2 * i], p0);
+        _mm256_storeu_ps(&out[2 * i + 8], p1);
+    }
+    complex_multiply_interleaved_scalar(&a[2 * i], &b[2 * i], &out[2 * i], count - i);
+}
+
+void complex_multiply_conj_interleaved_avx2(const float* a, const float* b, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 p0 = multiply_conj_pairs(_mm256_loadu_ps(&a[2 * i]), _mm256_loadu_ps(&b[2 * i]));
+        __m256 p1 = multiply_conj_pairs(_mm256_loadu_ps(&a[2 * i + 8]), _mm256_loadu_ps(&b[2 * i + 8]));
+        _mm256_storeu_ps(&out[2 * i], p0);
+        _mm256_storeu_ps(&out[2 * i + 8], p1);
+    }
+    complex_multiply_conj_interleaved_scalar(&a[2 * i], &b[2 * i], &out[2 * i], count - i);
+}
+
+// Squared magnitudes of eight interleaved values, in order: hadd sums each
+// pair but interleaves the two sources per lane, which permute4x64 undoes
+static inline __m256 magnitude_squared_pairs(const float* data) {
+    __m256 v0 = _mm256_loadu_ps(data);
+    __m256 v1 = _mm256_loadu_ps(data + 8);
+    __m256 sums = _mm256_hadd_ps(_mm256_mul_ps(v0, v0), _mm256_mul_ps(v1, v1));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sums), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+void complex_magnitude_interleaved_avx2(const float* data, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(&out[i], _mm256_sqrt_ps(magnitude_squared_pairs(&data[2 * i])));
+    }
+    complex_magnitude_interleaved_scalar(&data[2 * i], &out[i], count - i);
+}
+
+void complex_magnitude_squared_interleaved_avx2(const float* data, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(&out[i], magnitude_squared_pairs(&data[2 * i]));
+    }
+    complex_magnitude_squared_interleaved_scalar(&data[2 * i], &out[i], count - i);
+}
+
+void complex_phase_interleaved_avx2(const float* data, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 re, im;
+        split_pairs(&data[2 * i], &re, &im);
+        _mm256_storeu_ps(&out[i], atan2_256_ps(im, re));
+    }
+    if (i < count) {
+        float pairs[16] = {}, phase[8];
+        for (size_t k = 0; k < 2 * (count - i); ++k) {
+            pairs[k] = data[2 * i + k];
+        }
+        __m256 re, im;
+        split_pairs(pairs, &re, &im);
+        _mm256_storeu_ps(phase, atan2_256_ps(im, re));
+        for (size_t k = 0; k < count - i; ++k) {
+            out[i + k] = phase[k];
+        }
+    }
+}
+
+void complex_scale_accumulate_interleaved_avx2(const float* data, float scale_real, float scale_imag, float* acc,
+                                               size_t count) {
+    // The scale as a repeated (sr, si) pair, so multiply_pairs applies it
+    const __m256 scale = _mm256_setr_ps(scale_real, scale_imag, scale_real, scale_imag, scale_real, scale_imag,
+                                        scale_real, scale_imag);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256 product = multiply_pairs(_mm256_loadu_ps(&data[2 * i]), scale);
+        _mm256_storeu_ps(&acc[2 * i], _mm256_add_ps(_mm256_loadu_ps(&acc[2 * i]), product));
+    }
+    complex_scale_accumulate_interleaved_scalar(&data[2 * i], scale_real, scale_imag, &acc[2 * i], count - i);
+}
+
+} // namespace simd_lib
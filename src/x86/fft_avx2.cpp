@@ -0,0 +1,107 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+void fft_stage_avx2(float* real, float* imag, size_t n, size_t half, const float* w_real, const float* w_imag) {
+    // The first three stages have fewer than 8 butterflies per group
+    if (half < 8) {
+        fft_stage_scalar(real, imag, n, half, w_real, w_imag);
+        return;
+    }
+
+    for (size_t i = 0; i < n; i += 2 * half) {
+        float* u_real = &real[i];
+        float* u_imag = &imag[i];
+        float* v_real = &real[i + half];
+        float* v_imag = &imag[i + half];
+
+        for (size_t j = 0; j < half; j += 8) {
+            __m256 wr = _mm256_loadu_ps(&w_real[j]);
+            __m256 wi = _mm256_loadu_ps(&w_imag[j]);
+            __m256 vr = _mm256_loadu_ps(&v_real[j]);
+            __m256 vi = _mm256_loadu_ps(&v_imag[j]);
+
+            // t = w * v
+            __m256 tr = _mm256_fmsub_ps(wr, vr, _mm256_mul_ps(wi, vi));
+            __m256 ti = _mm256_fmadd_ps(wr, vi, _mm256_mul_ps(wi, vr));
+
+            __m256 ur = _mm256_loadu_ps(&u_real[j]);
+            __m256 ui = _mm256_loadu_ps(&u_imag[j]);
+            _mm256_storeu_ps(&v_real[j], _mm256_sub_ps(ur, tr));
+            _mm256_storeu_ps(&v_imag[j], _mm256_sub_ps(ui, ti));
+            _mm256_storeu_ps(&u_real[j], _mm256_add_ps(ur, tr));
+            _mm256_storeu_ps(&u_imag[j], _mm256_add_ps(ui, ti));
+        }
+    }
+}
+
+// Interleaves 8 real and 8 imaginary parts into dst[0..16)
+static inline void store_interleaved(float* dst, __m256 re, __m256 im) {
+    __m256 lo = _mm256_unpacklo_ps(re, im);  // r0 i0 r1 i1 | r4 i4 r5 i5
+    __m256 hi = _mm256_unpackhi_ps(re, im);  // r2 i2 r3 i3 | r6 i6 r7 i7
+    _mm256_storeu_ps(dst, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+
+void fft_first_stage_interleaved_avx2(const float* data, const uint32_t* index, float* real, float* imag, size_t n) {
+    const size_t half_n = n / 2;
+    // Each (re, im) pair is gathered as one 64-bit element
+    const double* pairs = reinterpret_cast<const double*>(data);
+    const __m128i offset = _mm_set1_epi32((int)half_n);
+    // The masked form with an explicit zero source keeps GCC from warning that
+    // the plain gather's pass-through register is uninitialized
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+    size_t k = 0;
+    for (; k + 4 <= half_n; k += 4) {
+        __m128i iu = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&index[k]));
+        __m128i iv = _mm_add_epi32(iu, offset);
+        __m256 u = _mm256_castpd_ps(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), pairs, iu, all, 8));
+        __m256 v = _mm256_castpd_ps(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), pairs, iv, all, 8));
+        __m256 sum = _mm256_add_ps(u, v);   // s0r s0i s1r s1i | s2r s2i s3r s3i
+        __m256 diff = _mm256_sub_ps(u, v);
+
+        // Outputs 2k, 2k + 1, ... alternate sum and difference
+        __m256 lo = _mm256_unpacklo_ps(sum, diff);  // s0r d0r s0i d0i | s2r d2r s2i d2i
+        __m256 hi = _mm256_unpackhi_ps(sum, diff);  // s1r d1r s1i d1i | s3r d3r s3i d3i
+        _mm256_storeu_ps(&real[2 * k], _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(lo), _mm256_castps_pd(hi))));
+        _mm256_storeu_ps(&imag[2 * k], _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(lo), _mm256_castps_pd(hi))));
+    }
+    for (; k < half_n; ++k) {
+        const float* u = &data[2 * index[k]];
+        const float* v = &data[2 * (index[k] + half_n)];
+        real[2 * k] = u[0] + v[0];
+        imag[2 * k] = u[1] + v[1];
+        real[2 * k + 1] = u[0] - v[0];
+        imag[2 * k + 1] = u[1] - v[1];
+    }
+}
+
+void fft_last_stage_interleaved_avx2(const float* real, const float* imag, size_t n, const float* w_real,
+                                     const float* w_imag, float scale, float* data) {
+    const size_t half = n / 2;
+    if (half < 8) {
+        fft_last_stage_interleaved_scalar(real, imag, n, w_real, w_imag, scale, data);
+        return;
+    }
+
+    const __m256 vscale = _mm256_set1_ps(scale);
+    for (size_t j = 0; j < half; j += 8) {
+        __m256 wr = _mm256_loadu_ps(&w_real[j]);
+        __m256 wi = _mm256_loadu_ps(&w_imag[j]);
+        __m256 vr = _mm256_loadu_ps(&real[half + j]);
+        __m256 vi = _mm256_loadu_ps(&imag[half + j]);
+        __m256 tr = _mm256_fmsub_ps(wr, vr, _mm256_mul_ps(wi, vi));
+        __m256 ti = _mm256_fmadd_ps(wr, vi, _mm256_mul_ps(wi, vr));
+
+        __m256 ur = _mm256_loadu_ps(&real[j]);
+        __m256 ui = _mm256_loadu_ps(&imag[j]);
+        store_interleaved(&data[2 * j], _mm256_mul_ps(_mm256_add_ps(ur, tr), vscale),
+                          _mm256_mul_ps(_mm256_add_ps(ui, ti), vscale));
+        store_interleaved(&data[2 * (half + j)], _mm256_mul_ps(_mm256_sub_ps(ur, tr), vscale),
+                          _mm256_mul_ps(_mm256_sub_ps(ui, ti), vscale));
+    }
+}
+
+} // namespace simd_lib
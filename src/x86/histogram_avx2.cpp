@@ -0,0 +1,142 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// Up to this many bins each lane of a vector increments one of 4 interleaved
+// sub-histograms; beyond it equal neighbours are rare and one copy is kept
+static const size_t kSubHistogramMaxBins = 1 << 16;
+// uint32 sub-histogram counters are flushed to the uint64 output this often
+static const size_t kFlushElements = (size_t)1 << 31;
+
+// 8 bin indices, or -1 in lanes outside [lo, hi] or NaN. Matches bin_of() in
+// histogram_scalar.cpp.
+static inline __m256i bin_index8(__m256 x, __m256 lo, __m256 hi, __m256 scale, __m256i last) {
+    __m256 valid = _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ), _mm256_cmp_ps(x, hi, _CMP_LE_OQ));
+    __m256i bin = _mm256_min_epu32(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(x, lo), scale)), last);
+    return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(_mm256_set1_epi32(-1)),
+                                                _mm256_castsi256_ps(bin), valid));
+}
+
+// Scalar tail, as in histogram_scalar.cpp
+static inline size_t bin_of(float x, float lo, float hi, float scale, size_t bins) {
+    if (!(x >= lo && x <= hi)) {
+        return bins;
+    }
+    size_t bin = (size_t)(int32_t)((x - lo) * scale);
+    return bin < bins ? bin : bins - 1;
+}
+
+namespace {
+
+// Sub-histograms of bins + 1 counters each; the extra one absorbs
+// out-of-range lanes so the increment loop has no branch
+class SubHistograms {
+public:
+    explicit SubHistograms(size_t bins)
+        : bins_(bins), copies_(bins <= kSubHistogramMaxBins ? 4 : 1), stride_(bins + 1),
+          counters_(new uint32_t[copies_ * stride_]()) {}
+    ~SubHistograms() { delete[] counters_; }
+
+    // Offset of each lane's copy, added to its bin index
+    __m256i lane_offsets() const {
+        const int32_t s = (int32_t)stride_;
+        return copies_ == 4 ? _mm256_setr_epi32(0, s, 2 * s, 3 * s, 0, s, 2 * s, 3 * s) : _mm256_setzero_si256();
+    }
+
+    // Out-of-range lanes (-1) go to the spare counter of their copy
+    void add8(__m256i bin, __m256i offsets) {
+        alignas(32) uint32_t slot[8];
+        __m256i spare = _mm256_set1_epi32((int32_t)bins_);
+        bin = _mm256_blendv_epi8(bin, spare, _mm256_srai_epi32(bin, 31));
+        _mm256_store_si256((__m256i*)slot, _mm256_add_epi32(bin, offsets));
+        for (int lane = 0; lane < 8; ++lane) {
+            ++counters_[slot[lane]];
+        }
+    }
+
+    void add(size_t bin) { ++counters_[bin]; }
+
+    void flush(uint64_t* counts) {
+        for (size_t c = 0; c < copies_; ++c) {
+            uint32_t* copy = &counters_[c * stride_];
+            for (size_t b = 0; b < bins_; ++b) {
+                counts[b] += copy[b];
+            }
+            for (size_t b = 0; b < stride_; ++b) {
+                copy[b] = 0;
+            }
+        }
+    }
+
+private:
+    SubHistograms(const SubHistograms&) = delete;
+    SubHistograms& operator=(const SubHistograms&) = delete;
+
+    size_t bins_;
+    size_t copies_;
+    size_t stride_;
+    uint32_t* counters_;
+};
+
+} // namespace
+
+void histogram_avx2(const float* data, size_t count, float lo, float hi, size_t bins, uint64_t* counts) {
+    const float scale = (float)((double)bins / ((double)hi - (double)lo));
+    const __m256 lo_v = _mm256_set1_ps(lo);
+    const __m256 hi_v = _mm256_set1_ps(hi);
+    const __m256 scale_v = _mm256_set1_ps(scale);
+    const __m256i last = _mm256_set1_epi32((int32_t)(bins - 1));
+    SubHistograms sub(bins);
+    const __m256i offsets = sub.lane_offsets();
+
+    for (size_t begin = 0; begin < count; begin += kFlushElements) {
+        size_t end = count - begin < kFlushElements ? count : begin + kFlushElements;
+        size_t i = begin;
+        for (; i + 16 <= end; i += 16) {
+            __m256i a = bin_index8(_mm256_loadu_ps(&data[i]), lo_v, hi_v, scale_v, last);
+            __m256i b = bin_index8(_mm256_loadu_ps(&data[i + 8]), lo_v, hi_v, scale_v, last);
+            sub.add8(a, offsets);
+            sub.add8(b, offsets);
+        }
+        for (; i < end; ++i) {
+            sub.add(bin_of(data[i], lo, hi, scale, bins));
+        }
+        sub.flush(counts);
+    }
+}
+
+void histogram2d_avx2(const float* x, const float* y, size_t count, float x_lo, float x_hi, size_t x_bins,
+                      float y_lo, float y_hi, size_t y_bins, uint64_t* counts) {
+    const float x_scale = (float)((double)x_bins / ((double)x_hi - (double)x_lo));
+    const float y_scale = (float)((double)y_bins / ((double)y_hi - (double)y_lo));
+    const __m256 x_lo_v = _mm256_set1_ps(x_lo), x_hi_v = _mm256_set1_ps(x_hi), x_scale_v = _mm256_set1_ps(x_scale);
+    const __m256 y_lo_v = _mm256_set1_ps(y_lo), y_hi_v = _mm256_set1_ps(y_hi), y_scale_v = _mm256_set1_ps(y_scale);
+    const __m256i x_last = _mm256_set1_epi32((int32_t)(x_bins - 1));
+    const __m256i y_last = _mm256_set1_epi32((int32_t)(y_bins - 1));
+    const __m256i row = _mm256_set1_epi32((int32_t)y_bins);
+    const size_t bins = x_bins * y_bins;
+    SubHistograms sub(bins);
+    const __m256i offsets = sub.lane_offsets();
+
+    for (size_t begin = 0; begin < count; begin += kFlushElements) {
+        size_t end = count - begin < kFlushElements ? count : begin + kFlushElements;
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8) {
+            __m256i bx = bin_index8(_mm256_loadu_ps(&x[i]), x_lo_v, x_hi_v, x_scale_v, x_last);
+            __m256i by = bin_index8(_mm256_loadu_ps(&y[i]), y_lo_v, y_hi_v, y_scale_v, y_last);
+            // Either coordinate out of range makes the combined index -1
+            __m256i outside = _mm256_or_si256(_mm256_srai_epi32(bx, 31), _mm256_srai_epi32(by, 31));
+            __m256i bin = _mm256_add_epi32(_mm256_mullo_epi32(bx, row), by);
+            sub.add8(_mm256_or_si256(bin, outside), offsets);
+        }
+        for (; i < end; ++i) {
+            size_t bx = bin_of(x[i], x_lo, x_hi, x_scale, x_bins);
+            size_t by = bin_of(y[i], y_lo, y_hi, y_scale, y_bins);
+            sub.add(bx < x_bins && by < y_bins ? bx * y_bins + by : bins);
+        }
+        sub.flush(counts);
+    }
+}
+
+} // namespace simd_lib
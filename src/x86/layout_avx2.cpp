@@ -0,0 +1,124 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// Two 128-bit loads into the low and high lanes of one register
+static inline __m256 load_lanes(const float* low, const float* high) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+}
+
+// 4x4 transpose within each 128-bit lane
+static inline void transpose4_lanes(__m256& a, __m256& b, __m256& c, __m256& d) {
+    __m256 t0 = _mm256_unpacklo_ps(a, b);
+    __m256 t1 = _mm256_unpackhi_ps(a, b);
+    __m256 t2 = _mm256_unpacklo_ps(c, d);
+    __m256 t3 = _mm256_unpackhi_ps(c, d);
+    a = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    b = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    d = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+void deinterleave2_avx2(const float* src, float* a, float* b, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 v0 = _mm256_loadu_ps(&src[2 * i]);      // a0 b0 a1 b1 | a2 b2 a3 b3
+        __m256 v1 = _mm256_loadu_ps(&src[2 * i + 8]);  // a4 b4 a5 b5 | a6 b6 a7 b7
+        // Per lane: a0 a1 a4 a5 | a2 a3 a6 a7, then reorder the 64-bit pairs
+        __m256 even = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 odd = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm256_storeu_ps(&a[i], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(even), _MM_SHUFFLE(3, 1, 2, 0))));
+        _mm256_storeu_ps(&b[i], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(odd), _MM_SHUFFLE(3, 1, 2, 0))));
+    }
+    deinterleave2_scalar(&src[2 * i], &a[i], &b[i], count - i);
+}
+
+void deinterleave3_avx2(const float* src, float* a, float* b, float* c, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float* p = &src[3 * i];
+        // Points 0-3 in the low lanes, 4-7 in the high lanes
+        __m256 m03 = load_lanes(p, p + 12);       // x0 y0 z0 x1 | x4 y4 z4 x5
+        __m256 m14 = load_lanes(p + 4, p + 16);   // y1 z1 x2 y2 | y5 z5 x6 y6
+        __m256 m25 = load_lanes(p + 8, p + 20);   // z2 x3 y3 z3 | z6 x7 y7 z7
+        __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));  // x2 y2 x3 y3
+        __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));  // y0 z0 y1 z1
+        _mm256_storeu_ps(&a[i], _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0)));
+        _mm256_storeu_ps(&b[i], _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm256_storeu_ps(&c[i], _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1)));
+    }
+    deinterleave3_scalar(&src[3 * i], &a[i], &b[i], &c[i], count - i);
+}
+
+void deinterleave4_avx2(const float* src, float* a, float* b, float* c, float* d, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // Point k in the low lane and point k + 4 in the high lane, so the
+        // in-lane transposes leave each component in order
+        const float* p = &src[4 * i];
+        __m256 r0 = load_lanes(p, p + 16);
+        __m256 r1 = load_lanes(p + 4, p + 20);
+        __m256 r2 = load_lanes(p + 8, p + 24);
+        __m256 r3 = load_lanes(p + 12, p + 28);
+        transpose4_lanes(r0, r1, r2, r3);
+        _mm256_storeu_ps(&a[i], r0);
+        _mm256_storeu_ps(&b[i], r1);
+        _mm256_storeu_ps(&c[i], r2);
+        _mm256_storeu_ps(&d[i], r3);
+    }
+    deinterleave4_scalar(&src[4 * i], &a[i], &b[i], &c[i], &d[i], count - i);
+}
+
+void interleave2_avx2(const float* a, const float* b, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 va = _mm256_loadu_ps(&a[i]);
+        __m256 vb = _mm256_loadu_ps(&b[i]);
+        __m256 lo = _mm256_unpacklo_ps(va, vb);  // a0 b0 a1 b1 | a4 b4 a5 b5
+        __m256 hi = _mm256_unpackhi_ps(va, vb);  // a2 b2 a3 b3 | a6 b6 a7 b7
+        _mm256_storeu_ps(&dst[2 * i], _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(&dst[2 * i + 8], _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    interleave2_scalar(&a[i], &b[i], &dst[2 * i], count - i);
+}
+
+void interleave3_avx2(const float* a, const float* b, const float* c, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(&a[i]);
+        __m256 y = _mm256_loadu_ps(&b[i]);
+        __m256 z = _mm256_loadu_ps(&c[i]);
+        __m256 rxy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));  // x0 x2 y0 y2
+        __m256 ryz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));  // y1 y3 z1 z3
+        __m256 rzx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));  // z0 z2 x1 x3
+        __m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));  // x0 y0 z0 x1
+        __m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));  // y1 z1 x2 y2
+        __m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));  // z2 x3 y3 z3
+        float* p = &dst[3 * i];
+        _mm256_storeu_ps(p, _mm256_permute2f128_ps(r03, r14, 0x20));
+        _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(r25, r03, 0x30));
+        _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(r14, r25, 0x31));
+    }
+    interleave3_scalar(&a[i], &b[i], &c[i], &dst[3 * i], count - i);
+}
+
+void interleave4_avx2(const float* a, const float* b, const float* c, const float* d, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 r0 = _mm256_loadu_ps(&a[i]);
+        __m256 r1 = _mm256_loadu_ps(&b[i]);
+        __m256 r2 = _mm256_loadu_ps(&c[i]);
+        __m256 r3 = _mm256_loadu_ps(&d[i]);
+        // Lanes now hold points k | k + 4
+        transpose4_lanes(r0, r1, r2, r3);
+        float* p = &dst[4 * i];
+        _mm256_storeu_ps(p, _mm256_permute2f128_ps(r0, r1, 0x20));
+        _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(r2, r3, 0x20));
+        _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(r0, r1, 0x31));
+        _mm256_storeu_ps(p + 24, _mm256_permute2f128_ps(r2, r3, 0x31));
+    }
+    interleave4_scalar(&a[i], &b[i], &c[i], &d[i], &dst[4 * i], count - i);
+}
+
+} // namespace simd_lib
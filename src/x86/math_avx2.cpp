@@ -0,0 +1,122 @@
+#include "simd_lib.h"
+#include "math_avx2.h"
+#include <immintrin.h>
+#include <cmath>
+
+namespace simd_lib {
+
+// Lane mask selecting the first remaining elements of a partial vector
+static inline __m256i tail_mask(size_t remaining) {
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)remaining), lanes);
+}
+
+// Applies op to 8 floats at a time. The tail goes through masked loads and
+// stores so every element sees the same polynomial, whatever its position.
+template <typename Op>
+static inline void apply_unary(const float* input, float* result, size_t count, Op op) {
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(&result[i], op(_mm256_loadu_ps(&input[i])));
+    }
+
+    if (i < count) {
+        __m256i mask = tail_mask(count - i);
+        _mm256_maskstore_ps(&result[i], mask, op(_mm256_maskload_ps(&input[i], mask)));
+    }
+}
+
+// sincos256_ps loses accuracy past kSinCosMaxArgument; rare out-of-range
+// lanes (and infinities) are recomputed with libm
+static inline void sincos_checked(const float* input, __m256 x, __m256* s, __m256* c, int lanes) {
+    sincos256_ps(x, s, c);
+    __m256 abs_x = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    int large = _mm256_movemask_ps(_mm256_cmp_ps(abs_x, _mm256_set1_ps(kSinCosMaxArgument), _CMP_GT_OQ));
+    if (large != 0) {
+        alignas(32) float sin_buf[8];
+        alignas(32) float cos_buf[8];
+        _mm256_store_ps(sin_buf, *s);
+        _mm256_store_ps(cos_buf, *c);
+        for (int k = 0; k < lanes; ++k) {
+            if (large & (1 << k)) {
+                sin_buf[k] = std::sin(input[k]);
+                cos_buf[k] = std::cos(input[k]);
+            }
+        }
+        *s = _mm256_load_ps(sin_buf);
+        *c = _mm256_load_ps(cos_buf);
+    }
+}
+
+void vector_exp_avx2(const float* input, float* result, size_t count) {
+    apply_unary(input, result, count, exp256_ps);
+}
+
+void vector_log_avx2(const float* input, float* result, size_t count) {
+    apply_unary(input, result, count, log256_ps);
+}
+
+void vector_tanh_avx2(const float* input, float* result, size_t count) {
+    apply_unary(input, result, count, tanh256_ps);
+}
+
+void vector_sigmoid_avx2(const float* input, float* result, size_t count) {
+    apply_unary(input, result, count, sigmoid256_ps);
+}
+
+void vector_rsqrt_avx2(const float* input, float* result, size_t count) {
+    apply_unary(input, result, count, rsqrt256_ps);
+}
+
+void vector_sincos_avx2(const float* input, float* sin_result, float* cos_result, size_t count) {
+    size_t i = 0;
+    __m256 s, c;
+
+    for (; i + 8 <= count; i += 8) {
+        sincos_checked(&input[i], _mm256_loadu_ps(&input[i]), &s, &c, 8);
+        _mm256_storeu_ps(&sin_result[i], s);
+        _mm256_storeu_ps(&cos_result[i], c);
+    }
+
+    if (i < count) {
+        __m256i mask = tail_mask(count - i);
+        sincos_checked(&input[i], _mm256_maskload_ps(&input[i], mask), &s, &c, (int)(count - i));
+        _mm256_maskstore_ps(&sin_result[i], mask, s);
+        _mm256_maskstore_ps(&cos_result[i], mask, c);
+    }
+}
+
+void vector_sin_avx2(const float* input, float* result, size_t count) {
+    size_t i = 0;
+    __m256 s, c;
+
+    for (; i + 8 <= count; i += 8) {
+        sincos_checked(&input[i], _mm256_loadu_ps(&input[i]), &s, &c, 8);
+        _mm256_storeu_ps(&result[i], s);
+    }
+
+    if (i < count) {
+        __m256i mask = tail_mask(count - i);
+        sincos_checked(&input[i], _mm256_maskload_ps(&input[i], mask), &s, &c, (int)(count - i));
+        _mm256_maskstore_ps(&result[i], mask, s);
+    }
+}
+
+void vector_cos_avx2(const float* input, float* result, size_t count) {
+    size_t i = 0;
+    __m256 s, c;
+
+    for (; i + 8 <= count; i += 8) {
+        sincos_checked(&input[i], _mm256_loadu_ps(&input[i]), &s, &c, 8);
+        _mm256_storeu_ps(&result[i], c);
+    }
+
+    if (i < count) {
+        __m256i mask = tail_mask(count - i);
+        sincos_checked(&input[i], _mm256_maskload_ps(&input[i], mask), &s, &c, (int)(count - i));
+        _mm256_maskstore_ps(&result[i], mask, c);
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,239 @@
+#pragma once
+
+// Cephes-derived single precision elementary functions on 8 lanes. Shared by
+// the vector_* math kernels and by any AVX2 kernel that needs exp/log/sin/cos
+// inline. Requires AVX2 and FMA.
+
+#include <immintrin.h>
+#include <limits>
+
+namespace simd_lib {
+
+static const float kFloatInfinity = std::numeric_limits<float>::infinity();
+
+// exp(x): n = round(x / ln2), r = x - n*ln2 (two-constant split), degree-6
+// polynomial for e^r, then 2^n is added to the exponent field. Inputs above
+// 88.72 return +inf, inputs below -87.33 return 0 (no denormal results).
+static inline __m256 exp256_ps(__m256 x) {
+    const __m256 hi = _mm256_set1_ps(88.7228391f);
+    const __m256 lo = _mm256_set1_ps(-87.3365447f);
+    const __m256 log2e = _mm256_set1_ps(1.44269504088896341f);
+    const __m256 ln2_hi = _mm256_set1_ps(0.693359375f);
+    const __m256 ln2_lo = _mm256_set1_ps(-2.12194440e-4f);
+
+    __m256 overflow = _mm256_cmp_ps(x, hi, _CMP_GT_OQ);
+    __m256 underflow = _mm256_cmp_ps(x, lo, _CMP_LT_OQ);
+    // min/max return the second operand on NaN, so NaN inputs propagate
+    x = _mm256_max_ps(lo, _mm256_min_ps(hi, x));
+
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, log2e), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(n, ln2_hi, x);
+    r = _mm256_fnmadd_ps(n, ln2_lo, r);
+
+    __m256 p = _mm256_set1_ps(1.9875691500e-4f);
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.3981999507e-3f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(8.3334519073e-3f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(4.1665795894e-2f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.6666665459e-1f));
+    p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.0000001201e-1f));
+    p = _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+
+    // Scale by 2^n in two halves so n = 128 (x near 88.7) does not overflow the exponent
+    __m256i ni = _mm256_cvtps_epi32(n);
+    __m256i half = _mm256_srai_epi32(ni, 1);
+    __m256 scale0 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(half, _mm256_set1_epi32(127)), 23));
+    __m256 scale1 = _mm256_castsi256_ps(
+        _mm256_slli_epi32(_mm256_add_epi32(_mm256_sub_epi32(ni, half), _mm256_set1_epi32(127)), 23));
+    __m256 result = _mm256_mul_ps(_mm256_mul_ps(p, scale0), scale1);
+
+    result = _mm256_blendv_ps(result, _mm256_set1_ps(kFloatInfinity), overflow);
+    return _mm256_andnot_ps(underflow, result);
+}
+
+// log(x): split x = m * 2^e with m in [sqrt(0.5), sqrt(2)), degree-8 polynomial
+// in m - 1. Denormals are rescaled first; x < 0 gives NaN, 0 gives -inf and
+// +inf gives +inf.
+static inline __m256 log256_ps(__m256 x) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 min_normal = _mm256_set1_ps(1.17549435e-38f);
+
+    __m256 invalid = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ);
+    __m256 zero = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    __m256 infinite = _mm256_cmp_ps(x, _mm256_set1_ps(kFloatInfinity), _CMP_EQ_OQ);
+    __m256 nan_in = _mm256_cmp_ps(x, x, _CMP_UNORD_Q);
+
+    // Bring denormals into the normal range and remember the 2^23 factor
+    __m256 denormal = _mm256_cmp_ps(x, min_normal, _CMP_LT_OQ);
+    x = _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(8388608.0f)), denormal);
+    __m256 e_adjust = _mm256_and_ps(denormal, _mm256_set1_ps(23.0f));
+
+    __m256i bits = _mm256_castps_si256(x);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+    e = _mm256_sub_ps(e, e_adjust);
+    // Mantissa in [0.5, 1)
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)),
+                                                   _mm256_set1_epi32(0x3F000000)));
+
+    __m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(small, one));
+    m = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(small, m)), one);
+
+    __m256 z = _mm256_mul_ps(m, m);
+    __m256 p = _mm256_set1_ps(7.0376836292e-2f);
+    p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.1514610310e-1f));
+    p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(1.1676998740e-1f));
+    p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.2420140846e-1f));
+    p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(1.4249322787e-1f));
+    p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.6668057665e-1f));
+    p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(2.0000714765e-1f));
+    p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-2.4999993993e-1f));
+    p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(3.3333331174e-1f));
+    p = _mm256_mul_ps(_mm256_mul_ps(p, m), z);
+
+    p = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), p);
+    p = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), p);
+    __m256 result = _mm256_add_ps(m, p);
+    result = _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), result);
+
+    result = _mm256_blendv_ps(result, x, infinite);
+    result = _mm256_blendv_ps(result, _mm256_set1_ps(-kFloatInfinity), zero);
+    return _mm256_or_ps(result, _mm256_or_ps(invalid, nan_in));
+}
+
+// sin(x) and cos(x) together: reduce by multiples of pi/4 using a three-part
+// pi/4 (exact for |x| <= 8192), then pick the sine or cosine polynomial per
+// octant. Callers must route larger |x| to a scalar path.
+static inline void sincos256_ps(__m256 x, __m256* s, __m256* c) {
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    __m256 sign_sin = _mm256_and_ps(x, sign_mask);
+    x = _mm256_andnot_ps(sign_mask, x);
+
+    // j = nearest even octant index
+    __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f)));
+    j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+    __m256 y = _mm256_cvtepi32_ps(j);
+
+    x = _mm256_fnmadd_ps(y, _mm256_set1_ps(0.78515625f), x);
+    x = _mm256_fnmadd_ps(y, _mm256_set1_ps(2.4187564849853515625e-4f), x);
+    x = _mm256_fnmadd_ps(y, _mm256_set1_ps(3.77489497744594108e-8f), x);
+
+    // Octant bit 2 flips the sign of sin; (j - 2) bit 2 flips the sign of cos
+    __m256 flip_sin = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29));
+    __m256 flip_cos = _mm256_castsi256_ps(
+        _mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+    // Octants 2 and 6 swap the two polynomials
+    __m256 swap = _mm256_castsi256_ps(
+        _mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(2)));
+
+    __m256 z = _mm256_mul_ps(x, x);
+
+    __m256 pc = _mm256_set1_ps(2.443315711809948e-5f);
+    pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps(-1.388731625493765e-3f));
+    pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps(4.166664568298827e-2f));
+    pc = _mm256_mul_ps(_mm256_mul_ps(pc, z), z);
+    pc = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), pc);
+    pc = _mm256_add_ps(pc, _mm256_set1_ps(1.0f));
+
+    __m256 ps = _mm256_set1_ps(-1.9515295891e-4f);
+    ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps(8.3321608736e-3f));
+    ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps(-1.6666654611e-1f));
+    ps = _mm256_fmadd_ps(_mm256_mul_ps(ps, z), x, x);
+
+    __m256 sin_val = _mm256_blendv_ps(ps, pc, swap);
+    __m256 cos_val = _mm256_blendv_ps(pc, ps, swap);
+
+    *s = _mm256_xor_ps(sin_val, _mm256_xor_ps(flip_sin, sign_sin));
+    *c = _mm256_xor_ps(cos_val, flip_cos);
+}
+
+// Largest |x| for which sincos256_ps keeps its error bound
+static const float kSinCosMaxArgument = 8192.0f;
+
+// tanh(x): odd polynomial below |x| = 0.625, otherwise 1 - 2 / (e^{2|x|} + 1)
+// with the sign restored. Saturates to +-1 beyond |x| = 9.
+static inline __m256 tanh256_ps(__m256 x) {
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 sign = _mm256_and_ps(x, sign_mask);
+    __m256 ax = _mm256_andnot_ps(sign_mask, x);
+
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(-5.70498872745e-3f);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(2.06390887954e-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-5.37397155531e-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.33314422036e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33332819422e-1f));
+    __m256 small_result = _mm256_fmadd_ps(_mm256_mul_ps(p, z), x, x);
+
+    __m256 e = exp256_ps(_mm256_add_ps(ax, ax));
+    __m256 large = _mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, one)));
+    large = _mm256_or_ps(_mm256_min_ps(one, large), sign);
+
+    __m256 use_small = _mm256_cmp_ps(ax, _mm256_set1_ps(0.625f), _CMP_LT_OQ);
+    return _mm256_blendv_ps(large, small_result, use_small);
+}
+
+// 1 / (1 + e^{-x})
+static inline __m256 sigmoid256_ps(__m256 x) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 e = exp256_ps(_mm256_xor_ps(x, _mm256_set1_ps(-0.0f)));
+    return _mm256_div_ps(one, _mm256_add_ps(one, e));
+}
+
+// atan2(y, x): a = min(|x|, |y|) / max(|x|, |y|) is reduced to [0, tan(pi/8)]
+// about pi/4 (one division for both cases), Cephes degree-4 polynomial, then
+// the octant and quadrant are restored from the input magnitudes and signs.
+// Signed zeros follow std::atan2; NaN propagates; both inputs infinite gives NaN.
+static inline __m256 atan2_256_ps(__m256 y, __m256 x) {
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 pi = _mm256_set1_ps(3.14159265358979f);
+    const __m256 half_pi = _mm256_set1_ps(1.57079632679490f);
+
+    __m256 ax = _mm256_andnot_ps(sign_mask, x);
+    __m256 ay = _mm256_andnot_ps(sign_mask, y);
+    __m256 lo = _mm256_min_ps(ax, ay);
+    __m256 hi = _mm256_max_ps(ax, ay);
+
+    // Above tan(pi/8): atan(a) = pi/4 + atan((lo - hi) / (lo + hi))
+    __m256 above = _mm256_cmp_ps(lo, _mm256_mul_ps(hi, _mm256_set1_ps(0.414213562373095f)), _CMP_GT_OQ);
+    __m256 num = _mm256_blendv_ps(lo, _mm256_sub_ps(lo, hi), above);
+    __m256 den = _mm256_blendv_ps(hi, _mm256_add_ps(lo, hi), above);
+    // The origin would be 0 / 0; make it 0 / 1
+    den = _mm256_blendv_ps(den, one, _mm256_cmp_ps(den, _mm256_setzero_ps(), _CMP_EQ_OQ));
+    __m256 t = _mm256_div_ps(num, den);
+
+    __m256 z = _mm256_mul_ps(t, t);
+    __m256 p = _mm256_set1_ps(8.05374449538e-2f);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-1.38776856032e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.99777106478e-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33329491539e-1f));
+    __m256 r = _mm256_fmadd_ps(_mm256_mul_ps(p, z), t, t);
+    r = _mm256_add_ps(r, _mm256_and_ps(above, _mm256_set1_ps(0.785398163397448f)));
+
+    // |y| > |x| measures from the y axis; a negative x (sign bit, so -0
+    // included) reflects into the left half-plane
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(half_pi, r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(pi, r), x);
+    r = _mm256_or_ps(r, _mm256_and_ps(y, sign_mask));
+    return _mm256_or_ps(r, _mm256_cmp_ps(x, y, _CMP_UNORD_Q));
+}
+
+// 1 / sqrt(x): vrsqrtps (12 bits) plus one Newton-Raphson step. Zero, inf and
+// negative inputs keep the hardware estimate (inf, 0 and NaN respectively).
+// vrsqrtps reads denormals as zero, so those are scaled by 2^24 first and the
+// result by 2^12 after.
+static inline __m256 rsqrt256_ps(__m256 x) {
+    __m256 small = _mm256_cmp_ps(x, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ);
+    x = _mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(16777216.0f)), small);
+    __m256 y = _mm256_rsqrt_ps(x);
+    // y' = y + y/2 * (1 - x*y*y); the FMA keeps the residual accurate
+    __m256 residual = _mm256_fnmadd_ps(_mm256_mul_ps(x, y), y, _mm256_set1_ps(1.0f));
+    __m256 refined = _mm256_fmadd_ps(_mm256_mul_ps(y, _mm256_set1_ps(0.5f)), residual, y);
+    __m256 finite = _mm256_and_ps(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ),
+                                  _mm256_cmp_ps(x, _mm256_set1_ps(kFloatInfinity), _CMP_LT_OQ));
+    return _mm256_mul_ps(_mm256_blendv_ps(y, refined, finite),
+                         _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_set1_ps(4096.0f), small));
+}
+
+} // namespace simd_lib
@@ -1,89 +1,39 @@
 #include "simd_lib.h"
 #include <immintrin.h>
-#include <cstring>
 
 namespace simd_lib {
 
-void matrix_multiply_4x4(const float* a, const float* b, float* result) {
-    // Load matrix A (4x4)
-    __m256 a0 = _mm256_loadu_ps(&a[0]);   // [a00, a01, a02, a03, a10, a11, a12, a13]
-    __m256 a1 = _mm256_loadu_ps(&a[8]);   // [a20, a21, a22, a23, a30, a31, a32, a33]
-    
-    // Load matrix B (4x4) - we need to transpose it for efficient multiplication
-    __m256 b0 = _mm256_loadu_ps(&b[0]);   // [b00, b01, b02, b03, b10, b11, b12, b13]
-    __m256 b1 = _mm256_loadu_ps(&b[8]);   // [b20, b21, b22, b23, b30, b31, b32, b33]
-    
-    // Transpose B for efficient multiplication
-    __m256 b0_lo = _mm256_unpacklo_ps(b0, b1);  // [b00, b20, b01, b21, b10, b30, b11, b31]
-    __m256 b0_hi = _mm256_unpackhi_ps(b0, b1);  // [b02, b22, b03, b23, b12, b32, b13, b33]
-    
-    // For simplicity, let's use a more straightforward approach
-    // This is a basic implementation - could be optimized further
-    
-    // Row 0: result[0] = a[0]*b[0] + a[1]*b[4] + a[2]*b[8] + a[3]*b[12]
-    __m256 a_row0 = _mm256_set1_ps(a[0]);
-    __m256 b_col0 = _mm256_set_ps(b[12], b[8], b[4], b[0], b[12], b[8], b[4], b[0]);
-    __m256 prod0 = _mm256_mul_ps(a_row0, b_col0);
-    
-    // Continue with other elements...
-    // This is a simplified version - full implementation would be more complex
-    
-    // For now, let's use a scalar fallback for matrix operations
-    // A full SIMD matrix multiplication would be quite complex
-    matrix_multiply_4x4_scalar(a, b, result);
-}
+void matrix_multiply_4x4_avx2(const float* a, const float* b, float* result) {
+    // Row i of the result is sum_k a[i][k] * (row k of b). Each row of b is
+    // broadcast to both 128-bit lanes so one register produces two result rows.
+    __m256 b0 = _mm256_broadcast_ps((const __m128*)&b[0]);
+    __m256 b1 = _mm256_broadcast_ps((const __m128*)&b[4]);
+    __m256 b2 = _mm256_broadcast_ps((const __m128*)&b[8]);
+    __m256 b3 = _mm256_broadcast_ps((const __m128*)&b[12]);
 
-void matrix_multiply_3x3(const float* a, const float* b, float* result) {
-    // 3x3 matrix multiplication using scalar for now
-    // Could be optimized with SIMD but requires careful handling of 3-element vectors
-    matrix_multiply_3x3_scalar(a, b, result);
+    for (int i = 0; i < 16; i += 8) {
+        __m256 rows = _mm256_loadu_ps(&a[i]);  // [a_r0, a_r1] for two rows
+        __m256 sum = _mm256_mul_ps(_mm256_permute_ps(rows, 0x00), b0);
+        sum = _mm256_fmadd_ps(_mm256_permute_ps(rows, 0x55), b1, sum);
+        sum = _mm256_fmadd_ps(_mm256_permute_ps(rows, 0xAA), b2, sum);
+        sum = _mm256_fmadd_ps(_mm256_permute_ps(rows, 0xFF), b3, sum);
+        _mm256_storeu_ps(&result[i], sum);
+    }
 }
 
-void matrix_vector_multiply_4x4(const float* matrix, const float* vector, float* result) {
-    // 4x4 matrix * 4x1 vector multiplication
-    // This is more suitable for SIMD optimization
-    
-    __m256 vec = _mm256_loadu_ps(vector);  // Load vector [v0, v1, v2, v3, 0, 0, 0, 0]
-    
-    // Extract the first 4 elements
-    __m128 vec_4 = _mm256_extractf128_ps(vec, 0);
-    
-    // Load matrix rows
-    __m128 row0 = _mm_loadu_ps(&matrix[0]);
-    __m128 row1 = _mm_loadu_ps(&matrix[4]);
-    __m128 row2 = _mm_loadu_ps(&matrix[8]);
-    __m128 row3 = _mm_loadu_ps(&matrix[12]);
-    
-    // Multiply each row by the vector
-    __m128 prod0 = _mm_mul_ps(row0, vec_4);
-    __m128 prod1 = _mm_mul_ps(row1, vec_4);
-    __m128 prod2 = _mm_mul_ps(row2, vec_4);
-    __m128 prod3 = _mm_mul_ps(row3, vec_4);
-    
-    // Horizontal sum each product
-    prod0 = _mm_hadd_ps(prod0, prod0);
-    prod0 = _mm_hadd_ps(prod0, prod0);
-    
-    prod1 = _mm_hadd_ps(prod1, prod1);
-    prod1 = _mm_hadd_ps(prod1, prod1);
-    
-    prod2 = _mm_hadd_ps(prod2, prod2);
-    prod2 = _mm_hadd_ps(prod2, prod2);
-    
-    prod3 = _mm_hadd_ps(prod3, prod3);
-    prod3 = _mm_hadd_ps(prod3, prod3);
-    
-    // Store results
-    result[0] = _mm_cvtss_f32(prod0);
-    result[1] = _mm_cvtss_f32(prod1);
-    result[2] = _mm_cvtss_f32(prod2);
-    result[3] = _mm_cvtss_f32(prod3);
-}
+void matrix_vector_multiply_4x4_avx2(const float* matrix, const float* vector, float* result) {
+    // 4x4 matrix * 4x1 vector; the vector is exactly four floats, so a 128-bit load
+    __m128 vec = _mm_loadu_ps(vector);
+
+    __m128 prod0 = _mm_mul_ps(_mm_loadu_ps(&matrix[0]), vec);
+    __m128 prod1 = _mm_mul_ps(_mm_loadu_ps(&matrix[4]), vec);
+    __m128 prod2 = _mm_mul_ps(_mm_loadu_ps(&matrix[8]), vec);
+    __m128 prod3 = _mm_mul_ps(_mm_loadu_ps(&matrix[12]), vec);
 
-void matrix_vector_multiply_3x3(const float* matrix, const float* vector, float* result) {
-    // 3x3 matrix * 3x1 vector multiplication
-    // Use scalar implementation for now
-    matrix_vector_multiply_3x3_scalar(matrix, vector, result);
+    // Two rounds of horizontal adds leave the four row sums in order
+    __m128 sum01 = _mm_hadd_ps(prod0, prod1);
+    __m128 sum23 = _mm_hadd_ps(prod2, prod3);
+    _mm_storeu_ps(result, _mm_hadd_ps(sum01, sum23));
 }
 
 } // namespace simd_lib
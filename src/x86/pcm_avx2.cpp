@@ -0,0 +1,143 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// Dither for samples index .. index + 7, matching dither_noise() in pcm_scalar.cpp
+static inline __m256 dither_noise8(uint32_t seed, uint64_t index) {
+    __m256i n = _mm256_add_epi32(_mm256_set1_epi32((int32_t)(uint32_t)index),
+                                 _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i h = _mm256_add_epi32(_mm256_mullo_epi32(n, _mm256_set1_epi32((int32_t)0x9e3779b9u)),
+                                 _mm256_set1_epi32((int32_t)seed));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32(0x7feb352d));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32((int32_t)0x846ca68bu));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    __m256i diff = _mm256_sub_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0xffff)), _mm256_srli_epi32(h, 16));
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(diff), _mm256_set1_ps(1.0f / 65536.0f));
+}
+
+// Scales, dithers and clamps 8 floats, then rounds them to int32
+static inline __m256i quantize8(const float* input, __m256 k, __m256 lower, __m256 upper, const PcmDither* dither,
+                                uint64_t index) {
+    __m256 v = _mm256_mul_ps(_mm256_loadu_ps(input), k);
+    if (dither) {
+        v = _mm256_add_ps(v, dither_noise8(dither->seed, index));
+    }
+    return _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(v, lower), upper));
+}
+
+void convert_s16_to_f32_avx2(const int16_t* input, float* output, size_t count, float scale) {
+    const __m256 k = _mm256_set1_ps(scale * (1.0f / 32768.0f));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i w = _mm256_loadu_si256((const __m256i*)&input[i]);
+        __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(w));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(w, 1));
+        _mm256_storeu_ps(&output[i], _mm256_mul_ps(_mm256_cvtepi32_ps(lo), k));
+        _mm256_storeu_ps(&output[i + 8], _mm256_mul_ps(_mm256_cvtepi32_ps(hi), k));
+    }
+    convert_s16_to_f32_scalar(&input[i], &output[i], count - i, scale);
+}
+
+void convert_s24_to_f32_avx2(const uint8_t* input, float* output, size_t count, float scale) {
+    const __m256 k = _mm256_set1_ps(scale * (1.0f / 8388608.0f));
+    // Lane 0 holds bytes 0..15 of the block and lane 1 bytes 8..23, so each
+    // lane has four 3-byte samples; they move to the top of each dword and
+    // an arithmetic shift sign-extends them. Loads stay inside the 24 bytes.
+    const __m256i spread = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+                                            -1, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t* p = &input[3 * i];
+        __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)p)),
+                                                _mm_loadu_si128((const __m128i*)(p + 8)), 1);
+        __m256i v = _mm256_srai_epi32(_mm256_shuffle_epi8(bytes, spread), 8);
+        _mm256_storeu_ps(&output[i], _mm256_mul_ps(_mm256_cvtepi32_ps(v), k));
+    }
+    convert_s24_to_f32_scalar(&input[3 * i], &output[i], count - i, scale);
+}
+
+void convert_s32_to_f32_avx2(const int32_t* input, float* output, size_t count, float scale) {
+    const __m256 k = _mm256_set1_ps(scale * (1.0f / 2147483648.0f));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)&input[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i*)&input[i + 8]);
+        _mm256_storeu_ps(&output[i], _mm256_mul_ps(_mm256_cvtepi32_ps(a), k));
+        _mm256_storeu_ps(&output[i + 8], _mm256_mul_ps(_mm256_cvtepi32_ps(b), k));
+    }
+    convert_s32_to_f32_scalar(&input[i], &output[i], count - i, scale);
+}
+
+void convert_f32_to_s16_avx2(const float* input, int16_t* output, size_t count, float scale,
+                             const PcmDither* dither) {
+    const __m256 k = _mm256_set1_ps(scale * 32768.0f);
+    const __m256 lower = _mm256_set1_ps(-32768.0f);
+    const __m256 upper = _mm256_set1_ps(32767.0f);
+    const uint64_t index = dither ? dither->index : 0;
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i a = quantize8(&input[i], k, lower, upper, dither, index + i);
+        __m256i b = quantize8(&input[i + 8], k, lower, upper, dither, index + i + 8);
+        // packs works per 128-bit lane; the permute restores sample order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*)&output[i], packed);
+    }
+    if (i < count) {
+        PcmDither rest;
+        if (dither) {
+            rest = *dither;
+            rest.index += i;
+        }
+        convert_f32_to_s16_scalar(&input[i], &output[i], count - i, scale, dither ? &rest : nullptr);
+    }
+}
+
+void convert_f32_to_s24_avx2(const float* input, uint8_t* output, size_t count, float scale,
+                             const PcmDither* dither) {
+    const __m256 k = _mm256_set1_ps(scale * 8388608.0f);
+    const __m256 lower = _mm256_set1_ps(-8388608.0f);
+    const __m256 upper = _mm256_set1_ps(8388607.0f);
+    // Low three bytes of each dword to the front of its lane, then the two
+    // 12-byte halves next to each other
+    const __m256i gather = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                            0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    const uint64_t index = dither ? dither->index : 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i q = quantize8(&input[i], k, lower, upper, dither, index + i);
+        __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(q, gather), compact);
+        uint8_t* p = &output[3 * i];
+        _mm_storeu_si128((__m128i*)p, _mm256_castsi256_si128(packed));
+        _mm_storel_epi64((__m128i*)(p + 16), _mm256_extracti128_si256(packed, 1));
+    }
+    if (i < count) {
+        PcmDither rest;
+        if (dither) {
+            rest = *dither;
+            rest.index += i;
+        }
+        convert_f32_to_s24_scalar(&input[i], &output[3 * i], count - i, scale, dither ? &rest : nullptr);
+    }
+}
+
+void convert_f32_to_s32_avx2(const float* input, int32_t* output, size_t count, float scale) {
+    const __m256 k = _mm256_set1_ps(scale * 2147483648.0f);
+    const __m256 limit = _mm256_set1_ps(2147483648.0f);
+    const __m256i max_value = _mm256_set1_epi32(INT32_MAX);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_loadu_ps(&input[i]), k);
+        // cvtps returns INT32_MIN for anything out of range, which is already
+        // the saturated value below -2^31; only the positive side needs fixing
+        __m256i q = _mm256_cvtps_epi32(v);
+        __m256i over = _mm256_castps_si256(_mm256_cmp_ps(v, limit, _CMP_GE_OQ));
+        _mm256_storeu_si256((__m256i*)&output[i], _mm256_blendv_epi8(q, max_value, over));
+    }
+    convert_f32_to_s32_scalar(&input[i], &output[i], count - i, scale);
+}
+
+} // namespace simd_lib
@@ -0,0 +1,408 @@
+#include "simd_lib.h"
+#include "avx2_helpers.h"
+#include <immintrin.h>
+
+// AVX-VNNI kernels are compiled for that extension only and are reached
+// through dispatch when CPUFeatures::has_avx_vnni is set
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET_AVXVNNI __attribute__((target("avx2,fma,avxvnni")))
+#else
+#define SIMD_TARGET_AVXVNNI
+#endif
+
+namespace simd_lib {
+
+// Quantize 8 floats to int32 lanes: round-to-nearest-even of x / scale + zero_point.
+// x / scale is clamped in float to [lower, upper] (the target range less the
+// zero point) first, since cvtps turns anything outside int32 into INT_MIN.
+static inline __m256i quantize_epi32(__m256 x, __m256 inv_scale, __m256i zero_point, __m256 lower, __m256 upper) {
+    __m256 scaled = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(x, inv_scale), lower), upper);
+    return _mm256_add_epi32(_mm256_cvtps_epi32(scaled), zero_point);
+}
+
+// Undo the per-128-bit-lane interleave left by two rounds of packs
+static inline __m256i restore_pack_order(__m256i packed) {
+    return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+void quantize_s8_avx2(const float* input, int8_t* output, size_t count, const QuantizationParams& params) {
+    const float inv = 1.0f / params.scale;
+    const __m256 inv_scale = _mm256_set1_ps(inv);
+    const __m256i zp = _mm256_set1_epi32(params.zero_point);
+    const __m256i lower = _mm256_set1_epi8(-127);
+    const __m256 lo = _mm256_set1_ps(-127.0f - (float)params.zero_point);
+    const __m256 hi = _mm256_set1_ps(127.0f - (float)params.zero_point);
+    size_t i = 0;
+
+    // Process 32 floats at a time, saturating through int16 to int8
+    for (; i + 32 <= count; i += 32) {
+        __m256i q0 = quantize_epi32(_mm256_loadu_ps(&input[i]), inv_scale, zp, lo, hi);
+        __m256i q1 = quantize_epi32(_mm256_loadu_ps(&input[i + 8]), inv_scale, zp, lo, hi);
+        __m256i q2 = quantize_epi32(_mm256_loadu_ps(&input[i + 16]), inv_scale, zp, lo, hi);
+        __m256i q3 = quantize_epi32(_mm256_loadu_ps(&input[i + 24]), inv_scale, zp, lo, hi);
+        __m256i w01 = _mm256_packs_epi32(q0, q1);
+        __m256i w23 = _mm256_packs_epi32(q2, q3);
+        __m256i bytes = restore_pack_order(_mm256_packs_epi16(w01, w23));
+        _mm256_storeu_si256((__m256i*)&output[i], _mm256_max_epi8(bytes, lower));
+    }
+
+    // Handle remaining elements with scalar code
+    if (i < count) {
+        quantize_s8_scalar(&input[i], &output[i], count - i, params);
+    }
+}
+
+void quantize_u8_avx2(const float* input, uint8_t* output, size_t count, const QuantizationParams& params) {
+    const float inv = 1.0f / params.scale;
+    const __m256 inv_scale = _mm256_set1_ps(inv);
+    const __m256i zp = _mm256_set1_epi32(params.zero_point);
+    const __m256 lo = _mm256_set1_ps(0.0f - (float)params.zero_point);
+    const __m256 hi = _mm256_set1_ps(255.0f - (float)params.zero_point);
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        __m256i q0 = quantize_epi32(_mm256_loadu_ps(&input[i]), inv_scale, zp, lo, hi);
+        __m256i q1 = quantize_epi32(_mm256_loadu_ps(&input[i + 8]), inv_scale, zp, lo, hi);
+        __m256i q2 = quantize_epi32(_mm256_loadu_ps(&input[i + 16]), inv_scale, zp, lo, hi);
+        __m256i q3 = quantize_epi32(_mm256_loadu_ps(&input[i + 24]), inv_scale, zp, lo, hi);
+        __m256i w01 = _mm256_packs_epi32(q0, q1);
+        __m256i w23 = _mm256_packs_epi32(q2, q3);
+        __m256i bytes = restore_pack_order(_mm256_packus_epi16(w01, w23));
+        _mm256_storeu_si256((__m256i*)&output[i], bytes);
+    }
+
+    if (i < count) {
+        quantize_u8_scalar(&input[i], &output[i], count - i, params);
+    }
+}
+
+int32_t sum_u8_avx2(const uint8_t* a, size_t count) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    // vpsadbw against zero sums each group of 8 bytes into a 64-bit lane
+    for (; i + 32 <= count; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)&a[i]);
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, _mm256_setzero_si256()));
+    }
+
+    int32_t result = hsum_epi32(acc);
+    for (; i < count; ++i) {
+        result += a[i];
+    }
+    return result;
+}
+
+int32_t sum_s8_avx2(const int8_t* a, size_t count) {
+    const __m256i bias = _mm256_set1_epi8((char)0x80);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    // Flip the sign bit to sum as unsigned, then remove the 128 bias per element
+    for (; i + 32 <= count; i += 32) {
+        __m256i va = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&a[i]), bias);
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, _mm256_setzero_si256()));
+    }
+
+    int32_t result = hsum_epi32(acc) - (int32_t)(i * 128);
+    for (; i < count; ++i) {
+        result += a[i];
+    }
+    return result;
+}
+
+// s8 x s8 through vpmaddubsw: move the sign of a onto b so that the unsigned
+// operand is |a|. Exact for inputs in [-127, 127] (pair sums stay below 2^15).
+static inline __m256i dot_s8_step(__m256i acc, __m256i va, __m256i vb, __m256i ones) {
+    __m256i abs_a = _mm256_sign_epi8(va, va);
+    __m256i signed_b = _mm256_sign_epi8(vb, va);
+    __m256i pairs = _mm256_maddubs_epi16(abs_a, signed_b);
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(pairs, ones));
+}
+
+// u8 x s8 through vpmaddwd on widened lanes: vpmaddubsw would saturate for
+// 255 * 127 * 2, so the AVX2 path trades width for exactness
+static inline __m256i dot_u8s8_step(__m256i acc, __m256i va, __m256i vb) {
+    __m256i a_lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(va));
+    __m256i a_hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(va, 1));
+    __m256i b_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(vb));
+    __m256i b_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(vb, 1));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a_lo, b_lo));
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(a_hi, b_hi));
+}
+
+static inline __m256i l2_s8_step(__m256i acc, __m256i va, __m256i vb) {
+    __m256i d_lo = _mm256_sub_epi16(_mm256_cvtepi8_epi16(_mm256_castsi256_si128(va)),
+                                    _mm256_cvtepi8_epi16(_mm256_castsi256_si128(vb)));
+    __m256i d_hi = _mm256_sub_epi16(_mm256_cvtepi8_epi16(_mm256_extracti128_si256(va, 1)),
+                                    _mm256_cvtepi8_epi16(_mm256_extracti128_si256(vb, 1)));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(d_lo, d_lo));
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(d_hi, d_hi));
+}
+
+int32_t dot_product_s8_avx2(const int8_t* a, const int8_t* b, size_t count) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    // Process 32 bytes at a time
+    for (; i + 32 <= count; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)&a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*)&b[i]);
+        acc = dot_s8_step(acc, va, vb, ones);
+    }
+
+    int32_t result = hsum_epi32(acc);
+    for (; i < count; ++i) {
+        result += (int32_t)a[i] * (int32_t)b[i];
+    }
+    return result;
+}
+
+int32_t dot_product_u8s8_avx2(const uint8_t* a, const int8_t* b, size_t count) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)&a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*)&b[i]);
+        acc = dot_u8s8_step(acc, va, vb);
+    }
+
+    int32_t result = hsum_epi32(acc);
+    for (; i < count; ++i) {
+        result += (int32_t)a[i] * (int32_t)b[i];
+    }
+    return result;
+}
+
+int32_t l2_distance_squared_s8_avx2(const int8_t* a, const int8_t* b, size_t count) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)&a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*)&b[i]);
+        acc = l2_s8_step(acc, va, vb);
+    }
+
+    int32_t result = hsum_epi32(acc);
+    for (; i < count; ++i) {
+        int32_t diff = (int32_t)a[i] - (int32_t)b[i];
+        result += diff * diff;
+    }
+    return result;
+}
+
+// vpdpbusd accumulates u8 x s8 quads straight into int32 without the
+// intermediate int16 saturation of vpmaddubsw
+SIMD_TARGET_AVXVNNI
+int32_t dot_product_u8s8_avxvnni(const uint8_t* a, const int8_t* b, size_t count) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)&a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*)&b[i]);
+        acc = _mm256_dpbusd_avx_epi32(acc, va, vb);
+    }
+
+    int32_t result = hsum_epi32(acc);
+    for (; i < count; ++i) {
+        result += (int32_t)a[i] * (int32_t)b[i];
+    }
+    return result;
+}
+
+SIMD_TARGET_AVXVNNI
+int32_t dot_product_s8_avxvnni(const int8_t* a, const int8_t* b, size_t count) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)&a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*)&b[i]);
+        acc = _mm256_dpbusd_avx_epi32(acc, _mm256_sign_epi8(va, va), _mm256_sign_epi8(vb, va));
+    }
+
+    int32_t result = hsum_epi32(acc);
+    for (; i < count; ++i) {
+        result += (int32_t)a[i] * (int32_t)b[i];
+    }
+    return result;
+}
+
+// Batched kernels process 4 database rows per pass so each query block is
+// loaded once and reused from a register
+
+void batch_dot_product_s8_avx2(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    size_t r = 0;
+
+    for (; r + 4 <= rows; r += 4) {
+        const int8_t* row0 = &database[r * dim];
+        const int8_t* row1 = row0 + dim;
+        const int8_t* row2 = row1 + dim;
+        const int8_t* row3 = row2 + dim;
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256();
+        __m256i acc3 = _mm256_setzero_si256();
+        size_t i = 0;
+
+        for (; i + 32 <= dim; i += 32) {
+            __m256i q = _mm256_loadu_si256((const __m256i*)&query[i]);
+            acc0 = dot_s8_step(acc0, q, _mm256_loadu_si256((const __m256i*)&row0[i]), ones);
+            acc1 = dot_s8_step(acc1, q, _mm256_loadu_si256((const __m256i*)&row1[i]), ones);
+            acc2 = dot_s8_step(acc2, q, _mm256_loadu_si256((const __m256i*)&row2[i]), ones);
+            acc3 = dot_s8_step(acc3, q, _mm256_loadu_si256((const __m256i*)&row3[i]), ones);
+        }
+
+        out[r] = hsum_epi32(acc0) + dot_product_s8_scalar(&query[i], &row0[i], dim - i);
+        out[r + 1] = hsum_epi32(acc1) + dot_product_s8_scalar(&query[i], &row1[i], dim - i);
+        out[r + 2] = hsum_epi32(acc2) + dot_product_s8_scalar(&query[i], &row2[i], dim - i);
+        out[r + 3] = hsum_epi32(acc3) + dot_product_s8_scalar(&query[i], &row3[i], dim - i);
+    }
+
+    // Handle remaining rows one at a time
+    for (; r < rows; ++r) {
+        out[r] = dot_product_s8_avx2(query, &database[r * dim], dim);
+    }
+}
+
+void batch_dot_product_u8s8_avx2(const uint8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    size_t r = 0;
+
+    for (; r + 4 <= rows; r += 4) {
+        const int8_t* row0 = &database[r * dim];
+        const int8_t* row1 = row0 + dim;
+        const int8_t* row2 = row1 + dim;
+        const int8_t* row3 = row2 + dim;
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256();
+        __m256i acc3 = _mm256_setzero_si256();
+        size_t i = 0;
+
+        for (; i + 32 <= dim; i += 32) {
+            __m256i q = _mm256_loadu_si256((const __m256i*)&query[i]);
+            acc0 = dot_u8s8_step(acc0, q, _mm256_loadu_si256((const __m256i*)&row0[i]));
+            acc1 = dot_u8s8_step(acc1, q, _mm256_loadu_si256((const __m256i*)&row1[i]));
+            acc2 = dot_u8s8_step(acc2, q, _mm256_loadu_si256((const __m256i*)&row2[i]));
+            acc3 = dot_u8s8_step(acc3, q, _mm256_loadu_si256((const __m256i*)&row3[i]));
+        }
+
+        out[r] = hsum_epi32(acc0) + dot_product_u8s8_scalar(&query[i], &row0[i], dim - i);
+        out[r + 1] = hsum_epi32(acc1) + dot_product_u8s8_scalar(&query[i], &row1[i], dim - i);
+        out[r + 2] = hsum_epi32(acc2) + dot_product_u8s8_scalar(&query[i], &row2[i], dim - i);
+        out[r + 3] = hsum_epi32(acc3) + dot_product_u8s8_scalar(&query[i], &row3[i], dim - i);
+    }
+
+    for (; r < rows; ++r) {
+        out[r] = dot_product_u8s8_avx2(query, &database[r * dim], dim);
+    }
+}
+
+void batch_l2_distance_squared_s8_avx2(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    size_t r = 0;
+
+    for (; r + 4 <= rows; r += 4) {
+        const int8_t* row0 = &database[r * dim];
+        const int8_t* row1 = row0 + dim;
+        const int8_t* row2 = row1 + dim;
+        const int8_t* row3 = row2 + dim;
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256();
+        __m256i acc3 = _mm256_setzero_si256();
+        size_t i = 0;
+
+        for (; i + 32 <= dim; i += 32) {
+            __m256i q = _mm256_loadu_si256((const __m256i*)&query[i]);
+            acc0 = l2_s8_step(acc0, q, _mm256_loadu_si256((const __m256i*)&row0[i]));
+            acc1 = l2_s8_step(acc1, q, _mm256_loadu_si256((const __m256i*)&row1[i]));
+            acc2 = l2_s8_step(acc2, q, _mm256_loadu_si256((const __m256i*)&row2[i]));
+            acc3 = l2_s8_step(acc3, q, _mm256_loadu_si256((const __m256i*)&row3[i]));
+        }
+
+        out[r] = hsum_epi32(acc0) + l2_distance_squared_s8_scalar(&query[i], &row0[i], dim - i);
+        out[r + 1] = hsum_epi32(acc1) + l2_distance_squared_s8_scalar(&query[i], &row1[i], dim - i);
+        out[r + 2] = hsum_epi32(acc2) + l2_distance_squared_s8_scalar(&query[i], &row2[i], dim - i);
+        out[r + 3] = hsum_epi32(acc3) + l2_distance_squared_s8_scalar(&query[i], &row3[i], dim - i);
+    }
+
+    for (; r < rows; ++r) {
+        out[r] = l2_distance_squared_s8_avx2(query, &database[r * dim], dim);
+    }
+}
+
+SIMD_TARGET_AVXVNNI
+void batch_dot_product_s8_avxvnni(const int8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    size_t r = 0;
+
+    for (; r + 4 <= rows; r += 4) {
+        const int8_t* row0 = &database[r * dim];
+        const int8_t* row1 = row0 + dim;
+        const int8_t* row2 = row1 + dim;
+        const int8_t* row3 = row2 + dim;
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256();
+        __m256i acc3 = _mm256_setzero_si256();
+        size_t i = 0;
+
+        for (; i + 32 <= dim; i += 32) {
+            __m256i q = _mm256_loadu_si256((const __m256i*)&query[i]);
+            __m256i abs_q = _mm256_sign_epi8(q, q);
+            acc0 = _mm256_dpbusd_avx_epi32(acc0, abs_q, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*)&row0[i]), q));
+            acc1 = _mm256_dpbusd_avx_epi32(acc1, abs_q, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*)&row1[i]), q));
+            acc2 = _mm256_dpbusd_avx_epi32(acc2, abs_q, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*)&row2[i]), q));
+            acc3 = _mm256_dpbusd_avx_epi32(acc3, abs_q, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*)&row3[i]), q));
+        }
+
+        out[r] = hsum_epi32(acc0) + dot_product_s8_scalar(&query[i], &row0[i], dim - i);
+        out[r + 1] = hsum_epi32(acc1) + dot_product_s8_scalar(&query[i], &row1[i], dim - i);
+        out[r + 2] = hsum_epi32(acc2) + dot_product_s8_scalar(&query[i], &row2[i], dim - i);
+        out[r + 3] = hsum_epi32(acc3) + dot_product_s8_scalar(&query[i], &row3[i], dim - i);
+    }
+
+    for (; r < rows; ++r) {
+        out[r] = dot_product_s8_avxvnni(query, &database[r * dim], dim);
+    }
+}
+
+SIMD_TARGET_AVXVNNI
+void batch_dot_product_u8s8_avxvnni(const uint8_t* query, const int8_t* database, size_t rows, size_t dim, int32_t* out) {
+    size_t r = 0;
+
+    for (; r + 4 <= rows; r += 4) {
+        const int8_t* row0 = &database[r * dim];
+        const int8_t* row1 = row0 + dim;
+        const int8_t* row2 = row1 + dim;
+        const int8_t* row3 = row2 + dim;
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256();
+        __m256i acc3 = _mm256_setzero_si256();
+        size_t i = 0;
+
+        for (; i + 32 <= dim; i += 32) {
+            __m256i q = _mm256_loadu_si256((const __m256i*)&query[i]);
+            acc0 = _mm256_dpbusd_avx_epi32(acc0, q, _mm256_loadu_si256((const __m256i*)&row0[i]));
+            acc1 = _mm256_dpbusd_avx_epi32(acc1, q, _mm256_loadu_si256((const __m256i*)&row1[i]));
+            acc2 = _mm256_dpbusd_avx_epi32(acc2, q, _mm256_loadu_si256((const __m256i*)&row2[i]));
+            acc3 = _mm256_dpbusd_avx_epi32(acc3, q, _mm256_loadu_si256((const __m256i*)&row3[i]));
+        }
+
+        out[r] = hsum_epi32(acc0) + dot_product_u8s8_scalar(&query[i], &row0[i], dim - i);
+        out[r + 1] = hsum_epi32(acc1) + dot_product_u8s8_scalar(&query[i], &row1[i], dim - i);
+        out[r + 2] = hsum_epi32(acc2) + dot_product_u8s8_scalar(&query[i], &row2[i], dim - i);
+        out[r + 3] = hsum_epi32(acc3) + dot_product_u8s8_scalar(&query[i], &row3[i], dim - i);
+    }
+
+    for (; r < rows; ++r) {
+        out[r] = dot_product_u8s8_avxvnni(query, &database[r * dim], dim);
+    }
+}
+
+} // namespace simd_lib
@@ -0,0 +1,241 @@
+#include "simd_lib.h"
+#include "math_avx2.h"
+#include <cfloat>
+#include <immintrin.h>
+
+namespace simd_lib {
+
+namespace {
+
+struct Quat8 {
+    __m256 w, x, y, z;
+};
+
+struct Vec8 {
+    __m256 x, y, z;
+};
+
+// One block of up to eight elements. The last partial block goes through
+// masked loads and stores, so the tail takes the same arithmetic as the body.
+struct Block {
+    size_t i;
+    bool full;
+    __m256i mask;
+
+    Block(size_t start, size_t count)
+        : i(start), full(start + 8 <= count),
+          mask(_mm256_cmpgt_epi32(_mm256_set1_epi32((int)(full ? 8 : count - start)),
+                                  _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))) {}
+
+    __m256 load(const float* p) const { return full ? _mm256_loadu_ps(&p[i]) : _mm256_maskload_ps(&p[i], mask); }
+
+    void store(float* p, __m256 v) const {
+        if (full) {
+            _mm256_storeu_ps(&p[i], v);
+        } else {
+            _mm256_maskstore_ps(&p[i], mask, v);
+        }
+    }
+
+    Quat8 load(ConstQuaternionArrays q) const { return {load(q.w), load(q.x), load(q.y), load(q.z)}; }
+
+    Vec8 load(ConstVec3Arrays v) const { return {load(v.x), load(v.y), load(v.z)}; }
+
+    void store(QuaternionArrays q, const Quat8& v) const {
+        store(q.w, v.w);
+        store(q.x, v.x);
+        store(q.y, v.y);
+        store(q.z, v.z);
+    }
+
+    void store(Vec3Arrays out, const Vec8& v) const {
+        store(out.x, v.x);
+        store(out.y, v.y);
+        store(out.z, v.z);
+    }
+};
+
+} // namespace
+
+static inline Vec8 cross8(__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz) {
+    return {_mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by)), _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz)),
+            _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx))};
+}
+
+static inline __m256 dot8(const Quat8& a, const Quat8& b) {
+    return _mm256_fmadd_ps(a.w, b.w, _mm256_fmadd_ps(a.x, b.x, _mm256_fmadd_ps(a.y, b.y, _mm256_mul_ps(a.z, b.z))));
+}
+
+// Unit length via rsqrt plus a Newton step; norms below FLT_MIN give the identity
+static inline Quat8 normalize8(const Quat8& q) {
+    __m256 norm_sq = dot8(q, q);
+    __m256 inv = rsqrt256_ps(norm_sq);
+    __m256 zero = _mm256_cmp_ps(norm_sq, _mm256_set1_ps(FLT_MIN), _CMP_LT_OQ);
+    return {_mm256_blendv_ps(_mm256_mul_ps(q.w, inv), _mm256_set1_ps(1.0f), zero),
+            _mm256_andnot_ps(zero, _mm256_mul_ps(q.x, inv)), _mm256_andnot_ps(zero, _mm256_mul_ps(q.y, inv)),
+            _mm256_andnot_ps(zero, _mm256_mul_ps(q.z, inv))};
+}
+
+void quaternion_multiply_avx2(ConstQuaternionArrays a, ConstQuaternionArrays b, QuaternionArrays result,
+                              size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        Block block(i, count);
+        Quat8 p = block.load(a);
+        Quat8 q = block.load(b);
+        Quat8 r;
+        r.w = _mm256_fmsub_ps(p.w, q.w, _mm256_mul_ps(p.x, q.x));
+        r.w = _mm256_fnmadd_ps(p.z, q.z, _mm256_fnmadd_ps(p.y, q.y, r.w));
+        r.x = _mm256_fmadd_ps(p.w, q.x, _mm256_mul_ps(p.x, q.w));
+        r.x = _mm256_fnmadd_ps(p.z, q.y, _mm256_fmadd_ps(p.y, q.z, r.x));
+        r.y = _mm256_fmsub_ps(p.w, q.y, _mm256_mul_ps(p.x, q.z));
+        r.y = _mm256_fmadd_ps(p.z, q.x, _mm256_fmadd_ps(p.y, q.w, r.y));
+        r.z = _mm256_fmadd_ps(p.w, q.z, _mm256_mul_ps(p.x, q.y));
+        r.z = _mm256_fmadd_ps(p.z, q.w, _mm256_fnmadd_ps(p.y, q.x, r.z));
+        block.store(result, r);
+    }
+}
+
+void quaternion_rotate_avx2(ConstQuaternionArrays q, ConstVec3Arrays v, Vec3Arrays result, size_t count) {
+    const __m256 two = _mm256_set1_ps(2.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        Block block(i, count);
+        Quat8 r = block.load(q);
+        Vec8 p = block.load(v);
+        Vec8 t = cross8(r.x, r.y, r.z, p.x, p.y, p.z);
+        t = {_mm256_mul_ps(t.x, two), _mm256_mul_ps(t.y, two), _mm256_mul_ps(t.z, two)};
+        Vec8 u = cross8(r.x, r.y, r.z, t.x, t.y, t.z);
+        block.store(result, {_mm256_add_ps(_mm256_fmadd_ps(r.w, t.x, p.x), u.x),
+                             _mm256_add_ps(_mm256_fmadd_ps(r.w, t.y, p.y), u.y),
+                             _mm256_add_ps(_mm256_fmadd_ps(r.w, t.z, p.z), u.z)});
+    }
+}
+
+void quaternion_to_matrix3_avx2(ConstQuaternionArrays q, float* matrices, size_t count) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        Block block(i, count);
+        Quat8 r = block.load(q);
+        __m256 x2 = _mm256_add_ps(r.x, r.x), y2 = _mm256_add_ps(r.y, r.y), z2 = _mm256_add_ps(r.z, r.z);
+        __m256 xx = _mm256_mul_ps(r.x, x2), yy = _mm256_mul_ps(r.y, y2), zz = _mm256_mul_ps(r.z, z2);
+        __m256 xy = _mm256_mul_ps(r.x, y2), xz = _mm256_mul_ps(r.x, z2), yz = _mm256_mul_ps(r.y, z2);
+        __m256 wx = _mm256_mul_ps(r.w, x2), wy = _mm256_mul_ps(r.w, y2), wz = _mm256_mul_ps(r.w, z2);
+        block.store(&matrices[0 * count], _mm256_sub_ps(one, _mm256_add_ps(yy, zz)));
+        block.store(&matrices[1 * count], _mm256_sub_ps(xy, wz));
+        block.store(&matrices[2 * count], _mm256_add_ps(xz, wy));
+        block.store(&matrices[3 * count], _mm256_add_ps(xy, wz));
+        block.store(&matrices[4 * count], _mm256_sub_ps(one, _mm256_add_ps(xx, zz)));
+        block.store(&matrices[5 * count], _mm256_sub_ps(yz, wx));
+        block.store(&matrices[6 * count], _mm256_sub_ps(xz, wy));
+        block.store(&matrices[7 * count], _mm256_add_ps(yz, wx));
+        block.store(&matrices[8 * count], _mm256_sub_ps(one, _mm256_add_ps(xx, yy)));
+    }
+}
+
+void quaternion_from_matrix3_avx2(const float* matrices, QuaternionArrays q, size_t count) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (size_t i = 0; i < count; i += 8) {
+        Block block(i, count);
+        __m256 m[9];
+        for (size_t k = 0; k < 9; ++k) {
+            m[k] = block.load(&matrices[k * count]);
+        }
+        __m256 trace = _mm256_add_ps(_mm256_add_ps(m[0], m[4]), m[8]);
+        __m256 d0 = _mm256_sub_ps(m[7], m[5]), d1 = _mm256_sub_ps(m[2], m[6]), d2 = _mm256_sub_ps(m[3], m[1]);
+        __m256 s0 = _mm256_add_ps(m[5], m[7]), s1 = _mm256_add_ps(m[2], m[6]), s2 = _mm256_add_ps(m[1], m[3]);
+
+        // Running maximum of trace, m00, m11, m22; a later winner overrides
+        __m256 use_x = _mm256_cmp_ps(m[0], trace, _CMP_GT_OQ);
+        __m256 best = _mm256_max_ps(trace, m[0]);
+        __m256 use_y = _mm256_cmp_ps(m[4], best, _CMP_GT_OQ);
+        best = _mm256_max_ps(best, m[4]);
+        __m256 use_z = _mm256_cmp_ps(m[8], best, _CMP_GT_OQ);
+
+        // 4 c^2 = t for the largest component c, and every component is its
+        // numerator times 0.5 / sqrt(t), with t itself as the numerator of c
+        __m256 t = _mm256_add_ps(one, trace);
+        __m256 off = _mm256_sub_ps(one, trace);
+        t = _mm256_blendv_ps(t, _mm256_fmadd_ps(m[0], _mm256_set1_ps(2.0f), off), use_x);
+        t = _mm256_blendv_ps(t, _mm256_fmadd_ps(m[4], _mm256_set1_ps(2.0f), off), use_y);
+        t = _mm256_blendv_ps(t, _mm256_fmadd_ps(m[8], _mm256_set1_ps(2.0f), off), use_z);
+        Quat8 n = {t, d0, d1, d2};
+        n = {_mm256_blendv_ps(n.w, d0, use_x), _mm256_blendv_ps(n.x, t, use_x), _mm256_blendv_ps(n.y, s2, use_x),
+             _mm256_blendv_ps(n.z, s1, use_x)};
+        n = {_mm256_blendv_ps(n.w, d1, use_y), _mm256_blendv_ps(n.x, s2, use_y), _mm256_blendv_ps(n.y, t, use_y),
+             _mm256_blendv_ps(n.z, s0, use_y)};
+        n = {_mm256_blendv_ps(n.w, d2, use_z), _mm256_blendv_ps(n.x, s1, use_z), _mm256_blendv_ps(n.y, s0, use_z),
+             _mm256_blendv_ps(n.z, t, use_z)};
+
+        __m256 scale = _mm256_mul_ps(rsqrt256_ps(t), _mm256_set1_ps(0.5f));
+        block.store(q, {_mm256_mul_ps(n.w, scale), _mm256_mul_ps(n.x, scale), _mm256_mul_ps(n.y, scale),
+                        _mm256_mul_ps(n.z, scale)});
+    }
+}
+
+void quaternion_normalize_avx2(ConstQuaternionArrays q, QuaternionArrays result, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        Block block(i, count);
+        block.store(result, normalize8(block.load(q)));
+    }
+}
+
+void quaternion_slerp_avx2(ConstQuaternionArrays a, ConstQuaternionArrays b, float t, QuaternionArrays result,
+                           size_t count) {
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 vt = _mm256_set1_ps(t);
+    for (size_t i = 0; i < count; i += 8) {
+        Block block(i, count);
+        Quat8 p = block.load(a);
+        Quat8 q = block.load(b);
+        // Flip b onto the shorter arc by the sign of the dot product
+        __m256 d = dot8(p, q);
+        __m256 flip = _mm256_and_ps(d, sign_mask);
+        q = {_mm256_xor_ps(q.w, flip), _mm256_xor_ps(q.x, flip), _mm256_xor_ps(q.y, flip), _mm256_xor_ps(q.z, flip)};
+        d = _mm256_andnot_ps(sign_mask, d);
+
+        // theta = acos(d) as atan2(sin, cos), then one sincos of t theta:
+        // sin((1 - t) theta) = sin(theta) cos(t theta) - d sin(t theta)
+        __m256 close = _mm256_cmp_ps(d, _mm256_set1_ps(0.9995f), _CMP_GT_OQ);
+        __m256 sin_theta = _mm256_sqrt_ps(_mm256_mul_ps(_mm256_sub_ps(one, d), _mm256_add_ps(one, d)));
+        __m256 theta = atan2_256_ps(sin_theta, d);
+        __m256 s, c;
+        sincos256_ps(_mm256_mul_ps(vt, theta), &s, &c);
+        __m256 wb = _mm256_div_ps(s, _mm256_blendv_ps(sin_theta, one, close));
+        __m256 wa = _mm256_fnmadd_ps(d, wb, c);
+        // Close pairs lerp and renormalize instead of dividing by a tiny sine
+        wa = _mm256_blendv_ps(wa, _mm256_sub_ps(one, vt), close);
+        wb = _mm256_blendv_ps(wb, vt, close);
+
+        Quat8 r = {_mm256_fmadd_ps(wa, p.w, _mm256_mul_ps(wb, q.w)), _mm256_fmadd_ps(wa, p.x, _mm256_mul_ps(wb, q.x)),
+                   _mm256_fmadd_ps(wa, p.y, _mm256_mul_ps(wb, q.y)), _mm256_fmadd_ps(wa, p.z, _mm256_mul_ps(wb, q.z))};
+        if (!_mm256_testz_ps(close, close)) {
+            Quat8 n = normalize8(r);
+            r = {_mm256_blendv_ps(r.w, n.w, close), _mm256_blendv_ps(r.x, n.x, close),
+                 _mm256_blendv_ps(r.y, n.y, close), _mm256_blendv_ps(r.z, n.z, close)};
+        }
+        block.store(result, r);
+    }
+}
+
+void rigid_transform_points_avx2(const float* rotation, const float* translation, ConstVec3Arrays points,
+                                 Vec3Arrays result, size_t count) {
+    // A single quaternion in the planar layout is a row-major 3x3 matrix
+    float matrix[9];
+    quaternion_to_matrix3_scalar({&rotation[0], &rotation[1], &rotation[2], &rotation[3]}, matrix, 1);
+    __m256 m[9];
+    for (size_t k = 0; k < 9; ++k) {
+        m[k] = _mm256_set1_ps(matrix[k]);
+    }
+    const __m256 tx = _mm256_set1_ps(translation[0]);
+    const __m256 ty = _mm256_set1_ps(translation[1]);
+    const __m256 tz = _mm256_set1_ps(translation[2]);
+    for (size_t i = 0; i < count; i += 8) {
+        Block block(i, count);
+        Vec8 p = block.load(points);
+        block.store(result, {_mm256_fmadd_ps(m[2], p.z, _mm256_fmadd_ps(m[1], p.y, _mm256_fmadd_ps(m[0], p.x, tx))),
+                             _mm256_fmadd_ps(m[5], p.z, _mm256_fmadd_ps(m[4], p.y, _mm256_fmadd_ps(m[3], p.x, ty))),
+                             _mm256_fmadd_ps(m[8], p.z, _mm256_fmadd_ps(m[7], p.y, _mm256_fmadd_ps(m[6], p.x, tz)))});
+    }
+}
+
+} // namespace simd_lib
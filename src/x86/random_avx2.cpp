@@ -0,0 +1,104 @@
+#include "simd_lib.h"
+#include "math_avx2.h"
+#include <cmath>
+#include <immintrin.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace simd_lib {
+
+// xoshiro128+ on 8 lanes; the state stays in registers between steps
+struct Lanes {
+    __m256i s0, s1, s2, s3;
+};
+
+static inline Lanes load_lanes(const RandomState* state) {
+    return {_mm256_loadu_si256((const __m256i*)state->s[0]), _mm256_loadu_si256((const __m256i*)state->s[1]),
+            _mm256_loadu_si256((const __m256i*)state->s[2]), _mm256_loadu_si256((const __m256i*)state->s[3])};
+}
+
+static inline void store_lanes(RandomState* state, const Lanes& lanes) {
+    _mm256_storeu_si256((__m256i*)state->s[0], lanes.s0);
+    _mm256_storeu_si256((__m256i*)state->s[1], lanes.s1);
+    _mm256_storeu_si256((__m256i*)state->s[2], lanes.s2);
+    _mm256_storeu_si256((__m256i*)state->s[3], lanes.s3);
+}
+
+static inline __m256i next8(Lanes& x) {
+    __m256i result = _mm256_add_epi32(x.s0, x.s3);
+    __m256i t = _mm256_slli_epi32(x.s1, 9);
+    x.s2 = _mm256_xor_si256(x.s2, x.s0);
+    x.s3 = _mm256_xor_si256(x.s3, x.s1);
+    x.s1 = _mm256_xor_si256(x.s1, x.s2);
+    x.s0 = _mm256_xor_si256(x.s0, x.s3);
+    x.s2 = _mm256_xor_si256(x.s2, t);
+    x.s3 = _mm256_or_si256(_mm256_slli_epi32(x.s3, 11), _mm256_srli_epi32(x.s3, 21));
+    return result;
+}
+
+// Top 24 bits as a float in [0, 1); the conversion is exact
+static inline __m256 uniform8(Lanes& x) {
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(next8(x), 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+}
+
+// lo + u (hi - lo); the top draws round up to hi itself, so those lanes take
+// the float next to hi and the interval stays half open
+static inline __m256 scale8(__m256 u, __m256 lo, __m256 span, __m256 hi, __m256 top) {
+    __m256 v = _mm256_fmadd_ps(u, span, lo);
+    return _mm256_blendv_ps(v, top, _mm256_cmp_ps(v, hi, _CMP_EQ_OQ));
+}
+
+void fill_uniform_avx2(RandomState* state, float* output, size_t count, float lo, float hi) {
+    const __m256 lo_v = _mm256_set1_ps(lo);
+    const __m256 span = _mm256_set1_ps(hi - lo);
+    const __m256 hi_v = _mm256_set1_ps(hi);
+    const __m256 top = _mm256_set1_ps(std::nextafter(hi, lo));
+    Lanes x = load_lanes(state);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(&output[i], scale8(uniform8(x), lo_v, span, hi_v, top));
+    }
+    if (i < count) {
+        alignas(32) float rest[8];
+        _mm256_store_ps(rest, scale8(uniform8(x), lo_v, span, hi_v, top));
+        for (size_t lane = 0; i + lane < count; ++lane) {
+            output[i + lane] = rest[lane];
+        }
+    }
+    store_lanes(state, x);
+}
+
+void fill_normal_avx2(RandomState* state, float* output, size_t count, float mean, float stddev) {
+    const __m256 mean_v = _mm256_set1_ps(mean);
+    const __m256 stddev_v = _mm256_set1_ps(stddev);
+    const __m256 two_pi = _mm256_set1_ps((float)(2.0 * M_PI));
+    const __m256 step = _mm256_set1_ps(1.0f / 16777216.0f);
+    Lanes x = load_lanes(state);
+    for (size_t i = 0; i < count; i += 16) {
+        // u1 in (0, 1] keeps the logarithm finite
+        __m256i bits = _mm256_add_epi32(_mm256_srli_epi32(next8(x), 8), _mm256_set1_epi32(1));
+        __m256 u1 = _mm256_mul_ps(_mm256_cvtepi32_ps(bits), step);
+        __m256 u2 = uniform8(x);
+        __m256 r = _mm256_sqrt_ps(_mm256_mul_ps(_mm256_set1_ps(-2.0f), log256_ps(u1)));
+        __m256 s, c;
+        sincos256_ps(_mm256_mul_ps(two_pi, u2), &s, &c);
+        __m256 z0 = _mm256_fmadd_ps(stddev_v, _mm256_mul_ps(r, c), mean_v);
+        __m256 z1 = _mm256_fmadd_ps(stddev_v, _mm256_mul_ps(r, s), mean_v);
+        if (i + 16 <= count) {
+            _mm256_storeu_ps(&output[i], z0);
+            _mm256_storeu_ps(&output[i + 8], z1);
+        } else {
+            alignas(32) float rest[16];
+            _mm256_store_ps(rest, z0);
+            _mm256_store_ps(&rest[8], z1);
+            for (size_t k = 0; i + k < count; ++k) {
+                output[i + k] = rest[k];
+            }
+        }
+    }
+    store_lanes(state, x);
+}
+
+} // namespace simd_lib
@@ -0,0 +1,243 @@
+#include "simd_lib.h"
+#include "avx2_helpers.h"
+#include <immintrin.h>
+#include <limits>
+
+namespace simd_lib {
+
+float vector_sum_avx2(const float* a, size_t count) {
+    // Four independent accumulators hide the add latency and, as a side
+    // effect, sum in a more balanced order than a single running total
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(&a[i]));
+        acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(&a[i + 8]));
+        acc2 = _mm256_add_ps(acc2, _mm256_loadu_ps(&a[i + 16]));
+        acc3 = _mm256_add_ps(acc3, _mm256_loadu_ps(&a[i + 24]));
+    }
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(&a[i]));
+    }
+
+    float result = hsum_ps(_mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+
+    // Handle remaining elements with scalar code
+    for (; i < count; ++i) {
+        result += a[i];
+    }
+    return result;
+}
+
+void vector_minmax_avx2(const float* a, size_t count, float* min_value, float* max_value) {
+    const float inf = std::numeric_limits<float>::infinity();
+    __m256 lo0 = _mm256_set1_ps(inf), lo1 = lo0;
+    __m256 hi0 = _mm256_set1_ps(-inf), hi1 = hi0;
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m256 v0 = _mm256_loadu_ps(&a[i]);
+        __m256 v1 = _mm256_loadu_ps(&a[i + 8]);
+        lo0 = _mm256_min_ps(lo0, v0);
+        lo1 = _mm256_min_ps(lo1, v1);
+        hi0 = _mm256_max_ps(hi0, v0);
+        hi1 = _mm256_max_ps(hi1, v1);
+    }
+
+    alignas(32) float lo[8];
+    alignas(32) float hi[8];
+    _mm256_store_ps(lo, _mm256_min_ps(lo0, lo1));
+    _mm256_store_ps(hi, _mm256_max_ps(hi0, hi1));
+
+    float result_min = inf;
+    float result_max = -inf;
+    for (int k = 0; k < 8; ++k) {
+        result_min = lo[k] < result_min ? lo[k] : result_min;
+        result_max = hi[k] > result_max ? hi[k] : result_max;
+    }
+    for (; i < count; ++i) {
+        result_min = a[i] < result_min ? a[i] : result_min;
+        result_max = a[i] > result_max ? a[i] : result_max;
+    }
+
+    *min_value = result_min;
+    *max_value = result_max;
+}
+
+float vector_min_avx2(const float* a, size_t count) {
+    __m256 lo0 = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256 lo1 = lo0, lo2 = lo0, lo3 = lo0;
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        lo0 = _mm256_min_ps(lo0, _mm256_loadu_ps(&a[i]));
+        lo1 = _mm256_min_ps(lo1, _mm256_loadu_ps(&a[i + 8]));
+        lo2 = _mm256_min_ps(lo2, _mm256_loadu_ps(&a[i + 16]));
+        lo3 = _mm256_min_ps(lo3, _mm256_loadu_ps(&a[i + 24]));
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_min_ps(_mm256_min_ps(lo0, lo1), _mm256_min_ps(lo2, lo3)));
+    float result = vector_min_scalar(lanes, 8);
+    for (; i < count; ++i) {
+        result = a[i] < result ? a[i] : result;
+    }
+    return result;
+}
+
+float vector_max_avx2(const float* a, size_t count) {
+    __m256 hi0 = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    __m256 hi1 = hi0, hi2 = hi0, hi3 = hi0;
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32) {
+        hi0 = _mm256_max_ps(hi0, _mm256_loadu_ps(&a[i]));
+        hi1 = _mm256_max_ps(hi1, _mm256_loadu_ps(&a[i + 8]));
+        hi2 = _mm256_max_ps(hi2, _mm256_loadu_ps(&a[i + 16]));
+        hi3 = _mm256_max_ps(hi3, _mm256_loadu_ps(&a[i + 24]));
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, _mm256_max_ps(_mm256_max_ps(hi0, hi1), _mm256_max_ps(hi2, hi3)));
+    float result = vector_max_scalar(lanes, 8);
+    for (; i < count; ++i) {
+        result = a[i] > result ? a[i] : result;
+    }
+    return result;
+}
+
+// Tracks the best value and its index in each lane; a strict comparison keeps
+// the earliest index per lane, and the lane reduction breaks ties by index.
+// Lane indices are int32, so callers feed at most 2^31 elements per call.
+template <bool FindMax>
+static size_t arg_extreme_block(const float* a, size_t count) {
+    if (count < 8) {
+        return FindMax ? argmax_scalar(a, count) : argmin_scalar(a, count);
+    }
+
+    __m256 best = _mm256_loadu_ps(a);
+    __m256i best_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i index = best_index;
+    const __m256i step = _mm256_set1_epi32(8);
+    size_t i = 8;
+
+    for (; i + 8 <= count; i += 8) {
+        index = _mm256_add_epi32(index, step);
+        __m256 v = _mm256_loadu_ps(&a[i]);
+        __m256 better = FindMax ? _mm256_cmp_ps(v, best, _CMP_GT_OQ) : _mm256_cmp_ps(v, best, _CMP_LT_OQ);
+        best = _mm256_blendv_ps(best, v, better);
+        best_index = _mm256_blendv_epi8(best_index, index, _mm256_castps_si256(better));
+    }
+
+    alignas(32) float values[8];
+    alignas(32) int32_t indices[8];
+    _mm256_store_ps(values, best);
+    _mm256_store_si256((__m256i*)indices, best_index);
+
+    size_t result = (size_t)indices[0];
+    float result_value = values[0];
+    for (int k = 1; k < 8; ++k) {
+        bool wins = FindMax ? values[k] > result_value : values[k] < result_value;
+        if (wins || (values[k] == result_value && (size_t)indices[k] < result)) {
+            result = (size_t)indices[k];
+            result_value = values[k];
+        }
+    }
+
+    for (; i < count; ++i) {
+        if (FindMax ? a[i] > result_value : a[i] < result_value) {
+            result = i;
+            result_value = a[i];
+        }
+    }
+    return result;
+}
+
+template <bool FindMax>
+static size_t arg_extreme(const float* a, size_t count) {
+    const size_t block = (size_t)1 << 30;
+    size_t result = 0;
+
+    for (size_t base = 0; base < count; base += block) {
+        size_t n = count - base < block ? count - base : block;
+        size_t candidate = base + arg_extreme_block<FindMax>(&a[base], n);
+        if (base == 0 || (FindMax ? a[candidate] > a[result] : a[candidate] < a[result])) {
+            result = candidate;
+        }
+    }
+    return result;
+}
+
+size_t argmin_avx2(const float* a, size_t count) {
+    return arg_extreme<false>(a, count);
+}
+
+size_t argmax_avx2(const float* a, size_t count) {
+    return arg_extreme<true>(a, count);
+}
+
+void mean_m2_avx2(const float* a, size_t count, double* mean, double* m2) {
+    // Each block accumulates d = x - shift and d*d in float lanes, with the
+    // block's first element as the shift so the sums stay small; block
+    // statistics are then merged with Chan's update in double
+    const size_t block = 4096;
+    double total_n = 0.0;
+    double total_mean = 0.0;
+    double total_m2 = 0.0;
+
+    for (size_t base = 0; base < count; base += block) {
+        size_t n = count - base < block ? count - base : block;
+        const float* p = &a[base];
+        float shift = p[0];
+        __m256 shift_vec = _mm256_set1_ps(shift);
+        __m256 s0 = _mm256_setzero_ps(), s1 = s0;
+        __m256 q0 = _mm256_setzero_ps(), q1 = q0;
+        size_t i = 0;
+
+        for (; i + 16 <= n; i += 16) {
+            __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(&p[i]), shift_vec);
+            __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(&p[i + 8]), shift_vec);
+            s0 = _mm256_add_ps(s0, d0);
+            s1 = _mm256_add_ps(s1, d1);
+            q0 = _mm256_fmadd_ps(d0, d0, q0);
+            q1 = _mm256_fmadd_ps(d1, d1, q1);
+        }
+
+        double s = hsum_ps(_mm256_add_ps(s0, s1));
+        double q = hsum_ps(_mm256_add_ps(q0, q1));
+        for (; i < n; ++i) {
+            double d = (double)p[i] - shift;
+            s += d;
+            q += d * d;
+        }
+
+        double block_n = (double)n;
+        double block_mean = shift + s / block_n;
+        double block_m2 = q - s * s / block_n;
+        if (block_m2 < 0.0) {
+            block_m2 = 0.0;
+        }
+
+        double merged_n = total_n + block_n;
+        double delta = block_mean - total_mean;
+        total_mean += delta * block_n / merged_n;
+        total_m2 += block_m2 + delta * delta * total_n * block_n / merged_n;
+        total_n = merged_n;
+    }
+
+    *mean = total_mean;
+    *m2 = total_m2;
+}
+
+void mean_variance_avx2(const float* a, size_t count, float* mean, float* variance) {
+    double m, m2;
+    mean_m2_avx2(a, count, &m, &m2);
+    *mean = (float)m;
+    *variance = count > 0 ? (float)(m2 / (double)count) : 0.0f;
+}
+
+} // namespace simd_lib
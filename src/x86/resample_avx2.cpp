@@ -0,0 +1,73 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// Reduces four accumulators together: lane j of the result sums acc j. Single
+// outputs go through the same tree with zeros, so a sample's value never
+// depends on whether it was computed alone or in a group of four.
+static inline __m128 reduce4(__m256 acc0, __m256 acc1, __m256 acc2, __m256 acc3) {
+    __m256 sums = _mm256_hadd_ps(_mm256_hadd_ps(acc0, acc1), _mm256_hadd_ps(acc2, acc3));
+    return _mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1));
+}
+
+size_t resample_polyphase_avx2(const float* input, size_t length, const float* bank, size_t taps, size_t phases,
+                               size_t step, size_t* position, float* output, size_t output_stride) {
+    size_t pos = *position;
+    size_t produced = 0;
+
+    // Four outputs at a time: their windows overlap in the input, and four
+    // independent FMA chains hide the latency a single dot product would expose
+    while ((pos + 3 * step) / phases + taps <= length) {
+        const float* x0 = &input[pos / phases];
+        const float* x1 = &input[(pos + step) / phases];
+        const float* x2 = &input[(pos + 2 * step) / phases];
+        const float* x3 = &input[(pos + 3 * step) / phases];
+        const float* h0 = &bank[(pos % phases) * taps];
+        const float* h1 = &bank[((pos + step) % phases) * taps];
+        const float* h2 = &bank[((pos + 2 * step) % phases) * taps];
+        const float* h3 = &bank[((pos + 3 * step) % phases) * taps];
+
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        for (size_t k = 0; k < taps; k += 8) {
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&h0[k]), _mm256_loadu_ps(&x0[k]), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(&h1[k]), _mm256_loadu_ps(&x1[k]), acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(&h2[k]), _mm256_loadu_ps(&x2[k]), acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(&h3[k]), _mm256_loadu_ps(&x3[k]), acc3);
+        }
+
+        __m128 result = reduce4(acc0, acc1, acc2, acc3);
+        if (output_stride == 1) {
+            _mm_storeu_ps(&output[produced], result);
+        } else {
+            float values[4];
+            _mm_storeu_ps(values, result);
+            for (size_t j = 0; j < 4; ++j) {
+                output[(produced + j) * output_stride] = values[j];
+            }
+        }
+        produced += 4;
+        pos += 4 * step;
+    }
+
+    while (pos / phases + taps <= length) {
+        const float* x = &input[pos / phases];
+        const float* h = &bank[(pos % phases) * taps];
+        __m256 acc = _mm256_setzero_ps();
+        for (size_t k = 0; k < taps; k += 8) {
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(&h[k]), _mm256_loadu_ps(&x[k]), acc);
+        }
+        const __m256 zero = _mm256_setzero_ps();
+        output[produced * output_stride] = _mm_cvtss_f32(reduce4(acc, zero, zero, zero));
+        ++produced;
+        pos += step;
+    }
+
+    *position = pos;
+    return produced;
+}
+
+} // namespace simd_lib
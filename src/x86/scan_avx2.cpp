@@ -0,0 +1,74 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// Inclusive prefix sum of the 8 lanes of x: two in-lane shift-and-add steps,
+// then the low 128-bit lane's total is added to the high lane
+static inline __m256 scan8_ps(__m256 x) {
+    x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+    x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+    __m256 low_total = _mm256_permute_ps(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_add_ps(x, _mm256_permute2f128_ps(low_total, low_total, 0x08));
+}
+
+// Broadcast of lane 7
+static inline __m256 last_lane_ps(__m256 x) {
+    __m256 high = _mm256_permute_ps(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_permute2f128_ps(high, high, 0x11);
+}
+
+float inclusive_scan_avx2(const float* input, float* result, size_t count, float carry) {
+    __m256 carry_vec = _mm256_set1_ps(carry);
+    size_t i = 0;
+
+    // The local scans and their totals do not depend on the carry, so the
+    // loop-carried chain is a single add per 16 elements
+    for (; i + 16 <= count; i += 16) {
+        __m256 s0 = scan8_ps(_mm256_loadu_ps(&input[i]));
+        __m256 s1 = scan8_ps(_mm256_loadu_ps(&input[i + 8]));
+        __m256 total0 = last_lane_ps(s0);
+        __m256 total01 = _mm256_add_ps(total0, last_lane_ps(s1));
+        _mm256_storeu_ps(&result[i], _mm256_add_ps(s0, carry_vec));
+        _mm256_storeu_ps(&result[i + 8], _mm256_add_ps(s1, _mm256_add_ps(carry_vec, total0)));
+        carry_vec = _mm256_add_ps(carry_vec, total01);
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m256 s = _mm256_add_ps(scan8_ps(_mm256_loadu_ps(&input[i])), carry_vec);
+        _mm256_storeu_ps(&result[i], s);
+        carry_vec = last_lane_ps(s);
+    }
+
+    // Handle remaining elements with scalar code
+    return inclusive_scan_scalar(&input[i], &result[i], count - i, _mm256_cvtss_f32(carry_vec));
+}
+
+float exclusive_scan_avx2(const float* input, float* result, size_t count, float carry) {
+    // The inclusive scan rotated up one lane, with the incoming carry in lane 0;
+    // shifting the sums rather than subtracting the input keeps this exact
+    const __m256i rotate = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+    __m256 carry_vec = _mm256_set1_ps(carry);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m256 s0 = scan8_ps(_mm256_loadu_ps(&input[i]));
+        __m256 s1 = scan8_ps(_mm256_loadu_ps(&input[i + 8]));
+        __m256 total0 = last_lane_ps(s0);
+        __m256 total01 = _mm256_add_ps(total0, last_lane_ps(s1));
+        __m256 middle = _mm256_add_ps(carry_vec, total0);
+        s0 = _mm256_add_ps(s0, carry_vec);
+        s1 = _mm256_add_ps(s1, middle);
+        _mm256_storeu_ps(&result[i], _mm256_blend_ps(_mm256_permutevar8x32_ps(s0, rotate), carry_vec, 0x01));
+        _mm256_storeu_ps(&result[i + 8], _mm256_blend_ps(_mm256_permutevar8x32_ps(s1, rotate), middle, 0x01));
+        carry_vec = _mm256_add_ps(carry_vec, total01);
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m256 s = _mm256_add_ps(scan8_ps(_mm256_loadu_ps(&input[i])), carry_vec);
+        _mm256_storeu_ps(&result[i], _mm256_blend_ps(_mm256_permutevar8x32_ps(s, rotate), carry_vec, 0x01));
+        carry_vec = last_lane_ps(s);
+    }
+
+    return exclusive_scan_scalar(&input[i], &result[i], count - i, _mm256_cvtss_f32(carry_vec));
+}
+
+} // namespace simd_lib
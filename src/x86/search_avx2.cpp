@@ -0,0 +1,122 @@
+#include "simd_lib.h"
+#include "avx2_helpers.h"
+#include <immintrin.h>
+#include <cmath>
+
+namespace simd_lib {
+
+enum class BatchKind { Dot, L2, Cosine };
+
+// Scores 4 rows per pass against one query load, with two accumulators per row
+// (16 floats per step) so eight independent FMA chains hide the FMA latency.
+// Cosine tracks the row norms in the same pass; the caller supplies |query|.
+template <BatchKind Kind>
+static void batch_kernel_avx2(const float* query, const float* matrix, size_t rows, size_t dim,
+                              float* out, float query_norm) {
+    size_t r = 0;
+
+    for (; r + 4 <= rows; r += 4) {
+        const float* row[4] = {&matrix[r * dim], &matrix[(r + 1) * dim],
+                               &matrix[(r + 2) * dim], &matrix[(r + 3) * dim]};
+        __m256 acc[4][2];
+        __m256 norm[4][2];
+        for (int k = 0; k < 4; ++k) {
+            acc[k][0] = acc[k][1] = _mm256_setzero_ps();
+            norm[k][0] = norm[k][1] = _mm256_setzero_ps();
+        }
+
+        size_t i = 0;
+        for (; i + 16 <= dim; i += 16) {
+            __m256 q0 = _mm256_loadu_ps(&query[i]);
+            __m256 q1 = _mm256_loadu_ps(&query[i + 8]);
+            for (int k = 0; k < 4; ++k) {
+                __m256 x0 = _mm256_loadu_ps(&row[k][i]);
+                __m256 x1 = _mm256_loadu_ps(&row[k][i + 8]);
+                if (Kind == BatchKind::L2) {
+                    __m256 d0 = _mm256_sub_ps(x0, q0);
+                    __m256 d1 = _mm256_sub_ps(x1, q1);
+                    acc[k][0] = _mm256_fmadd_ps(d0, d0, acc[k][0]);
+                    acc[k][1] = _mm256_fmadd_ps(d1, d1, acc[k][1]);
+                } else {
+                    acc[k][0] = _mm256_fmadd_ps(x0, q0, acc[k][0]);
+                    acc[k][1] = _mm256_fmadd_ps(x1, q1, acc[k][1]);
+                }
+                if (Kind == BatchKind::Cosine) {
+                    norm[k][0] = _mm256_fmadd_ps(x0, x0, norm[k][0]);
+                    norm[k][1] = _mm256_fmadd_ps(x1, x1, norm[k][1]);
+                }
+            }
+        }
+
+        for (int k = 0; k < 4; ++k) {
+            float sum = hsum_ps(_mm256_add_ps(acc[k][0], acc[k][1]));
+            float row_norm = hsum_ps(_mm256_add_ps(norm[k][0], norm[k][1]));
+            // Handle remaining elements with scalar code
+            for (size_t j = i; j < dim; ++j) {
+                if (Kind == BatchKind::L2) {
+                    float diff = row[k][j] - query[j];
+                    sum += diff * diff;
+                } else {
+                    sum += row[k][j] * query[j];
+                }
+                if (Kind == BatchKind::Cosine) {
+                    row_norm += row[k][j] * row[k][j];
+                }
+            }
+            if (Kind == BatchKind::Cosine) {
+                float denom = query_norm * std::sqrt(row_norm);
+                sum = denom > 0.0f ? sum / denom : 0.0f;
+            }
+            out[r + k] = sum;
+        }
+    }
+
+    // Handle remaining rows with the scalar kernels
+    if (r < rows) {
+        if (Kind == BatchKind::Dot) {
+            batch_dot_scalar(query, &matrix[r * dim], rows - r, dim, &out[r]);
+        } else if (Kind == BatchKind::L2) {
+            batch_l2_squared_scalar(query, &matrix[r * dim], rows - r, dim, &out[r]);
+        } else {
+            batch_cosine_scalar(query, &matrix[r * dim], rows - r, dim, &out[r]);
+        }
+    }
+}
+
+void batch_dot_avx2(const float* query, const float* matrix, size_t rows, size_t dim, float* out) {
+    batch_kernel_avx2<BatchKind::Dot>(query, matrix, rows, dim, out, 0.0f);
+}
+
+void batch_l2_squared_avx2(const float* query, const float* matrix, size_t rows, size_t dim, float* out) {
+    batch_kernel_avx2<BatchKind::L2>(query, matrix, rows, dim, out, 0.0f);
+}
+
+void batch_cosine_avx2(const float* query, const float* matrix, size_t rows, size_t dim, float* out) {
+    batch_kernel_avx2<BatchKind::Cosine>(query, matrix, rows, dim, out, vector_norm_avx2(query, dim));
+}
+
+size_t select_greater_avx2(const float* values, size_t count, float threshold, uint32_t* positions) {
+    const __m256 limit = _mm256_set1_ps(threshold);
+    size_t found = 0;
+    size_t i = 0;
+
+    // Most blocks have no survivors once the threshold settles, so the
+    // common case is one compare and one movemask per 8 values
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_loadu_ps(&values[i]);
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(v, limit, _CMP_GT_OQ));
+        while (mask != 0) {
+            positions[found++] = (uint32_t)i + lowest_set_bit(mask);
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i < count; ++i) {
+        if (values[i] > threshold) {
+            positions[found++] = (uint32_t)i;
+        }
+    }
+    return found;
+}
+
+} // namespace simd_lib
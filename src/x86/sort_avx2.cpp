@@ -0,0 +1,403 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// Ranges up to this size are sorted by the register network
+static const size_t kNetworkMax = 64;
+
+// The key of each lane paired with lane i ^ Xor of the same register
+template <int Xor>
+static inline __m256 partner(__m256 x) {
+    if constexpr (Xor == 1) {
+        return _mm256_permute_ps(x, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if constexpr (Xor == 2) {
+        return _mm256_permute_ps(x, _MM_SHUFFLE(1, 0, 3, 2));
+    } else if constexpr (Xor == 3) {
+        return _mm256_permute_ps(x, _MM_SHUFFLE(0, 1, 2, 3));
+    } else if constexpr (Xor == 4) {
+        return _mm256_permute2f128_ps(x, x, 1);
+    } else {
+        return _mm256_permutevar8x32_ps(x, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+}
+
+template <int Xor>
+static inline __m256i partner(__m256i x) {
+    if constexpr (Xor == 1) {
+        return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if constexpr (Xor == 2) {
+        return _mm256_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+    } else if constexpr (Xor == 3) {
+        return _mm256_shuffle_epi32(x, _MM_SHUFFLE(0, 1, 2, 3));
+    } else if constexpr (Xor == 4) {
+        return _mm256_permute2x128_si256(x, x, 1);
+    } else {
+        return _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+}
+
+// Lanes with a higher index than their partner, which keep the larger key
+template <int Xor>
+static constexpr int upper_lanes() {
+    return Xor == 1 ? 0xAA : (Xor == 2 || Xor == 3) ? 0xCC : 0xF0;
+}
+
+// One comparator layer inside a register. With values (V), keys decide and
+// both registers follow the same blend; equal keys never move, so no value
+// is duplicated or lost. Without values min/max suffice: min(k, p) and
+// max(k, p) return p for equal keys, which swaps the pair but keeps both.
+template <bool V, int Xor>
+static inline void layer(__m256& k, __m256i& v) {
+    __m256 p = partner<Xor>(k);
+    if constexpr (V) {
+        __m256 take_lower = _mm256_cmp_ps(k, p, _CMP_GT_OQ);
+        __m256 take_upper = _mm256_cmp_ps(k, p, _CMP_LT_OQ);
+        __m256 take = _mm256_blend_ps(take_lower, take_upper, upper_lanes<Xor>());
+        k = _mm256_blendv_ps(k, p, take);
+        v = _mm256_blendv_epi8(v, partner<Xor>(v), _mm256_castps_si256(take));
+    } else {
+        k = _mm256_blend_ps(_mm256_min_ps(k, p), _mm256_max_ps(k, p), upper_lanes<Xor>());
+    }
+}
+
+// Comparator between two registers, lane by lane: a keeps the smaller keys.
+// max(b, a) returns a for equal keys, the counterpart of min(a, b) returning b.
+template <bool V>
+static inline void exchange(__m256& ka, __m256i& va, __m256& kb, __m256i& vb) {
+    if constexpr (V) {
+        __m256 swap = _mm256_cmp_ps(ka, kb, _CMP_GT_OQ);
+        __m256i swap_values = _mm256_castps_si256(swap);
+        __m256 low = _mm256_blendv_ps(ka, kb, swap);
+        __m256i low_values = _mm256_blendv_epi8(va, vb, swap_values);
+        kb = _mm256_blendv_ps(kb, ka, swap);
+        vb = _mm256_blendv_epi8(vb, va, swap_values);
+        ka = low;
+        va = low_values;
+    } else {
+        __m256 low = _mm256_min_ps(ka, kb);
+        kb = _mm256_max_ps(kb, ka);
+        ka = low;
+    }
+}
+
+// Bitonic sort of one register in the variant where each merge starts by
+// comparing mirrored positions, so every comparator points the same way
+template <bool V>
+static inline void sort8(__m256& k, __m256i& v) {
+    layer<V, 1>(k, v);
+    layer<V, 3>(k, v);
+    layer<V, 1>(k, v);
+    layer<V, 7>(k, v);
+    layer<V, 2>(k, v);
+    layer<V, 1>(k, v);
+}
+
+// Final half-cleaner layers within one register
+template <bool V>
+static inline void clean8(__m256& k, __m256i& v) {
+    layer<V, 4>(k, v);
+    layer<V, 2>(k, v);
+    layer<V, 1>(k, v);
+}
+
+// Merges registers k[0, size) whose two halves are each sorted across registers
+template <bool V>
+static inline void merge_registers(__m256* k, __m256i* v, size_t size) {
+    // Mirror layer: position i meets position 8 * size - 1 - i
+    for (size_t i = 0; i < size / 2; ++i) {
+        __m256 kb = partner<7>(k[size - 1 - i]);
+        __m256i vb = V ? partner<7>(v[size - 1 - i]) : v[size - 1 - i];
+        exchange<V>(k[i], v[i], kb, vb);
+        k[size - 1 - i] = partner<7>(kb);
+        if constexpr (V) {
+            v[size - 1 - i] = partner<7>(vb);
+        }
+    }
+    for (size_t d = size / 4; d >= 1; d /= 2) {
+        for (size_t i = 0; i < size; ++i) {
+            if ((i & d) == 0) {
+                exchange<V>(k[i], v[i], k[i + d], v[i + d]);
+            }
+        }
+    }
+    for (size_t i = 0; i < size; ++i) {
+        clean8<V>(k[i], v[i]);
+    }
+}
+
+template <bool V, size_t N>
+static inline void sort_registers(__m256* k, __m256i* v) {
+    for (size_t i = 0; i < N; ++i) {
+        sort8<V>(k[i], v[i]);
+    }
+    for (size_t size = 2; size <= N; size *= 2) {
+        for (size_t g = 0; g < N; g += size) {
+            merge_registers<V>(&k[g], &v[g], size);
+        }
+    }
+}
+
+// Sorts up to 64 keys through the smallest network that holds them; the
+// unused lanes are padded with +inf, which sorts after every real key
+template <bool V, size_t N>
+static inline void sort_padded(float* keys, uint32_t* values, size_t count) {
+    alignas(32) float key_buffer[8 * N];
+    alignas(32) uint32_t value_buffer[8 * N];
+    for (size_t i = 0; i < 8 * N; ++i) {
+        key_buffer[i] = i < count ? keys[i] : __builtin_inff();
+        if constexpr (V) {
+            value_buffer[i] = i < count ? values[i] : 0;
+        }
+    }
+    __m256 k[N];
+    __m256i v[N];
+    for (size_t i = 0; i < N; ++i) {
+        k[i] = _mm256_load_ps(&key_buffer[8 * i]);
+        v[i] = _mm256_setzero_si256();
+        if constexpr (V) {
+            v[i] = _mm256_load_si256((const __m256i*)&value_buffer[8 * i]);
+        }
+    }
+    sort_registers<V, N>(k, v);
+    for (size_t i = 0; i < N; ++i) {
+        _mm256_store_ps(&key_buffer[8 * i], k[i]);
+        if constexpr (V) {
+            _mm256_store_si256((__m256i*)&value_buffer[8 * i], v[i]);
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = key_buffer[i];
+        if constexpr (V) {
+            values[i] = value_buffer[i];
+        }
+    }
+}
+
+template <bool V>
+static void sort_small(float* keys, uint32_t* values, size_t count) {
+    if constexpr (V) {
+        // A real +inf key ties with the padding and could trade places with it
+        for (size_t i = 0; i < count; ++i) {
+            if (keys[i] == __builtin_inff()) {
+                sort_key_value_scalar(keys, values, count);
+                return;
+            }
+        }
+    }
+    if (count <= 1) {
+        return;
+    } else if (count <= 8) {
+        sort_padded<V, 1>(keys, values, count);
+    } else if (count <= 16) {
+        sort_padded<V, 2>(keys, values, count);
+    } else if (count <= 32) {
+        sort_padded<V, 4>(keys, values, count);
+    } else {
+        sort_padded<V, 8>(keys, values, count);
+    }
+}
+
+// For each movemask of keys that go left: the lane order that puts them
+// first, in order, followed by the others
+struct PartitionTable {
+    int32_t order[256][8];
+    uint8_t left[256];
+};
+
+static const PartitionTable& partition_table() {
+    static const PartitionTable table = [] {
+        PartitionTable t = {};
+        for (int mask = 0; mask < 256; ++mask) {
+            int n = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) {
+                    t.order[mask][n++] = lane;
+                }
+            }
+            t.left[mask] = (uint8_t)n;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (!(mask & (1 << lane))) {
+                    t.order[mask][n++] = lane;
+                }
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Writes one register's keys to both ends: the whole permuted register goes
+// to the left cursor and again so that it ends at the right cursor, and each
+// cursor advances by the keys that belong on its side
+template <bool V, int Cmp>
+static inline void partition_register(__m256 k, __m256i v, __m256 pivot, const PartitionTable& table, float* keys,
+                                      uint32_t* values, size_t& left, size_t& right) {
+    int mask = _mm256_movemask_ps(_mm256_cmp_ps(k, pivot, Cmp));
+    __m256i order = _mm256_loadu_si256((const __m256i*)table.order[mask]);
+    __m256 pk = _mm256_permutevar8x32_ps(k, order);
+    _mm256_storeu_ps(&keys[left], pk);
+    _mm256_storeu_ps(&keys[right - 8], pk);
+    if constexpr (V) {
+        __m256i pv = _mm256_permutevar8x32_epi32(v, order);
+        _mm256_storeu_si256((__m256i*)&values[left], pv);
+        _mm256_storeu_si256((__m256i*)&values[right - 8], pv);
+    }
+    size_t n = table.left[mask];
+    left += n;
+    right -= 8 - n;
+}
+
+// In-place partition of count >= 16 keys: those with Cmp(key, pivot) first.
+// The first and last registers are set aside to open 8 free slots at each
+// end; each step then reads from the end with less free space, so the 8-wide
+// stores never overwrite unread keys. Returns the size of the left part.
+template <bool V, int Cmp>
+static size_t partition(float* keys, uint32_t* values, size_t count, float pivot_value) {
+    const PartitionTable& table = partition_table();
+    const __m256 pivot = _mm256_set1_ps(pivot_value);
+    const __m256 first = _mm256_loadu_ps(keys);
+    const __m256 last = _mm256_loadu_ps(&keys[count - 8]);
+    __m256i first_values = _mm256_setzero_si256(), last_values = _mm256_setzero_si256();
+    if constexpr (V) {
+        first_values = _mm256_loadu_si256((const __m256i*)values);
+        last_values = _mm256_loadu_si256((const __m256i*)&values[count - 8]);
+    }
+
+    size_t left = 0, right = count;              // write cursors
+    size_t read_left = 8, read_right = count - 8;  // unread keys [read_left, read_right)
+    while (read_right - read_left >= 8) {
+        size_t at;
+        if (read_left - left <= right - read_right) {
+            at = read_left;
+            read_left += 8;
+        } else {
+            read_right -= 8;
+            at = read_right;
+        }
+        __m256i v = V ? _mm256_loadu_si256((const __m256i*)&values[at]) : _mm256_setzero_si256();
+        partition_register<V, Cmp>(_mm256_loadu_ps(&keys[at]), v, pivot, table, keys, values, left, right);
+    }
+    while (read_left < read_right) {
+        size_t at = read_left - left <= right - read_right ? read_left++ : --read_right;
+        float key = keys[at];
+        uint32_t value = V ? values[at] : 0;
+        bool goes_left = Cmp == _CMP_LT_OQ ? key < pivot_value : key <= pivot_value;
+        size_t to = goes_left ? left++ : --right;
+        keys[to] = key;
+        if constexpr (V) {
+            values[to] = value;
+        }
+    }
+    // Exactly 16 free slots remain for the two registers set aside
+    partition_register<V, Cmp>(first, first_values, pivot, table, keys, values, left, right);
+    partition_register<V, Cmp>(last, last_values, pivot, table, keys, values, left, right);
+    return left;
+}
+
+static inline float median_of_three(float a, float b, float c) {
+    float low = a < b ? a : b;
+    float high = a < b ? b : a;
+    return c < low ? low : (c > high ? high : c);
+}
+
+static inline int depth_limit(size_t count) {
+    int depth = 0;
+    while (count > 1) {
+        count >>= 1;
+        depth += 2;
+    }
+    return depth;
+}
+
+template <bool V>
+static void fallback_sort(float* keys, uint32_t* values, size_t count) {
+    if constexpr (V) {
+        sort_key_value_scalar(keys, values, count);
+    } else {
+        sort_floats_scalar(keys, count);
+    }
+}
+
+template <bool V>
+static void quicksort(float* keys, uint32_t* values, size_t count, int depth) {
+    while (count > kNetworkMax) {
+        // Degenerate splits: hand the range to the scalar sort (introsort)
+        if (depth-- == 0) {
+            fallback_sort<V>(keys, values, count);
+            return;
+        }
+        float pivot = median_of_three(keys[count / 4], keys[count / 2], keys[count * 3 / 4]);
+        size_t mid = partition<V, _CMP_LT_OQ>(keys, values, count, pivot);
+        if (mid == 0) {
+            // The pivot is the smallest key; the keys equal to it are in place
+            mid = partition<V, _CMP_LE_OQ>(keys, values, count, pivot);
+            if (mid == 0) {
+                fallback_sort<V>(keys, values, count);
+                return;
+            }
+            keys += mid;
+            if constexpr (V) {
+                values += mid;
+            }
+            count -= mid;
+            continue;
+        }
+        // Recurse into the smaller part, loop on the larger one
+        if (mid < count - mid) {
+            quicksort<V>(keys, values, mid, depth);
+            keys += mid;
+            if constexpr (V) {
+                values += mid;
+            }
+            count -= mid;
+        } else {
+            quicksort<V>(&keys[mid], V ? &values[mid] : values, count - mid, depth);
+            count = mid;
+        }
+    }
+    sort_small<V>(keys, values, count);
+}
+
+void sort_floats_avx2(float* data, size_t count) {
+    quicksort<false>(data, nullptr, count, depth_limit(count));
+}
+
+void sort_key_value_avx2(float* keys, uint32_t* values, size_t count) {
+    quicksort<true>(keys, values, count, depth_limit(count));
+}
+
+float select_nth_avx2(float* data, size_t count, size_t n) {
+    size_t low = 0, high = count;
+    int depth = depth_limit(count);
+    while (high - low > kNetworkMax) {
+        if (depth-- == 0) {
+            return select_nth_scalar(&data[low], high - low, n - low);
+        }
+        size_t size = high - low;
+        float* range = &data[low];
+        float pivot = median_of_three(range[size / 4], range[size / 2], range[size * 3 / 4]);
+        size_t mid = low + partition<false, _CMP_LT_OQ>(range, nullptr, size, pivot);
+        if (mid == low) {
+            mid = low + partition<false, _CMP_LE_OQ>(range, nullptr, size, pivot);
+            if (mid == low) {
+                return select_nth_scalar(range, size, n - low);
+            }
+            // Everything in [low, mid) equals the pivot
+            if (n < mid) {
+                return data[n];
+            }
+            low = mid;
+            continue;
+        }
+        if (n < mid) {
+            high = mid;
+        } else {
+            low = mid;
+        }
+    }
+    sort_small<false>(&data[low], nullptr, high - low);
+    return data[n];
+}
+
+} // namespace simd_lib
@@ -0,0 +1,91 @@
+#include "simd_lib.h"
+#include "avx2_helpers.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+float sparse_dot_dense_avx2(const uint32_t* indices, const float* values, size_t nnz, const float* dense) {
+    // Two accumulators keep two gathers in flight
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= nnz; i += 16) {
+        __m256i idx0 = _mm256_loadu_si256((const __m256i*)&indices[i]);
+        __m256i idx1 = _mm256_loadu_si256((const __m256i*)&indices[i + 8]);
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&values[i]), _mm256_i32gather_ps(dense, idx0, 4), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(&values[i + 8]), _mm256_i32gather_ps(dense, idx1, 4), acc1);
+    }
+    if (i + 8 <= nnz) {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)&indices[i]);
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&values[i]), _mm256_i32gather_ps(dense, idx, 4), acc0);
+        i += 8;
+    }
+    return hsum_ps(_mm256_add_ps(acc0, acc1)) + sparse_dot_dense_scalar(&indices[i], &values[i], nnz - i, dense);
+}
+
+float sparse_dot_dense_delta16_avx2(const uint16_t* deltas, const float* values, size_t nnz, const float* dense) {
+    const __m256i last = _mm256_set1_epi32(7);
+    __m256i base = _mm256_setzero_si256();
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= nnz; i += 8) {
+        // Inclusive prefix sum of the 8 gaps: within each 128-bit lane, then
+        // the low lane's total carried into the high lane
+        __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&deltas[i]));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+        __m256i carry = _mm256_shuffle_epi32(_mm256_permute2x128_si256(x, x, 0x08), _MM_SHUFFLE(3, 3, 3, 3));
+        __m256i idx = _mm256_add_epi32(base, _mm256_add_epi32(x, carry));
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(&values[i]), _mm256_i32gather_ps(dense, idx, 4), acc);
+        base = _mm256_permutevar8x32_epi32(idx, last);
+    }
+    // The tail continues from the last decoded index
+    const float* rest = &dense[(uint32_t)_mm256_extract_epi32(base, 0)];
+    return hsum_ps(acc) + sparse_dot_dense_delta16_scalar(&deltas[i], &values[i], nnz - i, rest);
+}
+
+// Rotates the lanes of an index block and its values by one position
+static inline void rotate(__m256i& indices, __m256& values) {
+    const __m256i next = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    indices = _mm256_permutevar8x32_epi32(indices, next);
+    values = _mm256_permutevar8x32_ps(values, next);
+}
+
+float sparse_dot_sparse_avx2(const uint32_t* a_indices, const float* a_values, size_t a_nnz,
+                             const uint32_t* b_indices, const float* b_values, size_t b_nnz) {
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0, j = 0;
+    while (i + 8 <= a_nnz && j + 8 <= b_nnz) {
+        uint32_t a_last = a_indices[i + 7];
+        uint32_t b_last = b_indices[j + 7];
+        // Skip a whole block when the ranges cannot overlap
+        if (a_last < b_indices[j]) {
+            i += 8;
+            continue;
+        }
+        if (b_last < a_indices[i]) {
+            j += 8;
+            continue;
+        }
+        __m256i ai = _mm256_loadu_si256((const __m256i*)&a_indices[i]);
+        __m256 av = _mm256_loadu_ps(&a_values[i]);
+        __m256i bi = _mm256_loadu_si256((const __m256i*)&b_indices[j]);
+        __m256 bv = _mm256_loadu_ps(&b_values[j]);
+        // Indices are unique within each side, so each lane matches at most once
+        for (int r = 0; r < 8; ++r) {
+            __m256 match = _mm256_castsi256_ps(_mm256_cmpeq_epi32(ai, bi));
+            acc = _mm256_fmadd_ps(av, _mm256_and_ps(bv, match), acc);
+            rotate(bi, bv);
+        }
+        if (a_last <= b_last) {
+            i += 8;
+        }
+        if (b_last <= a_last) {
+            j += 8;
+        }
+    }
+    return hsum_ps(acc) + sparse_dot_sparse_scalar(&a_indices[i], &a_values[i], a_nnz - i,
+                                                   &b_indices[j], &b_values[j], b_nnz - j);
+}
+
+} // namespace simd_lib
@@ -0,0 +1,96 @@
+#include "simd_lib.h"
+#include <immintrin.h>
+
+namespace simd_lib {
+
+// Local rather than std::swap: a template instantiated in this -mavx2 object
+// could be the copy the linker keeps for baseline callers
+static inline void swap_floats(float& x, float& y) {
+    float t = x;
+    x = y;
+    y = t;
+}
+
+// 4x4 transpose within each 128-bit lane
+static inline void transpose4_lanes(__m256& a, __m256& b, __m256& c, __m256& d) {
+    __m256 t0 = _mm256_unpacklo_ps(a, b);  // a0 b0 a1 b1
+    __m256 t1 = _mm256_unpackhi_ps(a, b);  // a2 b2 a3 b3
+    __m256 t2 = _mm256_unpacklo_ps(c, d);
+    __m256 t3 = _mm256_unpackhi_ps(c, d);
+    a = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    b = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    d = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+// Loads an 8x8 block and leaves its transpose in out[0..8). Row k goes to the
+// low lane and row k + 4 to the high lane, so the in-lane 4x4 transposes
+// finish the job without any cross-lane permutes.
+static inline void load_transposed8x8(const float* src, size_t lds, __m256 out[8]) {
+    for (int k = 0; k < 4; ++k) {
+        const float* low = &src[k * lds];
+        const float* high = &src[(k + 4) * lds];
+        out[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+        out[k + 4] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low + 4)), _mm_loadu_ps(high + 4), 1);
+    }
+    transpose4_lanes(out[0], out[1], out[2], out[3]);
+    transpose4_lanes(out[4], out[5], out[6], out[7]);
+}
+
+static inline void store8x8(float* dst, size_t ldd, const __m256 rows[8]) {
+    for (int k = 0; k < 8; ++k) {
+        _mm256_storeu_ps(&dst[k * ldd], rows[k]);
+    }
+}
+
+void transpose_avx2(const float* src, size_t rows, size_t cols, size_t lds, float* dst, size_t ldd) {
+    size_t r = 0;
+    for (; r + 8 <= rows; r += 8) {
+        size_t c = 0;
+        for (; c + 8 <= cols; c += 8) {
+            __m256 block[8];
+            load_transposed8x8(&src[r * lds + c], lds, block);
+            store8x8(&dst[c * ldd + r], ldd, block);
+        }
+        for (; c < cols; ++c) {
+            for (size_t i = r; i < r + 8; ++i) {
+                dst[c * ldd + i] = src[i * lds + c];
+            }
+        }
+    }
+    for (; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            dst[c * ldd + r] = src[r * lds + c];
+        }
+    }
+}
+
+void transpose_swap_avx2(float* a, float* b, size_t rows, size_t cols, size_t ld) {
+    // A diagonal block swaps with itself, so only its upper triangle is visited
+    const bool diagonal = a == b;
+    size_t r = 0;
+    for (; r + 8 <= rows; r += 8) {
+        size_t c = diagonal ? r : 0;
+        for (; c + 8 <= cols; c += 8) {
+            // Both blocks are loaded before either is stored, so the 8x8
+            // blocks on the diagonal transpose in place
+            __m256 block_a[8], block_b[8];
+            load_transposed8x8(&a[r * ld + c], ld, block_a);
+            load_transposed8x8(&b[c * ld + r], ld, block_b);
+            store8x8(&b[c * ld + r], ld, block_a);
+            store8x8(&a[r * ld + c], ld, block_b);
+        }
+        for (; c < cols; ++c) {
+            for (size_t i = r; i < r + 8; ++i) {
+                swap_floats(a[i * ld + c], b[c * ld + i]);
+            }
+        }
+    }
+    for (; r < rows; ++r) {
+        for (size_t c = diagonal ? r + 1 : 0; c < cols; ++c) {
+            swap_floats(a[r * ld + c], b[c * ld + r]);
+        }
+    }
+}
+
+} // namespace simd_lib
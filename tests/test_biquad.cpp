@@ -0,0 +1,369 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <algorithm>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static std::vector<float> random_vector(size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> v(count);
+    for (float& x : v) {
+        x = dist(rng);
+    }
+    return v;
+}
+
+// A different equalizer chain per channel, so lanes cannot be mixed up unnoticed
+static simd_lib::BiquadCoefficients design(size_t channel, size_t section) {
+    const double rate = 48000.0;
+    switch (section % 3) {
+    case 0:
+        return simd_lib::biquad_lowpass(4000.0 + 150.0 * channel, rate);
+    case 1:
+        return simd_lib::biquad_peaking(500.0 + 40.0 * channel, rate, 1.5, -6.0 + 0.5 * (double)(channel % 24));
+    default:
+        return simd_lib::biquad_highpass(40.0 + 3.0 * channel, rate, 0.9);
+    }
+}
+
+static void configure(simd_lib::BiquadCascade& cascade) {
+    for (size_t c = 0; c < cascade.channels(); ++c) {
+        for (size_t s = 0; s < cascade.sections(); ++s) {
+            cascade.set_section(c, s, design(c, s));
+        }
+    }
+}
+
+// Direct form II transposed in double over interleaved frames
+static std::vector<double> reference(const std::vector<float>& input, size_t channels, size_t sections) {
+    size_t frames = input.size() / channels;
+    std::vector<double> out(input.begin(), input.end());
+    for (size_t c = 0; c < channels; ++c) {
+        for (size_t s = 0; s < sections; ++s) {
+            simd_lib::BiquadCoefficients k = design(c, s);
+            double s1 = 0.0, s2 = 0.0;
+            for (size_t t = 0; t < frames; ++t) {
+                double x = out[t * channels + c];
+                double y = k.b0 * x + s1;
+                s1 = k.b1 * x - k.a1 * y + s2;
+                s2 = k.b2 * x - k.a2 * y;
+                out[t * channels + c] = y;
+            }
+        }
+    }
+    return out;
+}
+
+static double max_error(const std::vector<float>& actual, const std::vector<double>& expected) {
+    double error = 0.0;
+    for (size_t i = 0; i < actual.size(); ++i) {
+        error = std::max(error, std::fabs(actual[i] - expected[i]));
+    }
+    return error;
+}
+
+// Both modes against the double reference, with the signal fed in uneven
+// pieces so state has to carry across calls and across partial blocks
+void test_biquad_modes() {
+    std::cout << "=== Modes ===\n";
+
+    std::mt19937 rng(5);
+    const size_t sections = 4;
+    const size_t pieces[] = {1, 7, 8, 300, 9, 675};
+    bool channels_ok = true, time_ok = true, auto_ok = true;
+
+    for (size_t channels : {1, 3, 8, 13, 64}) {
+        std::vector<float> input = random_vector(1000 * channels, rng);
+        std::vector<double> expected = reference(input, channels, sections);
+
+        for (simd_lib::BiquadMode mode : {simd_lib::BiquadMode::AcrossChannels, simd_lib::BiquadMode::AcrossTime}) {
+            simd_lib::BiquadCascade cascade(channels, sections, mode);
+            configure(cascade);
+            std::vector<float> output(input.size());
+            size_t t = 0;
+            for (size_t n : pieces) {
+                cascade.process(&input[t * channels], &output[t * channels], n);
+                t += n;
+            }
+            // The 40 Hz highpass has poles near z = 1, where float rounding grows to ~1e-4
+            bool ok = max_error(output, expected) < 5e-4;
+            (mode == simd_lib::BiquadMode::AcrossChannels ? channels_ok : time_ok) &= ok;
+        }
+
+        simd_lib::BiquadCascade automatic(channels, sections);
+        auto_ok &= automatic.mode() == (channels < 4 ? simd_lib::BiquadMode::AcrossTime
+                                                     : simd_lib::BiquadMode::AcrossChannels);
+    }
+
+    report("Across channels:", channels_ok);
+    report("Across time (block state space):", time_ok);
+    report("Auto mode selection:", auto_ok);
+    std::cout << "\n";
+}
+
+void test_biquad_layouts() {
+    std::cout << "=== Layouts and State ===\n";
+
+    std::mt19937 rng(6);
+    const size_t frames = 777;
+    bool planar_ok = true, in_place_ok = true, reset_ok = true, accessor_ok = true;
+
+    for (size_t channels : {2, 13}) {
+        for (simd_lib::BiquadMode mode : {simd_lib::BiquadMode::AcrossChannels, simd_lib::BiquadMode::AcrossTime}) {
+            std::vector<float> input = random_vector(frames * channels, rng);
+            simd_lib::BiquadCascade cascade(channels, 3, mode);
+            configure(cascade);
+
+            std::vector<float> interleaved(input.size());
+            cascade.process(input.data(), interleaved.data(), frames);
+
+            // Planar copy of the same signal through a fresh state
+            cascade.reset();
+            std::vector<std::vector<float>> planes(channels, std::vector<float>(frames));
+            std::vector<const float*> in_ptrs(channels);
+            std::vector<float*> out_ptrs(channels);
+            for (size_t c = 0; c < channels; ++c) {
+                for (size_t t = 0; t < frames; ++t) {
+                    planes[c][t] = input[t * channels + c];
+                }
+                in_ptrs[c] = planes[c].data();
+                out_ptrs[c] = planes[c].data();
+            }
+            cascade.process_planar(in_ptrs.data(), out_ptrs.data(), frames);
+            for (size_t c = 0; c < channels; ++c) {
+                for (size_t t = 0; t < frames; ++t) {
+                    planar_ok &= planes[c][t] == interleaved[t * channels + c];
+                }
+            }
+
+            cascade.reset();
+            std::vector<float> in_place = input;
+            cascade.process(in_place.data(), in_place.data(), frames);
+            in_place_ok &= in_place == interleaved;
+
+            // After reset the cascade repeats itself exactly
+            cascade.reset();
+            std::vector<float> again(input.size());
+            cascade.process(input.data(), again.data(), frames);
+            reset_ok &= again == interleaved;
+
+            simd_lib::BiquadCoefficients k = cascade.section(channels - 1, 1);
+            simd_lib::BiquadCoefficients expected = design(channels - 1, 1);
+            accessor_ok &= k.b0 == expected.b0 && k.b1 == expected.b1 && k.b2 == expected.b2 &&
+                           k.a1 == expected.a1 && k.a2 == expected.a2;
+        }
+    }
+
+    report("Planar matches interleaved:", planar_ok);
+    report("In place:", in_place_ok);
+    report("Reset:", reset_ok);
+    report("Section accessor:", accessor_ok);
+    std::cout << "\n";
+}
+
+// Packs the per-channel designs into the across-channel kernel layout
+static void pack_channels(size_t channels, size_t sections, std::vector<float>& coefficients,
+                          std::vector<float>& state) {
+    size_t groups = (channels + 7) / 8;
+    coefficients.assign(sections * groups * 40, 0.0f);
+    state.assign(sections * groups * 16, 0.0f);
+    for (size_t s = 0; s < sections; ++s) {
+        for (size_t c = 0; c < groups * 8; ++c) {
+            simd_lib::BiquadCoefficients k = c < channels ? design(c, s) : simd_lib::BiquadCoefficients();
+            float* dst = &coefficients[(s * groups + c / 8) * 40 + c % 8];
+            dst[0] = k.b0;
+            dst[8] = k.b1;
+            dst[16] = k.b2;
+            dst[24] = k.a1;
+            dst[32] = k.a2;
+        }
+    }
+}
+
+static void pack_time(size_t sections, std::vector<float>& coefficients, std::vector<float>& state) {
+    coefficients.resize(sections * 5);
+    state.assign(sections * 2, 0.0f);
+    for (size_t s = 0; s < sections; ++s) {
+        simd_lib::BiquadCoefficients k = design(0, s);
+        const float values[5] = {k.b0, k.b1, k.b2, k.a1, k.a2};
+        std::copy(values, values + 5, &coefficients[s * 5]);
+    }
+}
+
+void test_biquad_kernels() {
+    std::cout << "=== Kernels ===\n";
+
+    std::mt19937 rng(7);
+    bool channels_ok = true, time_ok = true;
+
+    // Group counts 1..9 cover every remainder of the four-group interleave
+    for (size_t groups = 1; groups <= 9; ++groups) {
+        const size_t channels = groups * 8, frames = 50, sections = 3;
+        std::vector<float> input = random_vector(frames * channels, rng);
+        std::vector<float> coefficients, state_a, state_b;
+        pack_channels(channels, sections, coefficients, state_a);
+        state_b = state_a;
+        std::vector<float> a = input, b = input;
+        simd_lib::biquad_channels_scalar(a.data(), frames, channels, groups, sections, coefficients.data(),
+                                         state_a.data());
+        simd_lib::biquad_channels_avx2(b.data(), frames, channels, groups, sections, coefficients.data(),
+                                       state_b.data());
+        for (size_t i = 0; i < a.size(); ++i) {
+            channels_ok &= std::fabs(a[i] - b[i]) <= 5e-4f;
+        }
+        for (size_t i = 0; i < state_a.size(); ++i) {
+            channels_ok &= std::fabs(state_a[i] - state_b[i]) <= 5e-4f;
+        }
+    }
+
+    // The scalar time kernel needs no block matrices
+    const size_t sections = 5;
+    std::vector<float> input = random_vector(1000, rng);
+    std::vector<double> expected = reference(input, 1, sections);
+    std::vector<float> coefficients, state;
+    pack_time(sections, coefficients, state);
+    std::vector<float> output = input;
+    simd_lib::biquad_time_scalar(output.data(), 400, sections, coefficients.data(), nullptr, state.data());
+    simd_lib::biquad_time_scalar(&output[400], 600, sections, coefficients.data(), nullptr, state.data());
+    time_ok = max_error(output, expected) < 5e-4;
+
+    report("Channel kernel scalar vs AVX2:", channels_ok);
+    report("Time kernel scalar:", time_ok);
+    std::cout << "\n";
+}
+
+// Steady-state amplitude of a sine after the cascade has settled
+static double sine_gain(simd_lib::BiquadCascade& cascade, double frequency, double rate) {
+    const size_t frames = 48000;
+    std::vector<float> signal(frames);
+    for (size_t t = 0; t < frames; ++t) {
+        signal[t] = (float)std::sin(2.0 * M_PI * frequency * (double)t / rate);
+    }
+    cascade.reset();
+    cascade.process(signal.data(), signal.data(), frames);
+    double peak = 0.0;
+    for (size_t t = frames / 2; t < frames; ++t) {
+        peak = std::max(peak, (double)std::fabs(signal[t]));
+    }
+    return peak;
+}
+
+void test_biquad_response() {
+    std::cout << "=== Frequency Response ===\n";
+
+    const double rate = 48000.0;
+    simd_lib::BiquadCascade lowpass(1, 2);
+    lowpass.set_section(0, simd_lib::biquad_lowpass(1000.0, rate));
+    lowpass.set_section(1, simd_lib::biquad_lowpass(1000.0, rate));
+    double pass = sine_gain(lowpass, 100.0, rate);
+    double cutoff = sine_gain(lowpass, 1000.0, rate);
+    double stop = sine_gain(lowpass, 12000.0, rate);
+
+    simd_lib::BiquadCascade highpass(1, 1);
+    highpass.set_section(0, simd_lib::biquad_highpass(1000.0, rate));
+    double high_pass = sine_gain(highpass, 10000.0, rate);
+    double high_stop = sine_gain(highpass, 50.0, rate);
+
+    simd_lib::BiquadCascade peaking(1, 1);
+    peaking.set_section(0, simd_lib::biquad_peaking(2000.0, rate, 1.0, 6.0));
+    double boost = sine_gain(peaking, 2000.0, rate);
+
+    report("Lowpass passband:", std::fabs(pass - 1.0) < 0.01);
+    report("Lowpass -6 dB at cutoff:", std::fabs(cutoff - 0.5) < 0.01);  // two -3 dB sections
+    report("Lowpass stopband:", stop < 0.01);
+    report("Highpass:", std::fabs(high_pass - 1.0) < 0.02 && high_stop < 0.01);
+    report("Peaking +6 dB at center:", std::fabs(boost - std::pow(10.0, 6.0 / 20.0)) < 0.01);
+    std::cout << "\n";
+}
+
+void benchmark_biquad() {
+    std::cout << "=== Performance ===\n";
+
+    std::mt19937 rng(1);
+    const int iterations = 50;
+    auto time_us = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+    auto print = [](const char* name, double samples, double scalar_time, double simd_time) {
+        std::cout << "  " << name << ":\n";
+        std::cout << "    Scalar: " << samples / scalar_time << " Msamples/s\n";
+        std::cout << "    AVX2:   " << samples / simd_time << " Msamples/s\n";
+        std::cout << "    Speedup: " << scalar_time / simd_time << "x\n";
+    };
+    std::cout << std::fixed << std::setprecision(2);
+
+    // 64-channel equalizer bank, 8 sections per channel
+    {
+        const size_t channels = 64, sections = 8, frames = 4096;
+        std::vector<float> input = random_vector(frames * channels, rng), output(input.size());
+        std::vector<float> coefficients, state;
+        pack_channels(channels, sections, coefficients, state);
+        simd_lib::BiquadCascade cascade(channels, sections, simd_lib::BiquadMode::AcrossChannels);
+        configure(cascade);
+        double scalar_time = time_us([&] {
+            std::copy(input.begin(), input.end(), output.begin());
+            for (size_t t = 0; t < frames; t += 128) {
+                simd_lib::biquad_channels_scalar(&output[t * channels], 128, channels, 8, sections,
+                                                 coefficients.data(), state.data());
+            }
+        });
+        double simd_time = time_us([&] { cascade.process(input.data(), output.data(), frames); });
+        print("64 channels x 8 sections, across channels", (double)(frames * channels), scalar_time, simd_time);
+    }
+
+    // One long channel through the block state-space kernel
+    {
+        const size_t sections = 8, frames = 1 << 16;
+        std::vector<float> input = random_vector(frames, rng), output(frames);
+        std::vector<float> coefficients, state;
+        pack_time(sections, coefficients, state);
+        simd_lib::BiquadCascade cascade(1, sections, simd_lib::BiquadMode::AcrossTime);
+        configure(cascade);
+        double scalar_time = time_us([&] {
+            std::copy(input.begin(), input.end(), output.begin());
+            simd_lib::biquad_time_scalar(output.data(), frames, sections, coefficients.data(), nullptr,
+                                         state.data());
+        });
+        double simd_time = time_us([&] { cascade.process(input.data(), output.data(), frames); });
+        print("1 channel x 8 sections, across time", (double)frames, scalar_time, simd_time);
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Biquad Cascade Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_biquad_modes();
+    test_biquad_layouts();
+    test_biquad_kernels();
+    test_biquad_response();
+    benchmark_biquad();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,347 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static std::vector<float> random_vector(size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+    std::vector<float> v(count);
+    for (float& x : v) {
+        x = dist(rng);
+    }
+    return v;
+}
+
+static bool close(float actual, double expected, double tolerance = 1e-6) {
+    return std::fabs(actual - expected) <= tolerance * (1.0 + std::fabs(expected));
+}
+
+// Distance in representable floats between a result and the correctly
+// rounded double reference
+static int64_t ulp_distance(float actual, double expected) {
+    float rounded = (float)expected;
+    int32_t a, b;
+    std::memcpy(&a, &actual, sizeof(a));
+    std::memcpy(&b, &rounded, sizeof(b));
+    if ((a < 0) != (b < 0)) {
+        return actual == rounded ? 0 : std::numeric_limits<int64_t>::max();
+    }
+    return std::llabs((int64_t)a - (int64_t)b);
+}
+
+// Every split kernel against a double reference, for each implementation;
+// counts cover the 8-wide body, the tail and both together
+void test_complex_split() {
+    std::cout << "=== Split Layout ===\n";
+
+    std::mt19937 rng(3);
+    bool multiply_ok = true, conj_ok = true, magnitude_ok = true, squared_ok = true, accumulate_ok = true;
+    bool in_place_ok = true;
+    const float sr = 0.75f, si = -1.25f;
+
+    for (size_t count : {0, 1, 7, 8, 9, 31, 100, 1001}) {
+        std::vector<float> ar = random_vector(count, rng), ai = random_vector(count, rng);
+        std::vector<float> br = random_vector(count, rng), bi = random_vector(count, rng);
+
+        const float *a_re = ar.data(), *a_im = ai.data(), *b_re = br.data(), *b_im = bi.data();
+        for (int k = 0; k < 3; ++k) {
+            std::vector<float> re(count), im(count), mag(count), sq(count);
+            std::vector<float> acc_re = br, acc_im = bi;
+            if (k == 0) {
+                simd_lib::complex_multiply_scalar(a_re, a_im, b_re, b_im, re.data(), im.data(), count);
+            } else if (k == 1) {
+                simd_lib::complex_multiply_avx2(a_re, a_im, b_re, b_im, re.data(), im.data(), count);
+            } else {
+                simd_lib::complex_multiply(a_re, a_im, b_re, b_im, re.data(), im.data(), count);
+            }
+            for (size_t i = 0; i < count; ++i) {
+                multiply_ok = multiply_ok && close(re[i], (double)ar[i] * br[i] - (double)ai[i] * bi[i]) &&
+                              close(im[i], (double)ar[i] * bi[i] + (double)ai[i] * br[i]);
+            }
+
+            if (k == 0) {
+                simd_lib::complex_multiply_conj_scalar(a_re, a_im, b_re, b_im, re.data(), im.data(), count);
+                simd_lib::complex_magnitude_scalar(a_re, a_im, mag.data(), count);
+                simd_lib::complex_magnitude_squared_scalar(a_re, a_im, sq.data(), count);
+                simd_lib::complex_scale_accumulate_scalar(a_re, a_im, sr, si, acc_re.data(), acc_im.data(), count);
+            } else if (k == 1) {
+                simd_lib::complex_multiply_conj_avx2(a_re, a_im, b_re, b_im, re.data(), im.data(), count);
+                simd_lib::complex_magnitude_avx2(a_re, a_im, mag.data(), count);
+                simd_lib::complex_magnitude_squared_avx2(a_re, a_im, sq.data(), count);
+                simd_lib::complex_scale_accumulate_avx2(a_re, a_im, sr, si, acc_re.data(), acc_im.data(), count);
+            } else {
+                simd_lib::complex_multiply_conj(a_re, a_im, b_re, b_im, re.data(), im.data(), count);
+                simd_lib::complex_magnitude(a_re, a_im, mag.data(), count);
+                simd_lib::complex_magnitude_squared(a_re, a_im, sq.data(), count);
+                simd_lib::complex_scale_accumulate(a_re, a_im, sr, si, acc_re.data(), acc_im.data(), count);
+            }
+            for (size_t i = 0; i < count; ++i) {
+                double norm = (double)ar[i] * ar[i] + (double)ai[i] * ai[i];
+                conj_ok = conj_ok && close(re[i], (double)ar[i] * br[i] + (double)ai[i] * bi[i]) &&
+                          close(im[i], (double)ai[i] * br[i] - (double)ar[i] * bi[i]);
+                magnitude_ok = magnitude_ok && close(mag[i], std::sqrt(norm));
+                squared_ok = squared_ok && close(sq[i], norm);
+                accumulate_ok = accumulate_ok && close(acc_re[i], br[i] + sr * (double)ar[i] - si * (double)ai[i]) &&
+                                close(acc_im[i], bi[i] + sr * (double)ai[i] + si * (double)ar[i]);
+            }
+        }
+
+        // out aliasing a
+        std::vector<float> re(count), im(count), xr = ar, xi = ai;
+        simd_lib::complex_multiply(ar.data(), ai.data(), br.data(), bi.data(), re.data(), im.data(), count);
+        simd_lib::complex_multiply(xr.data(), xi.data(), br.data(), bi.data(), xr.data(), xi.data(), count);
+        in_place_ok = in_place_ok && xr == re && xi == im;
+    }
+    report("complex_multiply", multiply_ok);
+    report("complex_multiply_conj", conj_ok);
+    report("complex_magnitude", magnitude_ok);
+    report("complex_magnitude_squared", squared_ok);
+    report("complex_scale_accumulate", accumulate_ok);
+    report("in place", in_place_ok);
+    std::cout << "\n";
+}
+
+// The interleaved kernels must agree with the split ones on the same values
+void test_complex_interleaved() {
+    std::cout << "=== Interleaved Layout ===\n";
+
+    std::mt19937 rng(5);
+    bool multiply_ok = true, conj_ok = true, magnitude_ok = true, squared_ok = true, phase_ok = true;
+    bool accumulate_ok = true, in_place_ok = true;
+    const float sr = -0.5f, si = 2.0f;
+
+    for (size_t count : {0, 1, 3, 4, 7, 8, 9, 31, 100, 1001}) {
+        std::vector<float> a = random_vector(2 * count, rng), b = random_vector(2 * count, rng);
+        std::vector<float> ar(count), ai(count), br(count), bi(count);
+        simd_lib::deinterleave2_scalar(a.data(), ar.data(), ai.data(), count);
+        simd_lib::deinterleave2_scalar(b.data(), br.data(), bi.data(), count);
+
+        std::vector<float> re(count), im(count), expected(2 * count), out(2 * count);
+        std::vector<float> mag(count), mag_i(count), phase(count), phase_i(count);
+
+        simd_lib::complex_multiply(ar.data(), ai.data(), br.data(), bi.data(), re.data(), im.data(), count);
+        simd_lib::interleave2_scalar(re.data(), im.data(), expected.data(), count);
+        for (int k = 0; k < 2; ++k) {
+            if (k == 0) {
+                simd_lib::complex_multiply_interleaved_scalar(a.data(), b.data(), out.data(), count);
+            } else {
+                simd_lib::complex_multiply_interleaved(a.data(), b.data(), out.data(), count);
+            }
+            for (size_t i = 0; i < 2 * count; ++i) {
+                multiply_ok = multiply_ok && close(out[i], expected[i]);
+            }
+        }
+
+        simd_lib::complex_multiply_conj(ar.data(), ai.data(), br.data(), bi.data(), re.data(), im.data(), count);
+        simd_lib::interleave2_scalar(re.data(), im.data(), expected.data(), count);
+        simd_lib::complex_multiply_conj_interleaved(a.data(), b.data(), out.data(), count);
+        for (size_t i = 0; i < 2 * count; ++i) {
+            conj_ok = conj_ok && close(out[i], expected[i]);
+        }
+
+        simd_lib::complex_magnitude(ar.data(), ai.data(), mag.data(), count);
+        simd_lib::complex_magnitude_interleaved(a.data(), mag_i.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            magnitude_ok = magnitude_ok && close(mag_i[i], mag[i]);
+        }
+        simd_lib::complex_magnitude_squared(ar.data(), ai.data(), mag.data(), count);
+        simd_lib::complex_magnitude_squared_interleaved(a.data(), mag_i.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            squared_ok = squared_ok && close(mag_i[i], mag[i]);
+        }
+
+        // Same polynomial on both layouts, so bit-identical
+        simd_lib::complex_phase(ar.data(), ai.data(), phase.data(), count);
+        simd_lib::complex_phase_interleaved(a.data(), phase_i.data(), count);
+        phase_ok = phase_ok && phase == phase_i;
+
+        std::vector<float> acc_re = br, acc_im = bi, acc = b;
+        simd_lib::complex_scale_accumulate(ar.data(), ai.data(), sr, si, acc_re.data(), acc_im.data(), count);
+        simd_lib::complex_scale_accumulate_interleaved(a.data(), sr, si, acc.data(), count);
+        simd_lib::interleave2_scalar(acc_re.data(), acc_im.data(), expected.data(), count);
+        for (size_t i = 0; i < 2 * count; ++i) {
+            accumulate_ok = accumulate_ok && close(acc[i], expected[i]);
+        }
+
+        // Magnitudes written over their own input
+        std::vector<float> work = a;
+        simd_lib::complex_magnitude_interleaved(a.data(), mag_i.data(), count);
+        simd_lib::complex_magnitude_interleaved(work.data(), work.data(), count);
+        in_place_ok = in_place_ok && std::equal(mag_i.begin(), mag_i.end(), work.begin());
+    }
+    report("complex_multiply_interleaved", multiply_ok);
+    report("multiply_conj_interleaved", conj_ok);
+    report("magnitude_interleaved", magnitude_ok);
+    report("magnitude_squared_interleaved", squared_ok);
+    report("phase matches split layout", phase_ok);
+    report("scale_accumulate_interleaved", accumulate_ok);
+    report("in place", in_place_ok);
+    std::cout << "\n";
+}
+
+void test_complex_phase() {
+    std::cout << "=== Phase (atan2) ===\n";
+
+    // A polar grid over all quadrants and magnitudes, plus the axes
+    std::vector<float> re, im;
+    for (int m = -20; m <= 20; m += 4) {
+        double radius = std::ldexp(1.0, m);
+        for (int k = 0; k < 20000; ++k) {
+            double angle = -M_PI + 2.0 * M_PI * (k + 0.5) / 20000;
+            re.push_back((float)(radius * std::cos(angle)));
+            im.push_back((float)(radius * std::sin(angle)));
+        }
+    }
+    for (float v : {1.0f, -1.0f, 3.5e-8f, 1e20f}) {
+        re.push_back(v);
+        im.push_back(0.0f);
+        re.push_back(0.0f);
+        im.push_back(v);
+    }
+
+    std::vector<float> phase(re.size());
+    simd_lib::complex_phase_avx2(re.data(), im.data(), phase.data(), re.size());
+    int64_t max_ulp = 0;
+    bool within = true;
+    for (size_t i = 0; i < re.size(); ++i) {
+        double expected = std::atan2((double)im[i], (double)re[i]);
+        max_ulp = std::max(max_ulp, ulp_distance(phase[i], expected));
+        within = within && (ulp_distance(phase[i], expected) <= 2 || std::fabs(phase[i] - expected) <= 0x1p-24);
+    }
+    std::cout << "  Max error: " << max_ulp << " ulp\n";
+    report("within 2 ulp + 2^-24", within);
+
+    // Signed zeros and NaN, as std::atan2
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float special_re[] = {0.0f, -0.0f, 0.0f, -0.0f, -1.0f, -1.0f, nan, 1.0f};
+    const float special_im[] = {0.0f, 0.0f, -0.0f, -0.0f, 0.0f, -0.0f, 1.0f, nan};
+    float special[8];
+    simd_lib::complex_phase_avx2(special_re, special_im, special, 8);
+    bool specials_ok = true;
+    for (int i = 0; i < 8; ++i) {
+        float expected = std::atan2(special_im[i], special_re[i]);
+        specials_ok = specials_ok && (std::isnan(expected) ? std::isnan(special[i])
+                                                           : special[i] == expected &&
+                                                                 std::signbit(special[i]) == std::signbit(expected));
+    }
+    report("signed zeros and NaN", specials_ok);
+    std::cout << "\n";
+}
+
+// The building blocks in use: circular convolution through the spectrum, and
+// the lag of a shifted signal from the cross-correlation peak
+void test_frequency_domain() {
+    std::cout << "=== Frequency-Domain Filtering ===\n";
+
+    const size_t n = 256;
+    std::mt19937 rng(11);
+    std::vector<float> x = random_vector(n, rng), h(n, 0.0f);
+    for (size_t i = 0; i < 9; ++i) {
+        h[i] = 1.0f / (1.0f + i);
+    }
+
+    std::vector<float> xr = x, xi(n, 0.0f), hr = h, hi(n, 0.0f);
+    simd_lib::fft_forward(xr.data(), xi.data(), n);
+    simd_lib::fft_forward(hr.data(), hi.data(), n);
+    simd_lib::complex_multiply(xr.data(), xi.data(), hr.data(), hi.data(), xr.data(), xi.data(), n);
+    simd_lib::fft_inverse(xr.data(), xi.data(), n);
+
+    bool convolution_ok = true;
+    for (size_t i = 0; i < n; ++i) {
+        double expected = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            expected += (double)x[j] * h[(i + n - j) % n];
+        }
+        convolution_ok = convolution_ok && std::fabs(xr[i] - expected) < 1e-4;
+    }
+    report("circular convolution", convolution_ok);
+
+    const size_t lag = 37;
+    std::vector<float> ar(n), ai(n, 0.0f), br(n), bi(n, 0.0f);
+    for (size_t i = 0; i < n; ++i) {
+        ar[i] = x[(i + n - lag) % n];
+        br[i] = x[i];
+    }
+    simd_lib::fft_forward(ar.data(), ai.data(), n);
+    simd_lib::fft_forward(br.data(), bi.data(), n);
+    simd_lib::complex_multiply_conj(ar.data(), ai.data(), br.data(), bi.data(), ar.data(), ai.data(), n);
+    simd_lib::fft_inverse(ar.data(), ai.data(), n);
+    report("cross-correlation peak at lag", simd_lib::argmax(ar.data(), n) == lag);
+    std::cout << "\n";
+}
+
+void benchmark_complex() {
+    std::cout << "=== Performance ===\n";
+
+    // A spectrum that stays in L2, as after a mid-size FFT
+    const size_t count = 1 << 14;
+    const int iterations = 2000;
+    std::mt19937 rng(1);
+    std::vector<float> ar = random_vector(count, rng), ai = random_vector(count, rng);
+    std::vector<float> br = random_vector(count, rng), bi = random_vector(count, rng);
+    std::vector<float> re(count), im(count), a = random_vector(2 * count, rng), b = random_vector(2 * count, rng);
+    std::vector<float> out(2 * count);
+
+    auto time_us = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+    auto print = [](const char* name, double scalar_time, double simd_time) {
+        std::cout << "  " << name << ":\n";
+        std::cout << "    Scalar: " << scalar_time << " us\n";
+        std::cout << "    AVX2:   " << simd_time << " us\n";
+        std::cout << "    Speedup: " << scalar_time / simd_time << "x\n";
+    };
+    std::cout << std::fixed << std::setprecision(2);
+
+    const float *a_re = ar.data(), *a_im = ai.data(), *b_re = br.data(), *b_im = bi.data();
+    print("complex_multiply, 16K split",
+          time_us([&] { simd_lib::complex_multiply_scalar(a_re, a_im, b_re, b_im, re.data(), im.data(), count); }),
+          time_us([&] { simd_lib::complex_multiply(a_re, a_im, b_re, b_im, re.data(), im.data(), count); }));
+    print("complex_multiply, 16K interleaved",
+          time_us([&] { simd_lib::complex_multiply_interleaved_scalar(a.data(), b.data(), out.data(), count); }),
+          time_us([&] { simd_lib::complex_multiply_interleaved(a.data(), b.data(), out.data(), count); }));
+    print("complex_magnitude, 16K interleaved",
+          time_us([&] { simd_lib::complex_magnitude_interleaved_scalar(a.data(), re.data(), count); }),
+          time_us([&] { simd_lib::complex_magnitude_interleaved(a.data(), re.data(), count); }));
+    print("complex_phase, 16K split",
+          time_us([&] { simd_lib::complex_phase_scalar(ar.data(), ai.data(), re.data(), count); }),
+          time_us([&] { simd_lib::complex_phase(ar.data(), ai.data(), re.data(), count); }));
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Complex Arithmetic Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_complex_split();
+    test_complex_interleaved();
+    test_complex_phase();
+    test_frequency_domain();
+    benchmark_complex();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
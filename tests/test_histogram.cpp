@@ -0,0 +1,216 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+// Uniform values over a range a little wider than [lo, hi], plus the edges,
+// infinities and NaN
+static std::vector<float> make_data(size_t count, float lo, float hi, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(lo - 0.1f * (hi - lo), hi + 0.1f * (hi - lo));
+    std::vector<float> data(count);
+    for (float& v : data) {
+        v = dist(rng);
+    }
+    const float specials[] = {lo, hi, std::nextafter(hi, lo), std::nextafter(lo, hi), std::nextafter(hi, 2 * hi),
+                              std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                              std::numeric_limits<float>::quiet_NaN()};
+    for (size_t i = 0; i < 8 && i < count; ++i) {
+        data[(i * 7919) % count] = specials[i];
+    }
+    return data;
+}
+
+void test_histogram_1d() {
+    std::cout << "=== Histogram ===\n";
+
+    std::mt19937 rng(1);
+    bool dispatch_ok = true, avx2_ok = true, total_ok = true;
+    for (size_t count : {0, 1, 7, 8, 15, 16, 17, 100, 1000, 65537}) {
+        for (size_t bins : {1, 7, 256, 70000}) {
+            std::vector<float> data = make_data(count, -2.0f, 3.0f, rng);
+            std::vector<uint64_t> expected(bins, 0), a(bins, 7), b(bins, 0);
+            simd_lib::histogram_scalar(data.data(), count, -2.0f, 3.0f, bins, expected.data());
+            simd_lib::histogram(data.data(), count, -2.0f, 3.0f, bins, a.data());
+            dispatch_ok &= a == expected;
+            if (simd_lib::get_cpu_features().has_avx2) {
+                simd_lib::histogram_avx2(data.data(), count, -2.0f, 3.0f, bins, b.data());
+                avx2_ok &= b == expected;
+            }
+            size_t in_range = 0;
+            for (float v : data) {
+                in_range += v >= -2.0f && v <= 3.0f;
+            }
+            total_ok &= std::accumulate(a.begin(), a.end(), (uint64_t)0) == in_range;
+        }
+    }
+
+    // Every value in one bin: the worst case for store-to-load forwarding
+    std::vector<float> same(100003, 0.5f);
+    std::vector<uint64_t> same_counts(16);
+    simd_lib::histogram(same.data(), same.size(), 0.0f, 1.0f, 16, same_counts.data());
+    bool same_ok = same_counts[8] == same.size();
+
+    // The top edge belongs to the last bin; values just past it are dropped
+    float edges[] = {0.0f, 1.0f, 0.25f, std::nextafter(1.0f, 2.0f), std::nextafter(0.0f, -1.0f)};
+    uint64_t edge_counts[4];
+    simd_lib::histogram(edges, 5, 0.0f, 1.0f, 4, edge_counts);
+    bool edges_ok = edge_counts[0] == 1 && edge_counts[1] == 1 && edge_counts[2] == 0 && edge_counts[3] == 1;
+
+    report("Dispatch matches scalar:", dispatch_ok);
+    report("AVX2 kernel matches scalar:", avx2_ok);
+    report("Counts only in-range values:", total_ok);
+    report("Repeated bin:", same_ok);
+    report("Range edges:", edges_ok);
+    std::cout << "\n";
+}
+
+void test_histogram_2d() {
+    std::cout << "=== 2D Histogram ===\n";
+
+    std::mt19937 rng(2);
+    bool dispatch_ok = true, avx2_ok = true;
+    for (size_t count : {0, 5, 8, 33, 1000, 50001}) {
+        for (size_t x_bins : {1, 10, 64}) {
+            for (size_t y_bins : {1, 3, 64}) {
+                std::vector<float> x = make_data(count, 0.0f, 1.0f, rng);
+                std::vector<float> y = make_data(count, -5.0f, 5.0f, rng);
+                size_t bins = x_bins * y_bins;
+                std::vector<uint64_t> expected(bins, 0), a(bins, 3), b(bins, 0);
+                simd_lib::histogram2d_scalar(x.data(), y.data(), count, 0.0f, 1.0f, x_bins, -5.0f, 5.0f, y_bins,
+                                             expected.data());
+                simd_lib::histogram2d(x.data(), y.data(), count, 0.0f, 1.0f, x_bins, -5.0f, 5.0f, y_bins, a.data());
+                dispatch_ok &= a == expected;
+                if (simd_lib::get_cpu_features().has_avx2) {
+                    simd_lib::histogram2d_avx2(x.data(), y.data(), count, 0.0f, 1.0f, x_bins, -5.0f, 5.0f, y_bins,
+                                               b.data());
+                    avx2_ok &= b == expected;
+                }
+            }
+        }
+    }
+
+    // Marginals: summing over y gives the 1D histogram of x when every y is in range
+    std::vector<float> x = make_data(10000, 0.0f, 1.0f, rng);
+    std::vector<float> y(x.size(), 0.0f);
+    std::vector<uint64_t> joint(8 * 4), marginal(8);
+    simd_lib::histogram2d(x.data(), y.data(), x.size(), 0.0f, 1.0f, 8, -1.0f, 1.0f, 4, joint.data());
+    simd_lib::histogram(x.data(), x.size(), 0.0f, 1.0f, 8, marginal.data());
+    bool marginal_ok = true;
+    for (size_t i = 0; i < 8; ++i) {
+        marginal_ok &= joint[i * 4 + 2] == marginal[i] && joint[i * 4] + joint[i * 4 + 1] + joint[i * 4 + 3] == 0;
+    }
+
+    report("Dispatch matches scalar:", dispatch_ok);
+    report("AVX2 kernel matches scalar:", avx2_ok);
+    report("Marginal matches 1D histogram:", marginal_ok);
+    std::cout << "\n";
+}
+
+void test_histogram_threads() {
+    std::cout << "=== Threaded Merge ===\n";
+
+    std::mt19937 rng(3);
+    std::vector<float> data = make_data(300001, 0.0f, 10.0f, rng);
+    std::vector<float> y = make_data(data.size(), 0.0f, 10.0f, rng);
+    std::vector<uint64_t> one(100), many(100), one_2d(100), many_2d(100);
+    simd_lib::histogram(data.data(), data.size(), 0.0f, 10.0f, 100, one.data());
+    simd_lib::histogram2d(data.data(), y.data(), data.size(), 0.0f, 10.0f, 10, 0.0f, 10.0f, 10, one_2d.data());
+
+    // Lower the per-thread minimum so the input is really split
+    simd_lib::TuningConfig saved = simd_lib::get_tuning();
+    simd_lib::TuningConfig split = saved;
+    split.reduce_min_block = 10000;
+    simd_lib::set_tuning(split);
+    simd_lib::histogram(data.data(), data.size(), 0.0f, 10.0f, 100, many.data(), 4);
+    simd_lib::histogram2d(data.data(), y.data(), data.size(), 0.0f, 10.0f, 10, 0.0f, 10.0f, 10, many_2d.data(), 3);
+    simd_lib::set_tuning(saved);
+
+    report("Threads match one thread:", one == many);
+    report("2D threads match one thread:", one_2d == many_2d);
+    std::cout << "\n";
+}
+
+void benchmark_histogram() {
+    std::cout << "=== Performance ===\n";
+
+    const size_t count = 1 << 22;
+    const int iterations = 20;
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> uniform(count), constant(count, 0.3f), y(count);
+    for (size_t i = 0; i < count; ++i) {
+        uniform[i] = dist(rng);
+        y[i] = dist(rng);
+    }
+    std::vector<uint64_t> counts(64 * 64);
+
+    auto time_us = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+    auto print = [&](const char* name, double scalar_time, double simd_time) {
+        std::cout << "  " << name << ":\n";
+        std::cout << "    Scalar: " << scalar_time << " us (" << count / scalar_time << " M/s)\n";
+        std::cout << "    AVX2:   " << simd_time << " us (" << count / simd_time << " M/s)\n";
+        std::cout << "    Speedup: " << scalar_time / simd_time << "x\n";
+    };
+    std::cout << std::fixed << std::setprecision(2);
+
+    // The scalar kernel adds to counts, so clear them as the dispatcher does
+    print("4M uniform, 256 bins", time_us([&] {
+              std::fill(counts.begin(), counts.end(), 0);
+              simd_lib::histogram_scalar(uniform.data(), count, 0.0f, 1.0f, 256, counts.data());
+          }),
+          time_us([&] { simd_lib::histogram(uniform.data(), count, 0.0f, 1.0f, 256, counts.data()); }));
+    print("4M equal values, 256 bins", time_us([&] {
+              std::fill(counts.begin(), counts.end(), 0);
+              simd_lib::histogram_scalar(constant.data(), count, 0.0f, 1.0f, 256, counts.data());
+          }),
+          time_us([&] { simd_lib::histogram(constant.data(), count, 0.0f, 1.0f, 256, counts.data()); }));
+    print("4M pairs, 64 x 64 bins", time_us([&] {
+              std::fill(counts.begin(), counts.end(), 0);
+              simd_lib::histogram2d_scalar(uniform.data(), y.data(), count, 0.0f, 1.0f, 64, 0.0f, 1.0f, 64,
+                                           counts.data());
+          }),
+          time_us([&] {
+              simd_lib::histogram2d(uniform.data(), y.data(), count, 0.0f, 1.0f, 64, 0.0f, 1.0f, 64, counts.data());
+          }));
+    double threaded = time_us([&] { simd_lib::histogram(uniform.data(), count, 0.0f, 1.0f, 256, counts.data(), 0); });
+    std::cout << "  4M uniform, 256 bins, all cores: " << threaded << " us\n";
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Histogram Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_histogram_1d();
+    test_histogram_2d();
+    test_histogram_threads();
+    benchmark_histogram();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static std::vector<float> iota_vector(size_t count) {
+    std::vector<float> v(count);
+    for (size_t i = 0; i < count; ++i) {
+        v[i] = (float)i;
+    }
+    return v;
+}
+
+// Round trip through planar form for every record width and kernel set;
+// counts cover the 8-wide body, the scalar tail and both together
+void test_layout() {
+    std::cout << "=== Layout Conversion ===\n";
+
+    bool deinterleave_ok = true, interleave_ok = true, kernels_agree = true;
+    for (size_t count : {0, 1, 7, 8, 9, 31, 64, 1001}) {
+        for (size_t width = 2; width <= 4; ++width) {
+            std::vector<float> src = iota_vector(count * width);
+            std::vector<std::vector<float>> planes(4, std::vector<float>(count, -1.0f));
+            std::vector<std::vector<float>> scalar_planes = planes;
+            std::vector<float> back(count * width, -1.0f), scalar_back(count * width, -1.0f);
+            float* p[4] = {planes[0].data(), planes[1].data(), planes[2].data(), planes[3].data()};
+            float* s[4] = {scalar_planes[0].data(), scalar_planes[1].data(), scalar_planes[2].data(),
+                           scalar_planes[3].data()};
+
+            if (width == 2) {
+                simd_lib::deinterleave2(src.data(), p[0], p[1], count);
+                simd_lib::deinterleave2_scalar(src.data(), s[0], s[1], count);
+                simd_lib::interleave2(p[0], p[1], back.data(), count);
+                simd_lib::interleave2_scalar(s[0], s[1], scalar_back.data(), count);
+            } else if (width == 3) {
+                simd_lib::deinterleave3(src.data(), p[0], p[1], p[2], count);
+                simd_lib::deinterleave3_scalar(src.data(), s[0], s[1], s[2], count);
+                simd_lib::interleave3(p[0], p[1], p[2], back.data(), count);
+                simd_lib::interleave3_scalar(s[0], s[1], s[2], scalar_back.data(), count);
+            } else {
+                simd_lib::deinterleave4(src.data(), p[0], p[1], p[2], p[3], count);
+                simd_lib::deinterleave4_scalar(src.data(), s[0], s[1], s[2], s[3], count);
+                simd_lib::interleave4(p[0], p[1], p[2], p[3], back.data(), count);
+                simd_lib::interleave4_scalar(s[0], s[1], s[2], s[3], scalar_back.data(), count);
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                for (size_t k = 0; k < width; ++k) {
+                    deinterleave_ok = deinterleave_ok && planes[k][i] == src[i * width + k];
+                }
+            }
+            interleave_ok = interleave_ok && back == src;
+            kernels_agree = kernels_agree && planes == scalar_planes && scalar_back == src;
+        }
+    }
+    report("deinterleave2/3/4", deinterleave_ok);
+    report("interleave2/3/4", interleave_ok);
+    report("scalar kernels agree", kernels_agree);
+    std::cout << "\n";
+}
+
+void test_fft_interleaved() {
+    std::cout << "=== Interleaved FFT ===\n";
+
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    bool matches = true, round_trip = true;
+    for (size_t n = 1; n <= 4096; n *= 2) {
+        std::vector<float> data(2 * n);
+        for (float& x : data) {
+            x = dist(rng);
+        }
+        std::vector<float> real(n), imag(n);
+        simd_lib::deinterleave2_scalar(data.data(), real.data(), imag.data(), n);
+        simd_lib::fft_forward(real.data(), imag.data(), n);
+
+        std::vector<float> work = data;
+        simd_lib::fft_forward_interleaved(work.data(), n);
+        for (size_t k = 0; k < n; ++k) {
+            float tolerance = 1e-5f * (1.0f + std::fabs(real[k]) + std::fabs(imag[k]));
+            matches = matches && std::fabs(work[2 * k] - real[k]) <= tolerance &&
+                      std::fabs(work[2 * k + 1] - imag[k]) <= tolerance;
+        }
+
+        simd_lib::fft_inverse_interleaved(work.data(), n);
+        for (size_t i = 0; i < 2 * n; ++i) {
+            round_trip = round_trip && std::fabs(work[i] - data[i]) < 1e-5f;
+        }
+    }
+    report("matches planar FFT, n = 1..4096", matches);
+    report("inverse round trip", round_trip);
+
+    std::vector<float> odd(24, 1.0f);
+    simd_lib::fft_forward_interleaved(odd.data(), 12);
+    report("non-power-of-2 unchanged", odd[0] == 1.0f && odd[1] == 1.0f);
+    std::cout << "\n";
+}
+
+void benchmark_layout() {
+    std::cout << "=== Performance ===\n";
+
+    // Cache-resident, so the shuffles rather than memory set the pace
+    const size_t count = 1 << 14;
+    const int iterations = 2000;
+    std::vector<float> src = iota_vector(count * 3), x(count), y(count), z(count);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        simd_lib::deinterleave3_scalar(src.data(), x.data(), y.data(), z.data(), count);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double scalar_time = std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        simd_lib::deinterleave3(src.data(), x.data(), y.data(), z.data(), count);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double simd_time = std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  deinterleave3, 16K xyz points:\n";
+    std::cout << "    Scalar: " << scalar_time << " us\n";
+    std::cout << "    AVX2:   " << simd_time << " us\n";
+    std::cout << std::setprecision(2) << "    Speedup: " << scalar_time / simd_time << "x\n";
+
+    // Interleaved FFT: separate conversion passes around the planar FFT, as
+    // callers did before, against the fused entry point
+    const size_t n = 1024;
+    const int frames = 2000;
+    std::vector<float> data(2 * n), real(n), imag(n);
+    for (size_t i = 0; i < 2 * n; ++i) {
+        data[i] = (float)(i % 17) * 0.1f;
+    }
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        for (size_t i = 0; i < n; ++i) {
+            real[i] = data[2 * i];
+            imag[i] = data[2 * i + 1];
+        }
+        simd_lib::fft_forward(real.data(), imag.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            data[2 * i] = real[i] * (1.0f / n);
+            data[2 * i + 1] = imag[i] * (1.0f / n);
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double separate = std::chrono::duration<double, std::micro>(end - start).count() / frames;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        simd_lib::fft_forward_interleaved(data.data(), n);
+        simd_lib::vector_scale(data.data(), 1.0f / n, data.data(), 2 * n);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double fused = std::chrono::duration<double, std::micro>(end - start).count() / frames;
+
+    std::cout << "  1024-point complex-interleaved FFT:\n";
+    std::cout << "    Scalar conversion passes: " << separate << " us\n";
+    std::cout << "    fft_forward_interleaved:  " << fused << " us\n";
+    std::cout << "    Speedup: " << separate / fused << "x\n";
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Layout Conversion Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_layout();
+    test_fft_interleaved();
+    benchmark_layout();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
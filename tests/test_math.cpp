@@ -0,0 +1,205 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <cmath>
+#include <limits>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+// Error of value in units of the last place of the correctly rounded reference
+static double ulp_error(float value, double reference) {
+    float rounded = (float)reference;
+    if (value == rounded) {
+        return 0.0;
+    }
+    float magnitude = std::fabs(rounded);
+    double ulp = (double)std::nextafter(magnitude, std::numeric_limits<float>::infinity()) - magnitude;
+    if (magnitude < std::numeric_limits<float>::min()) {
+        ulp = std::numeric_limits<float>::denorm_min();
+    }
+    return std::fabs((double)value - reference) / ulp;
+}
+
+struct MathCase {
+    const char* name;
+    void (*simd)(const float*, float*, size_t);
+    double (*reference)(double);
+    float lo, hi;
+    double max_ulp;
+};
+
+static double ref_exp(double x) { return std::exp(x); }
+static double ref_log(double x) { return std::log(x); }
+static double ref_tanh(double x) { return std::tanh(x); }
+static double ref_sigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+static double ref_rsqrt(double x) { return 1.0 / std::sqrt(x); }
+
+void test_ulp_bounds() {
+    std::cout << "=== ULP Error Bounds ===\n";
+
+    const size_t count = 1 << 20;
+    std::mt19937 gen(17);
+
+    MathCase cases[] = {
+        {"exp  [-87, 88]", simd_lib::vector_exp, ref_exp, -87.0f, 88.0f, 1.5},
+        {"log  [1e-30, 1e30]", simd_lib::vector_log, ref_log, 1e-30f, 1e30f, 1.0},
+        {"log  [0.5, 2]", simd_lib::vector_log, ref_log, 0.5f, 2.0f, 1.0},
+        {"tanh [-10, 10]", simd_lib::vector_tanh, ref_tanh, -10.0f, 10.0f, 1.5},
+        {"sigmoid [-80, 80]", simd_lib::vector_sigmoid, ref_sigmoid, -80.0f, 80.0f, 3.5},
+        {"rsqrt [1e-30, 1e30]", simd_lib::vector_rsqrt, ref_rsqrt, 1e-30f, 1e30f, 3.5},
+    };
+
+    std::vector<float> x(count), y(count);
+    for (const auto& c : cases) {
+        // Sample log-uniformly for wide positive ranges, uniformly otherwise
+        bool logarithmic = c.lo > 0.0f && c.hi / c.lo > 1e6f;
+        std::uniform_real_distribution<double> dis(logarithmic ? std::log(c.lo) : c.lo,
+                                                   logarithmic ? std::log(c.hi) : c.hi);
+        for (auto& v : x) {
+            v = (float)(logarithmic ? std::exp(dis(gen)) : dis(gen));
+        }
+        c.simd(x.data(), y.data(), count);
+
+        double max_ulp = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            max_ulp = std::max(max_ulp, ulp_error(y[i], c.reference((double)x[i])));
+        }
+        std::cout << "  " << std::left << std::setw(22) << c.name << std::right
+                  << "max " << std::fixed << std::setprecision(2) << max_ulp << " ulp\n";
+        report(c.name, max_ulp <= c.max_ulp);
+    }
+
+    // sin/cos: ULP bound away from zeros, absolute bound everywhere
+    std::vector<float> s(count), co(count);
+    std::uniform_real_distribution<float> dis(-8192.0f, 8192.0f);
+    for (auto& v : x) v = dis(gen);
+    simd_lib::vector_sincos(x.data(), s.data(), co.data(), count);
+    double max_ulp = 0.0, max_abs = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double rs = std::sin((double)x[i]);
+        double rc = std::cos((double)x[i]);
+        max_abs = std::max(max_abs, std::max(std::fabs(s[i] - rs), std::fabs(co[i] - rc)));
+        if (std::fabs(rs) > 0.5) max_ulp = std::max(max_ulp, ulp_error(s[i], rs));
+        if (std::fabs(rc) > 0.5) max_ulp = std::max(max_ulp, ulp_error(co[i], rc));
+    }
+    std::cout << "  sincos [-8192, 8192]  max " << std::fixed << std::setprecision(2) << max_ulp
+              << " ulp, abs " << std::scientific << std::setprecision(2) << max_abs << "\n";
+    report("sin/cos", max_ulp <= 1.5 && max_abs < 1.2e-7);
+
+    std::vector<float> single(count);
+    simd_lib::vector_sin(x.data(), single.data(), count);
+    bool same = single == s;
+    simd_lib::vector_cos(x.data(), single.data(), count);
+    report("sin/cos agree with sincos", same && single == co);
+    std::cout << "\n";
+}
+
+void test_special_values() {
+    std::cout << "=== Special Values ===\n";
+
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    float in[] = {100.0f, -100.0f, nan, 0.0f, inf};
+    float out[5];
+    simd_lib::vector_exp(in, out, 5);
+    report("exp overflow/underflow/NaN", out[0] == inf && out[1] == 0.0f && std::isnan(out[2]) && out[3] == 1.0f);
+
+    float log_in[] = {0.0f, -1.0f, inf, 1.0f, 1e-40f};
+    simd_lib::vector_log(log_in, out, 5);
+    report("log 0/negative/inf/1/denormal", out[0] == -inf && std::isnan(out[1]) && out[2] == inf &&
+           out[3] == 0.0f && std::fabs(out[4] - std::log(1e-40)) < 1e-4);
+
+    float big[] = {1e6f, -3e5f, inf};
+    float s[3], c[3];
+    simd_lib::vector_sincos(big, s, c, 3);
+    report("sincos libm fallback", std::fabs(s[0] - std::sin(1e6f)) < 1e-6f &&
+           std::fabs(c[1] - std::cos(-3e5f)) < 1e-6f && std::isnan(s[2]));
+
+    float rs_in[] = {0.0f, inf, -1.0f, 4.0f};
+    simd_lib::vector_rsqrt(rs_in, out, 4);
+    report("rsqrt 0/inf/negative", out[0] == inf && out[1] == 0.0f && std::isnan(out[2]) &&
+           std::fabs(out[3] - 0.5f) < 1e-6f);
+
+    // Denormals on both the vector body and the tail
+    float rs_small[] = {1e-40f, 1e-45f, 1.1e-38f, 1.17549435e-38f, 3e-39f, 1e-40f, 1e-45f, 1.1e-38f, 1e-40f};
+    float rs_out[9];
+    simd_lib::vector_rsqrt(rs_small, rs_out, 9);
+    bool denormal_ok = true;
+    for (size_t i = 0; i < 9; ++i) {
+        double expected = 1.0 / std::sqrt((double)rs_small[i]);
+        denormal_ok &= std::fabs(rs_out[i] - expected) <= 1e-6 * expected;
+    }
+    report("rsqrt denormals", denormal_ok);
+
+    float t_in[] = {20.0f, -20.0f, 0.0f};
+    simd_lib::vector_tanh(t_in, out, 3);
+    report("tanh saturation", out[0] == 1.0f && out[1] == -1.0f && out[2] == 0.0f);
+    std::cout << "\n";
+}
+
+void benchmark_math() {
+    std::cout << "=== Transcendental Benchmark (1M elements) ===\n";
+
+    const size_t count = 1000000;
+    std::vector<float> x(count), y(count), y2(count);
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dis(0.01f, 10.0f);
+    for (auto& v : x) v = dis(gen);
+
+    struct Bench {
+        const char* name;
+        void (*scalar)(const float*, float*, size_t);
+        void (*simd)(const float*, float*, size_t);
+    };
+    Bench benches[] = {
+        {"exp", simd_lib::vector_exp_scalar, simd_lib::vector_exp},
+        {"log", simd_lib::vector_log_scalar, simd_lib::vector_log},
+        {"sin", simd_lib::vector_sin_scalar, simd_lib::vector_sin},
+        {"tanh", simd_lib::vector_tanh_scalar, simd_lib::vector_tanh},
+        {"sigmoid", simd_lib::vector_sigmoid_scalar, simd_lib::vector_sigmoid},
+        {"rsqrt", simd_lib::vector_rsqrt_scalar, simd_lib::vector_rsqrt},
+    };
+
+    for (const auto& b : benches) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 10; ++i) b.scalar(x.data(), y.data(), count);
+        auto end = std::chrono::high_resolution_clock::now();
+        auto scalar_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 10; ++i) b.simd(x.data(), y2.data(), count);
+        end = std::chrono::high_resolution_clock::now();
+        auto simd_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+        std::cout << "  " << std::left << std::setw(8) << b.name << std::right
+                  << "scalar " << std::setw(8) << scalar_time.count() << " us   SIMD "
+                  << std::setw(8) << simd_time.count() << " us   " << std::fixed << std::setprecision(2)
+                  << (double)scalar_time.count() / simd_time.count() << "x\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Transcendental Math Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_ulp_bounds();
+    test_special_values();
+    benchmark_math();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
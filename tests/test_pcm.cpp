@@ -0,0 +1,315 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static std::vector<uint8_t> pack_s24(const std::vector<int32_t>& values) {
+    std::vector<uint8_t> bytes(3 * values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        uint32_t v = (uint32_t)values[i];
+        bytes[3 * i] = (uint8_t)v;
+        bytes[3 * i + 1] = (uint8_t)(v >> 8);
+        bytes[3 * i + 2] = (uint8_t)(v >> 16);
+    }
+    return bytes;
+}
+
+// Integer to float is exact at every width, and back again recovers the integer
+void test_pcm_round_trip() {
+    std::cout << "=== Round Trip ===\n";
+
+    std::vector<int16_t> s16(65536);
+    for (size_t i = 0; i < s16.size(); ++i) {
+        s16[i] = (int16_t)(i - 32768);
+    }
+    std::vector<float> f(s16.size());
+    simd_lib::convert_s16_to_f32(s16.data(), f.data(), s16.size());
+    bool s16_exact = true;
+    for (size_t i = 0; i < s16.size(); ++i) {
+        s16_exact &= f[i] == (float)s16[i] / 32768.0f;
+    }
+    std::vector<int16_t> s16_back(s16.size());
+    simd_lib::convert_f32_to_s16(f.data(), s16_back.data(), f.size());
+
+    std::mt19937 rng(2);
+    std::uniform_int_distribution<int32_t> dist24(-8388608, 8388607);
+    std::vector<int32_t> s24(1003);
+    for (int32_t& v : s24) {
+        v = dist24(rng);
+    }
+    s24[0] = -8388608;
+    s24[1] = 8388607;
+    s24[2] = -1;
+    s24[3] = 0;
+    std::vector<uint8_t> s24_bytes = pack_s24(s24);
+    std::vector<float> f24(s24.size());
+    simd_lib::convert_s24_to_f32(s24_bytes.data(), f24.data(), s24.size());
+    bool s24_exact = true;
+    for (size_t i = 0; i < s24.size(); ++i) {
+        s24_exact &= f24[i] == (float)s24[i] / 8388608.0f;
+    }
+    std::vector<uint8_t> s24_back(s24_bytes.size());
+    simd_lib::convert_f32_to_s24(f24.data(), s24_back.data(), f24.size());
+
+    // Above 2^24 the float step exceeds 1, so compare against the rounded value
+    std::uniform_int_distribution<int32_t> dist32(INT32_MIN, INT32_MAX);
+    std::vector<int32_t> s32(1003);
+    for (int32_t& v : s32) {
+        v = dist32(rng);
+    }
+    s32[0] = INT32_MIN;
+    s32[1] = INT32_MAX;
+    std::vector<float> f32(s32.size());
+    simd_lib::convert_s32_to_f32(s32.data(), f32.data(), s32.size());
+    bool s32_ok = true;
+    for (size_t i = 0; i < s32.size(); ++i) {
+        s32_ok &= f32[i] == (float)s32[i] / 2147483648.0f;
+    }
+
+    report("s16 -> f32 exact:", s16_exact);
+    report("s16 round trip:", s16_back == s16);
+    report("s24 -> f32 exact:", s24_exact);
+    report("s24 round trip:", s24_back == s24_bytes);
+    report("s32 -> f32:", s32_ok);
+    std::cout << "\n";
+}
+
+void test_pcm_saturation() {
+    std::cout << "=== Saturation ===\n";
+
+    const std::vector<float> input = {1.0f, -1.0f, 1.5f, -1.5f, 1e30f, -1e30f, 0.99999f, 0.5f, -0.5f, 0.0f,
+                                      2.0f, -3.0f, 1e10f, -1e10f, 0.25f, 1.0f, -1.0f};
+    std::vector<int16_t> s16(input.size());
+    std::vector<int32_t> s32(input.size());
+    std::vector<uint8_t> s24(3 * input.size());
+    simd_lib::convert_f32_to_s16(input.data(), s16.data(), input.size());
+    simd_lib::convert_f32_to_s32(input.data(), s32.data(), input.size());
+    simd_lib::convert_f32_to_s24(input.data(), s24.data(), input.size());
+
+    bool s16_ok = true, s24_ok = true, s32_ok = true;
+    for (size_t i = 0; i < input.size(); ++i) {
+        double x = input[i];
+        s16_ok &= s16[i] == (int16_t)std::min(32767.0, std::max(-32768.0, std::nearbyint(x * 32768.0)));
+        int32_t v24 = (int32_t)((uint32_t)s24[3 * i] << 8 | (uint32_t)s24[3 * i + 1] << 16 |
+                                (uint32_t)s24[3 * i + 2] << 24) >> 8;
+        s24_ok &= v24 == (int32_t)std::min(8388607.0, std::max(-8388608.0, std::nearbyint(x * 8388608.0)));
+        s32_ok &= s32[i] == (int32_t)std::min(2147483647.0, std::max(-2147483648.0, std::nearbyint(x * 2147483648.0)));
+    }
+
+    report("f32 -> s16:", s16_ok);
+    report("f32 -> s24:", s24_ok);
+    report("f32 -> s32:", s32_ok);
+    std::cout << "\n";
+}
+
+// Dispatching entry points against the scalar kernels at counts around the
+// vector widths, with a fused gain
+void test_pcm_kernels() {
+    std::cout << "=== Kernels and Fused Scale ===\n";
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-1.2f, 1.2f);
+    std::uniform_int_distribution<int32_t> dist_int(INT32_MIN, INT32_MAX);
+    bool to_float_ok = true, to_int_ok = true, fused_ok = true;
+    const float scale = 0.7f;
+
+    for (size_t count : {0, 1, 7, 8, 15, 16, 17, 100, 1001}) {
+        std::vector<float> x(count);
+        std::vector<int32_t> ints(count);
+        std::vector<int16_t> shorts(count);
+        for (size_t i = 0; i < count; ++i) {
+            x[i] = dist(rng);
+            ints[i] = dist_int(rng);
+            shorts[i] = (int16_t)(ints[i] >> 16);
+        }
+        std::vector<int32_t> ints24(count);
+        for (size_t i = 0; i < count; ++i) {
+            ints24[i] = ints[i] >> 8;
+        }
+        std::vector<uint8_t> bytes = pack_s24(ints24);
+
+        std::vector<float> a(count), b(count);
+        simd_lib::convert_s16_to_f32(shorts.data(), a.data(), count, scale);
+        simd_lib::convert_s16_to_f32_scalar(shorts.data(), b.data(), count, scale);
+        to_float_ok &= a == b;
+        simd_lib::convert_s24_to_f32(bytes.data(), a.data(), count, scale);
+        simd_lib::convert_s24_to_f32_scalar(bytes.data(), b.data(), count, scale);
+        to_float_ok &= a == b;
+        simd_lib::convert_s32_to_f32(ints.data(), a.data(), count, scale);
+        simd_lib::convert_s32_to_f32_scalar(ints.data(), b.data(), count, scale);
+        to_float_ok &= a == b;
+
+        std::vector<int16_t> sa(count), sb(count);
+        simd_lib::convert_f32_to_s16(x.data(), sa.data(), count, scale);
+        simd_lib::convert_f32_to_s16_scalar(x.data(), sb.data(), count, scale, nullptr);
+        to_int_ok &= sa == sb;
+        std::vector<uint8_t> ba(3 * count), bb(3 * count);
+        simd_lib::convert_f32_to_s24(x.data(), ba.data(), count, scale);
+        simd_lib::convert_f32_to_s24_scalar(x.data(), bb.data(), count, scale, nullptr);
+        to_int_ok &= ba == bb;
+        std::vector<int32_t> ia(count), ib(count);
+        simd_lib::convert_f32_to_s32(x.data(), ia.data(), count, scale);
+        simd_lib::convert_f32_to_s32_scalar(x.data(), ib.data(), count, scale);
+        to_int_ok &= ia == ib;
+
+        // A power-of-two gain is exact either way, so fused and separate passes agree bit for bit
+        std::vector<float> fused(count), separate(count);
+        simd_lib::convert_s16_to_f32(shorts.data(), fused.data(), count, 0.5f);
+        simd_lib::convert_s16_to_f32(shorts.data(), separate.data(), count);
+        simd_lib::vector_scale(separate.data(), 0.5f, separate.data(), count);
+        fused_ok &= fused == separate;
+    }
+
+    report("Integer -> float vs scalar:", to_float_ok);
+    report("Float -> integer vs scalar:", to_int_ok);
+    report("Fused scale matches vector_scale:", fused_ok);
+    std::cout << "\n";
+}
+
+void test_pcm_dither() {
+    std::cout << "=== Dither ===\n";
+
+    // A constant 0.3 LSB rounds to 0 without dither; TPDF dither keeps it on average
+    const size_t count = 1 << 16;
+    std::vector<float> x(count, 0.3f / 32768.0f);
+    std::vector<int16_t> plain(count), dithered(count);
+    simd_lib::convert_f32_to_s16(x.data(), plain.data(), count);
+    simd_lib::PcmDither dither;
+    simd_lib::convert_f32_to_s16(x.data(), dithered.data(), count, 1.0f, &dither);
+    double mean = 0.0;
+    bool bounded = true;
+    for (size_t i = 0; i < count; ++i) {
+        mean += dithered[i];
+        bounded &= dithered[i] >= -1 && dithered[i] <= 1;
+    }
+    mean /= count;
+    bool plain_zero = true;
+    for (int16_t v : plain) {
+        plain_zero &= v == 0;
+    }
+
+    // The same stream split into uneven calls, and through the scalar kernel
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (float& v : x) {
+        v = dist(rng);
+    }
+    simd_lib::PcmDither whole, pieces;
+    std::vector<int16_t> a(count), b(count), c(count);
+    simd_lib::convert_f32_to_s16(x.data(), a.data(), count, 1.0f, &whole);
+    for (size_t i = 0, n = 1; i < count; i += n, n = n * 3 + 1) {
+        n = std::min(n, count - i);
+        simd_lib::convert_f32_to_s16(&x[i], &b[i], n, 1.0f, &pieces);
+    }
+    simd_lib::PcmDither start;
+    simd_lib::convert_f32_to_s16_scalar(x.data(), c.data(), count, 1.0f, &start);
+    // Mul and add may be contracted into one FMA in some builds, which can
+    // move a value that sits exactly on a rounding boundary by one step
+    bool split_ok = whole.index == count && pieces.index == count;
+    for (size_t i = 0; i < count; ++i) {
+        split_ok &= std::abs(a[i] - b[i]) <= 1 && std::abs(a[i] - c[i]) <= 1;
+    }
+
+    std::vector<uint8_t> s24(3 * count);
+    simd_lib::PcmDither dither24;
+    simd_lib::convert_f32_to_s24(x.data(), s24.data(), count, 1.0f, &dither24);
+    bool s24_ok = true;
+    for (size_t i = 0; i < count; ++i) {
+        int32_t v = (int32_t)((uint32_t)s24[3 * i] << 8 | (uint32_t)s24[3 * i + 1] << 16 |
+                              (uint32_t)s24[3 * i + 2] << 24) >> 8;
+        s24_ok &= std::fabs(v - x[i] * 8388608.0) <= 1.5;
+    }
+
+    report("No dither rounds 0.3 LSB to 0:", plain_zero);
+    report("TPDF mean preserves 0.3 LSB:", std::fabs(mean - 0.3) < 0.01 && bounded);
+    report("Independent of call split:", split_ok);
+    report("s24 within 1.5 LSB:", s24_ok);
+    std::cout << "\n";
+}
+
+void benchmark_pcm() {
+    std::cout << "=== Performance ===\n";
+
+    // One second of 48 kHz stereo
+    const size_t count = 96000;
+    const int iterations = 500;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> f(count), g(count);
+    for (float& v : f) {
+        v = dist(rng);
+    }
+    std::vector<int16_t> s16(count);
+    std::vector<uint8_t> s24(3 * count);
+    simd_lib::convert_f32_to_s16(f.data(), s16.data(), count);
+    simd_lib::convert_f32_to_s24(f.data(), s24.data(), count);
+
+    auto time_us = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+    auto print = [](const char* name, double scalar_time, double simd_time) {
+        std::cout << "  " << name << ":\n";
+        std::cout << "    Scalar: " << scalar_time << " us\n";
+        std::cout << "    AVX2:   " << simd_time << " us\n";
+        std::cout << "    Speedup: " << scalar_time / simd_time << "x\n";
+    };
+    std::cout << std::fixed << std::setprecision(2);
+
+    print("s16 -> f32 with gain, 96K",
+          time_us([&] { simd_lib::convert_s16_to_f32_scalar(s16.data(), g.data(), count, 0.8f); }),
+          time_us([&] { simd_lib::convert_s16_to_f32(s16.data(), g.data(), count, 0.8f); }));
+    print("s24 -> f32 with gain, 96K",
+          time_us([&] { simd_lib::convert_s24_to_f32_scalar(s24.data(), g.data(), count, 0.8f); }),
+          time_us([&] { simd_lib::convert_s24_to_f32(s24.data(), g.data(), count, 0.8f); }));
+    simd_lib::PcmDither dither;
+    print("f32 -> s16 dithered, 96K",
+          time_us([&] { simd_lib::convert_f32_to_s16_scalar(f.data(), s16.data(), count, 0.8f, &dither); }),
+          time_us([&] { simd_lib::convert_f32_to_s16(f.data(), s16.data(), count, 0.8f, &dither); }));
+    print("f32 -> s24, 96K",
+          time_us([&] { simd_lib::convert_f32_to_s24_scalar(f.data(), s24.data(), count, 0.8f, nullptr); }),
+          time_us([&] { simd_lib::convert_f32_to_s24(f.data(), s24.data(), count, 0.8f); }));
+
+    // Gain in the conversion pass against a separate vector_scale pass
+    double separate = time_us([&] {
+        simd_lib::convert_s16_to_f32(s16.data(), g.data(), count);
+        simd_lib::vector_scale(g.data(), 0.8f, g.data(), count);
+    });
+    double fused = time_us([&] { simd_lib::convert_s16_to_f32(s16.data(), g.data(), count, 0.8f); });
+    std::cout << "  s16 -> f32 then vector_scale: " << separate << " us, fused: " << fused << " us\n";
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - PCM Conversion Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_pcm_round_trip();
+    test_pcm_saturation();
+    test_pcm_kernels();
+    test_pcm_dither();
+    benchmark_pcm();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
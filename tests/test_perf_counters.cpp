@@ -0,0 +1,77 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+void test_counters() {
+    std::cout << "=== Counters ===\n";
+
+    simd_lib::PerfCounters counters;
+    bool hardware = (counters.available() & (simd_lib::kPerfCycles | simd_lib::kPerfInstructions)) ==
+                    (simd_lib::kPerfCycles | simd_lib::kPerfInstructions);
+    std::cout << "  Hardware counters: " << (hardware ? "available" : "unavailable") << "\n";
+
+    std::vector<float> a(1 << 16, 1.0f);
+    simd_lib::PerfSample begin = counters.read();
+    float sum = simd_lib::vector_sum(a.data(), a.size());
+    simd_lib::PerfSample delta = simd_lib::perf_delta(begin, counters.read());
+
+    report("workload result", sum == (float)a.size());
+    if (hardware) {
+        // Summing 64K floats takes at least 64K / 32 vector adds
+        report("cycles and instructions counted", delta.cycles > 0 && delta.instructions > 2048);
+        report("IPC plausible", delta.ipc() > 0.05 && delta.ipc() < 10.0);
+    } else {
+        report("unavailable counters read zero", delta.cycles == 0 && delta.instructions == 0 &&
+               delta.ipc() == 0.0);
+    }
+    std::cout << "\n";
+}
+
+void test_regions() {
+    std::cout << "=== Regions ===\n";
+
+    simd_lib::perf_reset();
+    std::vector<float> a(4096, 2.0f), b(4096, 0.5f);
+    for (int i = 0; i < 10; ++i) {
+        SIMD_PERF_SCOPE("dot_product");
+        volatile float dot = simd_lib::dot_product(a.data(), b.data(), a.size());
+        (void)dot;
+    }
+    {
+        SIMD_PERF_SCOPE("outer");
+        SIMD_PERF_SCOPE("inner");
+    }
+
+    simd_lib::PerfRegion regions[4];
+    size_t count = simd_lib::perf_regions(regions, 4);
+    report("three regions recorded", count == 3);
+    report("calls accumulated", count >= 1 && std::string(regions[0].name) == "dot_product" &&
+           regions[0].calls == 10);
+
+    simd_lib::perf_report();
+    simd_lib::perf_reset();
+    report("reset clears regions", simd_lib::perf_regions(regions, 4) == 0);
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Performance Counter Test\n\n";
+
+    simd_lib::init_cpu_features();
+
+    test_counters();
+    test_regions();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <cmath>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+void test_quantized_kernels() {
+    std::cout << "=== Quantized Kernel Correctness ===\n";
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> s8_dis(-127, 127);
+    std::uniform_int_distribution<int> u8_dis(0, 255);
+
+    // Odd sizes exercise the scalar tails
+    for (size_t count : {1, 31, 32, 77, 1000, 4099}) {
+        std::vector<int8_t> a(count), b(count);
+        std::vector<uint8_t> u(count);
+        for (size_t i = 0; i < count; ++i) {
+            a[i] = (int8_t)s8_dis(gen);
+            b[i] = (int8_t)s8_dis(gen);
+            u[i] = (uint8_t)u8_dis(gen);
+        }
+
+        bool correct = true;
+        correct &= simd_lib::dot_product_s8(a.data(), b.data(), count) ==
+                   simd_lib::dot_product_s8_scalar(a.data(), b.data(), count);
+        correct &= simd_lib::dot_product_s8_avx2(a.data(), b.data(), count) ==
+                   simd_lib::dot_product_s8_scalar(a.data(), b.data(), count);
+        correct &= simd_lib::dot_product_u8s8(u.data(), b.data(), count) ==
+                   simd_lib::dot_product_u8s8_scalar(u.data(), b.data(), count);
+        correct &= simd_lib::dot_product_u8s8_avx2(u.data(), b.data(), count) ==
+                   simd_lib::dot_product_u8s8_scalar(u.data(), b.data(), count);
+        correct &= simd_lib::l2_distance_squared_s8(a.data(), b.data(), count) ==
+                   simd_lib::l2_distance_squared_s8_scalar(a.data(), b.data(), count);
+        correct &= simd_lib::sum_s8(a.data(), count) == simd_lib::sum_s8_scalar(a.data(), count);
+        correct &= simd_lib::sum_u8(u.data(), count) == simd_lib::sum_u8_scalar(u.data(), count);
+
+        std::string name = "Exact integer kernels (n=" + std::to_string(count) + ")";
+        report(name.c_str(), correct);
+    }
+
+    // Batched kernels against per-row scalar results
+    const size_t rows = 103, dim = 96;
+    std::vector<int8_t> query(dim), database(rows * dim);
+    std::vector<uint8_t> uquery(dim);
+    for (size_t i = 0; i < dim; ++i) {
+        query[i] = (int8_t)s8_dis(gen);
+        uquery[i] = (uint8_t)u8_dis(gen);
+    }
+    for (auto& v : database) {
+        v = (int8_t)s8_dis(gen);
+    }
+
+    std::vector<int32_t> out(rows), expected(rows);
+    simd_lib::batch_dot_product_s8(query.data(), database.data(), rows, dim, out.data());
+    simd_lib::batch_dot_product_s8_scalar(query.data(), database.data(), rows, dim, expected.data());
+    report("Batched s8 dot product", out == expected);
+
+    simd_lib::batch_dot_product_u8s8(uquery.data(), database.data(), rows, dim, out.data());
+    simd_lib::batch_dot_product_u8s8_scalar(uquery.data(), database.data(), rows, dim, expected.data());
+    report("Batched u8s8 dot product", out == expected);
+
+    simd_lib::batch_l2_distance_squared_s8(query.data(), database.data(), rows, dim, out.data());
+    simd_lib::batch_l2_distance_squared_s8_scalar(query.data(), database.data(), rows, dim, expected.data());
+    report("Batched s8 L2 distance", out == expected);
+
+    // Values beyond the int32 range saturate like the scalar path
+    std::vector<float> extreme(64);
+    for (size_t i = 0; i < extreme.size(); ++i) {
+        const float values[] = {3e9f, -3e9f, 1e30f, -1e30f, 200.0f, -200.0f, 126.4f, 0.0f};
+        extreme[i] = values[i % 8];
+    }
+    bool saturated = true;
+    for (int zero_point : {0, 10, -20}) {
+        simd_lib::QuantizationParams qs{1.0f, zero_point}, qu{1.0f, zero_point + 128};
+        std::vector<int8_t> s8(extreme.size()), s8_ref(extreme.size());
+        std::vector<uint8_t> u8(extreme.size()), u8_ref(extreme.size());
+        simd_lib::quantize_s8(extreme.data(), s8.data(), extreme.size(), qs);
+        simd_lib::quantize_s8_scalar(extreme.data(), s8_ref.data(), extreme.size(), qs);
+        simd_lib::quantize_u8(extreme.data(), u8.data(), extreme.size(), qu);
+        simd_lib::quantize_u8_scalar(extreme.data(), u8_ref.data(), extreme.size(), qu);
+        saturated &= s8 == s8_ref && u8 == u8_ref && s8[0] == 127 && s8[1] == -127 && u8[0] == 255 && u8[1] == 0;
+    }
+    report("Out-of-range inputs saturate", saturated);
+    std::cout << "\n";
+}
+
+void test_quantized_accuracy() {
+    std::cout << "=== Quantized vs Float Accuracy ===\n";
+
+    const size_t count = 768;
+    std::vector<float> x(count), y(count);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> pos(0.0f, 1.5f);
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = pos(gen);
+        y[i] = dis(gen);
+    }
+
+    // Asymmetric u8 activations, symmetric s8 weights
+    simd_lib::QuantizationParams qx{2.0f / 255.0f, 0};
+    simd_lib::QuantizationParams qy{1.0f / 127.0f, 0};
+    std::vector<uint8_t> xq(count);
+    std::vector<int8_t> yq(count);
+    simd_lib::quantize_u8(x.data(), xq.data(), count, qx);
+    simd_lib::quantize_s8(y.data(), yq.data(), count, qy);
+
+    std::vector<uint8_t> xq_ref(count);
+    std::vector<int8_t> yq_ref(count);
+    simd_lib::quantize_u8_scalar(x.data(), xq_ref.data(), count, qx);
+    simd_lib::quantize_s8_scalar(y.data(), yq_ref.data(), count, qy);
+    report("Quantize matches scalar", xq == xq_ref && yq == yq_ref);
+
+    float exact = simd_lib::dot_product_scalar(x.data(), y.data(), count);
+    float quantized = simd_lib::dot_product_quantized(xq.data(), qx, yq.data(), qy, count);
+    std::cout << "  Float dot:     " << std::fixed << std::setprecision(6) << exact << "\n";
+    std::cout << "  Quantized dot: " << quantized << "\n";
+    report("Dequantized dot within 1%", std::fabs(exact - quantized) < 0.01f * std::sqrt((float)count));
+
+    // A zero point shifts every code; the correction must cancel it exactly
+    simd_lib::QuantizationParams qz{2.0f / 255.0f, 20};
+    std::vector<uint8_t> xz(count);
+    for (size_t i = 0; i < count; ++i) {
+        xz[i] = (uint8_t)(xq[i] + 20);
+    }
+    float shifted = simd_lib::dot_product_quantized(xz.data(), qz, yq.data(), qy, count);
+    report("Zero-point correction", shifted == quantized);
+    std::cout << "\n";
+}
+
+void benchmark_quantized_dot() {
+    std::cout << "=== Quantized Dot Product Benchmark ===\n";
+
+    const size_t rows = 10000, dim = 256;
+    std::vector<float> query_f(dim), database_f(rows * dim), scores_f(rows);
+    std::vector<int8_t> query_q(dim), database_q(rows * dim);
+    std::vector<int32_t> scores_q(rows);
+
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    for (auto& v : query_f) v = dis(gen);
+    for (auto& v : database_f) v = dis(gen);
+
+    simd_lib::QuantizationParams q{1.0f / 127.0f, 0};
+    simd_lib::quantize_s8(query_f.data(), query_q.data(), dim, q);
+    simd_lib::quantize_s8(database_f.data(), database_q.data(), rows * dim, q);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < 10; ++it) {
+        for (size_t r = 0; r < rows; ++r) {
+            scores_f[r] = simd_lib::dot_product(query_f.data(), &database_f[r * dim], dim);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto float_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < 10; ++it) {
+        simd_lib::batch_dot_product_s8(query_q.data(), database_q.data(), rows, dim, scores_q.data());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto int8_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    std::cout << "  Float dot loop: " << float_time.count() << " us\n";
+    std::cout << "  Int8 batched:   " << int8_time.count() << " us\n";
+    std::cout << "  Speedup:        " << std::fixed << std::setprecision(2)
+              << (double)float_time.count() / int8_time.count() << "x\n\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Quantized Operations Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_quantized_kernels();
+    test_quantized_accuracy();
+    benchmark_quantized_dot();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,374 @@
+#include "simd_lib.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+// Planar storage for a batch of quaternions or points
+struct Quaternions {
+    std::vector<float> w, x, y, z;
+
+    explicit Quaternions(size_t count) : w(count), x(count), y(count), z(count) {}
+    simd_lib::QuaternionArrays out() { return {w.data(), x.data(), y.data(), z.data()}; }
+    simd_lib::ConstQuaternionArrays in() const { return {w.data(), x.data(), y.data(), z.data()}; }
+};
+
+struct Points {
+    std::vector<float> x, y, z;
+
+    explicit Points(size_t count) : x(count), y(count), z(count) {}
+    simd_lib::Vec3Arrays out() { return {x.data(), y.data(), z.data()}; }
+    simd_lib::ConstVec3Arrays in() const { return {x.data(), y.data(), z.data()}; }
+};
+
+static Quaternions random_rotations(size_t count, std::mt19937& rng) {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    Quaternions q(count);
+    for (size_t i = 0; i < count; ++i) {
+        double w = dist(rng), x = dist(rng), y = dist(rng), z = dist(rng);
+        double inv = 1.0 / std::sqrt(w * w + x * x + y * y + z * z);
+        q.w[i] = (float)(w * inv), q.x[i] = (float)(x * inv), q.y[i] = (float)(y * inv), q.z[i] = (float)(z * inv);
+    }
+    return q;
+}
+
+static Points random_points(size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    Points p(count);
+    for (size_t i = 0; i < count; ++i) {
+        p.x[i] = dist(rng), p.y[i] = dist(rng), p.z[i] = dist(rng);
+    }
+    return p;
+}
+
+// Double precision references
+static void reference_multiply(const Quaternions& a, const Quaternions& b, size_t i, double r[4]) {
+    double aw = a.w[i], ax = a.x[i], ay = a.y[i], az = a.z[i];
+    double bw = b.w[i], bx = b.x[i], by = b.y[i], bz = b.z[i];
+    r[0] = aw * bw - ax * bx - ay * by - az * bz;
+    r[1] = aw * bx + ax * bw + ay * bz - az * by;
+    r[2] = aw * by - ax * bz + ay * bw + az * bx;
+    r[3] = aw * bz + ax * by - ay * bx + az * bw;
+}
+
+// q v q* through the full Hamilton products
+static void reference_rotate(double w, double x, double y, double z, const double v[3], double out[3]) {
+    double tw = -x * v[0] - y * v[1] - z * v[2];
+    double tx = w * v[0] + y * v[2] - z * v[1];
+    double ty = w * v[1] - x * v[2] + z * v[0];
+    double tz = w * v[2] + x * v[1] - y * v[0];
+    out[0] = -tw * x + tx * w - ty * z + tz * y;
+    out[1] = -tw * y + tx * z + ty * w - tz * x;
+    out[2] = -tw * z - tx * y + ty * x + tz * w;
+}
+
+static bool close_to(float value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+static const size_t kSizes[] = {0, 1, 7, 8, 9, 31, 1003};
+
+void test_multiply_rotate() {
+    std::cout << "=== Multiply and Rotate ===\n";
+
+    std::mt19937 rng(1);
+    bool multiply_ok = true, scalar_ok = true, in_place_ok = true, rotate_ok = true;
+    for (size_t count : kSizes) {
+        Quaternions a = random_rotations(count, rng), b = random_rotations(count, rng);
+        Quaternions r(count), s(count);
+        simd_lib::quaternion_multiply(a.in(), b.in(), r.out(), count);
+        simd_lib::quaternion_multiply_scalar(a.in(), b.in(), s.out(), count);
+        for (size_t i = 0; i < count; ++i) {
+            double e[4];
+            reference_multiply(a, b, i, e);
+            multiply_ok &= close_to(r.w[i], e[0], 1e-6) && close_to(r.x[i], e[1], 1e-6) &&
+                           close_to(r.y[i], e[2], 1e-6) && close_to(r.z[i], e[3], 1e-6);
+            scalar_ok &= close_to(s.w[i], e[0], 1e-6) && close_to(s.x[i], e[1], 1e-6) &&
+                         close_to(s.y[i], e[2], 1e-6) && close_to(s.z[i], e[3], 1e-6);
+        }
+        Quaternions c = a;
+        simd_lib::quaternion_multiply(c.in(), b.in(), c.out(), count);
+        in_place_ok &= c.w == r.w && c.x == r.x && c.y == r.y && c.z == r.z;
+
+        Points v = random_points(count, rng), out(count);
+        simd_lib::quaternion_rotate(a.in(), v.in(), out.out(), count);
+        for (size_t i = 0; i < count; ++i) {
+            double p[3] = {v.x[i], v.y[i], v.z[i]}, e[3];
+            reference_rotate(a.w[i], a.x[i], a.y[i], a.z[i], p, e);
+            rotate_ok &= close_to(out.x[i], e[0], 1e-5) && close_to(out.y[i], e[1], 1e-5) &&
+                         close_to(out.z[i], e[2], 1e-5);
+        }
+    }
+
+    // Rotating by a * b is rotating by b, then by a
+    const size_t count = 1000;
+    Quaternions a = random_rotations(count, rng), b = random_rotations(count, rng), ab(count);
+    Points v = random_points(count, rng), once(count), twice(count), composed(count);
+    simd_lib::quaternion_multiply(a.in(), b.in(), ab.out(), count);
+    simd_lib::quaternion_rotate(b.in(), v.in(), once.out(), count);
+    simd_lib::quaternion_rotate(a.in(), once.in(), twice.out(), count);
+    simd_lib::quaternion_rotate(ab.in(), v.in(), composed.out(), count);
+    bool compose_ok = true;
+    for (size_t i = 0; i < count; ++i) {
+        compose_ok &= close_to(composed.x[i], twice.x[i], 1e-4) && close_to(composed.y[i], twice.y[i], 1e-4) &&
+                      close_to(composed.z[i], twice.z[i], 1e-4);
+    }
+
+    report("Multiply matches reference:", multiply_ok);
+    report("Scalar multiply matches:", scalar_ok);
+    report("Multiply in place:", in_place_ok);
+    report("Rotate matches q v q*:", rotate_ok);
+    report("Rotation composes as a * b:", compose_ok);
+    std::cout << "\n";
+}
+
+void test_matrix_conversion() {
+    std::cout << "=== Matrix Conversion ===\n";
+
+    std::mt19937 rng(2);
+    bool rotate_ok = true, round_trip_ok = true, scalar_ok = true;
+    for (size_t count : kSizes) {
+        Quaternions q = random_rotations(count, rng);
+        std::vector<float> m(9 * count), ms(9 * count);
+        simd_lib::quaternion_to_matrix3(q.in(), m.data(), count);
+        simd_lib::quaternion_to_matrix3_scalar(q.in(), ms.data(), count);
+        for (size_t i = 0; i < m.size(); ++i) {
+            scalar_ok &= std::fabs(m[i] - ms[i]) <= 1e-6f;
+        }
+
+        // The matrix applies the same rotation
+        for (size_t i = 0; i < count; ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                double v[3] = {axis == 0 ? 1.0 : 0.0, axis == 1 ? 1.0 : 0.0, axis == 2 ? 1.0 : 0.0}, e[3];
+                reference_rotate(q.w[i], q.x[i], q.y[i], q.z[i], v, e);
+                for (int r = 0; r < 3; ++r) {
+                    rotate_ok &= close_to(m[(3 * r + axis) * count + i], e[r], 1e-6);
+                }
+            }
+        }
+
+        // q and -q give the same matrix; the largest component comes back positive
+        Quaternions back(count), back_scalar(count);
+        simd_lib::quaternion_from_matrix3(m.data(), back.out(), count);
+        simd_lib::quaternion_from_matrix3_scalar(m.data(), back_scalar.out(), count);
+        for (size_t i = 0; i < count; ++i) {
+            float c[4] = {q.w[i], q.x[i], q.y[i], q.z[i]};
+            float largest = *std::max_element(c, c + 4, [](float a, float b) { return std::fabs(a) < std::fabs(b); });
+            float sign = largest < 0.0f ? -1.0f : 1.0f;
+            round_trip_ok &= close_to(back.w[i], sign * c[0], 2e-6) && close_to(back.x[i], sign * c[1], 2e-6) &&
+                             close_to(back.y[i], sign * c[2], 2e-6) && close_to(back.z[i], sign * c[3], 2e-6);
+            scalar_ok &= close_to(back.w[i], back_scalar.w[i], 2e-6) && close_to(back.x[i], back_scalar.x[i], 2e-6) &&
+                         close_to(back.y[i], back_scalar.y[i], 2e-6) && close_to(back.z[i], back_scalar.z[i], 2e-6);
+        }
+    }
+
+    // Half turns put the trace at -1 and exercise every Shepperd case
+    const float h = std::sqrt(0.5f);
+    Quaternions turns(8);
+    const float cases[8][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1},
+                               {h, h, 0, 0}, {0, h, h, 0}, {0, 0, h, h}, {0, h, 0, h}};
+    for (size_t i = 0; i < 8; ++i) {
+        turns.w[i] = cases[i][0], turns.x[i] = cases[i][1], turns.y[i] = cases[i][2], turns.z[i] = cases[i][3];
+    }
+    std::vector<float> tm(72);
+    Quaternions turns_back(8);
+    simd_lib::quaternion_to_matrix3(turns.in(), tm.data(), 8);
+    simd_lib::quaternion_from_matrix3(tm.data(), turns_back.out(), 8);
+    bool turns_ok = true;
+    for (size_t i = 0; i < 8; ++i) {
+        turns_ok &= close_to(turns_back.w[i], turns.w[i], 1e-6) && close_to(turns_back.x[i], turns.x[i], 1e-6) &&
+                    close_to(turns_back.y[i], turns.y[i], 1e-6) && close_to(turns_back.z[i], turns.z[i], 1e-6);
+    }
+
+    report("Matrix rotates like q v q*:", rotate_ok);
+    report("From matrix round trip:", round_trip_ok);
+    report("Half turns and axis cases:", turns_ok);
+    report("AVX2 matches scalar:", scalar_ok);
+    std::cout << "\n";
+}
+
+void test_normalize_slerp() {
+    std::cout << "=== Normalize and Slerp ===\n";
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> scale(0.01f, 100.0f);
+    bool normalize_ok = true;
+    for (size_t count : kSizes) {
+        Quaternions q = random_rotations(count, rng), expected = q;
+        for (size_t i = 0; i < count; ++i) {
+            float s = scale(rng);
+            q.w[i] *= s, q.x[i] *= s, q.y[i] *= s, q.z[i] *= s;
+        }
+        simd_lib::quaternion_normalize(q.in(), q.out(), count);
+        for (size_t i = 0; i < count; ++i) {
+            normalize_ok &= close_to(q.w[i], expected.w[i], 1e-6) && close_to(q.x[i], expected.x[i], 1e-6) &&
+                            close_to(q.y[i], expected.y[i], 1e-6) && close_to(q.z[i], expected.z[i], 1e-6);
+        }
+    }
+    Quaternions zero(9), zero_scalar(9);
+    simd_lib::quaternion_normalize(zero.in(), zero.out(), 9);
+    simd_lib::quaternion_normalize_scalar(zero_scalar.in(), zero_scalar.out(), 9);
+    bool identity_ok = true;
+    for (size_t i = 0; i < 9; ++i) {
+        identity_ok &= zero.w[i] == 1.0f && zero.x[i] == 0.0f && zero.y[i] == 0.0f && zero.z[i] == 0.0f;
+        identity_ok &= zero_scalar.w[i] == 1.0f && zero_scalar.x[i] == 0.0f;
+    }
+
+    // The angle from a grows linearly in t along the shorter arc
+    const size_t count = 1003;
+    Quaternions a = random_rotations(count, rng), b = random_rotations(count, rng);
+    bool slerp_ok = true, scalar_ok = true, endpoints_ok = true;
+    for (float t : {0.0f, 0.25f, 0.5f, 0.9f, 1.0f}) {
+        Quaternions r(count), s(count);
+        simd_lib::quaternion_slerp(a.in(), b.in(), t, r.out(), count);
+        simd_lib::quaternion_slerp_scalar(a.in(), b.in(), t, s.out(), count);
+        for (size_t i = 0; i < count; ++i) {
+            double d = (double)a.w[i] * b.w[i] + (double)a.x[i] * b.x[i] + (double)a.y[i] * b.y[i] +
+                       (double)a.z[i] * b.z[i];
+            double theta = std::acos(std::min(std::fabs(d), 1.0));
+            double from_a = (double)a.w[i] * r.w[i] + (double)a.x[i] * r.x[i] + (double)a.y[i] * r.y[i] +
+                            (double)a.z[i] * r.z[i];
+            double norm = std::sqrt((double)r.w[i] * r.w[i] + (double)r.x[i] * r.x[i] + (double)r.y[i] * r.y[i] +
+                                    (double)r.z[i] * r.z[i]);
+            slerp_ok &= std::fabs(norm - 1.0) < 1e-5 && std::fabs(from_a - std::cos(t * theta)) < 1e-5;
+            scalar_ok &= close_to(r.w[i], s.w[i], 1e-5) && close_to(r.x[i], s.x[i], 1e-5) &&
+                         close_to(r.y[i], s.y[i], 1e-5) && close_to(r.z[i], s.z[i], 1e-5);
+            if (t == 1.0f) {
+                float sign = d < 0.0 ? -1.0f : 1.0f;
+                endpoints_ok &= close_to(r.w[i], sign * b.w[i], 1e-5) && close_to(r.x[i], sign * b.x[i], 1e-5) &&
+                                close_to(r.y[i], sign * b.y[i], 1e-5) && close_to(r.z[i], sign * b.z[i], 1e-5);
+            } else if (t == 0.0f) {
+                endpoints_ok &= close_to(r.w[i], a.w[i], 1e-6) && close_to(r.x[i], a.x[i], 1e-6) &&
+                                close_to(r.y[i], a.y[i], 1e-6) && close_to(r.z[i], a.z[i], 1e-6);
+            }
+        }
+    }
+
+    // Nearly equal and identical pairs take the lerp path and stay unit length
+    Quaternions near = a, r(count);
+    for (size_t i = 0; i < count; ++i) {
+        near.x[i] += (i % 3) * 1e-3f;
+    }
+    simd_lib::quaternion_normalize(near.in(), near.out(), count);
+    bool near_ok = true;
+    for (const Quaternions* other : {&near, &a}) {
+        simd_lib::quaternion_slerp(a.in(), other->in(), 0.3f, r.out(), count);
+        for (size_t i = 0; i < count; ++i) {
+            double norm_sq = (double)r.w[i] * r.w[i] + (double)r.x[i] * r.x[i] + (double)r.y[i] * r.y[i] +
+                             (double)r.z[i] * r.z[i];
+            near_ok &= std::fabs(norm_sq - 1.0) < 1e-5 && close_to(r.w[i], a.w[i], 2e-3) &&
+                       close_to(r.x[i], a.x[i], 2e-3);
+        }
+    }
+
+    report("Normalize gives unit length:", normalize_ok);
+    report("Zero quaternion gives identity:", identity_ok);
+    report("Slerp angle linear in t:", slerp_ok);
+    report("Slerp endpoints:", endpoints_ok);
+    report("Near-identical pairs:", near_ok);
+    report("Slerp AVX2 matches scalar:", scalar_ok);
+    std::cout << "\n";
+}
+
+void test_rigid_transform() {
+    std::cout << "=== Rigid Transform ===\n";
+
+    std::mt19937 rng(4);
+    bool transform_ok = true, scalar_ok = true, in_place_ok = true;
+    for (size_t count : kSizes) {
+        Quaternions q = random_rotations(1, rng);
+        const float rotation[4] = {q.w[0], q.x[0], q.y[0], q.z[0]};
+        const float translation[3] = {1.5f, -2.0f, 0.25f};
+        Points p = random_points(count, rng), out(count), out_scalar(count);
+        simd_lib::rigid_transform_points(rotation, translation, p.in(), out.out(), count);
+        simd_lib::rigid_transform_points_scalar(rotation, translation, p.in(), out_scalar.out(), count);
+        for (size_t i = 0; i < count; ++i) {
+            double v[3] = {p.x[i], p.y[i], p.z[i]}, e[3];
+            reference_rotate(rotation[0], rotation[1], rotation[2], rotation[3], v, e);
+            transform_ok &= close_to(out.x[i], e[0] + translation[0], 1e-5) &&
+                            close_to(out.y[i], e[1] + translation[1], 1e-5) &&
+                            close_to(out.z[i], e[2] + translation[2], 1e-5);
+            scalar_ok &= close_to(out.x[i], out_scalar.x[i], 1e-5) && close_to(out.y[i], out_scalar.y[i], 1e-5) &&
+                         close_to(out.z[i], out_scalar.z[i], 1e-5);
+        }
+        simd_lib::rigid_transform_points(rotation, translation, p.in(), p.out(), count);
+        in_place_ok &= p.x == out.x && p.y == out.y && p.z == out.z;
+    }
+
+    report("Matches rotate plus translate:", transform_ok);
+    report("AVX2 matches scalar:", scalar_ok);
+    report("Transform in place:", in_place_ok);
+    std::cout << "\n";
+}
+
+void benchmark_quaternion() {
+    std::cout << "=== Performance ===\n";
+
+    const size_t count = 1 << 20;
+    const int iterations = 20;
+    std::mt19937 rng(5);
+    Quaternions a = random_rotations(count, rng), b = random_rotations(count, rng), r(count);
+    Points p = random_points(count, rng), out(count);
+    const float rotation[4] = {a.w[0], a.x[0], a.y[0], a.z[0]};
+    const float translation[3] = {1.0f, 2.0f, 3.0f};
+
+    auto time_us = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+    auto print = [&](const char* name, double scalar_time, double simd_time) {
+        std::cout << "  " << name << ":\n";
+        std::cout << "    Scalar: " << scalar_time << " us (" << count / scalar_time << " M/s)\n";
+        std::cout << "    AVX2:   " << simd_time << " us (" << count / simd_time << " M/s)\n";
+        std::cout << "    Speedup: " << scalar_time / simd_time << "x\n";
+    };
+    std::cout << std::fixed << std::setprecision(2);
+
+    print("Multiply 1M quaternions",
+          time_us([&] { simd_lib::quaternion_multiply_scalar(a.in(), b.in(), r.out(), count); }),
+          time_us([&] { simd_lib::quaternion_multiply(a.in(), b.in(), r.out(), count); }));
+    print("Rotate 1M vectors", time_us([&] { simd_lib::quaternion_rotate_scalar(a.in(), p.in(), out.out(), count); }),
+          time_us([&] { simd_lib::quaternion_rotate(a.in(), p.in(), out.out(), count); }));
+    print("Normalize 1M quaternions", time_us([&] { simd_lib::quaternion_normalize_scalar(a.in(), r.out(), count); }),
+          time_us([&] { simd_lib::quaternion_normalize(a.in(), r.out(), count); }));
+    print("Slerp 1M pairs", time_us([&] { simd_lib::quaternion_slerp_scalar(a.in(), b.in(), 0.3f, r.out(), count); }),
+          time_us([&] { simd_lib::quaternion_slerp(a.in(), b.in(), 0.3f, r.out(), count); }));
+    print("Transform 1M points", time_us([&] {
+              simd_lib::rigid_transform_points_scalar(rotation, translation, p.in(), out.out(), count);
+          }),
+          time_us([&] { simd_lib::rigid_transform_points(rotation, translation, p.in(), out.out(), count); }));
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Quaternion Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_multiply_rotate();
+    test_matrix_conversion();
+    test_normalize_slerp();
+    test_rigid_transform();
+    benchmark_quaternion();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
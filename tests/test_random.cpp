@@ -0,0 +1,285 @@
+#include "simd_lib.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <thread>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static bool same_state(const simd_lib::RandomState& a, const simd_lib::RandomState& b) {
+    return std::memcmp(a.s, b.s, sizeof(a.s)) == 0;
+}
+
+// Reference xoshiro128+ (Blackman and Vigna), seeded the way lane 0 is
+struct Xoshiro128Plus {
+    uint32_t s[4];
+
+    explicit Xoshiro128Plus(uint64_t seed) {
+        uint64_t a = splitmix64(seed);
+        uint64_t b = splitmix64(seed);
+        s[0] = (uint32_t)a;
+        s[1] = (uint32_t)(a >> 32);
+        s[2] = (uint32_t)b;
+        s[3] = (uint32_t)(b >> 32);
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    uint32_t next() {
+        uint32_t result = s[0] + s[3];
+        uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = (s[3] << 11) | (s[3] >> 21);
+        return result;
+    }
+};
+
+void test_uniform() {
+    std::cout << "=== Uniform ===\n";
+
+    const size_t count = 1000003;
+    std::vector<float> a(count), b(count);
+    simd_lib::RandomState sa = simd_lib::random_state(42);
+    simd_lib::RandomState sb = sa;
+    simd_lib::fill_uniform(&sa, a.data(), count);
+    simd_lib::fill_uniform_scalar(&sb, b.data(), count, 0.0f, 1.0f);
+    bool scalar_ok = a == b && same_state(sa, sb);
+
+    // Lane 0 is a plain xoshiro128+ stream
+    Xoshiro128Plus reference(42);
+    bool reference_ok = true;
+    for (size_t i = 0; i < count; i += 8) {
+        reference_ok &= a[i] == (float)(reference.next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Any split into multiples of 8 gives the same sequence
+    std::vector<float> pieces(count);
+    simd_lib::RandomState sp = simd_lib::random_state(42);
+    for (size_t i = 0, n = 8; i < count; i += n, n = (n * 3) & ~(size_t)7) {
+        n = std::min(n, count - i);
+        simd_lib::fill_uniform(&sp, &pieces[i], n);
+    }
+    bool split_ok = pieces == a;
+
+    double sum = 0.0, sum_sq = 0.0;
+    bool range_ok = true;
+    for (float v : a) {
+        range_ok &= v >= 0.0f && v < 1.0f;
+        sum += v;
+        sum_sq += (double)v * v;
+    }
+    double mean = sum / count;
+    double variance = sum_sq / count - mean * mean;
+
+    std::vector<float> c(1000), d(1000);
+    simd_lib::RandomState sc = simd_lib::random_state(7), sd = sc;
+    simd_lib::fill_uniform(&sc, c.data(), c.size(), -3.0f, 5.0f);
+    simd_lib::fill_uniform_scalar(&sd, d.data(), d.size(), -3.0f, 5.0f);
+    bool scaled_ok = true;
+    for (size_t i = 0; i < c.size(); ++i) {
+        scaled_ok &= c[i] >= -3.0f && c[i] < 5.0f && std::fabs(c[i] - d[i]) <= 1e-6f;
+    }
+
+    // A state whose next output is all ones gives the largest draw, 1 - 2^-24,
+    // which rounds to hi for these ranges
+    bool top_ok = true;
+    for (float lo : {0.0f, 1.0f, 100.0f, -3.0f}) {
+        float hi = lo + 1.0f;
+        simd_lib::RandomState top = {};
+        for (int lane = 0; lane < 8; ++lane) {
+            top.s[0][lane] = 0xFFFFFFFFu;
+        }
+        simd_lib::RandomState top_scalar = top;
+        float v[8], w[8];
+        simd_lib::fill_uniform(&top, v, 8, lo, hi);
+        simd_lib::fill_uniform_scalar(&top_scalar, w, 8, lo, hi);
+        for (int lane = 0; lane < 8; ++lane) {
+            top_ok &= v[lane] >= lo && v[lane] < hi && w[lane] >= lo && w[lane] < hi;
+        }
+    }
+
+    report("AVX2 matches scalar:", scalar_ok);
+    report("Lane 0 matches xoshiro128+:", reference_ok);
+    report("Independent of call split:", split_ok);
+    report("In [0, 1), mean and variance:",
+           range_ok && std::fabs(mean - 0.5) < 2e-3 && std::fabs(variance - 1.0 / 12.0) < 1e-3);
+    report("Scaled range [lo, hi):", scaled_ok);
+    report("Largest draw stays below hi:", top_ok);
+    std::cout << "\n";
+}
+
+void test_normal() {
+    std::cout << "=== Normal ===\n";
+
+    const size_t count = 1000000;
+    std::vector<float> a(count), b(count);
+    simd_lib::RandomState sa = simd_lib::random_state(5);
+    simd_lib::RandomState sb = sa;
+    simd_lib::fill_normal(&sa, a.data(), count);
+    simd_lib::fill_normal_scalar(&sb, b.data(), count, 0.0f, 1.0f);
+    // Polynomial log and sincos against libm
+    bool scalar_ok = same_state(sa, sb);
+    for (size_t i = 0; i < count; ++i) {
+        scalar_ok &= std::fabs(a[i] - b[i]) <= 1e-6f + 4e-6f * std::fabs(b[i]);
+    }
+
+    double sum = 0.0, sum_sq = 0.0, sum_4 = 0.0;
+    size_t within_one = 0;
+    bool finite = true;
+    for (float v : a) {
+        finite &= std::isfinite(v);
+        sum += v;
+        sum_sq += (double)v * v;
+        sum_4 += (double)v * v * v * v;
+        within_one += std::fabs(v) < 1.0f;
+    }
+    double mean = sum / count;
+    double variance = sum_sq / count - mean * mean;
+    double kurtosis = sum_4 / count / (variance * variance);
+    double fraction = (double)within_one / count;
+
+    std::vector<float> shifted(1000);
+    simd_lib::RandomState ss = simd_lib::random_state(5);
+    simd_lib::fill_normal(&ss, shifted.data(), shifted.size(), 10.0f, 2.0f);
+    bool shifted_ok = true;
+    for (size_t i = 0; i < shifted.size(); ++i) {
+        shifted_ok &= std::fabs(shifted[i] - (10.0f + 2.0f * a[i])) <= 1e-5f;
+    }
+
+    report("AVX2 matches scalar:", scalar_ok);
+    report("Mean 0, variance 1:", finite && std::fabs(mean) < 5e-3 && std::fabs(variance - 1.0) < 5e-3);
+    report("Kurtosis 3, 68.3% within 1 sigma:",
+           std::fabs(kurtosis - 3.0) < 0.05 && std::fabs(fraction - 0.6827) < 2e-3);
+    report("Mean and stddev parameters:", shifted_ok);
+    std::cout << "\n";
+}
+
+void test_streams() {
+    std::cout << "=== Streams ===\n";
+
+    simd_lib::RandomState base = simd_lib::random_state(99);
+    simd_lib::RandomState jumped = base;
+    for (int k = 0; k < 3; ++k) {
+        simd_lib::random_long_jump(&jumped);
+    }
+    bool seek_ok = same_state(jumped, simd_lib::random_state(99, 3));
+
+    // Lanes and streams must not start out correlated
+    std::vector<float> s0(4096), s1(4096);
+    simd_lib::RandomState r0 = simd_lib::random_state(99, 0), r1 = simd_lib::random_state(99, 1);
+    simd_lib::fill_uniform(&r0, s0.data(), s0.size());
+    simd_lib::fill_uniform(&r1, s1.data(), s1.size());
+    double correlation = 0.0;
+    size_t equal = 0;
+    for (size_t i = 0; i < s0.size(); ++i) {
+        correlation += (s0[i] - 0.5) * (s1[i] - 0.5);
+        equal += s0[i] == s1[i];
+    }
+    correlation /= s0.size() / 12.0;
+    bool lanes_distinct = true;
+    for (int lane = 1; lane < 8; ++lane) {
+        lanes_distinct &= base.s[0][lane] != base.s[0][0] || base.s[1][lane] != base.s[1][0];
+    }
+
+    // Per-thread streams: the result does not depend on how threads are scheduled
+    const size_t per_thread = 100000;
+    std::vector<float> parallel(4 * per_thread), serial(4 * per_thread);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            simd_lib::RandomState state = simd_lib::random_state(123, t);
+            simd_lib::fill_normal(&state, &parallel[t * per_thread], per_thread);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (size_t t = 0; t < 4; ++t) {
+        simd_lib::RandomState state = simd_lib::random_state(123, t);
+        simd_lib::fill_normal(&state, &serial[t * per_thread], per_thread);
+    }
+
+    report("Seek matches repeated jumps:", seek_ok);
+    report("Streams and lanes distinct:", lanes_distinct && equal < 4 && std::fabs(correlation) < 0.1);
+    report("Parallel streams reproducible:", parallel == serial);
+    std::cout << "\n";
+}
+
+void benchmark_random() {
+    std::cout << "=== Performance ===\n";
+
+    const size_t count = 10000000;
+    const int iterations = 5;
+    std::vector<float> out(count);
+    simd_lib::RandomState state = simd_lib::random_state(1);
+    std::mt19937 rng(1);
+
+    auto time_us = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+    auto print = [&](const char* name, double std_time, double scalar_time, double simd_time) {
+        std::cout << "  " << name << ":\n";
+        std::cout << "    std::mt19937: " << std_time << " us (" << count / std_time << " M/s)\n";
+        std::cout << "    Scalar:       " << scalar_time << " us (" << count / scalar_time << " M/s)\n";
+        std::cout << "    AVX2:         " << simd_time << " us (" << count / simd_time << " M/s)\n";
+        std::cout << "    Speedup vs mt19937: " << std_time / simd_time << "x\n";
+    };
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    print("Uniform, 10M floats", time_us([&] {
+              for (float& v : out) v = uniform(rng);
+          }),
+          time_us([&] { simd_lib::fill_uniform_scalar(&state, out.data(), count, 0.0f, 1.0f); }),
+          time_us([&] { simd_lib::fill_uniform(&state, out.data(), count); }));
+    print("Normal, 10M floats", time_us([&] {
+              for (float& v : out) v = normal(rng);
+          }),
+          time_us([&] { simd_lib::fill_normal_scalar(&state, out.data(), count, 0.0f, 1.0f); }),
+          time_us([&] { simd_lib::fill_normal(&state, out.data(), count); }));
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Random Generation Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_uniform();
+    test_normal();
+    test_streams();
+    benchmark_random();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
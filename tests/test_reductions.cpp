@@ -0,0 +1,189 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <cmath>
+#include <limits>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+void test_known_values() {
+    std::cout << "=== Known Values ===\n";
+
+    std::vector<float> a = {3.0f, -1.0f, 4.0f, 1.0f, -5.0f, 9.0f, 2.0f, 6.0f, 5.0f, 3.0f, 5.0f};
+    // sum 32, min -5 at 4, max 9 at 5, mean 32/11
+    report("sum", simd_lib::vector_sum(a.data(), a.size()) == 32.0f);
+    report("min", simd_lib::vector_min(a.data(), a.size()) == -5.0f);
+    report("max", simd_lib::vector_max(a.data(), a.size()) == 9.0f);
+    report("argmin", simd_lib::argmin(a.data(), a.size()) == 4);
+    report("argmax", simd_lib::argmax(a.data(), a.size()) == 5);
+
+    float lo, hi;
+    simd_lib::vector_minmax(a.data(), a.size(), &lo, &hi);
+    report("minmax", lo == -5.0f && hi == 9.0f);
+
+    double ref_mean = 32.0 / 11.0, ref_m2 = 0.0;
+    for (float v : a) ref_m2 += (v - ref_mean) * (v - ref_mean);
+    float mean, variance;
+    simd_lib::mean_variance(a.data(), a.size(), &mean, &variance);
+    report("mean/variance", std::fabs(mean - ref_mean) < 1e-6 && std::fabs(variance - ref_m2 / 11.0) < 1e-5);
+
+    // Ties: the first occurrence wins, including across SIMD lanes and blocks
+    std::vector<float> ties(1000, 0.0f);
+    ties[37] = ties[38] = ties[517] = 7.0f;
+    ties[3] = ties[900] = -7.0f;
+    report("argmax first of ties", simd_lib::argmax(ties.data(), ties.size()) == 37);
+    report("argmin first of ties", simd_lib::argmin(ties.data(), ties.size()) == 3);
+    std::vector<float> flat(777, 1.0f);
+    report("argmin/argmax constant input",
+           simd_lib::argmin(flat.data(), flat.size()) == 0 && simd_lib::argmax(flat.data(), flat.size()) == 0);
+
+    // Empty input
+    simd_lib::vector_minmax(a.data(), 0, &lo, &hi);
+    simd_lib::mean_variance(a.data(), 0, &mean, &variance);
+    report("empty input", simd_lib::vector_sum(a.data(), 0) == 0.0f &&
+           lo == std::numeric_limits<float>::infinity() && hi == -std::numeric_limits<float>::infinity() &&
+           simd_lib::argmin(a.data(), 0) == 0 && mean == 0.0f && variance == 0.0f);
+    std::cout << "\n";
+}
+
+void test_precision() {
+    std::cout << "=== Precision vs Double Reference ===\n";
+
+    std::mt19937 gen(29);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+
+    bool ok = true;
+    double worst_sum = 0.0, worst_var = 0.0;
+    for (size_t n : {1, 7, 8, 31, 33, 1000, 4097, 100003, 1 << 20}) {
+        std::vector<float> a(n);
+        // A large offset stresses the variance: naive E[x^2] - E[x]^2 loses everything
+        for (auto& v : a) v = 1000.0f + dis(gen);
+
+        double ref_sum = 0.0, ref_abs = 0.0;
+        for (float v : a) {
+            ref_sum += v;
+            ref_abs += std::fabs(v);
+        }
+        double ref_mean = ref_sum / n, ref_m2 = 0.0;
+        for (float v : a) ref_m2 += (v - ref_mean) * (v - ref_mean);
+        double ref_var = ref_m2 / n;
+
+        for (size_t threads : {1, 4}) {
+            float sum = simd_lib::vector_sum(a.data(), n, threads);
+            float mean, variance;
+            simd_lib::mean_variance(a.data(), n, &mean, &variance, threads);
+
+            // Blocked summation error grows with n / lanes; scale by sum |x|
+            double sum_err = std::fabs(sum - ref_sum) / ref_abs;
+            double var_err = ref_var > 0.0 ? std::fabs(variance - ref_var) / ref_var : std::fabs(variance);
+            worst_sum = std::max(worst_sum, sum_err);
+            worst_var = std::max(worst_var, var_err);
+            ok = ok && sum_err < 1e-4 && std::fabs(mean - ref_mean) < 1e-3 && var_err < 1e-3;
+        }
+    }
+    std::cout << "  worst relative sum error      " << std::scientific << std::setprecision(2) << worst_sum << "\n";
+    std::cout << "  worst relative variance error " << worst_var << "\n";
+    report("sum and mean/variance", ok);
+    std::cout << "\n";
+}
+
+void test_simd_matches_scalar() {
+    std::cout << "=== SIMD vs Scalar, Multithreaded ===\n";
+
+    std::mt19937 gen(31);
+    std::uniform_real_distribution<float> dis(-100.0f, 100.0f);
+
+    bool extremes_ok = true, threads_ok = true;
+    for (size_t n : {1, 5, 8, 9, 16, 17, 63, 64, 65, 1001, 300007}) {
+        std::vector<float> a(n);
+        for (auto& v : a) v = dis(gen);
+
+        float lo, hi;
+        simd_lib::vector_minmax(a.data(), n, &lo, &hi);
+        extremes_ok = extremes_ok && lo == simd_lib::vector_min_scalar(a.data(), n) &&
+                      hi == simd_lib::vector_max_scalar(a.data(), n) &&
+                      simd_lib::vector_min(a.data(), n) == lo && simd_lib::vector_max(a.data(), n) == hi &&
+                      simd_lib::argmin(a.data(), n) == simd_lib::argmin_scalar(a.data(), n) &&
+                      simd_lib::argmax(a.data(), n) == simd_lib::argmax_scalar(a.data(), n);
+
+        float lo4, hi4;
+        simd_lib::vector_minmax(a.data(), n, &lo4, &hi4, 4);
+        threads_ok = threads_ok && lo4 == lo && hi4 == hi &&
+                     simd_lib::argmin(a.data(), n, 4) == simd_lib::argmin_scalar(a.data(), n) &&
+                     simd_lib::argmax(a.data(), n, 0) == simd_lib::argmax_scalar(a.data(), n);
+    }
+    report("min/max/argmin/argmax", extremes_ok);
+    report("threaded results identical", threads_ok);
+
+    // Extremes placed at the last element exercise the scalar tail
+    std::vector<float> a(203, 0.0f);
+    a[202] = -1.0f;
+    report("argmin in tail", simd_lib::argmin(a.data(), a.size()) == 202);
+    std::cout << "\n";
+}
+
+void benchmark_reductions() {
+    std::cout << "=== Reduction Benchmark (4M elements) ===\n";
+
+    const size_t count = 1 << 22;
+    std::vector<float> a(count);
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    for (auto& v : a) v = dis(gen);
+
+    volatile float sink = 0.0f;
+    auto time_us = [](auto&& fn) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 10; ++i) fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        return (long long)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    };
+    auto print = [](const char* name, long long scalar_time, long long simd_time) {
+        std::cout << "  " << std::left << std::setw(14) << name << std::right
+                  << "scalar " << std::setw(8) << scalar_time << " us   SIMD "
+                  << std::setw(8) << simd_time << " us   " << std::fixed << std::setprecision(2)
+                  << (double)scalar_time / simd_time << "x\n";
+    };
+
+    print("sum",
+          time_us([&] { sink = simd_lib::vector_sum_scalar(a.data(), count); }),
+          time_us([&] { sink = simd_lib::vector_sum(a.data(), count); }));
+    print("minmax",
+          time_us([&] { float lo, hi; simd_lib::vector_minmax_scalar(a.data(), count, &lo, &hi); sink = lo; }),
+          time_us([&] { float lo, hi; simd_lib::vector_minmax(a.data(), count, &lo, &hi); sink = lo; }));
+    print("argmax",
+          time_us([&] { sink = (float)simd_lib::argmax_scalar(a.data(), count); }),
+          time_us([&] { sink = (float)simd_lib::argmax(a.data(), count); }));
+    print("mean_variance",
+          time_us([&] { float m, v; simd_lib::mean_variance_scalar(a.data(), count, &m, &v); sink = v; }),
+          time_us([&] { float m, v; simd_lib::mean_variance(a.data(), count, &m, &v); sink = v; }));
+    print("sum 4 threads",
+          time_us([&] { sink = simd_lib::vector_sum(a.data(), count); }),
+          time_us([&] { sink = simd_lib::vector_sum(a.data(), count, 4); }));
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Reductions Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_known_values();
+    test_precision();
+    test_simd_matches_scalar();
+    benchmark_reductions();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+#include "simd_lib.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <cmath>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+// Largest |result - reference| relative to the running sum of |input|
+static double scan_error(const std::vector<float>& input, const std::vector<float>& result, bool exclusive) {
+    double running = 0.0, running_abs = 0.0, worst = 0.0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        if (!exclusive) {
+            running += input[i];
+            running_abs += std::fabs(input[i]);
+        }
+        double scale = running_abs > 0.0 ? running_abs : 1.0;
+        worst = std::max(worst, std::fabs(result[i] - running) / scale);
+        if (exclusive) {
+            running += input[i];
+            running_abs += std::fabs(input[i]);
+        }
+    }
+    return worst;
+}
+
+void test_known_values() {
+    std::cout << "=== Known Values ===\n";
+
+    // Integers stay exact, so every lane and carry path must match exactly
+    bool ok = true;
+    for (size_t n : {0, 1, 7, 8, 9, 15, 16, 17, 33, 100}) {
+        std::vector<float> a(n), inc(n), exc(n);
+        for (size_t i = 0; i < n; ++i) a[i] = (float)(i + 1);
+        simd_lib::inclusive_scan(a.data(), inc.data(), n);
+        simd_lib::exclusive_scan(a.data(), exc.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            float tri = (float)((i + 1) * (i + 2) / 2);
+            ok = ok && inc[i] == tri && exc[i] == tri - a[i];
+        }
+    }
+    report("inclusive/exclusive 1..n", ok);
+
+    std::vector<float> a(37), b(37);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = (float)(i % 5) - 2.0f;
+    simd_lib::inclusive_scan(a.data(), b.data(), a.size());
+    std::vector<float> in_place = a;
+    simd_lib::inclusive_scan(in_place.data(), in_place.data(), in_place.size());
+    bool same = in_place == b;
+    simd_lib::exclusive_scan(a.data(), b.data(), a.size());
+    in_place = a;
+    simd_lib::exclusive_scan(in_place.data(), in_place.data(), in_place.size());
+    report("in place", same && in_place == b);
+
+    // Carry in/out lets a long array be scanned in pieces
+    std::vector<float> pieces(100);
+    float carry = simd_lib::inclusive_scan_avx2(a.data(), pieces.data(), 20, 0.0f);
+    simd_lib::inclusive_scan_avx2(a.data() + 20, pieces.data() + 20, 17, carry);
+    simd_lib::inclusive_scan(a.data(), b.data(), 37);
+    report("carry continues a scan", std::equal(b.begin(), b.end(), pieces.begin()));
+    std::cout << "\n";
+}
+
+void test_precision_and_threads() {
+    std::cout << "=== Precision and Threaded Block Scan ===\n";
+
+    std::mt19937 gen(41);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+
+    const size_t n = (1 << 20) + 13;
+    std::vector<float> a(n), inc(n), exc(n), inc4(n), exc4(n);
+    for (auto& v : a) v = dis(gen);
+
+    simd_lib::inclusive_scan(a.data(), inc.data(), n);
+    simd_lib::exclusive_scan(a.data(), exc.data(), n);
+    simd_lib::inclusive_scan(a.data(), inc4.data(), n, 4);
+    simd_lib::exclusive_scan(a.data(), exc4.data(), n, 4);
+
+    double errors[] = {scan_error(a, inc, false), scan_error(a, exc, true),
+                       scan_error(a, inc4, false), scan_error(a, exc4, true)};
+    std::cout << "  worst relative error " << std::scientific << std::setprecision(2)
+              << *std::max_element(std::begin(errors), std::end(errors)) << "\n";
+    report("inclusive 1 thread", errors[0] < 1e-5);
+    report("exclusive 1 thread", errors[1] < 1e-5);
+    report("inclusive 4 threads", errors[2] < 1e-5);
+    report("exclusive 4 threads", errors[3] < 1e-5);
+
+    // Scalar and AVX2 agree to rounding
+    std::vector<float> ref(n);
+    simd_lib::inclusive_scan_scalar(a.data(), ref.data(), n, 0.0f);
+    report("scalar reference", scan_error(a, ref, false) < 1e-5);
+    std::cout << "\n";
+}
+
+void test_summed_area_table() {
+    std::cout << "=== Summed-Area Table ===\n";
+
+    const size_t rows = 301, cols = 517;
+    std::vector<float> image(rows * cols), table(rows * cols), table4(rows * cols), ref(rows * cols);
+    std::mt19937 gen(43);
+    std::uniform_int_distribution<int> dis(0, 3);
+    for (auto& v : image) v = (float)dis(gen);
+
+    // Small integers keep every sum exact, so all paths must agree exactly
+    simd_lib::summed_area_table(image.data(), table.data(), rows, cols);
+    simd_lib::summed_area_table(image.data(), table4.data(), rows, cols, 4);
+    simd_lib::summed_area_table_scalar(image.data(), ref.data(), rows, cols);
+
+    bool brute_ok = true;
+    for (size_t r : {(size_t)0, (size_t)1, rows / 2, rows - 1}) {
+        for (size_t c : {(size_t)0, (size_t)7, cols / 3, cols - 1}) {
+            double sum = 0.0;
+            for (size_t i = 0; i <= r; ++i)
+                for (size_t j = 0; j <= c; ++j) sum += image[i * cols + j];
+            brute_ok = brute_ok && table[r * cols + c] == (float)sum;
+        }
+    }
+    report("matches brute force", brute_ok);
+    report("matches scalar", table == ref);
+    report("threaded matches single", table4 == table);
+
+    // Box sum from four lookups
+    size_t r0 = 10, c0 = 20, r1 = 200, c1 = 400;
+    double box = 0.0;
+    for (size_t i = r0; i <= r1; ++i)
+        for (size_t j = c0; j <= c1; ++j) box += image[i * cols + j];
+    float lookup = table[r1 * cols + c1] - table[(r0 - 1) * cols + c1] - table[r1 * cols + c0 - 1] +
+                   table[(r0 - 1) * cols + c0 - 1];
+    report("box sum lookup", lookup == (float)box);
+
+    std::vector<float> in_place = image;
+    simd_lib::summed_area_table(in_place.data(), in_place.data(), rows, cols);
+    report("in place", in_place == table);
+    std::cout << "\n";
+}
+
+void benchmark_scan() {
+    std::cout << "=== Scan Benchmark ===\n";
+
+    const size_t count = 1 << 24;
+    std::vector<float> a(count), b(count, 0.0f);
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    for (auto& v : a) v = dis(gen);
+
+    const size_t small = 1 << 14;
+    auto time_small = [&](auto&& fn) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 5000; ++i) fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        return (long long)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    };
+    long long small_scalar = time_small([&] { simd_lib::inclusive_scan_scalar(a.data(), b.data(), small, 0.0f); });
+    long long small_simd = time_small([&] { simd_lib::inclusive_scan(a.data(), b.data(), small); });
+    std::cout << "  inclusive_scan 16K   scalar " << std::setw(8) << small_scalar << " us   SIMD "
+              << std::setw(8) << small_simd << " us   " << std::fixed << std::setprecision(2)
+              << (double)small_scalar / small_simd << "x\n";
+
+    auto time_us = [](auto&& fn) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 5; ++i) fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        return (long long)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    };
+
+    long long scalar_time = time_us([&] { simd_lib::inclusive_scan_scalar(a.data(), b.data(), count, 0.0f); });
+    long long simd_time = time_us([&] { simd_lib::inclusive_scan(a.data(), b.data(), count); });
+    long long threaded_time = time_us([&] { simd_lib::inclusive_scan(a.data(), b.data(), count, 0); });
+    std::cout << "  inclusive_scan 16M   scalar " << std::setw(8) << scalar_time << " us   SIMD "
+              << std::setw(8) << simd_time << " us   all cores " << std::setw(8) << threaded_time << " us   "
+              << std::fixed << std::setprecision(2) << (double)scalar_time / simd_time << "x\n";
+
+    const size_t rows = 2048, cols = 2048;
+    std::vector<float> image(rows * cols, 1.0f), table(rows * cols);
+    scalar_time = time_us([&] { simd_lib::summed_area_table_scalar(image.data(), table.data(), rows, cols); });
+    simd_time = time_us([&] { simd_lib::summed_area_table(image.data(), table.data(), rows, cols); });
+    std::cout << "  summed_area 2048^2   scalar " << std::setw(8) << scalar_time << " us   SIMD "
+              << std::setw(8) << simd_time << " us   " << std::fixed << std::setprecision(2)
+              << (double)scalar_time / simd_time << "x\n\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Prefix Sum Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_known_values();
+    test_precision_and_threads();
+    test_summed_area_table();
+    benchmark_scan();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
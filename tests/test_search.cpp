@@ -0,0 +1,175 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static bool close_enough(const std::vector<float>& a, const std::vector<float>& b, float tolerance) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::fabs(a[i] - b[i]) > tolerance * std::max(1.0f, std::fabs(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_batch_kernels() {
+    std::cout << "=== Batched Similarity Kernels ===\n";
+
+    // Odd row count and dimension exercise the row and element tails
+    const size_t rows = 1003, dim = 37;
+    std::vector<float> query(dim), matrix(rows * dim), out(rows), expected(rows);
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    for (auto& v : query) v = dis(gen);
+    for (auto& v : matrix) v = dis(gen);
+    // A zero row must score 0 under cosine
+    std::fill(matrix.begin() + 5 * dim, matrix.begin() + 6 * dim, 0.0f);
+
+    simd_lib::batch_dot(query.data(), matrix.data(), rows, dim, out.data());
+    simd_lib::batch_dot_scalar(query.data(), matrix.data(), rows, dim, expected.data());
+    report("batch_dot", close_enough(out, expected, 1e-5f));
+
+    simd_lib::batch_l2_squared(query.data(), matrix.data(), rows, dim, out.data(), 4);
+    simd_lib::batch_l2_squared_scalar(query.data(), matrix.data(), rows, dim, expected.data());
+    report("batch_l2_squared (4 threads)", close_enough(out, expected, 1e-5f));
+
+    simd_lib::batch_cosine(query.data(), matrix.data(), rows, dim, out.data());
+    simd_lib::batch_cosine_scalar(query.data(), matrix.data(), rows, dim, expected.data());
+    report("batch_cosine", close_enough(out, expected, 1e-5f) && out[5] == 0.0f);
+
+    std::vector<uint32_t> positions(rows), expected_positions(rows);
+    size_t found = simd_lib::select_greater(out.data(), rows, 0.25f, positions.data());
+    size_t expected_found = simd_lib::select_greater_scalar(out.data(), rows, 0.25f, expected_positions.data());
+    report("select_greater", found == expected_found &&
+           std::equal(positions.begin(), positions.begin() + found, expected_positions.begin()));
+    std::cout << "\n";
+}
+
+void test_top_k() {
+    std::cout << "=== Top-k Selection ===\n";
+
+    const size_t rows = 20000, dim = 64, k = 10;
+    std::vector<float> query(dim), matrix(rows * dim), scores(rows);
+    std::mt19937 gen(11);
+    std::normal_distribution<float> dis(0.0f, 1.0f);
+    for (auto& v : query) v = dis(gen);
+    for (auto& v : matrix) v = dis(gen);
+
+    struct Case {
+        const char* name;
+        simd_lib::SimilarityMetric metric;
+        bool smaller_is_better;
+    };
+    Case cases[] = {
+        {"Top-k dot product", simd_lib::SimilarityMetric::DotProduct, false},
+        {"Top-k L2 squared", simd_lib::SimilarityMetric::L2Squared, true},
+        {"Top-k cosine", simd_lib::SimilarityMetric::Cosine, false},
+    };
+
+    for (const auto& c : cases) {
+        if (c.metric == simd_lib::SimilarityMetric::DotProduct) {
+            simd_lib::batch_dot_scalar(query.data(), matrix.data(), rows, dim, scores.data());
+        } else if (c.metric == simd_lib::SimilarityMetric::L2Squared) {
+            simd_lib::batch_l2_squared_scalar(query.data(), matrix.data(), rows, dim, scores.data());
+        } else {
+            simd_lib::batch_cosine_scalar(query.data(), matrix.data(), rows, dim, scores.data());
+        }
+        std::vector<size_t> order(rows);
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](size_t a, size_t b) {
+            return c.smaller_is_better ? scores[a] < scores[b] : scores[a] > scores[b];
+        });
+
+        bool correct = true;
+        for (size_t threads : {1, 4}) {
+            std::vector<size_t> indices(k);
+            std::vector<float> best(k);
+            size_t found = simd_lib::top_k_search(query.data(), matrix.data(), rows, dim, k,
+                                                  c.metric, indices.data(), best.data(), threads);
+            correct &= found == k;
+            for (size_t i = 0; i < k; ++i) {
+                correct &= indices[i] == order[i];
+                correct &= std::fabs(best[i] - scores[order[i]]) < 1e-3f * std::max(1.0f, std::fabs(best[i]));
+            }
+        }
+        report(c.name, correct);
+    }
+
+    std::vector<size_t> indices(5);
+    std::vector<float> best(5);
+    size_t found = simd_lib::top_k_search(query.data(), matrix.data(), 3, dim, 5,
+                                          simd_lib::SimilarityMetric::DotProduct, indices.data(), best.data());
+    report("k larger than rows", found == 3);
+    std::cout << "\n";
+}
+
+void benchmark_search() {
+    std::cout << "=== Similarity Search Benchmark ===\n";
+
+    const size_t rows = 100000, dim = 128, k = 10;
+    std::vector<float> query(dim), matrix(rows * dim), scores(rows);
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+    for (auto& v : query) v = dis(gen);
+    for (auto& v : matrix) v = dis(gen);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < 10; ++it) {
+        for (size_t r = 0; r < rows; ++r) {
+            scores[r] = simd_lib::dot_product(query.data(), &matrix[r * dim], dim);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto loop_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < 10; ++it) {
+        simd_lib::batch_dot(query.data(), matrix.data(), rows, dim, scores.data());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto batch_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    std::vector<size_t> indices(k);
+    std::vector<float> best(k);
+    start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < 10; ++it) {
+        simd_lib::top_k_search(query.data(), matrix.data(), rows, dim, k,
+                               simd_lib::SimilarityMetric::DotProduct, indices.data(), best.data());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto top_k_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    std::cout << "  dot_product loop: " << loop_time.count() << " us\n";
+    std::cout << "  batch_dot:        " << batch_time.count() << " us\n";
+    std::cout << "  top_k_search:     " << top_k_time.count() << " us\n";
+    std::cout << "  Speedup:          " << std::fixed << std::setprecision(2)
+              << (double)loop_time.count() / batch_time.count() << "x\n\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Similarity Search Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_batch_kernels();
+    test_top_k();
+    benchmark_search();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+#include "simd_lib.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+enum class Distribution { Random, Sorted, Reverse, Equal, FewUnique, Infinite };
+
+static std::vector<float> make_input(size_t count, Distribution distribution, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+    std::uniform_int_distribution<int> few(0, 3);
+    std::vector<float> x(count);
+    for (size_t i = 0; i < count; ++i) {
+        switch (distribution) {
+        case Distribution::Random:
+            x[i] = dist(rng);
+            break;
+        case Distribution::Sorted:
+            x[i] = (float)i;
+            break;
+        case Distribution::Reverse:
+            x[i] = (float)(count - i);
+            break;
+        case Distribution::Equal:
+            x[i] = 7.0f;
+            break;
+        case Distribution::FewUnique:
+            x[i] = (float)few(rng);
+            break;
+        case Distribution::Infinite: {
+            int pick = few(rng);
+            float inf = std::numeric_limits<float>::infinity();
+            x[i] = pick == 0 ? inf : pick == 1 ? -inf : dist(rng);
+            break;
+        }
+        }
+    }
+    return x;
+}
+
+static const Distribution kDistributions[] = {Distribution::Random, Distribution::Sorted, Distribution::Reverse,
+                                              Distribution::Equal, Distribution::FewUnique, Distribution::Infinite};
+
+static std::vector<size_t> test_sizes() {
+    std::vector<size_t> sizes;
+    for (size_t n = 0; n <= 130; ++n) {
+        sizes.push_back(n);
+    }
+    for (size_t n : {255, 256, 257, 1000, 4099, 65536, 100000}) {
+        sizes.push_back(n);
+    }
+    return sizes;
+}
+
+void test_sort_floats() {
+    std::cout << "=== Sort ===\n";
+
+    std::mt19937 rng(1);
+    bool dispatch_ok = true, avx2_ok = true;
+    for (Distribution distribution : kDistributions) {
+        for (size_t count : test_sizes()) {
+            std::vector<float> x = make_input(count, distribution, rng);
+            std::vector<float> expected = x;
+            std::sort(expected.begin(), expected.end());
+            std::vector<float> a = x, b = x;
+            simd_lib::sort_floats(a.data(), count);
+            dispatch_ok &= a == expected;
+            if (simd_lib::get_cpu_features().has_avx2) {
+                simd_lib::sort_floats_avx2(b.data(), count);
+                avx2_ok &= b == expected;
+            }
+        }
+    }
+
+    // Patterns that defeat a median-of-three pivot fall back instead of going quadratic
+    std::vector<float> organ(200000);
+    for (size_t i = 0; i < organ.size(); ++i) {
+        organ[i] = (float)std::min(i, organ.size() - i);
+    }
+    std::vector<float> organ_expected = organ;
+    std::sort(organ_expected.begin(), organ_expected.end());
+    simd_lib::sort_floats(organ.data(), organ.size());
+
+    report("Matches std::sort:", dispatch_ok);
+    report("AVX2 kernel matches std::sort:", avx2_ok);
+    report("Organ pipe input:", organ == organ_expected);
+    std::cout << "\n";
+}
+
+void test_sort_key_value() {
+    std::cout << "=== Key-Value Sort ===\n";
+
+    std::mt19937 rng(2);
+    bool keys_ok = true, permutation_ok = true;
+    for (Distribution distribution : kDistributions) {
+        for (size_t count : test_sizes()) {
+            std::vector<float> keys = make_input(count, distribution, rng);
+            std::vector<float> original = keys;
+            std::vector<float> expected = keys;
+            std::sort(expected.begin(), expected.end());
+            std::vector<uint32_t> values(count);
+            for (size_t i = 0; i < count; ++i) {
+                values[i] = (uint32_t)i;
+            }
+            simd_lib::sort_key_value(keys.data(), values.data(), count);
+            keys_ok &= keys == expected;
+            // Every index appears once and still points at its key
+            std::vector<bool> seen(count, false);
+            for (size_t i = 0; i < count; ++i) {
+                bool valid = values[i] < count && !seen[values[i]];
+                permutation_ok &= valid && original[values[i]] == keys[i];
+                if (valid) {
+                    seen[values[i]] = true;
+                }
+            }
+        }
+    }
+
+    report("Keys match std::sort:", keys_ok);
+    report("Values follow their keys:", permutation_ok);
+    std::cout << "\n";
+}
+
+void test_select_and_quantile() {
+    std::cout << "=== Selection and Quantiles ===\n";
+
+    std::mt19937 rng(3);
+    bool select_ok = true, quantile_ok = true;
+    for (Distribution distribution : kDistributions) {
+        for (size_t count : {1, 2, 63, 64, 65, 100, 1001, 50000}) {
+            std::vector<float> x = make_input(count, distribution, rng);
+            std::vector<float> sorted = x;
+            std::sort(sorted.begin(), sorted.end());
+            for (size_t n : {(size_t)0, count / 3, count / 2, count - 1}) {
+                std::vector<float> y = x;
+                float value = simd_lib::select_nth(y.data(), count, n);
+                bool ok = value == sorted[n] && y[n] == value;
+                for (size_t i = 0; i < count; ++i) {
+                    ok &= i < n ? y[i] <= value : y[i] >= value;
+                }
+                std::sort(y.begin(), y.end());
+                select_ok &= ok && y == sorted;
+            }
+
+            // Type 7: linear interpolation between order statistics
+            const double qs[] = {0.9, 0.0, 0.25, 0.5, 0.75, 0.99, 1.0};
+            float out[7];
+            simd_lib::quantiles(x.data(), count, qs, 7, out);
+            for (size_t i = 0; i < 7; ++i) {
+                double h = qs[i] * (count - 1);
+                size_t lo = (size_t)std::floor(h);
+                size_t hi = std::min(lo + 1, count - 1);
+                double expected = h == lo || sorted[lo] == sorted[hi]
+                                      ? sorted[lo]
+                                      : sorted[lo] + (h - lo) * ((double)sorted[hi] - sorted[lo]);
+                // Interpolating from -inf to a finite value is NaN, as in numpy
+                float single = simd_lib::quantile(x.data(), count, qs[i]);
+                bool same = out[i] == (float)expected || std::fabs(out[i] - expected) <= 1e-4 * std::fabs(expected) ||
+                            (std::isnan(expected) && std::isnan(out[i]));
+                quantile_ok &= same && (out[i] == single || (std::isnan(out[i]) && std::isnan(single)));
+            }
+        }
+    }
+
+    float empty_quantile = simd_lib::quantile(nullptr, 0, 0.5);
+    float one = 1.0f;
+    float out_of_range = simd_lib::select_nth(&one, 1, 1);
+
+    report("select_nth partitions around n:", select_ok);
+    report("Quantiles match type 7:", quantile_ok);
+    report("Empty and out of range give NaN:", std::isnan(empty_quantile) && std::isnan(out_of_range) && one == 1.0f);
+    std::cout << "\n";
+}
+
+void benchmark_sort() {
+    std::cout << "=== Performance ===\n";
+
+    const size_t count = 1 << 20;
+    const int iterations = 10;
+    std::mt19937 rng(4);
+    std::vector<float> x = make_input(count, Distribution::Random, rng);
+    std::vector<float> y(count);
+    std::vector<uint32_t> values(count);
+
+    // Each run sorts a fresh copy of the same input; the copy is timed for both sides
+    auto time_us = [&](auto&& fn) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            std::copy(x.begin(), x.end(), y.begin());
+            for (size_t i = 0; i < count; ++i) {
+                values[i] = (uint32_t)i;
+            }
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+    auto print = [&](const char* name, double scalar_time, double simd_time) {
+        std::cout << "  " << name << ":\n";
+        std::cout << "    Scalar: " << scalar_time << " us (" << count / scalar_time << " M/s)\n";
+        std::cout << "    AVX2:   " << simd_time << " us (" << count / simd_time << " M/s)\n";
+        std::cout << "    Speedup: " << scalar_time / simd_time << "x\n";
+    };
+    std::cout << std::fixed << std::setprecision(2);
+
+    print("Sort 1M floats", time_us([&] { simd_lib::sort_floats_scalar(y.data(), count); }),
+          time_us([&] { simd_lib::sort_floats(y.data(), count); }));
+    print("Sort 1M key-index pairs", time_us([&] { simd_lib::sort_key_value_scalar(y.data(), values.data(), count); }),
+          time_us([&] { simd_lib::sort_key_value(y.data(), values.data(), count); }));
+    print("Median of 1M floats", time_us([&] { simd_lib::select_nth_scalar(y.data(), count, count / 2); }),
+          time_us([&] { simd_lib::select_nth(y.data(), count, count / 2); }));
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Sort and Selection Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_sort_floats();
+    test_sort_key_value();
+    test_select_and_quantile();
+    benchmark_sort();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,319 @@
+#include "simd_lib.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+struct SparseVector {
+    std::vector<uint32_t> indices;
+    std::vector<float> values;
+};
+
+// Each index of [0, dim) is present with the given probability
+static SparseVector random_sparse(size_t dim, double density, std::mt19937& rng) {
+    std::bernoulli_distribution keep(density);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    SparseVector v;
+    for (size_t i = 0; i < dim; ++i) {
+        if (keep(rng)) {
+            v.indices.push_back((uint32_t)i);
+            v.values.push_back(dist(rng));
+        }
+    }
+    return v;
+}
+
+static std::vector<float> random_dense(size_t dim, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> v(dim);
+    for (float& x : v) {
+        x = dist(rng);
+    }
+    return v;
+}
+
+static double reference_dot(const SparseVector& a, const std::vector<float>& dense) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.indices.size(); ++i) {
+        sum += (double)a.values[i] * dense[a.indices[i]];
+    }
+    return sum;
+}
+
+// Float sums of n terms of magnitude <= 1 stay within a few ulps of n
+static bool close(double value, double expected, size_t terms) {
+    return std::fabs(value - expected) <= 1e-6 * (terms + 1);
+}
+
+void test_sparse_dense() {
+    std::cout << "=== Sparse-Dense Dot ===\n";
+
+    std::mt19937 rng(1);
+    bool dispatch_ok = true, avx2_ok = true, delta_ok = true;
+    for (size_t dim : {1, 7, 8, 9, 15, 16, 17, 33, 100, 1000, 4096, 100000}) {
+        for (double density : {0.05, 0.5, 1.0}) {
+            std::vector<float> dense = random_dense(dim, rng);
+            SparseVector a = random_sparse(dim, density, rng);
+            size_t nnz = a.indices.size();
+            double expected = reference_dot(a, dense);
+            dispatch_ok &= close(simd_lib::sparse_dot_dense(a.indices.data(), a.values.data(), nnz, dense.data()),
+                                 expected, nnz);
+            if (simd_lib::get_cpu_features().has_avx2 && simd_lib::get_cpu_features().has_fma) {
+                avx2_ok &= close(simd_lib::sparse_dot_dense_avx2(a.indices.data(), a.values.data(), nnz,
+                                                                 dense.data()), expected, nnz);
+            }
+            simd_lib::SparseVector16 c = simd_lib::compress_sparse_indices(a.indices.data(), a.values.data(), nnz);
+            delta_ok &= c.deltas.size() == nnz &&
+                        close(simd_lib::sparse_dot_dense_delta16(c.deltas.data(), c.values.data(), nnz, dense.data()),
+                              expected, nnz);
+        }
+    }
+
+    // Gaps above 65535 are bridged with zero-valued fillers
+    std::vector<float> wide = random_dense(1000000, rng);
+    SparseVector far;
+    for (uint32_t index : {3u, 10u, 70000u, 70001u, 200000u, 600000u}) {
+        far.indices.push_back(index);
+        far.values.push_back(0.5f);
+    }
+    for (uint32_t index = 999990; index <= 999999; ++index) {
+        far.indices.push_back(index);
+        far.values.push_back(0.25f);
+    }
+    simd_lib::SparseVector16 far16 = simd_lib::compress_sparse_indices(far.indices.data(), far.values.data(),
+                                                                       far.indices.size());
+    size_t decoded_last = 0;
+    for (uint16_t delta : far16.deltas) {
+        decoded_last += delta;
+    }
+    double far_expected = reference_dot(far, wide);
+    float far_scalar = simd_lib::sparse_dot_dense_delta16_scalar(far16.deltas.data(), far16.values.data(),
+                                                                 far16.deltas.size(), wide.data());
+    float far_dispatch = simd_lib::sparse_dot_dense_delta16(far16.deltas.data(), far16.values.data(),
+                                                            far16.deltas.size(), wide.data());
+    bool far_ok = far16.deltas.size() > far.indices.size() && decoded_last == 999999 &&
+                  close(far_scalar, far_expected, 16) && close(far_dispatch, far_expected, 16);
+
+    report("Dispatch matches reference:", dispatch_ok);
+    report("AVX2 gather matches reference:", avx2_ok);
+    report("Delta16 matches reference:", delta_ok);
+    report("Delta16 gaps above 65535:", far_ok);
+    std::cout << "\n";
+}
+
+void test_sparse_sparse() {
+    std::cout << "=== Sparse-Sparse Dot ===\n";
+
+    std::mt19937 rng(2);
+    bool dispatch_ok = true, avx2_ok = true;
+    for (size_t dim : {0, 1, 8, 16, 17, 64, 100, 1000, 50000}) {
+        for (double density_a : {0.02, 0.3, 1.0}) {
+            for (double density_b : {0.05, 0.5, 1.0}) {
+                SparseVector a = random_sparse(dim, density_a, rng);
+                SparseVector b = random_sparse(dim, density_b, rng);
+                std::vector<float> b_dense(dim, 0.0f);
+                for (size_t i = 0; i < b.indices.size(); ++i) {
+                    b_dense[b.indices[i]] = b.values[i];
+                }
+                double expected = reference_dot(a, b_dense);
+                size_t terms = std::min(a.indices.size(), b.indices.size());
+                dispatch_ok &= close(simd_lib::sparse_dot_sparse(a.indices.data(), a.values.data(), a.indices.size(),
+                                                                 b.indices.data(), b.values.data(), b.indices.size()),
+                                     expected, terms);
+                if (simd_lib::get_cpu_features().has_avx2 && simd_lib::get_cpu_features().has_fma) {
+                    // Also with the operands swapped, so either side can run out first
+                    avx2_ok &= close(simd_lib::sparse_dot_sparse_avx2(a.indices.data(), a.values.data(),
+                                                                      a.indices.size(), b.indices.data(),
+                                                                      b.values.data(), b.indices.size()),
+                                     expected, terms);
+                    avx2_ok &= close(simd_lib::sparse_dot_sparse_avx2(b.indices.data(), b.values.data(),
+                                                                      b.indices.size(), a.indices.data(),
+                                                                      a.values.data(), a.indices.size()),
+                                     expected, terms);
+                }
+            }
+        }
+    }
+
+    report("Dispatch matches reference:", dispatch_ok);
+    report("AVX2 intersection matches:", avx2_ok);
+    std::cout << "\n";
+}
+
+void test_spmv() {
+    std::cout << "=== CSR spmv ===\n";
+
+    std::mt19937 rng(3);
+    const size_t rows = 777, cols = 1500;
+    std::vector<float> dense(rows * cols, 0.0f);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t r = 0; r < rows; ++r) {
+        // A few dense rows and some empty ones unbalance a plain row split
+        double density = r % 97 == 0 ? 1.0 : (r % 13 == 0 ? 0.0 : 0.05);
+        std::bernoulli_distribution row_keep(density);
+        for (size_t c = 0; c < cols; ++c) {
+            if (row_keep(rng)) {
+                dense[r * cols + c] = dist(rng);
+            }
+        }
+    }
+    std::vector<float> x = random_dense(cols, rng);
+
+    simd_lib::CsrMatrix csr = simd_lib::csr_from_dense(dense.data(), rows, cols);
+    simd_lib::CsrMatrix16 csr16 = simd_lib::compress_csr_indices(csr);
+    bool structure_ok = csr.row_offsets.size() == rows + 1 && csr.row_offsets.back() == csr.values.size() &&
+                        csr16.values.size() == csr.values.size();
+    std::vector<float> rebuilt(rows * cols, 0.0f);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t k = csr.row_offsets[r]; k < csr.row_offsets[r + 1]; ++k) {
+            rebuilt[r * cols + csr.col_indices[k]] = csr.values[k];
+        }
+    }
+    structure_ok &= rebuilt == dense;
+
+    std::vector<float> y1(rows), y4(rows), y16(rows), y16_threads(rows);
+    simd_lib::spmv(csr, x.data(), y1.data());
+    simd_lib::spmv(csr16, x.data(), y16.data());
+    // Lower the per-thread minimum so this small matrix is actually split
+    simd_lib::TuningConfig saved = simd_lib::get_tuning();
+    simd_lib::TuningConfig split = saved;
+    split.batch_min_floats = 1000;
+    simd_lib::set_tuning(split);
+    simd_lib::spmv(csr, x.data(), y4.data(), 4);
+    simd_lib::spmv(csr16, x.data(), y16_threads.data(), 3);
+    simd_lib::set_tuning(saved);
+    bool values_ok = true, delta_ok = true;
+    for (size_t r = 0; r < rows; ++r) {
+        double expected = 0.0;
+        for (size_t c = 0; c < cols; ++c) {
+            expected += (double)dense[r * cols + c] * x[c];
+        }
+        values_ok &= close(y1[r], expected, cols);
+        delta_ok &= close(y16[r], expected, cols);
+    }
+
+    report("CSR round trip:", structure_ok);
+    report("spmv matches dense reference:", values_ok);
+    report("Threads give identical rows:", y1 == y4 && y16 == y16_threads);
+    report("Delta16 spmv matches:", delta_ok);
+    std::cout << "\n";
+}
+
+void benchmark_sparse() {
+    std::cout << "=== Performance ===\n";
+
+    const size_t dim = 100000;
+    const int iterations = 200;
+    std::mt19937 rng(4);
+    std::vector<float> dense = random_dense(dim, rng);
+    SparseVector a = random_sparse(dim, 0.05, rng);
+    SparseVector b = random_sparse(dim, 0.05, rng);
+    size_t nnz = a.indices.size();
+    simd_lib::SparseVector16 a16 = simd_lib::compress_sparse_indices(a.indices.data(), a.values.data(), nnz);
+    std::vector<float> scratch(dim);
+    volatile float sink = 0.0f;
+
+    auto time_us = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Densifying means clearing and scattering into a scratch vector on every call
+    double densify = time_us([&] {
+        std::fill(scratch.begin(), scratch.end(), 0.0f);
+        for (size_t i = 0; i < nnz; ++i) {
+            scratch[a.indices[i]] = a.values[i];
+        }
+        sink = simd_lib::dot_product_avx2(scratch.data(), dense.data(), dim);
+    });
+    double scalar = time_us([&] { sink = simd_lib::sparse_dot_dense_scalar(a.indices.data(), a.values.data(), nnz,
+                                                                            dense.data()); });
+    double gather = time_us([&] { sink = simd_lib::sparse_dot_dense(a.indices.data(), a.values.data(), nnz,
+                                                                     dense.data()); });
+    double delta = time_us([&] { sink = simd_lib::sparse_dot_dense_delta16(a16.deltas.data(), a16.values.data(),
+                                                                            a16.deltas.size(), dense.data()); });
+    std::cout << "  Sparse-dense dot, 100K dims at 5%:\n";
+    std::cout << "    Densify + dot_product_avx2: " << densify << " us\n";
+    std::cout << "    Scalar:                     " << scalar << " us\n";
+    std::cout << "    AVX2 gather:                " << gather << " us (" << densify / gather << "x vs densify)\n";
+    std::cout << "    AVX2 delta16:               " << delta << " us (" << densify / delta << "x vs densify)\n";
+
+    double merge = time_us([&] {
+        sink = simd_lib::sparse_dot_sparse_scalar(a.indices.data(), a.values.data(), nnz, b.indices.data(),
+                                                  b.values.data(), b.indices.size());
+    });
+    double intersect = time_us([&] {
+        sink = simd_lib::sparse_dot_sparse(a.indices.data(), a.values.data(), nnz, b.indices.data(),
+                                           b.values.data(), b.indices.size());
+    });
+    std::cout << "  Sparse-sparse dot, both 5%:\n";
+    std::cout << "    Scalar merge:     " << merge << " us\n";
+    std::cout << "    AVX2 intersect:   " << intersect << " us\n";
+    std::cout << "    Speedup: " << merge / intersect << "x\n";
+
+    // 10000 x 10000 at 2%: 2M nonzeros
+    const size_t rows = 10000, cols = 10000;
+    simd_lib::CsrMatrix csr;
+    csr.rows = rows;
+    csr.cols = cols;
+    csr.row_offsets.push_back(0);
+    for (size_t r = 0; r < rows; ++r) {
+        SparseVector row = random_sparse(cols, 0.02, rng);
+        csr.col_indices.insert(csr.col_indices.end(), row.indices.begin(), row.indices.end());
+        csr.values.insert(csr.values.end(), row.values.begin(), row.values.end());
+        csr.row_offsets.push_back(csr.values.size());
+    }
+    simd_lib::CsrMatrix16 csr16 = simd_lib::compress_csr_indices(csr);
+    std::vector<float> x = random_dense(cols, rng);
+    std::vector<float> y(rows);
+    double spmv_scalar = time_us([&] {
+        for (size_t r = 0; r < rows; ++r) {
+            size_t offset = csr.row_offsets[r];
+            y[r] = simd_lib::sparse_dot_dense_scalar(&csr.col_indices[offset], &csr.values[offset],
+                                                     csr.row_offsets[r + 1] - offset, x.data());
+        }
+    });
+    double spmv_avx2 = time_us([&] { simd_lib::spmv(csr, x.data(), y.data()); });
+    double spmv_delta = time_us([&] { simd_lib::spmv(csr16, x.data(), y.data()); });
+    double spmv_threads = time_us([&] { simd_lib::spmv(csr, x.data(), y.data(), 0); });
+    std::cout << "  spmv, 10K x 10K at 2%:\n";
+    std::cout << "    Scalar:           " << spmv_scalar << " us\n";
+    std::cout << "    AVX2:             " << spmv_avx2 << " us (" << spmv_scalar / spmv_avx2 << "x)\n";
+    std::cout << "    AVX2 delta16:     " << spmv_delta << " us (" << spmv_scalar / spmv_delta << "x)\n";
+    std::cout << "    AVX2, all cores:  " << spmv_threads << " us (" << spmv_scalar / spmv_threads << "x)\n";
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Sparse Operations Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_sparse_dense();
+    test_sparse_sparse();
+    test_spmv();
+    benchmark_sparse();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+// Direct O(n^2) DFT in double, the reference for the plans
+static void reference_dft(const std::vector<float>& real, const std::vector<float>& imag,
+                          std::vector<double>& out_real, std::vector<double>& out_imag) {
+    size_t n = real.size();
+    out_real.assign(n, 0.0);
+    out_imag.assign(n, 0.0);
+    for (size_t k = 0; k < n; ++k) {
+        for (size_t t = 0; t < n; ++t) {
+            double angle = -2.0 * M_PI * (double)((k * t) % n) / (double)n;
+            out_real[k] += real[t] * std::cos(angle) - imag[t] * std::sin(angle);
+            out_imag[k] += real[t] * std::sin(angle) + imag[t] * std::cos(angle);
+        }
+    }
+}
+
+void test_plan() {
+    std::cout << "=== FFT Plan ===\n";
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    bool accurate = true;
+    bool round_trip = true;
+    for (size_t n = 2; n <= 2048; n *= 2) {
+        std::vector<float> real(n), imag(n);
+        for (size_t i = 0; i < n; ++i) {
+            real[i] = dist(rng);
+            imag[i] = dist(rng);
+        }
+        std::vector<double> ref_real, ref_imag;
+        reference_dft(real, imag, ref_real, ref_imag);
+
+        std::vector<float> work_real = real, work_imag = imag;
+        simd_lib::get_fft_plan(n)->execute(work_real.data(), work_imag.data());
+        double max_error = 0.0;
+        for (size_t k = 0; k < n; ++k) {
+            max_error = std::max(max_error, std::fabs(work_real[k] - ref_real[k]));
+            max_error = std::max(max_error, std::fabs(work_imag[k] - ref_imag[k]));
+        }
+        // Error grows like sqrt(n) * log2(n) * eps for random input
+        accurate = accurate && max_error < 2e-6 * std::sqrt((double)n) * std::log2((double)n) + 1e-6;
+
+        simd_lib::fft_inverse(work_real.data(), work_imag.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            round_trip = round_trip && std::fabs(work_real[i] - real[i]) < 1e-5f &&
+                         std::fabs(work_imag[i] - imag[i]) < 1e-5f;
+        }
+    }
+    report("matches DFT, n = 2..2048", accurate);
+    report("inverse round trip", round_trip);
+
+    report("plans are cached", simd_lib::get_fft_plan(1024) == simd_lib::get_fft_plan(1024));
+    std::vector<float> odd(12, 1.0f), odd_imag(12, 0.0f);
+    simd_lib::fft_forward(odd.data(), odd_imag.data(), 12);
+    report("non-power-of-2 unchanged", !simd_lib::get_fft_plan(12)->valid() && odd[0] == 1.0f);
+    std::cout << "\n";
+}
+
+void test_stft() {
+    std::cout << "=== STFT ===\n";
+
+    // 1 s at 8 kHz: a 1 kHz tone, frame 256 -> bin 32
+    const size_t rate = 8000;
+    const size_t count = rate;
+    std::vector<float> signal(count);
+    for (size_t i = 0; i < count; ++i) {
+        signal[i] = std::sin(2.0 * M_PI * 1000.0 * (double)i / rate);
+    }
+
+    simd_lib::STFTConfig config;
+    config.frame_size = 256;
+    config.hop_size = 64;
+    config.output = simd_lib::SpectrumType::Magnitude;
+    simd_lib::STFT stft(config);
+
+    size_t frames = stft.frame_count(count);
+    std::vector<float> spectrogram(frames * stft.bins());
+    report("frame count", stft.process(signal.data(), count, spectrogram.data()) == (count - 256) / 64 + 1);
+
+    bool peak_ok = true;
+    for (size_t f = 0; f < frames; ++f) {
+        const float* row = &spectrogram[f * stft.bins()];
+        size_t peak = std::max_element(row, row + stft.bins()) - row;
+        peak_ok = peak_ok && peak == 32;
+    }
+    // A unit sine under a Hann window peaks at n / 4 in magnitude
+    report("tone in bin 32", peak_ok && std::fabs(spectrogram[32] - 64.0f) < 0.01f);
+
+    // Threaded batches and streaming pushes of odd sizes give the same frames
+    config.num_threads = 4;
+    simd_lib::STFT threaded(config);
+    std::vector<float> threaded_out(spectrogram.size());
+    threaded.process(signal.data(), count, threaded_out.data());
+    report("threaded matches", threaded_out == spectrogram);
+
+    simd_lib::STFT streaming(config);
+    std::vector<float> streamed(spectrogram.size());
+    size_t written = 0;
+    for (size_t begin = 0; begin < count; begin += 97) {
+        size_t len = std::min<size_t>(97, count - begin);
+        size_t room = frames - written;
+        written += streaming.push(&signal[begin], len, &streamed[written * stft.bins()], room);
+    }
+    report("streaming matches", written == frames && streamed == spectrogram);
+
+    // Hop larger than the frame skips the gap samples, also across pushes
+    config.hop_size = 300;
+    simd_lib::STFT sparse(config);
+    std::vector<float> sparse_batch(sparse.frame_count(count) * sparse.bins());
+    size_t sparse_frames = sparse.process(signal.data(), count, sparse_batch.data());
+    std::vector<float> sparse_stream(sparse_batch.size());
+    size_t sparse_written = 0;
+    for (size_t begin = 0; begin < count; begin += 50) {
+        sparse_written += sparse.push(&signal[begin], 50, &sparse_stream[sparse_written * sparse.bins()],
+                                      sparse_frames - sparse_written);
+    }
+    report("hop > frame streaming", sparse_written == sparse_frames && sparse_stream == sparse_batch);
+
+    config.hop_size = 64;
+    config.output = simd_lib::SpectrumType::LogPower;
+    simd_lib::STFT log_stft(config);
+    std::vector<float> log_out(frames * log_stft.bins());
+    log_stft.process(signal.data(), count, log_out.data());
+    report("log power in dB", std::fabs(log_out[32] - 20.0f * std::log10(64.0f)) < 0.01f &&
+           log_out[100] >= -200.0f && log_out[100] < -60.0f);
+
+    // The fused dB kernels, with a partial tail vector and bins below the floor
+    const size_t db_count = 45;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    std::vector<float> re(db_count), im(db_count), db_scalar(db_count), db_avx2(db_count);
+    for (size_t i = 0; i < db_count; ++i) {
+        re[i] = i % 7 == 0 ? 0.0f : dist(rng) * std::pow(10.0f, -(float)(i % 5));
+        im[i] = i % 7 == 0 ? 0.0f : dist(rng);
+    }
+    bool db_ok = true;
+    simd_lib::complex_power_db_scalar(re.data(), im.data(), 1e-20f, db_scalar.data(), db_count);
+    for (size_t i = 0; i < db_count; ++i) {
+        double power = std::max((double)re[i] * re[i] + (double)im[i] * im[i], 1e-20);
+        db_ok = db_ok && std::fabs(db_scalar[i] - 10.0 * std::log10(power)) < 1e-4;
+    }
+    const auto& features = simd_lib::get_cpu_features();
+    if (features.has_avx2 && features.has_fma) {
+        simd_lib::complex_power_db_avx2(re.data(), im.data(), 1e-20f, db_avx2.data(), db_count);
+        for (size_t i = 0; i < db_count; ++i) {
+            db_ok = db_ok && std::fabs(db_avx2[i] - db_scalar[i]) < 1e-4f;
+        }
+    }
+    report("power_db kernels", db_ok && db_scalar[0] == db_scalar[7] && std::fabs(db_scalar[0] + 200.0f) < 1e-3f);
+    std::cout << "\n";
+}
+
+void benchmark_stft() {
+    std::cout << "=== Spectrogram Performance ===\n";
+
+    const size_t count = 1 << 20;
+    std::vector<float> signal(count);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (float& x : signal) {
+        x = dist(rng);
+    }
+
+    const size_t n = 1024, hop = 256;
+    size_t frames = (count - n) / hop + 1;
+    size_t bins = n / 2 + 1;
+    std::vector<float> out(frames * bins);
+
+    // The old way: scalar window loop, fft_forward, scalar magnitude loop per frame
+    std::vector<float> real(n), imag(n);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t f = 0; f < frames; ++f) {
+        for (size_t i = 0; i < n; ++i) {
+            float w = 0.5f - 0.5f * std::cos(2.0f * (float)M_PI * i / n);
+            real[i] = signal[f * hop + i] * w;
+            imag[i] = 0.0f;
+        }
+        simd_lib::fft_forward(real.data(), imag.data(), n);
+        for (size_t k = 0; k < bins; ++k) {
+            out[f * bins + k] = real[k] * real[k] + imag[k] * imag[k];
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double manual = std::chrono::duration<double, std::milli>(end - start).count();
+
+    simd_lib::STFTConfig config;
+    config.frame_size = n;
+    config.hop_size = hop;
+    simd_lib::STFT stft(config);
+    start = std::chrono::high_resolution_clock::now();
+    stft.process(signal.data(), count, out.data());
+    end = std::chrono::high_resolution_clock::now();
+    double fused = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "  " << frames << " frames of 1024, hop 256:\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  Per-frame loops: " << manual << " ms\n";
+    std::cout << "  STFT:            " << fused << " ms\n";
+    std::cout << "  Speedup: " << manual / fused << "x\n";
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - STFT Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_plan();
+    test_stft();
+    benchmark_stft();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
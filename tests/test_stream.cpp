@@ -0,0 +1,236 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static bool close_to(double value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance * std::max(1.0, std::fabs(expected));
+}
+
+static std::vector<float> random_data(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-2.0f, 3.0f);
+    std::vector<float> data(count);
+    for (float& x : data) {
+        x = dist(rng);
+    }
+    return data;
+}
+
+static bool write_floats(const std::string& path, const std::vector<float>& data) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+    return (bool)out;
+}
+
+void test_accumulators() {
+    std::cout << "=== Accumulators ===\n";
+
+    const size_t n = 100003;
+    std::vector<float> a = random_data(n, 1), b = random_data(n, 2);
+
+    double sum = 0.0, dot = 0.0, sq = 0.0;
+    float lo = a[0], hi = a[0];
+    for (size_t i = 0; i < n; ++i) {
+        sum += a[i];
+        dot += (double)a[i] * b[i];
+        sq += (double)a[i] * a[i];
+        lo = std::min(lo, a[i]);
+        hi = std::max(hi, a[i]);
+    }
+    double mean = sum / n;
+    double var = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        var += (a[i] - mean) * (a[i] - mean);
+    }
+    var /= n;
+
+    // Feed the data in irregular chunks
+    simd_lib::SumAccumulator sum_acc;
+    simd_lib::DotAccumulator dot_acc;
+    simd_lib::NormAccumulator norm_acc;
+    simd_lib::MinMaxAccumulator range_acc;
+    simd_lib::MeanVarianceAccumulator moments_acc;
+    std::mt19937 rng(3);
+    for (size_t begin = 0; begin < n;) {
+        size_t len = std::min<size_t>(n - begin, rng() % 9000);
+        sum_acc.add(&a[begin], len);
+        dot_acc.add(&a[begin], &b[begin], len);
+        norm_acc.add(&a[begin], len);
+        range_acc.add(&a[begin], len);
+        moments_acc.add(&a[begin], len);
+        begin += len;
+    }
+
+    report("sum", close_to(sum_acc.sum(), sum, 1e-6) && sum_acc.count() == n);
+    report("dot", close_to(dot_acc.dot(), dot, 1e-6));
+    report("norm", close_to(norm_acc.norm(), std::sqrt(sq), 1e-6));
+    report("min/max", range_acc.min() == lo && range_acc.max() == hi);
+    report("mean/variance", close_to(moments_acc.mean(), mean, 1e-6) && close_to(moments_acc.variance(), var, 1e-6));
+
+    // Two halves accumulated separately, as two threads would
+    simd_lib::MeanVarianceAccumulator first, second;
+    first.add(a.data(), n / 3);
+    second.add(&a[n / 3], n - n / 3);
+    first.merge(second);
+    simd_lib::MinMaxAccumulator range_first, range_second;
+    range_first.add(a.data(), n / 2);
+    range_second.add(&a[n / 2], n - n / 2);
+    range_first.merge(range_second);
+    report("merge", close_to(first.mean(), mean, 1e-6) && close_to(first.variance(), var, 1e-6) &&
+           range_first.min() == lo && range_first.max() == hi);
+
+    // Block moments reach the double merge unrounded: around an offset of 1000,
+    // float block means alone would leave the mean off by ~5e-7
+    std::vector<float> offset(1000003);
+    std::mt19937 offset_rng(4);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    double offset_mean = 0.0, offset_var = 0.0;
+    for (float& v : offset) {
+        v = 1000.0f + noise(offset_rng);
+        offset_mean += v;
+    }
+    offset_mean /= offset.size();
+    for (float v : offset) {
+        offset_var += (v - offset_mean) * (v - offset_mean);
+    }
+    offset_var /= offset.size();
+    simd_lib::MeanVarianceAccumulator offset_acc;
+    offset_acc.add(offset.data(), offset.size());
+    report("offset mean precision", close_to(offset_acc.mean(), offset_mean, 1e-11) &&
+           close_to(offset_acc.variance(), offset_var, 1e-6));
+
+    simd_lib::MinMaxAccumulator empty_range;
+    simd_lib::MeanVarianceAccumulator empty_moments;
+    report("empty accumulators", std::isinf(empty_range.min()) && empty_range.min() > 0 &&
+           std::isinf(empty_range.max()) && empty_moments.mean() == 0.0 && empty_moments.variance() == 0.0);
+
+    // 10M copies of 0.1f: one float sum over the whole stream is off by ~3e-4
+    std::vector<float> tenths(1 << 20, 0.1f);
+    simd_lib::SumAccumulator long_sum;
+    for (int i = 0; i < 10; ++i) {
+        long_sum.add(tenths.data(), tenths.size());
+    }
+    report("long stream precision", close_to(long_sum.sum(), 0.1f * 10.0 * (1 << 20), 1e-5));
+    std::cout << "\n";
+}
+
+void test_files() {
+    std::cout << "=== Files ===\n";
+
+    const std::string input = "simd_stream_test_in.bin";
+    const std::string output = "simd_stream_test_out.bin";
+    const size_t n = 300007;
+    std::vector<float> data = random_data(n, 4);
+    write_floats(input, data);
+
+    double expected = 0.0;
+    for (float x : data) {
+        expected += x;
+    }
+
+    for (simd_lib::ChunkSource source : {simd_lib::ChunkSource::Buffered, simd_lib::ChunkSource::Mapped}) {
+        simd_lib::SumAccumulator acc;
+        size_t chunks = 0;
+        bool ok = simd_lib::for_each_chunk(input, [&](const float* chunk, size_t count) {
+            acc.add(chunk, count);
+            ++chunks;
+        }, 65536, source);
+        report(source == simd_lib::ChunkSource::Buffered ? "buffered chunks" : "mapped chunks",
+               ok && acc.count() == n && chunks == (n + 65535) / 65536 && close_to(acc.sum(), expected, 1e-6));
+    }
+
+    bool ok = simd_lib::transform_file(input, output, [](const float* in, float* out, size_t count) {
+        simd_lib::vector_exp(in, out, count);
+    }, 50000);
+    std::vector<float> transformed(n + 1);
+    std::ifstream in(output, std::ios::binary);
+    in.read(reinterpret_cast<char*>(transformed.data()), (n + 1) * sizeof(float));
+    bool exact_size = (size_t)in.gcount() == n * sizeof(float);
+    std::vector<float> reference(n);
+    simd_lib::vector_exp(data.data(), reference.data(), n);
+    bool same = true;
+    for (size_t i = 0; i < n; ++i) {
+        same = same && transformed[i] == reference[i];
+    }
+    report("transform_file", ok && exact_size && same);
+
+    // A trailing partial float is rejected before any chunk is delivered
+    {
+        std::ofstream bad(input, std::ios::binary | std::ios::app);
+        bad.put(0);
+    }
+    bool called = false;
+    bool bad_ok = simd_lib::for_each_chunk(input, [&](const float*, size_t) { called = true; });
+    report("partial float rejected", !bad_ok && !called);
+    report("missing file rejected", !simd_lib::for_each_chunk("no_such_file.bin", [](const float*, size_t) {}));
+
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    std::cout << "\n";
+}
+
+void benchmark_streaming() {
+    std::cout << "=== Streaming Throughput ===\n";
+
+    const std::string path = "simd_stream_bench.bin";
+    const size_t n = 16 << 20;   // 64 MB
+    std::vector<float> data = random_data(n, 5);
+    write_floats(path, data);
+
+    auto time_source = [&](simd_lib::ChunkSource source) {
+        simd_lib::NormAccumulator acc;
+        auto start = std::chrono::high_resolution_clock::now();
+        simd_lib::for_each_chunk(path, [&](const float* chunk, size_t count) { acc.add(chunk, count); },
+                                 1 << 20, source);
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    // Whole array in memory, for reference
+    auto start = std::chrono::high_resolution_clock::now();
+    volatile float norm = simd_lib::vector_norm(data.data(), n);
+    (void)norm;
+    auto end = std::chrono::high_resolution_clock::now();
+    double in_memory = std::chrono::duration<double, std::milli>(end - start).count();
+
+    double buffered = time_source(simd_lib::ChunkSource::Buffered);
+    double mapped = time_source(simd_lib::ChunkSource::Mapped);
+    double mb = n * sizeof(float) / 1e6;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  In-memory vector_norm: " << in_memory << " ms\n";
+    std::cout << "  Buffered file norm:    " << buffered << " ms (" << mb / buffered * 1e3 << " MB/s)\n";
+    std::cout << "  Mapped file norm:      " << mapped << " ms (" << mb / mapped * 1e3 << " MB/s)\n";
+    std::remove(path.c_str());
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Streaming Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_accumulators();
+    test_files();
+    benchmark_streaming();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static simd_lib::KernelStats stats_of(const char* function) {
+    simd_lib::KernelStats stats = {};
+    simd_lib::telemetry_function_stats(function, &stats);
+    return stats;
+}
+
+static uint64_t isa_total(const simd_lib::KernelStats& stats) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < (size_t)simd_lib::DispatchIsa::Count; ++i) {
+        total += stats.isa_calls[i];
+    }
+    return total;
+}
+
+void test_recording() {
+    std::cout << "=== Recording ===\n";
+
+    std::vector<float> a(1000, 1.0f), b(1000, 2.0f), c(1000);
+
+    simd_lib::set_telemetry_enabled(false);
+    simd_lib::telemetry_reset();
+    simd_lib::vector_add(a.data(), b.data(), c.data(), a.size());
+    report("disabled records nothing", simd_lib::telemetry_snapshot(nullptr, 0) == 0);
+
+    simd_lib::set_telemetry_enabled(true);
+    for (int i = 0; i < 5; ++i) {
+        simd_lib::vector_add(a.data(), b.data(), c.data(), a.size());
+    }
+    simd_lib::vector_add(a.data(), b.data(), c.data(), 3);
+    simd_lib::KernelStats add = stats_of("vector_add");
+    report("calls counted", add.calls == 6);
+    report("every call has one ISA", isa_total(add) == 6);
+    // 1000 has bit length 10, 3 has bit length 2
+    report("size histogram", add.size_histogram[10] == 5 && add.size_histogram[2] == 1);
+
+    const auto& features = simd_lib::get_cpu_features();
+    simd_lib::DispatchIsa expected = features.has_avx2 ? simd_lib::DispatchIsa::AVX2
+                                   : features.has_sse4_1 ? simd_lib::DispatchIsa::SSE4
+                                   : simd_lib::DispatchIsa::Scalar;
+    report("ISA matches dispatch", add.isa_calls[(size_t)expected] == 6);
+
+    simd_lib::KernelStats unknown;
+    report("unknown name rejected", !simd_lib::telemetry_function_stats("no_such_kernel", &unknown));
+
+    // summed_area_table adds rows with vector_add; only the outer call counts
+    simd_lib::telemetry_reset();
+    std::vector<float> table(32 * 32, 1.0f), sat(table.size());
+    simd_lib::summed_area_table(table.data(), sat.data(), 32, 32);
+    report("nested calls not counted", stats_of("summed_area_table").calls == 1 &&
+           stats_of("vector_add").calls == 0);
+
+    // Worker threads of a recorded call inherit its nesting
+    simd_lib::telemetry_reset();
+    std::vector<float> big(1024 * 1024, 1.0f), big_sat(big.size());
+    simd_lib::summed_area_table(big.data(), big_sat.data(), 1024, 1024, 4);
+    report("nested calls in workers", stats_of("summed_area_table").calls == 1 &&
+           stats_of("vector_add").calls == 0);
+
+    // 2D FFTs are recorded as one call each, with no separate transposes
+    simd_lib::telemetry_reset();
+    std::vector<float> image(64 * 64, 1.0f), image_imag(image.size()), half_real(64 * 33), half_imag(64 * 33);
+    simd_lib::fft2d_forward(image.data(), image_imag.data(), 64, 64);
+    simd_lib::fft2d_inverse(image.data(), image_imag.data(), 64, 64);
+    simd_lib::fft2d_real_forward(image.data(), 64, 64, half_real.data(), half_imag.data());
+    report("fft2d recorded", stats_of("fft2d").calls == 2 && stats_of("fft2d_real").calls == 1 &&
+           stats_of("transpose").calls == 0);
+
+    simd_lib::telemetry_reset();
+    simd_lib::STFT stft(simd_lib::STFTConfig{});
+    std::vector<float> spectrogram(stft.frame_count(image.size()) * stft.bins());
+    stft.process(image.data(), image.size(), spectrogram.data());
+    report("stft recorded", stats_of("stft").calls == 1 && stats_of("vector_multiply").calls == 0 &&
+           stats_of("complex_magnitude_squared").calls == 0);
+
+    simd_lib::telemetry_reset();
+    std::vector<float> psd(simd_lib::welch_psd_bins(256));
+    simd_lib::welch_psd(big.data(), big.size(), psd.data(), 256, 128, simd_lib::WindowType::Hann, 1.0f, 4);
+    report("welch_psd recorded", stats_of("welch_psd").calls == 1 && stats_of("vector_add").calls == 0 &&
+           stats_of("vector_multiply").calls == 0);
+
+    simd_lib::telemetry_reset();
+    report("reset clears counts", simd_lib::telemetry_snapshot(nullptr, 0) == 0);
+    std::cout << "\n";
+}
+
+void test_threads() {
+    std::cout << "=== Threads ===\n";
+
+    simd_lib::set_telemetry_enabled(true);
+    simd_lib::telemetry_reset();
+
+    const int num_threads = 4;
+    const int calls_per_thread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([]() {
+            std::vector<float> a(256, 1.0f), b(256, 1.0f);
+            for (int i = 0; i < calls_per_thread; ++i) {
+                volatile float dot = simd_lib::dot_product(a.data(), b.data(), a.size());
+                (void)dot;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // The threads have exited; their counts must survive them
+    simd_lib::KernelStats dot = stats_of("dot_product");
+    report("exited threads aggregated", dot.calls == (uint64_t)num_threads * calls_per_thread);
+    report("time accumulated", dot.total_ns > 0);
+
+    std::string json = simd_lib::telemetry_json();
+    report("JSON lists function", json.find("\"name\": \"dot_product\"") != std::string::npos &&
+           json.find("\"calls\": 4000") != std::string::npos);
+    std::cout << json;
+    simd_lib::telemetry_reset();
+    std::cout << "\n";
+}
+
+void test_overhead() {
+    std::cout << "=== Overhead ===\n";
+
+    std::vector<float> a(16, 1.0f), b(16, 1.0f);
+    const int iterations = 200000;
+    auto time_calls = [&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            volatile float dot = simd_lib::dot_product(a.data(), b.data(), a.size());
+            (void)dot;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    };
+
+    simd_lib::set_telemetry_enabled(false);
+    double disabled = time_calls();
+    simd_lib::set_telemetry_enabled(true);
+    double enabled = time_calls();
+    simd_lib::set_telemetry_enabled(false);
+    simd_lib::telemetry_reset();
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  16-element dot_product, disabled: " << disabled << " ns/call\n";
+    std::cout << "  16-element dot_product, enabled:  " << enabled << " ns/call\n";
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Telemetry Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_recording();
+    test_threads();
+    test_overhead();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
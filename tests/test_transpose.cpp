@@ -0,0 +1,178 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static std::vector<float> iota_matrix(size_t count) {
+    std::vector<float> m(count);
+    for (size_t i = 0; i < count; ++i) {
+        m[i] = (float)i;
+    }
+    return m;
+}
+
+void test_transpose() {
+    std::cout << "=== Transpose ===\n";
+
+    const size_t shapes[][2] = {{1, 1}, {1, 9}, {7, 13}, {8, 8}, {16, 24}, {64, 64}, {100, 37}, {129, 257}};
+
+    bool scalar_ok = true, avx2_ok = true, dispatch_ok = true, padding_ok = true;
+    for (const auto& shape : shapes) {
+        size_t rows = shape[0], cols = shape[1];
+        // Strides wider than the matrix: only the rows x cols window moves
+        size_t lds = cols + 3, ldd = rows + 5;
+        std::vector<float> src = iota_matrix(rows * lds);
+
+        for (int k = 0; k < 3; ++k) {
+            std::vector<float> dst(cols * ldd, -1.0f);
+            if (k == 0) {
+                simd_lib::transpose_scalar(src.data(), rows, cols, lds, dst.data(), ldd);
+            } else if (k == 1) {
+                simd_lib::transpose_avx2(src.data(), rows, cols, lds, dst.data(), ldd);
+            } else {
+                simd_lib::transpose(src.data(), rows, cols, lds, dst.data(), ldd);
+            }
+            bool ok = true;
+            for (size_t c = 0; c < cols; ++c) {
+                for (size_t r = 0; r < ldd; ++r) {
+                    float expected = r < rows ? src[r * lds + c] : -1.0f;
+                    ok = ok && dst[c * ldd + r] == expected;
+                    if (r >= rows) {
+                        padding_ok = padding_ok && dst[c * ldd + r] == -1.0f;
+                    }
+                }
+            }
+            (k == 0 ? scalar_ok : k == 1 ? avx2_ok : dispatch_ok) &= ok;
+        }
+    }
+    report("scalar kernel", scalar_ok);
+    report("AVX2 kernel", avx2_ok);
+    report("blocked dispatch", dispatch_ok);
+    report("stride padding untouched", padding_ok);
+
+    const size_t rows = 1000, cols = 777;
+    std::vector<float> src = iota_matrix(rows * cols), single(rows * cols), threaded(rows * cols);
+    simd_lib::transpose(src.data(), rows, cols, cols, single.data(), rows);
+    simd_lib::transpose(src.data(), rows, cols, cols, threaded.data(), rows, 4);
+    report("threaded matches", single == threaded);
+    std::cout << "\n";
+}
+
+void test_transpose_inplace() {
+    std::cout << "=== In-Place Transpose ===\n";
+
+    bool scalar_ok = true, avx2_ok = true, dispatch_ok = true;
+    for (size_t n : {1, 2, 7, 8, 9, 63, 64, 65, 200}) {
+        size_t ld = n + 2;
+        const std::vector<float> original = iota_matrix(n * ld);
+
+        for (int k = 0; k < 3; ++k) {
+            std::vector<float> m = original;
+            if (k == 0) {
+                simd_lib::transpose_swap_scalar(m.data(), m.data(), n, n, ld);
+            } else if (k == 1) {
+                simd_lib::transpose_swap_avx2(m.data(), m.data(), n, n, ld);
+            } else {
+                simd_lib::transpose_inplace(m.data(), n, ld, 3);
+            }
+            bool ok = true;
+            for (size_t r = 0; r < n; ++r) {
+                for (size_t c = 0; c < ld; ++c) {
+                    float expected = c < n ? original[c * ld + r] : original[r * ld + c];
+                    ok = ok && m[r * ld + c] == expected;
+                }
+            }
+            (k == 0 ? scalar_ok : k == 1 ? avx2_ok : dispatch_ok) &= ok;
+        }
+    }
+    report("scalar kernel", scalar_ok);
+    report("AVX2 kernel", avx2_ok);
+    report("tiled dispatch", dispatch_ok);
+
+    // Swapping two distinct blocks: a (3x10) <-> b^T (10x3)
+    const size_t ld = 20;
+    std::vector<float> m = iota_matrix(ld * ld), before = m;
+    float* a = &m[0 * ld + 10];
+    float* b = &m[10 * ld + 0];
+    simd_lib::transpose_swap_avx2(a, b, 3, 10, ld);
+    bool swapped = true;
+    for (size_t r = 0; r < 3; ++r) {
+        for (size_t c = 0; c < 10; ++c) {
+            swapped = swapped && a[r * ld + c] == before[(10 + c) * ld + r] &&
+                      b[c * ld + r] == before[r * ld + 10 + c];
+        }
+    }
+    report("block swap", swapped);
+    std::cout << "\n";
+}
+
+void benchmark_transpose() {
+    std::cout << "=== Performance ===\n";
+
+    const size_t n = 4096;
+    std::vector<float> src = iota_matrix(n * n), dst(n * n);
+    const double bytes = 2.0 * n * n * sizeof(float);  // read + write
+    const int iterations = 5;
+
+    auto bandwidth = [&](double ms) { return bytes / (ms * 1e6); };
+    auto time_ms = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    };
+
+    double copy = time_ms([&] { std::memcpy(dst.data(), src.data(), n * n * sizeof(float)); });
+    double naive = time_ms([&] {
+        for (size_t r = 0; r < n; ++r) {
+            for (size_t c = 0; c < n; ++c) {
+                dst[c * n + r] = src[r * n + c];
+            }
+        }
+    });
+    double scalar_tiled = time_ms([&] { simd_lib::transpose_scalar(src.data(), n, n, n, dst.data(), n); });
+    double blocked = time_ms([&] { simd_lib::transpose(src.data(), n, n, n, dst.data(), n); });
+    double threaded = time_ms([&] { simd_lib::transpose(src.data(), n, n, n, dst.data(), n, 0); });
+    double inplace = time_ms([&] { simd_lib::transpose_inplace(dst.data(), n, n); });
+
+    std::cout << "  " << n << "x" << n << " floats:\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  memcpy:            " << copy << " ms (" << bandwidth(copy) << " GB/s)\n";
+    std::cout << "  Naive loop:        " << naive << " ms (" << bandwidth(naive) << " GB/s)\n";
+    std::cout << "  Scalar kernel:     " << scalar_tiled << " ms (" << bandwidth(scalar_tiled) << " GB/s)\n";
+    std::cout << "  transpose:         " << blocked << " ms (" << bandwidth(blocked) << " GB/s)\n";
+    std::cout << "  All threads:       " << threaded << " ms (" << bandwidth(threaded) << " GB/s)\n";
+    std::cout << "  transpose_inplace: " << inplace << " ms (" << bandwidth(inplace) << " GB/s)\n";
+    std::cout << "  Speedup over naive: " << naive / blocked << "x, " << 100.0 * copy / blocked
+              << "% of memcpy bandwidth\n";
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Transpose Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_transpose();
+    test_transpose_inplace();
+    benchmark_transpose();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static void set_env(const char* name, const char* value) {
+#ifdef _WIN32
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+static bool same_config(const simd_lib::TuningConfig& a, const simd_lib::TuningConfig& b) {
+    return a.streaming_store_bytes == b.streaming_store_bytes && a.reduce_min_block == b.reduce_min_block &&
+           a.scan_min_block == b.scan_min_block && a.batch_min_floats == b.batch_min_floats &&
+           a.top_k_block_rows == b.top_k_block_rows;
+}
+
+void test_config() {
+    std::cout << "=== Configuration ===\n";
+
+    std::cout << "  CPU model: " << simd_lib::get_cpu_model() << "\n";
+    report("defaults without a cache", same_config(simd_lib::get_tuning(), simd_lib::default_tuning()));
+
+    // Extreme thresholds must change speed only, never results
+    simd_lib::TuningConfig tiny = simd_lib::default_tuning();
+    tiny.streaming_store_bytes = 1;
+    tiny.reduce_min_block = 1;
+    tiny.scan_min_block = 1;
+    tiny.batch_min_floats = 1;
+    tiny.top_k_block_rows = 3;
+    simd_lib::set_tuning(tiny);
+    report("set_tuning applied", same_config(simd_lib::get_tuning(), tiny));
+
+    const size_t n = 1001;
+    std::vector<float> a(n + 1), b(n + 1), out(n + 1, 0.0f);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = (float)i;
+        b[i] = 2.0f;
+    }
+    // Output offset by one float so the streaming head loop runs
+    simd_lib::vector_add(a.data(), b.data(), out.data() + 1, n);
+    bool add_ok = out[0] == 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        add_ok = add_ok && out[i + 1] == a[i] + b[i];
+    }
+    report("streaming add, unaligned output", add_ok);
+
+    simd_lib::vector_scale(a.data(), 0.5f, out.data(), n);
+    bool scale_ok = true;
+    for (size_t i = 0; i < n; ++i) {
+        scale_ok = scale_ok && out[i] == a[i] * 0.5f;
+    }
+    report("streaming scale", scale_ok);
+
+    std::vector<float> ones(n, 1.0f), scan(n);
+    report("threaded sum, 1-element blocks", simd_lib::vector_sum(ones.data(), n, 4) == (float)n);
+    simd_lib::inclusive_scan(ones.data(), scan.data(), n, 4);
+    report("threaded scan, 1-element blocks", scan[0] == 1.0f && scan[n - 1] == (float)n);
+
+    size_t index = 0;
+    float score = 0.0f;
+    simd_lib::top_k_search(b.data(), a.data(), n, 1, 1, simd_lib::SimilarityMetric::DotProduct, &index, &score, 2);
+    report("top-k with 3-row blocks", index == n - 1);
+
+    simd_lib::set_tuning(simd_lib::default_tuning());
+    std::cout << "\n";
+}
+
+void test_cache() {
+    std::cout << "=== Cache ===\n";
+
+    std::string path = simd_lib::tuning_cache_path();
+    simd_lib::TuningConfig custom = simd_lib::default_tuning();
+    custom.reduce_min_block = 12345;
+    custom.top_k_block_rows = 512;
+    simd_lib::set_tuning(custom);
+    report("cache saved", simd_lib::save_tuning_cache());
+
+    simd_lib::set_tuning(simd_lib::default_tuning());
+    report("cache loaded", simd_lib::load_tuning_cache() && same_config(simd_lib::get_tuning(), custom));
+
+    // A cache from another CPU model is ignored
+    std::string text;
+    {
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            text += line.rfind("cpu ", 0) == 0 ? "cpu Some Other CPU" : line;
+            text += "\n";
+        }
+    }
+    std::ofstream(path) << text;
+    simd_lib::set_tuning(simd_lib::default_tuning());
+    report("other CPU rejected", !simd_lib::load_tuning_cache() &&
+           same_config(simd_lib::get_tuning(), simd_lib::default_tuning()));
+
+    std::ofstream(path) << "version 1\nreduce_min_block banana\n";
+    report("malformed cache rejected", !simd_lib::load_tuning_cache());
+
+    std::remove(path.c_str());
+    report("missing cache rejected", !simd_lib::load_tuning_cache());
+    std::cout << "\n";
+}
+
+void test_autotune() {
+    std::cout << "=== Autotune ===\n";
+
+    auto start = std::chrono::high_resolution_clock::now();
+    simd_lib::TuningConfig tuned = simd_lib::autotune(true);
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "  streaming_store_bytes: " << tuned.streaming_store_bytes << "\n";
+    std::cout << "  reduce_min_block:      " << tuned.reduce_min_block << "\n";
+    std::cout << "  scan_min_block:        " << tuned.scan_min_block << "\n";
+    std::cout << "  batch_min_floats:      " << tuned.batch_min_floats << "\n";
+    std::cout << "  top_k_block_rows:      " << tuned.top_k_block_rows << "\n";
+    std::cout << std::fixed << std::setprecision(1) << "  Autotune time: " << ms << " ms\n";
+
+    report("autotune applied", same_config(simd_lib::get_tuning(), tuned));
+    report("top-k block in range", tuned.top_k_block_rows >= 64 && tuned.top_k_block_rows <= 2048);
+
+    simd_lib::set_tuning(simd_lib::default_tuning());
+    start = std::chrono::high_resolution_clock::now();
+    bool loaded = simd_lib::load_tuning_cache();
+    end = std::chrono::high_resolution_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count();
+    report("autotune result cached", loaded && same_config(simd_lib::get_tuning(), tuned));
+    std::cout << "  Cache load time: " << us << " us\n";
+
+    std::remove(simd_lib::tuning_cache_path().c_str());
+    simd_lib::set_tuning(simd_lib::default_tuning());
+    std::cout << "\n";
+}
+
+void benchmark_streaming() {
+    std::cout << "=== Streaming Stores ===\n";
+
+    if (!simd_lib::get_cpu_features().has_avx2) {
+        std::cout << "  AVX2 not available\n\n";
+        return;
+    }
+
+    const size_t n = (32 << 20) / sizeof(float);
+    std::vector<float> a(n, 1.0f), b(n, 2.0f), out(n);
+    const int iterations = 10;
+
+    auto time_kernel = [&](void (*kernel)(const float*, const float*, float*, size_t)) {
+        kernel(a.data(), b.data(), out.data(), n);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            kernel(a.data(), b.data(), out.data(), n);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+
+    double regular = time_kernel(simd_lib::vector_add_avx2);
+    double streaming = time_kernel(simd_lib::vector_add_avx2_stream);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  32 MB vector_add, regular stores:   " << regular << " us\n";
+    std::cout << "  32 MB vector_add, streaming stores: " << streaming << " us\n";
+    std::cout << std::setprecision(2) << "  Speedup: " << regular / streaming << "x\n";
+    std::cout << "\n";
+}
+
+int main() {
+    // Keep the test's cache out of the user's cache directory
+    set_env("SIMD_LIB_TUNING_CACHE", "simd_lib_tuning_test.txt");
+    std::remove("simd_lib_tuning_test.txt");
+
+    std::cout << simd_lib::get_simd_version() << " - Auto-tuning Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_config();
+    test_cache();
+    test_autotune();
+    benchmark_streaming();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}
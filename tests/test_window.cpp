@@ -0,0 +1,184 @@
+#include "simd_lib.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static bool g_all_correct = true;
+
+static void report(const char* name, bool correct) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right
+              << (correct ? "Yes" : "No") << "\n";
+    g_all_correct = g_all_correct && correct;
+}
+
+static double reference_window(simd_lib::WindowType type, size_t i, size_t n) {
+    double phase = 2.0 * M_PI * (double)i / (double)n;
+    switch (type) {
+    case simd_lib::WindowType::Hann: return 0.5 - 0.5 * std::cos(phase);
+    case simd_lib::WindowType::Hamming: return 0.54 - 0.46 * std::cos(phase);
+    case simd_lib::WindowType::Blackman: return 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+    default: return 1.0;
+    }
+}
+
+void test_windows() {
+    std::cout << "=== Windows ===\n";
+
+    const simd_lib::WindowType types[] = {simd_lib::WindowType::Rectangular, simd_lib::WindowType::Hann,
+                                          simd_lib::WindowType::Hamming, simd_lib::WindowType::Blackman};
+    double max_error = 0.0;
+    for (simd_lib::WindowType type : types) {
+        for (size_t n : {1, 7, 64, 1000, 4096}) {
+            std::vector<float> window(n);
+            simd_lib::generate_window(type, window.data(), n);
+            for (size_t i = 0; i < n; ++i) {
+                max_error = std::max(max_error, std::fabs(window[i] - reference_window(type, i, n)));
+            }
+        }
+    }
+    std::cout << "  Max error vs double formula: " << std::scientific << std::setprecision(2) << max_error << "\n";
+    report("windows match formulas", max_error < 1e-6);
+
+    auto hann = simd_lib::get_window(simd_lib::WindowType::Hann, 512);
+    report("windows are cached", hann == simd_lib::get_window(simd_lib::WindowType::Hann, 512) &&
+           hann != simd_lib::get_window(simd_lib::WindowType::Hamming, 512));
+
+    // Periodic Hann at 50% overlap sums to exactly 1
+    bool cola = true;
+    for (size_t i = 0; i < 256; ++i) {
+        cola = cola && std::fabs((*hann)[i] + (*hann)[i + 256] - 1.0f) < 1e-6f;
+    }
+    report("Hann overlap-adds to 1", cola);
+
+    std::vector<float> data(512, 2.0f);
+    simd_lib::apply_window(data.data(), simd_lib::WindowType::Hann, data.size());
+    bool applied = true;
+    for (size_t i = 0; i < data.size(); ++i) {
+        applied = applied && data[i] == 2.0f * (*hann)[i];
+    }
+    report("apply_window in place", applied);
+    std::cout << "\n";
+}
+
+void test_welch() {
+    std::cout << "=== Welch PSD ===\n";
+
+    // White noise of variance 1 plus a 1 kHz tone of amplitude 1 at 8 kHz
+    const size_t count = 1 << 17;
+    const float rate = 8000.0f;
+    std::mt19937 rng(5);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<float> white(count), signal(count);
+    for (size_t i = 0; i < count; ++i) {
+        white[i] = noise(rng);
+        signal[i] = white[i] + std::sin(2.0 * M_PI * 1000.0 * (double)i / rate);
+    }
+
+    const size_t segment = 512;
+    std::vector<float> psd(segment / 2 + 1);
+    size_t segments = simd_lib::welch_psd(white.data(), count, psd.data(), segment, segment / 2,
+                                          simd_lib::WindowType::Hann, rate);
+    report("segment count", segments == (count - segment) / (segment / 2) + 1);
+
+    // One-sided density of unit white noise: 2 / rate everywhere but DC and Nyquist
+    double mean = 0.0;
+    for (size_t k = 1; k < segment / 2; ++k) {
+        mean += psd[k];
+    }
+    mean /= (double)(segment / 2 - 1);
+    report("white noise level", std::fabs(mean * rate / 2.0 - 1.0) < 0.02);
+
+    simd_lib::welch_psd(signal.data(), count, psd.data(), segment, segment / 2, simd_lib::WindowType::Hann, rate);
+    size_t peak = std::max_element(psd.begin(), psd.end()) - psd.begin();
+    report("tone at 1 kHz bin", peak == 64);
+
+    // Parseval: the integral of the PSD is the signal power (1 + 0.5)
+    double total = 0.0;
+    for (float p : psd) {
+        total += p * (rate / segment);
+    }
+    report("integrates to signal power", std::fabs(total - 1.5) < 0.05);
+
+    std::vector<float> threaded(psd.size());
+    simd_lib::welch_psd(signal.data(), count, threaded.data(), segment, segment / 2, simd_lib::WindowType::Hann,
+                        rate, 4);
+    // Different block sums round differently, so compare with a tolerance
+    bool threaded_ok = true;
+    for (size_t k = 0; k < psd.size(); ++k) {
+        threaded_ok = threaded_ok && std::fabs(threaded[k] - psd[k]) <= 1e-5f * psd[k];
+    }
+    report("threaded matches", threaded_ok);
+
+    // Segments round up to a power of 2: 1000 samples give 1024-point spectra
+    std::vector<float> rounded(simd_lib::welch_psd_bins(1000) + 1, -1.0f);
+    size_t rounded_segments = simd_lib::welch_psd(signal.data(), count, rounded.data(), 1000, 500,
+                                                  simd_lib::WindowType::Hann, rate);
+    size_t rounded_peak = std::max_element(rounded.begin(), rounded.end()) - rounded.begin();
+    report("non-power-of-2 segment", simd_lib::welch_psd_bins(1000) == 513 && rounded.back() == -1.0f &&
+           rounded_segments == (count - 1024) / 500 + 1 && rounded_peak == 128);
+
+    report("short input averages nothing", simd_lib::welch_psd(signal.data(), 100, psd.data(), segment, 256) == 0 &&
+           psd[0] == 0.0f);
+    std::cout << "\n";
+}
+
+void benchmark_windows() {
+    std::cout << "=== Performance ===\n";
+
+    const size_t n = 1024;
+    const int frames = 2000;
+    std::vector<float> frame(n, 1.0f);
+
+    // Scalar cos per sample, per frame, as before
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        for (size_t i = 0; i < n; ++i) {
+            frame[i] *= 0.5f - 0.5f * std::cos(2.0f * (float)M_PI * i / n);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double scalar_time = std::chrono::duration<double, std::micro>(end - start).count() / frames;
+
+    auto window = simd_lib::get_window(simd_lib::WindowType::Hann, n);
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        simd_lib::apply_window(frame.data(), window->data(), n);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double cached_time = std::chrono::duration<double, std::micro>(end - start).count() / frames;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  1024-sample Hann, scalar cos: " << scalar_time << " us\n";
+    std::cout << "  1024-sample Hann, cached:     " << cached_time << " us\n";
+    std::cout << std::setprecision(2) << "  Speedup: " << scalar_time / cached_time << "x\n";
+
+    std::vector<float> signal(1 << 20, 0.5f), psd(n / 2 + 1);
+    start = std::chrono::high_resolution_clock::now();
+    size_t segments = simd_lib::welch_psd(signal.data(), signal.size(), psd.data(), n, n / 2);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "  Welch, " << segments << " segments of 1024: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    std::cout << "\n";
+}
+
+int main() {
+    std::cout << simd_lib::get_simd_version() << " - Window and PSD Test\n\n";
+
+    simd_lib::init_cpu_features();
+    simd_lib::print_cpu_features();
+    std::cout << "\n";
+
+    test_windows();
+    test_welch();
+    benchmark_windows();
+
+    std::cout << "All correct: " << (g_all_correct ? "Yes" : "No") << "\n";
+    return g_all_correct ? 0 : 1;
+}